@@ -0,0 +1,258 @@
+//
+//  RawFrameDecoderTests.swift
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+import XCTest
+@testable import MyBrainTechnologiesSDK
+
+/// The C++ decoder of the signal processing (MBT_RawFrameDecoder, through the
+/// C interface) must give the samples of EEGDeserializer, bit for bit, and the
+/// lost frames of EEGAcquisitionBuffer.
+class RawFrameDecoderTests: XCTestCase {
+
+  //----------------------------------------------------------------------------
+  // MARK: - Helpers
+  //----------------------------------------------------------------------------
+
+  /// Reproducible bytes, all the codes being possible.
+  private func randomBytes(count: Int, seed: UInt32) -> [UInt8] {
+    var state = seed
+    return (0 ..< count).map { _ in
+      state = state &* 1_664_525 &+ 1_013_904_223
+      return UInt8(truncatingIfNeeded: state >> 24)
+    }
+  }
+
+  /// Frames of `payloadSize` bytes preceded by their big-endian index.
+  private func frames(indexes: [Int16], payloadSize: Int) -> [[UInt8]] {
+    return indexes.enumerated().map { frame, index in
+      let payload = randomBytes(count: payloadSize, seed: UInt32(frame + 1))
+      return [UInt8(truncatingIfNeeded: index >> 8),
+              UInt8(truncatingIfNeeded: index)] + payload
+    }
+  }
+
+  /// Planar samples split into one array per channel.
+  private func channels(_ planar: [Float],
+                        count: Int,
+                        samples: Int) -> [[Float]] {
+    return (0 ..< count).map {
+      Array(planar[$0 * samples ..< ($0 + 1) * samples])
+    }
+  }
+
+  private func decodeRawSamples(bytes: [UInt8], channelCount: Int) -> [[Float]] {
+    var samples: Int32 = 0
+    var status = MBTDecodeRawSamples(bytes, Int32(bytes.count),
+                                     Int32(channelCount), nil, 0, &samples)
+    XCTAssertTrue(status == MBTStatusOK || status == MBTStatusBufferTooSmall)
+
+    var planar = [Float](repeating: 0, count: Int(samples) * channelCount)
+    status = MBTDecodeRawSamples(bytes, Int32(bytes.count), Int32(channelCount),
+                                 &planar, Int32(planar.count), &samples)
+    XCTAssertEqual(status, MBTStatusOK)
+    return channels(planar, count: channelCount, samples: Int(samples))
+  }
+
+  private func decodeFrames(_ frames: [[UInt8]],
+                            decoder: MBTRawFrameDecoderRef,
+                            channelCount: Int) -> [[Float]] {
+    let bytes = frames.flatMap { $0 }
+    let frameSize = Int32(frames.first?.count ?? 3)
+    var samples: Int32 = 0
+    var status = MBTRawFrameDecoderDecodeFrames(decoder, bytes,
+                                                Int32(frames.count), frameSize,
+                                                nil, 0, &samples)
+    XCTAssertTrue(status == MBTStatusOK || status == MBTStatusBufferTooSmall)
+
+    var planar = [Float](repeating: 0, count: Int(samples) * channelCount)
+    status = MBTRawFrameDecoderDecodeFrames(decoder, bytes,
+                                            Int32(frames.count), frameSize,
+                                            &planar, Int32(planar.count),
+                                            &samples)
+    XCTAssertEqual(status, MBTStatusOK)
+    return channels(planar, count: channelCount, samples: Int(samples))
+  }
+
+  private func createDecoder(channelCount: Int,
+                             fill: MBTLostFrameFill) -> MBTRawFrameDecoderRef? {
+    var decoder: MBTRawFrameDecoderRef?
+    XCTAssertEqual(MBTRawFrameDecoderCreate(Int32(channelCount), fill, &decoder),
+                   MBTStatusOK)
+    return decoder
+  }
+
+  /// Samples of EEGDeserializer, the incomplete last sample being removed from
+  /// the first channels as by the decoder.
+  private func deserialize(bytes: [UInt8], channelCount: Int) -> [[Float]] {
+    let values = EEGDeserializer.deserializeToRelaxIndex(
+      bytes: bytes,
+      numberOfElectrodes: channelCount
+    )
+    let samples = bytes.count / (2 * channelCount)
+    return values.map { Array($0.prefix(samples)) }
+  }
+
+  /// Payloads of the frames as given by EEGAcquisitionBuffer.
+  private func acquire(_ frames: [[UInt8]]) -> [UInt8] {
+    let payloadSize = frames[0].count - 2
+    let buffer = EEGAcquisitionBuffer(bufferSizeMax: payloadSize)
+    var payloads = [UInt8]()
+    for frame in frames {
+      buffer.add(rawPacketValue: frame)
+      while let usable = buffer.getUsablePackets() {
+        payloads += usable
+      }
+    }
+    return payloads
+  }
+
+  //----------------------------------------------------------------------------
+  // MARK: - Same samples as EEGDeserializer
+  //----------------------------------------------------------------------------
+
+  func testDecodedSamplesAreTheDeserializedOnes() {
+    for channelCount in 1 ... 4 {
+      let bytes = randomBytes(count: 2 * channelCount * 250, seed: 7)
+
+      let decoded = decodeRawSamples(bytes: bytes, channelCount: channelCount)
+
+      XCTAssertEqual(decoded,
+                     deserialize(bytes: bytes, channelCount: channelCount),
+                     "\(channelCount) channels")
+    }
+  }
+
+  func testIncompleteLastSampleIsIgnored() {
+    for channelCount in 1 ... 4 {
+      for extraBytes in 1 ..< 2 * channelCount {
+        let bytes = randomBytes(count: 2 * channelCount * 20 + extraBytes,
+                                seed: UInt32(extraBytes))
+
+        let decoded = decodeRawSamples(bytes: bytes, channelCount: channelCount)
+
+        XCTAssertEqual(decoded.map { $0.count },
+                       [Int](repeating: 20, count: channelCount))
+        XCTAssertEqual(decoded,
+                       deserialize(bytes: bytes, channelCount: channelCount),
+                       "\(channelCount) channels, \(extraBytes) extra bytes")
+      }
+    }
+  }
+
+  /// The headset layouts are decoded by blocks of 4 or 8 samples, the last
+  /// samples by the scalar path.
+  func testScalarTailGivesTheSameSamples() {
+    let layouts = [(channels: 2, samples: 8 * 3 + 5),
+                   (channels: 2, samples: 7),
+                   (channels: 4, samples: 4 * 5 + 3),
+                   (channels: 4, samples: 8 * 2 + 7),
+                   (channels: 3, samples: 17)]
+    for layout in layouts {
+      let bytes = randomBytes(count: 2 * layout.channels * layout.samples,
+                              seed: UInt32(layout.samples))
+
+      let decoded = decodeRawSamples(bytes: bytes, channelCount: layout.channels)
+
+      XCTAssertEqual(decoded,
+                     deserialize(bytes: bytes, channelCount: layout.channels),
+                     "\(layout.channels) channels, \(layout.samples) samples")
+    }
+  }
+
+  func testExtremeCodes() {
+    let bytes: [UInt8] = [0x7F, 0xFF, 0x80, 0x00, 0xFF, 0xFF, 0x00, 0x00,
+                          0x00, 0x01, 0x80, 0x01, 0x12, 0x34, 0xFE, 0xDC]
+
+    for channelCount in [2, 4] {
+      XCTAssertEqual(decodeRawSamples(bytes: bytes, channelCount: channelCount),
+                     deserialize(bytes: bytes, channelCount: channelCount))
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // MARK: - Lost frames
+  //----------------------------------------------------------------------------
+
+  func testLostFramesAreFilledAsTheAcquisitionBuffer() {
+    // 2 then 3 frames lost, the payloads not being whole samples
+    let received = frames(indexes: [10, 11, 14, 15, 19, 20], payloadSize: 18)
+    let decoder = createDecoder(channelCount: 4, fill: MBTLostFrameFillBytes)
+    defer { MBTRawFrameDecoderRelease(decoder) }
+
+    let decoded = decodeFrames(received, decoder: decoder!, channelCount: 4)
+
+    XCTAssertEqual(decoded.first?.count, 11 * 18 / 8)
+    XCTAssertEqual(decoded,
+                   deserialize(bytes: acquire(received), channelCount: 4))
+  }
+
+  func testFramesLostBetweenTwoCallsAreFilled() {
+    let received = frames(indexes: [0, 1, 2, 6, 7], payloadSize: 16)
+    let decoder = createDecoder(channelCount: 2, fill: MBTLostFrameFillBytes)
+    defer { MBTRawFrameDecoderRelease(decoder) }
+
+    let first = decodeFrames(Array(received[..<3]),
+                             decoder: decoder!,
+                             channelCount: 2)
+    let second = decodeFrames(Array(received[3...]),
+                              decoder: decoder!,
+                              channelCount: 2)
+
+    let expected = deserialize(bytes: acquire(received), channelCount: 2)
+    XCTAssertEqual(zip(first, second).map { $0 + $1 }, expected)
+  }
+
+  func testLostFramesAreNaN() {
+    let payloadSize = 18
+    let received = frames(indexes: [3, 4, 7, 8, 9, 11], payloadSize: payloadSize)
+    let bytesDecoder = createDecoder(channelCount: 4, fill: MBTLostFrameFillBytes)
+    let nanDecoder = createDecoder(channelCount: 4, fill: MBTLostFrameFillNaN)
+    defer {
+      MBTRawFrameDecoderRelease(bytesDecoder)
+      MBTRawFrameDecoderRelease(nanDecoder)
+    }
+
+    let filled = decodeFrames(received, decoder: bytesDecoder!, channelCount: 4)
+    let decoded = decodeFrames(received, decoder: nanDecoder!, channelCount: 4)
+
+    // frames 5, 6 and 10 are lost, a sample of 8 bytes sharing a byte with
+    // them is missing
+    let lostBytes = [(2 * payloadSize, 4 * payloadSize),
+                     (7 * payloadSize, 8 * payloadSize)]
+    XCTAssertEqual(decoded.map { $0.count }, filled.map { $0.count })
+    for (channel, samples) in decoded.enumerated() {
+      for (sample, value) in samples.enumerated() {
+        let isLost = lostBytes.contains { sample * 8 < $0.1 && $0.0 < (sample + 1) * 8 }
+        if isLost {
+          XCTAssertTrue(value.isNaN, "channel \(channel), sample \(sample)")
+        } else {
+          XCTAssertEqual(value, filled[channel][sample],
+                         "channel \(channel), sample \(sample)")
+        }
+      }
+    }
+  }
+
+  func testTooSmallBufferKeepsTheLastIndex() {
+    let received = frames(indexes: [0, 1, 4], payloadSize: 16)
+    let decoder = createDecoder(channelCount: 2, fill: MBTLostFrameFillBytes)
+    defer { MBTRawFrameDecoderRelease(decoder) }
+    let bytes = received.flatMap { $0 }
+    var planar = [Float](repeating: 0, count: 4)
+    var samples: Int32 = 0
+
+    let status = MBTRawFrameDecoderDecodeFrames(decoder, bytes, 3, 18,
+                                                &planar, Int32(planar.count),
+                                                &samples)
+
+    XCTAssertEqual(status, MBTStatusBufferTooSmall)
+    XCTAssertEqual(samples, 5 * 16 / 4)
+    XCTAssertEqual(decodeFrames(received, decoder: decoder!, channelCount: 2),
+                   deserialize(bytes: acquire(received), channelCount: 2))
+  }
+
+}
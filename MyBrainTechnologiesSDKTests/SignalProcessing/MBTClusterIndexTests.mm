@@ -0,0 +1,189 @@
+//
+//  MBTClusterIndexTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <TimeFrequency/MBT_ClusterIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+/// Bounding boxes of clusters on integer coordinates, so that many of them
+/// touch each other.
+struct Boxes {
+  SP_Vector minX;
+  SP_Vector maxX;
+  SP_Vector minY;
+  SP_Vector maxY;
+};
+
+static unsigned int nextRandom(unsigned int& state, unsigned int range) {
+  state = state * 1664525u + 1013904223u;
+  return (state >> 8) % range;
+}
+
+static Boxes randomBoxes(unsigned int seed, size_t count) {
+  unsigned int state = seed;
+  Boxes boxes;
+  for (size_t i = 0; i < count; ++i) {
+    const SP_RealType x = nextRandom(state, 200);
+    const SP_RealType y = nextRandom(state, 20);
+    boxes.minX.push_back(x);
+    boxes.maxX.push_back(x + nextRandom(state, 15));
+    boxes.minY.push_back(y);
+    boxes.maxY.push_back(y + nextRandom(state, 5));
+  }
+  return boxes;
+}
+
+/// Gap between two closed intervals, 0 when they overlap.
+static SP_RealType gap(SP_RealType first, SP_RealType last, SP_RealType otherFirst, SP_RealType otherLast) {
+  return std::max<SP_RealType>(std::max(otherFirst - last, first - otherLast), 0);
+}
+
+/// Clusters overlapping a box, by scanning all of them.
+static std::vector<int> bruteForceOverlapping(const Boxes& boxes, SP_RealType firstX, SP_RealType lastX,
+                                              SP_RealType firstY, SP_RealType lastY, int excluded) {
+  std::vector<int> clusters;
+  for (size_t i = 0; i < boxes.minX.size(); ++i) {
+    if (static_cast<int>(i) != excluded && boxes.minX[i] <= lastX && boxes.maxX[i] >= firstX &&
+        boxes.minY[i] <= lastY && boxes.maxY[i] >= firstY) {
+      clusters.push_back(static_cast<int>(i));
+    }
+  }
+  return clusters;
+}
+
+/// True if the clusters are the expected ones, sorted by decreasing minimum x.
+static bool isSameClusters(const Boxes& boxes, std::vector<int> clusters, std::vector<int> const& expected) {
+  for (size_t i = 1; i < clusters.size(); ++i) {
+    if (boxes.minX[clusters[i - 1]] < boxes.minX[clusters[i]]) {
+      return false;
+    }
+  }
+  std::sort(clusters.begin(), clusters.end());
+  return clusters == expected;
+}
+
+@interface MBTClusterIndexTests : XCTestCase
+@end
+
+@implementation MBTClusterIndexTests
+
+//----------------------------------------------------------------------------
+// MARK: - Same clusters as a scan of all the clusters
+//----------------------------------------------------------------------------
+
+- (void)testOverlappingIsTheScan {
+  const SP_RealType infinity = std::numeric_limits<SP_RealType>::infinity();
+  MBT_ClusterIndex index;
+  std::vector<int> clusters;
+  for (unsigned int seed = 1; seed <= 40; ++seed) {
+    const Boxes boxes = randomBoxes(seed, 2 * seed);
+    index.build(boxes.minX, boxes.maxX, boxes.minY, boxes.maxY);
+    XCTAssertEqual(index.count(), static_cast<int>(boxes.minX.size()));
+
+    unsigned int state = seed + 1000;
+    for (int query = 0; query < 100; ++query) {
+      const SP_RealType firstX = static_cast<SP_RealType>(nextRandom(state, 230)) - 10;
+      const SP_RealType lastX = firstX + nextRandom(state, 20);
+      const SP_RealType firstY = nextRandom(state, 22);
+      const SP_RealType lastY = firstY + nextRandom(state, 4);
+
+      index.overlapping(firstX, lastX, clusters);
+      XCTAssertTrue(isSameClusters(boxes, clusters, bruteForceOverlapping(boxes, firstX, lastX, -infinity, infinity, -1)),
+                    @"seed %u, [%g, %g]", seed, firstX, lastX);
+      const size_t found = index.overlapping(firstX, lastX, firstY, lastY, clusters);
+      XCTAssertEqual(found, clusters.size());
+      XCTAssertTrue(isSameClusters(boxes, clusters, bruteForceOverlapping(boxes, firstX, lastX, firstY, lastY, -1)),
+                    @"seed %u, [%g, %g] x [%g, %g]", seed, firstX, lastX, firstY, lastY);
+    }
+
+    for (int cluster = 0; cluster < index.count(); ++cluster) {
+      index.overlapping(cluster, clusters);
+      XCTAssertTrue(isSameClusters(boxes, clusters,
+                                   bruteForceOverlapping(boxes, boxes.minX[cluster], boxes.maxX[cluster], -infinity,
+                                                         infinity, cluster)),
+                    @"seed %u, cluster %d", seed, cluster);
+    }
+  }
+}
+
+/// The nearest cluster is at the smallest distance found by the scan.
+- (void)testNearestIsTheScan {
+  MBT_ClusterIndex index;
+  for (unsigned int seed = 1; seed <= 40; ++seed) {
+    const Boxes boxes = randomBoxes(seed, 1 + seed / 2);
+    index.build(boxes.minX, boxes.maxX, boxes.minY, boxes.maxY);
+
+    unsigned int state = seed + 2000;
+    for (int query = 0; query < 100; ++query) {
+      const SP_RealType firstX = static_cast<SP_RealType>(nextRandom(state, 260)) - 30;
+      const SP_RealType lastX = firstX + nextRandom(state, 10);
+      SP_RealType expected = std::numeric_limits<SP_RealType>::infinity();
+      for (size_t i = 0; i < boxes.minX.size(); ++i) {
+        expected = std::min(expected, gap(firstX, lastX, boxes.minX[i], boxes.maxX[i]));
+      }
+
+      SP_RealType distance;
+      const int nearest = index.nearest(firstX, lastX, distance);
+      XCTAssertEqual(distance, expected, @"seed %u, [%g, %g]", seed, firstX, lastX);
+      XCTAssertEqual(gap(firstX, lastX, boxes.minX[nearest], boxes.maxX[nearest]), expected, @"seed %u", seed);
+    }
+
+    for (int cluster = 0; cluster < index.count(); ++cluster) {
+      SP_RealType expected = std::numeric_limits<SP_RealType>::infinity();
+      for (int i = 0; i < index.count(); ++i) {
+        if (i != cluster) {
+          expected = std::min(expected, gap(boxes.minX[cluster], boxes.maxX[cluster], boxes.minX[i], boxes.maxX[i]));
+        }
+      }
+
+      SP_RealType distance;
+      const int nearest = index.nearest(cluster, distance);
+      if (index.count() == 1) {
+        XCTAssertEqual(nearest, -1);
+        continue;
+      }
+      XCTAssertNotEqual(nearest, cluster, @"seed %u", seed);
+      XCTAssertEqual(distance, expected, @"seed %u, cluster %d", seed, cluster);
+      XCTAssertEqual(gap(boxes.minX[cluster], boxes.maxX[cluster], boxes.minX[nearest], boxes.maxX[nearest]), expected,
+                     @"seed %u, cluster %d", seed, cluster);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Edge cases
+//----------------------------------------------------------------------------
+
+- (void)testEmptyIndex {
+  MBT_ClusterIndex index;
+  const SP_Vector none;
+  index.build(none, none, none, none);
+  std::vector<int> clusters(3, 0);
+  XCTAssertEqual(index.overlapping(0, 100, clusters), 0u);
+  XCTAssertTrue(clusters.empty());
+  SP_RealType distance;
+  XCTAssertEqual(index.nearest(0, 100, distance), -1);
+  XCTAssertThrows(index.nearest(0, distance));
+}
+
+- (void)testInvalidArguments {
+  MBT_ClusterIndex index;
+  const Boxes boxes = randomBoxes(3, 5);
+  XCTAssertThrows(index.build(boxes.minX, SP_Vector(4, 1.0), boxes.minY, boxes.maxY));
+  index.build(boxes.minX, boxes.maxX, boxes.minY, boxes.maxY);
+  std::vector<int> clusters;
+  XCTAssertThrows(index.overlapping(5, clusters));
+  XCTAssertThrows(index.overlapping(-1, clusters));
+}
+
+@end
@@ -0,0 +1,200 @@
+//
+//  MBTClusterTableTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <TimeFrequency/MBT_ClusterTable.h>
+#include <TimeFrequency/MBT_Contour.h>
+#include <TimeFrequency/MBT_MarchingSquares.h>
+#include <TimeFrequency/MBT_TF_Stats.h>
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+typedef pair<VVDouble, vector<VVDouble>> ClusterStatistics;
+
+/// Map of 5 frequencies whose contours at 0.5 cover every stage of the
+/// statistics: a band over all the rows (two open contours to join), a closed
+/// cluster with a nested peak, a cluster on the first row and a neighbour
+/// overlapping it. The edges of each row are zero, as after TF_mask.
+static SP_Matrix fixedMap() {
+  const int rows = 5;
+  const int columns = 250;
+  SP_Matrix map(rows, columns);
+  for (int r = 0; r < rows; ++r) {
+    const int edge = 10 + 4 * (rows - 1 - r);
+    for (int c = edge; c < columns - edge; ++c) {
+      const double band = std::exp(-std::pow((c - 60) / 12.0, 2));
+      const double closed = r >= 1 && r <= 3
+        ? 1.2 * std::exp(-std::pow((c - 118) / 9.0, 2) - std::pow(r - 2.0, 2))
+        : 0;
+      const double nested =
+        0.9 * std::exp(-std::pow((c - 126) / 3.0, 2) - std::pow((r - 2.0) / 0.6, 2));
+      const double low =
+        r <= 1 ? 0.8 * std::exp(-std::pow((c - 180) / 10.0, 2)) : 0;
+      const double neighbour =
+        0.7 * std::exp(-std::pow((c - 196) / 6.0, 2) - std::pow((r - 1.0) / 1.5, 2));
+      map(r, c) = band + closed + nested + low + neighbour;
+    }
+  }
+  return map;
+}
+
+/// Describe the first value which differs, bit for bit, between two vectors
+/// of vectors, empty if they are identical.
+static std::string firstDifference(const VVDouble& expected,
+                                   const VVDouble& actual,
+                                   const char* name) {
+  std::ostringstream difference;
+  if (expected.size() != actual.size()) {
+    difference << name << ": " << actual.size() << " rows instead of "
+               << expected.size();
+    return difference.str();
+  }
+  for (size_t row = 0; row < expected.size(); ++row) {
+    if (expected[row].size() != actual[row].size()) {
+      difference << name << "[" << row << "]: " << actual[row].size()
+                 << " values instead of " << expected[row].size();
+      return difference.str();
+    }
+    for (size_t i = 0; i < expected[row].size(); ++i) {
+      if (std::memcmp(&expected[row][i], &actual[row][i], sizeof(SP_RealType)) != 0) {
+        difference.precision(17);
+        difference << name << "[" << row << "][" << i << "]: " << actual[row][i]
+                   << " instead of " << expected[row][i];
+        return difference.str();
+      }
+    }
+  }
+  return std::string();
+}
+
+static std::string firstDifference(const ClusterStatistics& expected,
+                                   const ClusterStatistics& actual) {
+  std::string difference =
+    firstDifference(expected.first, actual.first, "statistics");
+  if (!difference.empty()) {
+    return difference;
+  }
+  if (expected.second.size() != actual.second.size()) {
+    return "coordinates: not the same number of axes";
+  }
+  for (size_t axis = 0; axis < expected.second.size(); ++axis) {
+    difference = firstDifference(expected.second[axis],
+                                 actual.second[axis],
+                                 axis == 0 ? "x" : "y");
+    if (!difference.empty()) {
+      return difference;
+    }
+  }
+  return std::string();
+}
+
+@interface MBTClusterTableTests : XCTestCase
+@end
+
+@implementation MBTClusterTableTests
+
+//----------------------------------------------------------------------------
+// MARK: - Same contours as Contourc
+//----------------------------------------------------------------------------
+
+- (void)testContoursAreTheOnesOfContourc {
+  const SP_Matrix map = fixedMap();
+  const SP_Matrix contourMatrix = MBT_contourPolylines(map, 0.5).toContourMatrix();
+
+  // Contourc keeps the contours of its previous calls after the new ones
+  const SP_Matrix expected = Contourc(map, 0.5);
+  XCTAssertEqual(expected.size().first, 2);
+  XCTAssertTrue(expected.size().second >= contourMatrix.size().second);
+  for (int row = 0; row < 2; ++row) {
+    for (int column = 0; column < contourMatrix.size().second; ++column) {
+      const SP_RealType value = contourMatrix.rowData(row)[column];
+      const SP_RealType expectedValue = expected.rowData(row)[column];
+      XCTAssertTrue(std::memcmp(&expectedValue, &value, sizeof(SP_RealType)) == 0,
+                    @"(%d, %d): %.17g instead of %.17g", row, column, value,
+                    expectedValue);
+    }
+  }
+}
+
+- (void)testBoundsAreTheOnesOfC2xyz {
+  const MBT_Polylines contours = MBT_contourPolylines(fixedMap(), 0.5);
+
+  const MBT_Matrix<int> expected = C2xyz(contours.toContourMatrix());
+  const MBT_Matrix<int> bounds = contours.toBounds();
+
+  XCTAssertEqual(expected.size().first, bounds.size().first);
+  XCTAssertEqual(expected.size().second, bounds.size().second);
+  for (int row = 0; row < bounds.size().first; ++row) {
+    for (int column = 0; column < bounds.size().second; ++column) {
+      XCTAssertEqual(bounds.rowData(row)[column], expected.rowData(row)[column]);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Same results as TF_Statistics
+//----------------------------------------------------------------------------
+
+- (void)testContourMatrixStatisticsAreBitIdentical {
+  const SP_Matrix map = fixedMap();
+  const MBT_Polylines contours = MBT_contourPolylines(map, 0.5);
+  const SP_Matrix contourMatrix = contours.toContourMatrix();
+  const MBT_Matrix<int> bounds = contours.toBounds();
+  XCTAssertEqual(contours.count(), 5);
+
+  const ClusterStatistics expected =
+    CalculateStatistics(contourMatrix, bounds, map);
+  MBT_ClusterTable table;
+  const ClusterStatistics actual =
+    CalculateStatistics(table, contourMatrix, bounds, map);
+
+  XCTAssertEqual(expected.first.size(), 9u);
+  XCTAssertEqual(expected.first[0].size(), 3u);
+  const std::string difference = firstDifference(expected, actual);
+  XCTAssertTrue(difference.empty(), @"%s", difference.c_str());
+}
+
+- (void)testPolylineStatisticsAreBitIdentical {
+  const SP_Matrix map = fixedMap();
+  const MBT_Polylines contours = MBT_contourPolylines(map, 0.5);
+
+  const ClusterStatistics expected =
+    CalculateStatistics(contours.toContourMatrix(), contours.toBounds(), map);
+  const ClusterStatistics actual = CalculateStatistics(contours, map);
+
+  const std::string difference = firstDifference(expected, actual);
+  XCTAssertTrue(difference.empty(), @"%s", difference.c_str());
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Reused table
+//----------------------------------------------------------------------------
+
+- (void)testReusedTableGivesTheSameStatistics {
+  const SP_Matrix map = fixedMap();
+  SP_Matrix otherMap = fixedMap();
+  for (int c = 0; c < otherMap.size().second; ++c) {
+    otherMap(2, c) = otherMap(2, c) * 1.5;
+  }
+  const MBT_Polylines contours = MBT_contourPolylines(map, 0.5);
+  const MBT_Polylines otherContours = MBT_contourPolylines(otherMap, 0.5);
+
+  MBT_ClusterTable table;
+  CalculateStatistics(table, otherContours, otherMap);
+  const ClusterStatistics reused = CalculateStatistics(table, contours, map);
+  MBT_ClusterTable freshTable;
+  const ClusterStatistics fresh = CalculateStatistics(freshTable, contours, map);
+
+  const std::string difference = firstDifference(fresh, reused);
+  XCTAssertTrue(difference.empty(), @"%s", difference.c_str());
+}
+
+@end
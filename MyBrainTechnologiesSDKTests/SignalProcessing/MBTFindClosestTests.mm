@@ -0,0 +1,154 @@
+//
+//  MBTFindClosestTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <Algebra/MBT_FindClosest.h>
+#include <Transformations/MBT_BandIndex.h>
+#include <Transformations/MBT_FindPeak.h>
+
+/// Reproducible sorted values, with repeated values for even seeds.
+static SP_Vector sortedValues(unsigned int seed, size_t size) {
+  unsigned int state = seed;
+  SP_Vector values;
+  for (size_t i = 0; i < size; ++i) {
+    state = state * 1664525u + 1013904223u;
+    const SP_RealType random = (state >> 8) / 16777216.0;
+    values.push_back(seed % 2 == 0 ? std::floor(random * 20) * 0.5 : 40 * random - 10);
+  }
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+/// Values to find around sorted values: the values, the midpoints (ties), and
+/// values outside of the range.
+static SP_Vector valuesToFind(SP_Vector const& values) {
+  SP_Vector toFind(values);
+  for (size_t i = 1; i < values.size(); ++i) {
+    toFind.push_back((values[i - 1] + values[i]) * 0.5);
+    toFind.push_back(values[i - 1] * 0.75 + values[i] * 0.25);
+  }
+  if (!values.empty()) {
+    toFind.push_back(values.front() - 1);
+    toFind.push_back(values.back() + 1);
+  }
+  toFind.push_back(-1e9);
+  toFind.push_back(1e9);
+  return toFind;
+}
+
+/// Frequencies of MBT_PWelchComputer: nfft values (fs / nfft) * i.
+static SP_Vector pwelchFrequencies(int nfft, SP_RealType fs) {
+  const SP_RealType step = fs / nfft;
+  SP_Vector frequencies;
+  for (int i = 0; i < nfft; ++i) {
+    frequencies.push_back(step * i);
+  }
+  return frequencies;
+}
+
+@interface MBTFindClosestTests : XCTestCase
+@end
+
+@implementation MBTFindClosestTests
+
+//----------------------------------------------------------------------------
+// MARK: - Same index as MBT_FindClosest::findClosestIndex
+//----------------------------------------------------------------------------
+
+- (void)testSortedLookupIsTheLinearScan {
+  for (unsigned int seed = 1; seed <= 60; ++seed) {
+    const SP_Vector values = sortedValues(seed, seed);
+    for (SP_RealType value : valuesToFind(values)) {
+      XCTAssertEqual(MBT_FindClosest::findClosestIndexSorted(values, value),
+                     MBT_FindClosest::findClosestIndex(values, value), @"seed %u, value %g", seed, value);
+    }
+  }
+}
+
+- (void)testSortedIndicesAreTheLinearIndices {
+  for (unsigned int seed = 1; seed <= 30; ++seed) {
+    const SP_Vector values = sortedValues(seed, 2 * seed);
+    const SP_Vector toFind = valuesToFind(values);
+    for (size_t i = 1; i < toFind.size(); ++i) {
+      const std::pair<int, int> expected = MBT_FindClosest::findClosetIndices(values, toFind[i - 1], toFind[i]);
+      const std::pair<int, int> indices = MBT_FindClosest::findClosestIndicesSorted(values, toFind[i - 1], toFind[i]);
+      XCTAssertEqual(indices.first, expected.first, @"seed %u", seed);
+      XCTAssertEqual(indices.second, expected.second, @"seed %u", seed);
+    }
+  }
+}
+
+/// On the frequencies of MBT_PWelchComputer, the closed form gives the index
+/// of the linear scan.
+- (void)testUniformLookupIsTheLinearScanOnTheFrequencies {
+  const int nffts[] = {250, 256, 500, 512, 1000, 1024};
+  const SP_RealType samplingRates[] = {250, 500, 1000};
+  for (int nfft : nffts) {
+    for (SP_RealType fs : samplingRates) {
+      const SP_Vector frequencies = pwelchFrequencies(nfft, fs);
+      for (SP_RealType value : valuesToFind(frequencies)) {
+        XCTAssertEqual(MBT_FindClosest::findClosestIndexUniform(0, fs / nfft, nfft, value),
+                       MBT_FindClosest::findClosestIndex(frequencies, value), @"nfft %d, fs %g, value %g", nfft, fs,
+                       value);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Same bounds as MBT_frequencyBounds
+//----------------------------------------------------------------------------
+
+- (void)testBandBoundsAreTheOnesOfFrequencyBounds {
+  const int nffts[] = {250, 256, 512, 1024};
+  const SP_RealType samplingRates[] = {250, 500};
+  const SP_RealType bands[][2] = {{7, 13}, {8, 12}, {2, 40}, {0, 4}, {0.5, 0.6}, {13.1, 13.3}, {-5, 1}, {100, 1e4}};
+  for (int nfft : nffts) {
+    for (SP_RealType fs : samplingRates) {
+      const SP_Vector frequencies = pwelchFrequencies(nfft, fs);
+      MBT_BandIndexCache cache;
+      for (const SP_RealType* band : bands) {
+        const SP_RealType step = fs / nfft;
+        const bool isEmpty = std::ceil(band[0] / step) > std::floor(band[1] / step) ||
+                             band[1] < 0 || band[0] > frequencies.back();
+        if (isEmpty) {
+          XCTAssertThrows(MBT_frequencyBoundsSorted(frequencies, band[0], band[1]));
+          XCTAssertThrows(MBT_frequencyBoundsUniform(nfft, fs, band[0], band[1]));
+          continue;
+        }
+
+        const std::pair<int, int> expected = MBT_frequencyBounds(frequencies, band[0], band[1]);
+        const std::pair<int, int> sorted = MBT_frequencyBoundsSorted(frequencies, band[0], band[1]);
+        const std::pair<int, int> uniform = MBT_frequencyBoundsUniform(nfft, fs, band[0], band[1]);
+        const std::pair<int, int> cached = cache.bounds(nfft, fs, band[0], band[1]);
+        XCTAssertTrue(sorted == expected, @"nfft %d, fs %g, band [%g, %g]", nfft, fs, band[0], band[1]);
+        XCTAssertTrue(uniform == expected, @"nfft %d, fs %g, band [%g, %g]", nfft, fs, band[0], band[1]);
+        XCTAssertTrue(cached == expected, @"nfft %d, fs %g, band [%g, %g]", nfft, fs, band[0], band[1]);
+        XCTAssertTrue(cache.bounds(nfft, fs, band[0], band[1]) == expected);
+      }
+    }
+  }
+}
+
+- (void)testBandIndexCacheKeepsOneEntryPerBand {
+  MBT_BandIndexCache cache;
+  cache.bounds(512, 250, 7, 13);
+  cache.bounds(512, 250, 7, 13);
+  cache.bounds(512, 250, 8, 12);
+  cache.bounds(1024, 250, 7, 13);
+  XCTAssertEqual(cache.size(), 3u);
+  cache.clear();
+  XCTAssertEqual(cache.size(), 0u);
+}
+
+@end
@@ -0,0 +1,229 @@
+//
+//  MBTFixedShapeTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <DataManipulation/MBT_FixedShape.h>
+#include <NF_Melomind/MBT_NFConfig.h>
+#include <Transformations/MBT_BandIndex.h>
+
+/// Reproducible EEG like values.
+static SP_Vector randomSignal(unsigned int seed, size_t size) {
+  unsigned int state = seed;
+  SP_Vector values;
+  for (size_t i = 0; i < size; ++i) {
+    state = state * 1664525u + 1013904223u;
+    values.push_back(12 + 0.1 * i + 40 * ((state >> 8) / 16777216.0) - 20);
+  }
+  return values;
+}
+
+/// Bands of the headsets and bands on the edges of the grid.
+static const SP_RealType frequencyBands[][2] = {{7, 13},  {8, 12},     {2, 40},       {0, 4},    {0.5, 0.6},
+                                                {13.1, 13.3}, {-5, 1}, {124, 200}, {100, 1e4}, {6.25, 6.25}};
+
+/// Index bounds of a band on a fixed grid, (Nfft, -1) when no frequency is
+/// inside the band.
+template <unsigned int Nfft, unsigned int SampRate>
+static std::pair<int, int> fixedBounds(SP_RealType lower, SP_RealType upper) {
+  typedef MBT_FixedFrequencyGrid<Nfft, SampRate> Grid;
+  return std::make_pair(Grid::first(lower), Grid::last(upper));
+}
+
+/// Same bounds as MBT_frequencyBoundsUniform for the bands of frequencyBands.
+template <unsigned int Nfft, unsigned int SampRate>
+static bool isSameGrid() {
+  for (const SP_RealType* band : frequencyBands) {
+    const std::pair<int, int> bounds = fixedBounds<Nfft, SampRate>(band[0], band[1]);
+    try {
+      const std::pair<int, int> expected = MBT_frequencyBoundsUniform(Nfft, SampRate, band[0], band[1]);
+      if (bounds != expected ||
+          MBT_FixedFrequencyGrid<Nfft, SampRate>::count(band[0], band[1]) != expected.second - expected.first + 1) {
+        return false;
+      }
+    } catch (std::invalid_argument const&) {
+      // no frequency inside the band
+      if (bounds.first <= bounds.second) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// Fills a fixed matrix with reproducible signals and the same rows.
+template <typename Shape>
+static std::vector<SP_Vector> loadRandomMatrix(MBT_FixedMatrix<Shape>& fixed, unsigned int seed) {
+  std::vector<SP_Vector> rows;
+  SP_FloatMatrix matrix(Shape::CHANNELS, Shape::SAMPLES);
+  for (int channel = 0; channel < Shape::CHANNELS; ++channel) {
+    const SP_Vector row = randomSignal(seed + channel, Shape::SAMPLES);
+    for (int i = 0; i < Shape::SAMPLES; ++i) {
+      matrix(channel, i) = static_cast<SP_FloatType>(row[i]);
+    }
+    rows.push_back(SP_Vector(matrix.rowData(channel), matrix.rowData(channel) + Shape::SAMPLES));
+  }
+  fixed.load(matrix);
+  return rows;
+}
+
+/// True if the fixed kernels give the values of the overloads of
+/// MBT_Workspace.h on each row of a matrix.
+template <typename Shape>
+static bool isSameAsWorkspace(unsigned int seed) {
+  typedef MBT_FixedKernels<Shape> Kernels;
+  // up to 32 KB, not on the stack
+  static MBT_FixedMatrix<Shape> fixed;
+  const std::vector<SP_Vector> rows = loadRandomMatrix(fixed, seed);
+  SP_Vector output(Shape::SAMPLES);
+  SP_Vector expected;
+  for (int channel = 0; channel < Shape::CHANNELS; ++channel) {
+    const SP_Vector& row = rows[channel];
+    if (!std::equal(row.begin(), row.end(), fixed.rowData(channel))) {
+      return false;
+    }
+    if (Kernels::mean(fixed.rowData(channel)) != MBT_WorkspaceDetail::sequentialMean(row)) {
+      return false;
+    }
+
+    Kernels::removeDC(fixed.rowData(channel), output.data());
+    RemoveDC(row, expected);
+    if (output != expected) {
+      return false;
+    }
+    Kernels::powerOfTwoWithoutDC(fixed.rowData(channel), output.data());
+    powerOfTwoWithoutDC(row, expected);
+    if (output != expected) {
+      return false;
+    }
+    Kernels::detrend(fixed.rowData(channel), output.data());
+    detrend(row, Shape::SAMP_RATE, expected);
+    if (output != expected) {
+      return false;
+    }
+    output.resize(Kernels::timeFirstDerivative(fixed.rowData(channel), output.data()));
+    timeFirstDerivative(row, Shape::SAMP_RATE, expected);
+    if (output != expected || output.size() != Shape::SAMPLES - 1) {
+      return false;
+    }
+    output.resize(Shape::SAMPLES);
+  }
+  return true;
+}
+
+/// Kernel giving the shape it runs with.
+struct ShapeKernel {
+  typedef std::pair<int, int> Result;
+
+  template <typename Shape>
+  Result run() {
+    return Result(Shape::CHANNELS, Shape::SAMPLES);
+  }
+
+  Result runGeneric() { return Result(-1, -1); }
+};
+
+@interface MBTFixedShapeTests : XCTestCase
+@end
+
+@implementation MBTFixedShapeTests
+
+//----------------------------------------------------------------------------
+// MARK: - Same bounds as MBT_frequencyBoundsUniform
+//----------------------------------------------------------------------------
+
+- (void)testGridBoundsAreTheUniformBounds {
+  XCTAssertTrue((isSameGrid<256, 250>()));
+  XCTAssertTrue((isSameGrid<512, 250>()));
+  XCTAssertTrue((isSameGrid<1024, 250>()));
+  XCTAssertTrue((isSameGrid<256, 500>()));
+  XCTAssertTrue((isSameGrid<1024, 1000>()));
+}
+
+/// The bounds are constant expressions.
+- (void)testGridBoundsAreConstant {
+  constexpr int first = MBT_FixedFrequencyGrid<256, 250>::first(8);
+  constexpr int last = MBT_FixedFrequencyGrid<256, 250>::last(12);
+  constexpr int count = MBT_FixedFrequencyGrid<1024, 250>::count(7, 13);
+  const std::pair<int, int> expected = MBT_frequencyBoundsUniform(256, 250, 8, 12);
+  XCTAssertEqual(first, expected.first);
+  XCTAssertEqual(last, expected.second);
+  const std::pair<int, int> alpha = MBT_frequencyBoundsUniform(1024, 250, 7, 13);
+  XCTAssertEqual(count, alpha.second - alpha.first + 1);
+}
+
+- (void)testEmptyBandIsRejected {
+  XCTAssertThrows((MBT_FixedFrequencyGrid<256, 250>::count(0.5, 0.6)));
+  XCTAssertThrows((MBT_FixedFrequencyGrid<256, 250>::count(300, 400)));
+}
+
+- (void)testNfftIsTheZeroPaddedLength {
+  const unsigned int lengths[] = {1, 100, 250, 256, 257, 500, 512, 1000, 1024, 1025};
+  for (unsigned int length : lengths) {
+    XCTAssertEqual(MBT_fixedNfft(length), MBT_zeroPaddedLength(length), @"length %u", length);
+  }
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Same values as the overloads of MBT_Workspace.h
+//----------------------------------------------------------------------------
+
+- (void)testKernelsAreTheWorkspaceOverloads {
+  for (unsigned int seed = 1; seed <= 3; ++seed) {
+    XCTAssertTrue((isSameAsWorkspace<MBT_FixedShape<2, 250, 250> >(seed)), @"seed %u", seed);
+    XCTAssertTrue((isSameAsWorkspace<MBT_FixedShape<2, 500, 250> >(seed)), @"seed %u", seed);
+    XCTAssertTrue((isSameAsWorkspace<MBT_FixedShape<2, 1000, 250> >(seed)), @"seed %u", seed);
+    XCTAssertTrue((isSameAsWorkspace<MBT_FixedShape<4, 250, 250> >(seed)), @"seed %u", seed);
+    XCTAssertTrue((isSameAsWorkspace<MBT_FixedShape<4, 500, 250> >(seed)), @"seed %u", seed);
+    XCTAssertTrue((isSameAsWorkspace<MBT_FixedShape<4, 1000, 250> >(seed)), @"seed %u", seed);
+  }
+}
+
+- (void)testMatrixRejectsAnotherShape {
+  MBT_FixedMatrix<MBT_FixedShape<2, 250, 250> > fixed;
+  XCTAssertThrows(fixed.load(SP_FloatMatrix(4, 250)));
+  XCTAssertThrows(fixed.load(SP_FloatMatrix(2, 500)));
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Selection of the shapes
+//----------------------------------------------------------------------------
+
+- (void)testShapesRunTheirKernels {
+  ShapeKernel kernel;
+  const unsigned int channels[] = {1, 2, 3, 4, 8};
+  const unsigned int samples[] = {125, 250, 500, 1000, 2000};
+  for (unsigned int channelCount : channels) {
+    for (unsigned int sampleCount : samples) {
+      const bool isSpecialised = (channelCount == 2 || channelCount == 4) &&
+                                 (sampleCount == 250 || sampleCount == 500 || sampleCount == 1000);
+      const std::pair<int, int> expected =
+          isSpecialised ? std::pair<int, int>(channelCount, sampleCount) : std::pair<int, int>(-1, -1);
+      XCTAssertTrue(MBT_runWithShape(MBT_selectShape(250, channelCount, sampleCount), kernel) == expected,
+                    @"%u channels, %u samples", channelCount, sampleCount);
+      XCTAssertEqual(MBT_selectShape(500, channelCount, sampleCount), MBT_SHAPE_GENERIC);
+    }
+  }
+}
+
+- (void)testPacketShapeIsTheShapeOfThePackets {
+  const MBT_NFConfig melomind = {250, 250, 2, 4};
+  XCTAssertEqual(MBT_selectPacketShape(melomind, 2), MBT_SHAPE_MELOMIND_1S);
+  XCTAssertEqual(MBT_selectPacketShape(melomind, 4), MBT_SHAPE_QPLUS_1S);
+  XCTAssertEqual(MBT_selectShape(melomind, 2, 1000), MBT_SHAPE_MELOMIND_4S);
+  const MBT_NFConfig other = {500, 250, 2, 4};
+  XCTAssertEqual(MBT_selectPacketShape(other, 2), MBT_SHAPE_GENERIC);
+  const MBT_NFConfig longPackets = {250, 500, 2, 4};
+  XCTAssertEqual(MBT_selectPacketShape(longPackets, 4), MBT_SHAPE_QPLUS_2S);
+}
+
+@end
@@ -0,0 +1,181 @@
+//
+//  MBTInterpolationTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <Algebra/MBT_Interpolation.h>
+#include <PreProcessing/MBT_PreProcessing.h>
+
+/// Reproducible values in [offset, offset + scale).
+static SP_Vector randomValues(unsigned int seed, size_t size, SP_RealType offset, SP_RealType scale) {
+  unsigned int state = seed;
+  SP_Vector values;
+  for (size_t i = 0; i < size; ++i) {
+    state = state * 1664525u + 1013904223u;
+    values.push_back(offset + scale * ((state >> 8) / 16777216.0));
+  }
+  return values;
+}
+
+/// Sorted known positions, with repeated positions for seeds multiple of 3.
+static SP_Vector knownPositions(unsigned int seed, size_t size) {
+  SP_Vector x = randomValues(seed, size, 0, 100);
+  if (seed % 3 == 0) {
+    for (SP_RealType& position : x) {
+      position = std::floor(position / 4);
+    }
+  }
+  std::sort(x.begin(), x.end());
+  return x;
+}
+
+/// Sorted positions to interpolate: the known positions, random positions
+/// and positions outside of the known ones. MBT_linearInterp reads past the
+/// end of x and y at the last known position, it is left out.
+static SP_Vector interpolatedPositions(unsigned int seed, SP_Vector const& x) {
+  SP_Vector xInterp = randomValues(seed + 1000, 2 * x.size(), -5, 110);
+  xInterp.erase(std::remove(xInterp.begin(), xInterp.end(), x.back()), xInterp.end());
+  xInterp.insert(xInterp.end(), x.begin(), std::find(x.begin(), x.end(), x.back()));
+  std::sort(xInterp.begin(), xInterp.end());
+  return xInterp;
+}
+
+static bool isSame(SP_RealType value, SP_RealType expected) {
+  return value == expected || (std::isnan(value) && std::isnan(expected));
+}
+
+static bool isSame(SP_Vector const& values, SP_Vector const& expected) {
+  if (values.size() != expected.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (!isSame(values[i], expected[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+@interface MBTInterpolationTests : XCTestCase
+@end
+
+@implementation MBTInterpolationTests
+
+//----------------------------------------------------------------------------
+// MARK: - Same values as MBT_linearInterp
+//----------------------------------------------------------------------------
+
+- (void)testSortedInterpolationIsLinearInterp {
+  for (unsigned int seed = 1; seed <= 60; ++seed) {
+    SP_Vector x = knownPositions(seed, 2 + seed);
+    SP_Vector y = randomValues(seed + 500, x.size(), -20, 40);
+    SP_Vector xInterp = interpolatedPositions(seed, x);
+    const SP_Vector expected = MBT_linearInterp(x, y, xInterp);
+
+    SP_Vector yInterp(3, 1.0);
+    MBT_linearInterpSorted(x, y, xInterp, yInterp);
+    XCTAssertTrue(isSame(yInterp, expected), @"seed %u", seed);
+
+    // in place, the interpolated values replace the positions
+    SP_Vector buffer(xInterp);
+    MBT_linearInterpSorted(x.data(), y.data(), x.size(), buffer.data(), buffer.data(), buffer.size());
+    XCTAssertTrue(isSame(buffer, expected), @"seed %u", seed);
+  }
+}
+
+- (void)testUnsortedPositionsAreInterpolatedAsLinearInterp {
+  for (unsigned int seed = 1; seed <= 20; ++seed) {
+    SP_Vector x = knownPositions(seed, 10 + seed);
+    SP_Vector y = randomValues(seed + 500, x.size(), -20, 40);
+    SP_Vector xInterp = randomValues(seed + 2000, 30, -5, 110);
+
+    SP_Vector yInterp;
+    MBT_linearInterpSorted(x, y, xInterp, yInterp);
+    XCTAssertTrue(isSame(yInterp, MBT_linearInterp(x, y, xInterp)), @"seed %u", seed);
+  }
+}
+
+- (void)testBatchInterpolationIsLinearInterpOfEachChannel {
+  const int channels = 3;
+  for (unsigned int seed = 1; seed <= 20; ++seed) {
+    SP_Vector x = knownPositions(seed, 5 + 2 * seed);
+    SP_Vector xInterp = interpolatedPositions(seed, x);
+    SP_Matrix y(channels, static_cast<unsigned int>(x.size()));
+    for (int channel = 0; channel < channels; ++channel) {
+      const SP_Vector values = randomValues(seed + 100 * channel, x.size(), -1, 2);
+      std::copy(values.begin(), values.end(), y.rowData(channel));
+    }
+
+    const SP_Matrix yInterp = MBT_linearInterpBatch(x, y, xInterp);
+    for (int channel = 0; channel < channels; ++channel) {
+      SP_Vector row = y.row(channel);
+      XCTAssertTrue(isSame(yInterp.row(channel), MBT_linearInterp(x, row, xInterp)), @"seed %u, channel %d", seed,
+                    channel);
+    }
+  }
+}
+
+/// At the last known position, the value is the last known value.
+- (void)testLastKnownPositionIsTheLastKnownValue {
+  const SP_Vector x = knownPositions(4, 10);
+  const SP_Vector y = randomValues(7, x.size(), -20, 40);
+  SP_Vector yInterp;
+  MBT_linearInterpSorted(x, y, SP_Vector(1, x.back()), yInterp);
+  XCTAssertEqual(yInterp[0], y.back());
+}
+
+- (void)testDifferentSizesAreRejected {
+  SP_Vector yInterp;
+  XCTAssertThrows(MBT_linearInterpSorted(SP_Vector(3, 1.0), SP_Vector(2, 1.0), SP_Vector(4, 1.0), yInterp));
+  XCTAssertThrows(MBT_linearInterpBatch(SP_Vector(3, 1.0), SP_Matrix(2, 4), SP_Vector(4, 1.0)));
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Same values as InterpolateOutliers
+//----------------------------------------------------------------------------
+
+- (void)testOutliersInPlaceAreInterpolateOutliers {
+  for (unsigned int seed = 1; seed <= 60; ++seed) {
+    SP_Vector data = randomValues(seed, 50 + seed, -10, 20);
+    // outliers alone and in runs, at the edges for some seeds
+    for (size_t i = seed % 7; i < data.size(); i += 10 + seed % 5) {
+      data[i] = seed % 2 == 0 ? 80 : -80;
+      if (i + 1 < data.size() && i % 3 == 0) {
+        data[i + 1] = 90;
+      }
+    }
+    if (seed % 5 == 0) {
+      data.front() = 100;
+      data.back() = -100;
+    }
+    SP_Vector bounds = CalculateBounds(data);
+    const SP_Vector expected = InterpolateOutliers(data, bounds);
+
+    SP_Vector repaired(data);
+    const size_t replaced = MBT_interpolateOutliersInPlace(repaired, bounds);
+    XCTAssertTrue(isSame(repaired, expected), @"seed %u", seed);
+    XCTAssertGreaterThan(replaced, 0u, @"seed %u", seed);
+  }
+}
+
+- (void)testSignalWithoutOutliersIsUnchanged {
+  SP_Vector data = randomValues(4, 100, 0, 1);
+  SP_Vector bounds(2);
+  bounds[0] = -1;
+  bounds[1] = 2;
+
+  SP_Vector repaired(data);
+  XCTAssertEqual(MBT_interpolateOutliersInPlace(repaired, bounds), 0u);
+  XCTAssertTrue(repaired == data);
+  XCTAssertTrue(isSame(repaired, InterpolateOutliers(data, bounds)));
+}
+
+@end
@@ -0,0 +1,194 @@
+//
+//  MBTKMeans1DTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <Algebra/MBT_kmeans.h>
+#include <Algebra/MBT_kmeans1D.h>
+
+/// Kinds of reproducible values to cluster.
+enum ValuesKind {
+  /// Two groups of values, as the values clustered by the library.
+  BIMODAL_VALUES,
+  /// Uniform values.
+  UNIFORM_VALUES,
+  /// Few distinct values, repeated.
+  REPEATED_VALUES
+};
+
+static SP_Vector randomValues(ValuesKind kind, unsigned int seed, size_t size) {
+  unsigned int state = seed;
+  SP_Vector values;
+  for (size_t i = 0; i < size; ++i) {
+    state = state * 1664525u + 1013904223u;
+    const SP_RealType random = (state >> 8) / 16777216.0;
+    switch (kind) {
+      case BIMODAL_VALUES:
+        values.push_back((state >> 4) % 3 == 0 ? 8 + 2 * random : 2 + 3 * random);
+        break;
+      case UNIFORM_VALUES:
+        values.push_back(10 * random - 5);
+        break;
+      case REPEATED_VALUES:
+        values.push_back(std::floor(random * 4));
+        break;
+    }
+  }
+  return values;
+}
+
+/// Sum of the squared distances of the values to the centers of their labels.
+static SP_RealType clusteringCost(SP_Vector const& values, std::vector<int> const& labels, SP_Vector const& centers) {
+  SP_RealType cost = 0;
+  for (size_t i = 0; i < values.size(); ++i) {
+    const SP_RealType difference = values[i] - centers[labels[i] - 1];
+    cost += difference * difference;
+  }
+  return cost;
+}
+
+/// Best cost of the splits of sorted values in consecutive runs, by trying
+/// all of them.
+static SP_RealType bruteForceCost(SP_Vector const& sorted, size_t first, int clusterCount) {
+  if (clusterCount == 1) {
+    SP_RealType sum = 0;
+    for (size_t i = first; i < sorted.size(); ++i) {
+      sum += sorted[i];
+    }
+    const SP_RealType mean = sum / (sorted.size() - first);
+    SP_RealType cost = 0;
+    for (size_t i = first; i < sorted.size(); ++i) {
+      cost += (sorted[i] - mean) * (sorted[i] - mean);
+    }
+    return cost;
+  }
+  SP_RealType best = std::numeric_limits<SP_RealType>::infinity();
+  for (size_t end = first + 1; end + clusterCount - 1 <= sorted.size(); ++end) {
+    const SP_Vector head(sorted.begin() + first, sorted.begin() + end);
+    best = std::min(best, bruteForceCost(head, 0, 1) + bruteForceCost(sorted, end, clusterCount - 1));
+  }
+  return best;
+}
+
+@interface MBTKMeans1DTests : XCTestCase
+@end
+
+@implementation MBTKMeans1DTests
+
+//----------------------------------------------------------------------------
+// MARK: - Same clustering as ApplyKMeans
+//----------------------------------------------------------------------------
+
+- (void)testApplyIsApplyKMeans {
+  const ValuesKind kinds[] = {BIMODAL_VALUES, UNIFORM_VALUES, REPEATED_VALUES};
+  MBT_KMeans1D kmeans;
+  for (ValuesKind kind : kinds) {
+    for (unsigned int seed = 1; seed <= 40; ++seed) {
+      const SP_Vector values = randomValues(kind, seed, 2 + 5 * seed);
+      const std::pair<std::vector<int>, SP_Vector> expected = ApplyKMeans(values);
+      const std::pair<std::vector<int>, SP_Vector> result = kmeans.apply(values);
+
+      XCTAssertTrue(result.first == expected.first, @"kind %d, seed %u", kind, seed);
+      XCTAssertTrue(result.second == expected.second, @"kind %d, seed %u", kind, seed);
+    }
+  }
+}
+
+- (void)testApplyRejectsValuesWithoutTwoClusters {
+  MBT_KMeans1D kmeans;
+  XCTAssertThrows(kmeans.apply(SP_Vector()));
+  XCTAssertThrows(kmeans.apply(SP_Vector(1, 3.0)));
+  XCTAssertThrows(kmeans.apply(SP_Vector(10, 3.0)));
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Optimal clustering
+//----------------------------------------------------------------------------
+
+- (void)testOptimalCostIsTheBestSplit {
+  const ValuesKind kinds[] = {BIMODAL_VALUES, UNIFORM_VALUES, REPEATED_VALUES};
+  for (ValuesKind kind : kinds) {
+    for (unsigned int seed = 1; seed <= 20; ++seed) {
+      SP_Vector sorted = randomValues(kind, seed, 4 + seed);
+      std::sort(sorted.begin(), sorted.end());
+      for (int clusterCount = 1; clusterCount <= 3; ++clusterCount) {
+        std::vector<int> labels(sorted.size());
+        SP_Vector centers(clusterCount);
+        const SP_RealType cost = MBT_kmeans1DOptimal(sorted.data(), static_cast<int>(sorted.size()), clusterCount,
+                                                     labels.data(), centers.data());
+
+        const SP_RealType expected = bruteForceCost(sorted, 0, clusterCount);
+        XCTAssertEqualWithAccuracy(cost, expected, 1e-9 * (1 + expected), @"kind %d, seed %u, K %d", kind, seed,
+                                   clusterCount);
+        XCTAssertEqualWithAccuracy(clusteringCost(sorted, labels, centers), expected, 1e-9 * (1 + expected),
+                                   @"kind %d, seed %u, K %d", kind, seed, clusterCount);
+        XCTAssertTrue(std::is_sorted(labels.begin(), labels.end()), @"kind %d, seed %u, K %d", kind, seed,
+                      clusterCount);
+      }
+    }
+  }
+}
+
+/// The optimal clustering is never worse than the one of ApplyKMeans.
+- (void)testOptimalCostIsAtMostTheOneOfApplyKMeans {
+  for (unsigned int seed = 1; seed <= 40; ++seed) {
+    const SP_Vector values = randomValues(seed % 2 == 0 ? BIMODAL_VALUES : UNIFORM_VALUES, seed, 10 + 3 * seed);
+    const std::pair<std::vector<int>, SP_Vector> expected = ApplyKMeans(values);
+    const std::pair<std::vector<int>, SP_Vector> optimal = MBT_kmeans1DOptimal(values, 2);
+
+    XCTAssertLessThan(clusteringCost(values, optimal.first, optimal.second),
+                      clusteringCost(values, expected.first, expected.second) * (1 + 1e-12) + 1e-12, @"seed %u",
+                      seed);
+  }
+}
+
+- (void)testOptimalRejectsInvalidValues {
+  SP_Vector values(5, 1.0);
+  XCTAssertThrows(MBT_kmeans1DOptimal(values, 6));
+  values[2] = SP_NAN;
+  XCTAssertThrows(MBT_kmeans1DOptimal(values, 2));
+}
+
+//----------------------------------------------------------------------------
+// MARK: - k-means++
+//----------------------------------------------------------------------------
+
+/// The same seed gives the same clustering, each value is on its nearest
+/// center once the iterations converged.
+- (void)testPlusPlusIsDeterministicAndConverges {
+  MBT_KMeans1D kmeans;
+  MBT_KMeans1D other;
+  for (unsigned int seed = 1; seed <= 20; ++seed) {
+    const SP_Vector values = randomValues(UNIFORM_VALUES, seed, 30 + seed);
+    const int size = static_cast<int>(values.size());
+    const int clusterCount = 2 + seed % 3;
+    std::vector<int> labels(size), otherLabels(size);
+    SP_Vector centers(clusterCount), otherCenters(clusterCount);
+
+    const int iterations = kmeans.applyPlusPlus(values.data(), size, clusterCount, seed, labels.data(), centers.data());
+    other.applyPlusPlus(values.data(), size, clusterCount, seed, otherLabels.data(), otherCenters.data());
+    XCTAssertTrue(labels == otherLabels, @"seed %u", seed);
+    XCTAssertTrue(centers == otherCenters, @"seed %u", seed);
+
+    XCTAssertLessThan(iterations, 100, @"seed %u", seed);
+    for (int i = 0; i < size; ++i) {
+      XCTAssertTrue(labels[i] >= 1 && labels[i] <= clusterCount, @"seed %u", seed);
+      for (int k = 0; k < clusterCount; ++k) {
+        XCTAssertTrue(std::fabs(values[i] - centers[labels[i] - 1]) <= std::fabs(values[i] - centers[k]),
+                      @"seed %u, value %d", seed, i);
+      }
+    }
+  }
+}
+
+@end
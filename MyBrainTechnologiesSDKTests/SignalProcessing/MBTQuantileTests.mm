@@ -0,0 +1,149 @@
+//
+//  MBTQuantileTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <Algebra/MBT_Operations.h>
+#include <Algebra/MBT_Quantile.h>
+#include <PreProcessing/MBT_PreProcessing.h>
+
+/// Reproducible values, with repeated values when levels is not 0.
+static SP_Vector randomValues(unsigned int seed, size_t size, unsigned int levels = 0) {
+  unsigned int state = seed;
+  SP_Vector values;
+  for (size_t i = 0; i < size; ++i) {
+    state = state * 1664525u + 1013904223u;
+    const SP_RealType random = (state >> 8) / 16777216.0;
+    values.push_back(levels > 0 ? std::floor(random * levels) - levels / 2 : 100 * random - 30);
+  }
+  return values;
+}
+
+/// p-quantile of a vector with the operations of Quantile of the library.
+static SP_RealType sortedQuantile(SP_Vector values, SP_RealType probability) {
+  std::sort(values.begin(), values.end());
+  const SP_RealType position = probability * (values.size() - 0.5) - (1.0 - probability) * 0.5;
+  const long left = std::max(0L, static_cast<long>(std::floor(position)));
+  const long right = std::min(static_cast<long>(values.size()) - 1, static_cast<long>(std::ceil(position)));
+  return Lerp(values[left], values[right], position - left);
+}
+
+@interface MBTQuantileTests : XCTestCase
+@end
+
+@implementation MBTQuantileTests
+
+//----------------------------------------------------------------------------
+// MARK: - Same results as the library
+//----------------------------------------------------------------------------
+
+- (void)testFastMedianIsMedian {
+  for (unsigned int seed = 1; seed <= 200; ++seed) {
+    const SP_Vector values = randomValues(seed, seed, seed % 3 == 0 ? 7 : 0);
+    XCTAssertEqual(fastMedian(values), median(values), @"seed %u", seed);
+
+    SP_Vector reordered(values);
+    XCTAssertEqual(medianInPlace(reordered), median(values), @"seed %u", seed);
+  }
+}
+
+- (void)testFastQuantileIsQuantile {
+  for (unsigned int seed = 1; seed <= 200; ++seed) {
+    SP_Vector values = randomValues(seed, seed, seed % 3 == 0 ? 5 : 0);
+    const SP_Vector quantiles = fastQuantile(values);
+    XCTAssertTrue(quantiles == Quantile(values), @"seed %u", seed);
+  }
+}
+
+- (void)testFastCalculateBoundsIsCalculateBounds {
+  for (unsigned int seed = 1; seed <= 200; ++seed) {
+    const SP_Vector values = randomValues(seed, 3 * seed, seed % 4 == 0 ? 9 : 0);
+    XCTAssertTrue(fastCalculateBounds(values) == CalculateBounds(values), @"seed %u", seed);
+  }
+}
+
+/// Any increasing probabilities give the quantiles of a sorted vector,
+/// interpolated with Lerp of the library.
+- (void)testQuantilesInPlaceInterpolatesAsQuantile {
+  SP_Vector probabilities;
+  for (int i = 0; i <= 20; ++i) {
+    probabilities.push_back(i / 20.0);
+  }
+  for (unsigned int seed = 1; seed <= 60; ++seed) {
+    const SP_Vector values = randomValues(seed, 2 * seed + 1, seed % 2 == 0 ? 11 : 0);
+    SP_Vector reordered(values);
+    SP_Vector quantiles;
+    quantilesInPlace(reordered.begin(), reordered.end(), probabilities, quantiles);
+
+    XCTAssertEqual(quantiles.size(), probabilities.size());
+    for (size_t i = 0; i < probabilities.size(); ++i) {
+      XCTAssertEqual(quantiles[i], sortedQuantile(values, probabilities[i]), @"seed %u, probability %g", seed,
+                     probabilities[i]);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Edge cases
+//----------------------------------------------------------------------------
+
+- (void)testEmptyInput {
+  const SP_Vector empty;
+  XCTAssertTrue(std::isnan(fastMedian(empty)));
+  XCTAssertThrows(fastQuantile(empty));
+  XCTAssertThrows(fastCalculateBounds(empty));
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Streaming quantile
+//----------------------------------------------------------------------------
+
+/// Until 5 values are received, the estimation is the exact quantile.
+- (void)testStreamingQuantileIsExactForTheFirstValues {
+  const SP_Vector values = randomValues(9, 5);
+  const SP_RealType probabilities[] = {0.25, 0.5, 0.75};
+  for (SP_RealType probability : probabilities) {
+    MBT_StreamingQuantile estimator(probability);
+    for (size_t size = 1; size <= values.size(); ++size) {
+      estimator.push(values[size - 1]);
+      const SP_Vector pushed(values.begin(), values.begin() + size);
+      XCTAssertEqual(estimator.value(), sortedQuantile(pushed, probability), @"probability %g, %zu values",
+                     probability, size);
+    }
+  }
+}
+
+- (void)testStreamingQuantileEstimatesTheQuantile {
+  const SP_Vector values = randomValues(21, 10000);
+  SP_Vector sorted(values);
+  const SP_Vector quartiles = Quantile(sorted);
+  const SP_RealType probabilities[] = {0.25, 0.5, 0.75};
+  for (int i = 0; i < 3; ++i) {
+    MBT_StreamingQuantile estimator(probabilities[i]);
+    for (SP_RealType value : values) {
+      estimator.push(value);
+      estimator.push(SP_NAN);
+    }
+    XCTAssertEqual(estimator.count(), values.size());
+    // the values are uniform in [-30, 70]
+    XCTAssertEqualWithAccuracy(estimator.value(), quartiles[i], 1.0, @"probability %g", probabilities[i]);
+  }
+}
+
+- (void)testStreamingQuantileRejectsInvalidProbabilities {
+  XCTAssertThrows((void)MBT_StreamingQuantile(-0.1));
+  XCTAssertThrows((void)MBT_StreamingQuantile(1.5));
+  XCTAssertThrows((void)MBT_StreamingQuantile(SP_NAN));
+  XCTAssertTrue(std::isnan(MBT_StreamingQuantile(0.5).value()));
+}
+
+@end
@@ -0,0 +1,266 @@
+//
+//  MBTRingBufferTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <DataManipulation/MBT_RingBuffer.h>
+#include <PreProcessing/MBT_PrecisionPipeline.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+typedef MBT_RingBuffer<float> FloatRing;
+
+/// Value of sample `position` of a channel in the stream pushed by the tests,
+/// exact in float up to 2^24.
+static float sampleValue(unsigned int channel, uint64_t position) {
+  return static_cast<float>(position * 4 + channel);
+}
+
+/// Push the samples [start, start + samples) of the test stream, channel after
+/// channel, and return the number of samples pushed.
+static size_t pushStream(FloatRing& ring, uint64_t start, size_t samples) {
+  std::vector<float> planar(ring.channels() * samples);
+  for (unsigned int channel = 0; channel < ring.channels(); ++channel) {
+    for (size_t sample = 0; sample < samples; ++sample) {
+      planar[channel * samples + sample] = sampleValue(channel, start + sample);
+    }
+  }
+  return ring.push(planar.data(), samples, samples);
+}
+
+/// True if every sample of the view is the one of the test stream.
+static bool isStream(const FloatRing::View& view) {
+  for (unsigned int channel = 0; channel < view.channels(); ++channel) {
+    for (size_t sample = 0; sample < view.size(); ++sample) {
+      if (view(channel, sample) != sampleValue(channel, view.start() + sample)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// Push `samples` reproducible EEG like samples, with outliers, and return
+/// the number of samples pushed.
+static size_t pushSignal(FloatRing& ring, unsigned int seed, size_t samples) {
+  unsigned int state = seed;
+  std::vector<float> planar(ring.channels() * samples);
+  for (size_t i = 0; i < planar.size(); ++i) {
+    state = state * 1664525u + 1013904223u;
+    planar[i] = 12 + 0.01f * (i % samples) + 40 * ((state >> 8) / 16777216.0f) - 20;
+    if (i % 37 == seed % 37) {
+      planar[i] = (i % 2 == 0) ? 300 : -300;
+    }
+  }
+  return ring.push(planar.data(), samples, samples);
+}
+
+/// True if two vectors hold the same bits, NaN included: the outliers on the
+/// edges of a window become NaN.
+static bool isSameVector(const std::vector<float>& values, const std::vector<float>& expected) {
+  return values.size() == expected.size()
+    && std::memcmp(values.data(), expected.data(), values.size() * sizeof(float)) == 0;
+}
+
+/// True if two pipelines have the same outputs, bit for bit.
+static bool isSameProcessing(const MBT_PrecisionPipeline<float>& pipeline,
+                             const MBT_PrecisionPipeline<float>& expected) {
+  return isSameVector(pipeline.signal(), expected.signal())
+    && isSameVector(pipeline.derivative(), expected.derivative())
+    && isSameVector(pipeline.power(), expected.power())
+    && pipeline.lowerBound() == expected.lowerBound()
+    && pipeline.upperBound() == expected.upperBound()
+    && pipeline.replaced() == expected.replaced();
+}
+
+template<typename Exception, typename Function>
+static bool throws(Function function) {
+  try {
+    function();
+  } catch (const Exception&) {
+    return true;
+  }
+  return false;
+}
+
+@interface MBTRingBufferTests : XCTestCase
+@end
+
+@implementation MBTRingBufferTests
+
+//----------------------------------------------------------------------------
+// MARK: - Capacity
+//----------------------------------------------------------------------------
+
+- (void)testCapacityIsRoundedUpToAPowerOfTwo {
+  XCTAssertEqual(FloatRing(2, 100).capacity(), 128u);
+  XCTAssertEqual(FloatRing(4, 256).capacity(), 256u);
+  XCTAssertEqual(FloatRing(1, 1).capacity(), 1u);
+  XCTAssertTrue(throws<std::invalid_argument>([] { FloatRing(0, 8); }));
+  XCTAssertTrue(throws<std::invalid_argument>([] { FloatRing(2, 0); }));
+}
+
+- (void)testPushStopsAtTheUnreleasedSamples {
+  FloatRing ring(2, 8);
+
+  XCTAssertEqual(pushStream(ring, 0, 10), 8u);
+  XCTAssertEqual(ring.writable(), 0u);
+  XCTAssertEqual(pushStream(ring, 8, 1), 0u);
+
+  ring.release(3);
+  XCTAssertEqual(ring.writable(), 3u);
+  XCTAssertEqual(pushStream(ring, 8, 5), 3u);
+  XCTAssertEqual(ring.written(), 11u);
+  XCTAssertEqual(ring.available(), 8u);
+  XCTAssertTrue(isStream(ring.window(3, 8)));
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Wraparound
+//----------------------------------------------------------------------------
+
+- (void)testWrappedWindowHasTwoSegments {
+  FloatRing ring(3, 8);
+  pushStream(ring, 0, 6);
+  ring.release(6);
+  pushStream(ring, 6, 5);
+
+  const FloatRing::View window = ring.latest(5);
+
+  XCTAssertEqual(window.start(), 6u);
+  XCTAssertFalse(window.isContiguous());
+  XCTAssertEqual(window.firstSize(), 2u);
+  XCTAssertEqual(window.secondSize(), 3u);
+  for (unsigned int channel = 0; channel < 3; ++channel) {
+    XCTAssertEqual(window.firstSegment(channel)[1], sampleValue(channel, 7));
+    XCTAssertEqual(window.secondSegment(channel)[0], sampleValue(channel, 8));
+  }
+  XCTAssertTrue(isStream(window));
+
+  MBT_Matrix<float> packet(3, 5);
+  window.copyTo(packet);
+  for (unsigned int channel = 0; channel < 3; ++channel) {
+    for (int sample = 0; sample < 5; ++sample) {
+      XCTAssertEqual(packet(channel, sample), sampleValue(channel, 6 + sample));
+    }
+  }
+}
+
+/// The pipeline reads the two segments of a wrapped window as the row of the
+/// window copied into a matrix.
+- (void)testPipelineReadsAWrappedWindow {
+  FloatRing ring(4, 512);
+  MBT_PrecisionPipeline<float> fromRing(250);
+  MBT_PrecisionPipeline<float> fromMatrix(250);
+  MBT_Matrix<float> packet(4, 500);
+  for (unsigned int seed = 1; seed <= 3; ++seed) {
+    pushSignal(ring, seed + 100, 150 * seed);
+    ring.release(ring.written());
+    pushSignal(ring, seed, 500);
+
+    const FloatRing::View window = ring.latest(500);
+    XCTAssertFalse(window.isContiguous(), @"seed %u", seed);
+    window.copyTo(packet);
+    for (unsigned int channel = 0; channel < 4; ++channel) {
+      fromRing.process(window, channel);
+      fromMatrix.process(packet, channel);
+      XCTAssertEqual(fromRing.signal().size(), 500u);
+      XCTAssertGreaterThan(fromRing.replaced(), 0u);
+      XCTAssertTrue(isSameProcessing(fromRing, fromMatrix),
+                    @"seed %u, channel %u", seed, channel);
+    }
+    ring.release(window.end());
+  }
+}
+
+- (void)testStreamPositionsGoOnAfterManyTurns {
+  FloatRing ring(2, 16);
+  uint64_t written = 0;
+  for (int turn = 0; turn < 100; ++turn) {
+    written += pushStream(ring, written, 11);
+    const FloatRing::View window = ring.latest(11);
+    XCTAssertTrue(isStream(window));
+    ring.release(window.end());
+  }
+
+  XCTAssertEqual(ring.written(), 1100u);
+  XCTAssertEqual(ring.available(), 0u);
+  XCTAssertEqual(ring.writable(), 16u);
+}
+
+- (void)testWindowOutsideTheHistoryThrows {
+  FloatRing ring(2, 8);
+  pushStream(ring, 0, 6);
+  ring.release(2);
+
+  XCTAssertTrue(throws<std::out_of_range>([&] { ring.window(1, 2); }));
+  XCTAssertTrue(throws<std::out_of_range>([&] { ring.window(4, 3); }));
+  XCTAssertTrue(throws<std::out_of_range>([&] { ring.latest(5); }));
+  XCTAssertTrue(throws<std::out_of_range>([&] { ring.release(7); }));
+
+  ring.release(1);
+  XCTAssertEqual(ring.released(), 2u);
+}
+
+- (void)testResetNumbersTheSamplesFromZero {
+  FloatRing ring(2, 8);
+  pushStream(ring, 0, 8);
+  ring.release(5);
+
+  ring.reset();
+
+  XCTAssertEqual(ring.written(), 0u);
+  XCTAssertEqual(ring.released(), 0u);
+  XCTAssertEqual(ring.writable(), 8u);
+  XCTAssertEqual(pushStream(ring, 0, 8), 8u);
+  XCTAssertTrue(isStream(ring.latest(8)));
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Producer and consumer threads
+//----------------------------------------------------------------------------
+
+/// The consumer reads every sample once, in order, while the producer wraps
+/// around a small ring many times.
+- (void)testConsumerReadsTheSamplesInOrder {
+  const uint64_t total = 200000;
+  FloatRing ring(4, 64);
+
+  std::thread producer([&ring, total] {
+    uint64_t written = 0;
+    size_t chunk = 1;
+    while (written < total) {
+      const size_t samples = static_cast<size_t>(std::min<uint64_t>(chunk, total - written));
+      written += pushStream(ring, written, samples);
+      chunk = chunk % 37 + 1;
+    }
+  });
+
+  uint64_t read = 0;
+  bool ordered = true;
+  while (read < total) {
+    const size_t available = ring.available();
+    if (available == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    const FloatRing::View window = ring.window(read, std::min<size_t>(available, 48));
+    ordered = ordered && isStream(window);
+    read = window.end();
+    ring.release(read);
+  }
+  producer.join();
+
+  XCTAssertTrue(ordered);
+  XCTAssertEqual(ring.written(), total);
+  XCTAssertEqual(ring.released(), total);
+}
+
+@end
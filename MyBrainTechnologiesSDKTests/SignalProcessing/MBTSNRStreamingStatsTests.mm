@@ -0,0 +1,168 @@
+//
+//  MBTSNRStreamingStatsTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <Algebra/MBT_Operations.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <vector>
+
+// The exercises of the compiled statistics are private, the tests call them
+// through the header
+#define private public
+#include <SNR/MBT_SNR_Stats.h>
+#undef private
+
+#include <SNR/MBT_SNR_StreamingStats.h>
+
+/// Kinds of reproducible SNR sessions.
+enum SessionKind {
+  /// Slow oscillation through the three levels of the exercise Switch, with
+  /// noise.
+  OSCILLATING_SESSION,
+  /// Values jumping between the three levels.
+  LEVELS_SESSION,
+  /// Uniform values in [0, 2].
+  UNIFORM_SESSION,
+  /// Values always above the threshold 1.
+  HIGH_SESSION
+};
+
+static SP_FloatVector session(SessionKind kind, unsigned int seed, size_t size) {
+  unsigned int state = seed;
+  const float period = 6.0f + seed % 13;
+  SP_FloatVector snr;
+  for (size_t second = 0; second < size; ++second) {
+    state = state * 1664525u + 1013904223u;
+    const float random = (state >> 8) / 16777216.0f;
+    switch (kind) {
+      case OSCILLATING_SESSION:
+        snr.push_back(0.5f + 0.45f * std::sin(6.2831853f * second / period) + (random - 0.5f) * 0.2f);
+        break;
+      case LEVELS_SESSION: {
+        const unsigned int level = (state >> 20) % 3;
+        snr.push_back(level == 0 ? 0.1f + 0.1f * random : (level == 1 ? 0.3f + 0.4f * random : 0.8f + 0.1f * random));
+        break;
+      }
+      case UNIFORM_SESSION:
+        snr.push_back(2 * random);
+        break;
+      case HIGH_SESSION:
+        snr.push_back(1.2f + random);
+        break;
+    }
+  }
+  return snr;
+}
+
+static bool isClose(SP_RealType value, SP_RealType expected) {
+  return std::fabs(value - expected) <= 1e-5 * std::fabs(expected) + 1e-6;
+}
+
+@interface MBTSNRStreamingStatsTests : XCTestCase
+@end
+
+@implementation MBTSNRStreamingStatsTests
+
+//----------------------------------------------------------------------------
+// MARK: - Same statistics as SNR_Statistics
+//----------------------------------------------------------------------------
+
+/// The switch count is the one of ExerciseSwitch on the values pushed so far,
+/// at any time of the session.
+- (void)testSwitchCountIsTheOneOfExerciseSwitch {
+  const SessionKind kinds[] = {OSCILLATING_SESSION, LEVELS_SESSION, UNIFORM_SESSION};
+  int switches = 0;
+  for (SessionKind kind : kinds) {
+    for (unsigned int seed = 1; seed <= 40; ++seed) {
+      const SP_FloatVector snr = session(kind, seed, 20 + 3 * seed);
+      SNR_StreamingStatistics statistics(1.0);
+
+      for (size_t size = 1; size <= snr.size(); ++size) {
+        statistics.push(snr[size - 1]);
+        if (size < 4) {
+          continue;
+        }
+        const SP_FloatVector pushed(snr.begin(), snr.begin() + size);
+        const int expected = SNR_Statistics(pushed).ExerciseSwitch(pushed);
+        XCTAssertEqual(statistics.snapshot().switchCount, expected, @"kind %d, seed %u, %zu values", kind, seed, size);
+      }
+      switches += statistics.snapshot().switchCount;
+    }
+  }
+  XCTAssertGreaterThan(switches, 0);
+}
+
+- (void)testAreasAreTheOnesOfTheExercises {
+  const SessionKind kinds[] = {OSCILLATING_SESSION, UNIFORM_SESSION, HIGH_SESSION};
+  const SP_RealType thresholds[] = {0.83, 1.0};
+  for (SessionKind kind : kinds) {
+    for (SP_RealType threshold : thresholds) {
+      for (unsigned int seed = 1; seed <= 20; ++seed) {
+        const SP_FloatVector snr = session(kind, seed, 7 + 11 * seed);
+        SNR_StreamingStatistics statistics(threshold);
+        for (SP_FloatType value : snr) {
+          statistics.push(value);
+        }
+
+        SNR_Statistics expected(snr);
+        const SNR_StatisticsSnapshot current = statistics.snapshot();
+        XCTAssertTrue(isClose(current.areaUp, expected.ExerciseAreaUpAndPerformance(snr, threshold).first),
+                      @"kind %d, threshold %g, seed %u", kind, threshold, seed);
+        XCTAssertTrue(isClose(current.areaDown, expected.ExerciseAreaDown(snr, threshold)),
+                      @"kind %d, threshold %g, seed %u", kind, threshold, seed);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Session
+//----------------------------------------------------------------------------
+
+- (void)testNaNValuesAreSkipped {
+  const SP_FloatVector snr = session(OSCILLATING_SESSION, 3, 60);
+  SNR_StreamingStatistics withNaN(1.0);
+  SNR_StreamingStatistics withoutNaN(1.0);
+
+  for (size_t second = 0; second < snr.size(); ++second) {
+    if (second % 7 == 0) {
+      withNaN.push(SP_NAN);
+    }
+    withNaN.push(snr[second]);
+    withoutNaN.push(snr[second]);
+  }
+
+  XCTAssertEqual(withNaN.snapshot().count, snr.size());
+  XCTAssertTrue(withNaN.toMap() == withoutNaN.toMap());
+}
+
+- (void)testResetStartsANewSession {
+  const SP_FloatVector first = session(LEVELS_SESSION, 5, 50);
+  const SP_FloatVector second = session(OSCILLATING_SESSION, 8, 50);
+  SNR_StreamingStatistics reused(1.0);
+  SNR_StreamingStatistics fresh(1.0);
+
+  for (SP_FloatType value : first) {
+    reused.push(value);
+  }
+  reused.reset();
+  for (SP_FloatType value : second) {
+    reused.push(value);
+    fresh.push(value);
+  }
+
+  XCTAssertEqual(reused.snapshot().count, fresh.snapshot().count);
+  XCTAssertTrue(reused.toMap() == fresh.toMap());
+}
+
+@end
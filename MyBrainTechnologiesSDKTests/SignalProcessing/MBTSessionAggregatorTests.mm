@@ -0,0 +1,192 @@
+//
+//  MBTSessionAggregatorTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <NF_Melomind/MBT_SessionAggregator.h>
+#include <NF_Melomind/MelomindAnalysisSingleton.h>
+
+/// Value added to a session, as given by the relax index of the bridge.
+struct AlphaPowerValue {
+  SP_RealType alphaPower;
+  SP_RealType relativeAlphaPower;
+  SP_Vector qualities;
+};
+
+/// Reproducible session of two channels, with qualities of the quality checker.
+static std::vector<AlphaPowerValue> session(unsigned int seed, size_t size) {
+  static const SP_RealType qualityLevels[] = {0, 0.25, 0.5, 0.99, 1};
+  unsigned int state = seed;
+  std::vector<AlphaPowerValue> values;
+  for (size_t second = 0; second < size; ++second) {
+    state = state * 1664525u + 1013904223u;
+    const SP_RealType random = (state >> 8) / 16777216.0;
+    AlphaPowerValue value;
+    value.alphaPower = 1e-3 + 20 * random;
+    value.relativeAlphaPower = random;
+    value.qualities.push_back(qualityLevels[(state >> 4) % 5]);
+    value.qualities.push_back(qualityLevels[(state >> 12) % 5]);
+    values.push_back(value);
+  }
+  return values;
+}
+
+/// The singleton is shared by the tests, each test starts a new session.
+static MelomindAnalysisSingleton& newSingletonSession() {
+  MelomindAnalysisSingleton& singleton = MelomindAnalysisSingleton::getInstance();
+  singleton.resetSession();
+  return singleton;
+}
+
+static bool isSame(SP_RealType value, SP_RealType expected) {
+  return value == expected || (std::isnan(value) && std::isnan(expected));
+}
+
+@interface MBTSessionAggregatorTests : XCTestCase
+@end
+
+@implementation MBTSessionAggregatorTests
+
+//----------------------------------------------------------------------------
+// MARK: - Same values as MelomindAnalysisSingleton
+//----------------------------------------------------------------------------
+
+/// The means and the confidence are the ones of the singleton after each
+/// value, the confidence of the singleton is read after its mean getters.
+- (void)testMeansAndConfidenceAreTheOnesOfTheSingleton {
+  MelomindAnalysisSingleton& singleton = newSingletonSession();
+  for (unsigned int seed = 1; seed <= 10; ++seed) {
+    const std::vector<AlphaPowerValue> values = session(seed, 50 + 20 * seed);
+    MBT_SessionAggregator aggregator;
+    singleton.resetSession();
+
+    for (size_t index = 0; index < values.size(); ++index) {
+      const AlphaPowerValue& value = values[index];
+      singleton.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+      aggregator.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+
+      const SP_RealType meanAlphaPower = singleton.getSessionMeanAlphaPower();
+      const SP_RealType meanRelativeAlphaPower = singleton.getSessionMeanRelativeAlphaPower();
+      XCTAssertTrue(isSame(aggregator.getSessionMeanAlphaPower(), meanAlphaPower), @"seed %u, value %zu", seed, index);
+      XCTAssertTrue(isSame(aggregator.getSessionMeanRelativeAlphaPower(), meanRelativeAlphaPower),
+                    @"seed %u, value %zu", seed, index);
+      XCTAssertTrue(isSame(aggregator.getSessionConfidence(), singleton.getSessionConfidence()),
+                    @"seed %u, value %zu", seed, index);
+    }
+    XCTAssertFalse(std::isnan(aggregator.getSessionMeanAlphaPower()), @"seed %u", seed);
+  }
+}
+
+- (void)testHistoriesAreTheOnesOfTheSingleton {
+  MelomindAnalysisSingleton& singleton = newSingletonSession();
+  const std::vector<AlphaPowerValue> values = session(7, 300);
+  MBT_SessionAggregator aggregator(1000);
+  for (const AlphaPowerValue& value : values) {
+    singleton.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+    aggregator.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+  }
+
+  SP_FloatVector history;
+  aggregator.getSessionAlphaPowers(history);
+  XCTAssertTrue(history == singleton.getSessionAlphaPowers());
+  aggregator.getSessionRelativeAlphaPowers(history);
+  XCTAssertTrue(history == singleton.getSessionRelativeAlphaPowers());
+  aggregator.getSessionQualities(history);
+  XCTAssertTrue(history == singleton.getSessionQualities());
+}
+
+/// A bounded history keeps the last values of the history of the singleton.
+- (void)testBoundedHistoryKeepsTheLastValues {
+  MelomindAnalysisSingleton& singleton = newSingletonSession();
+  const std::vector<AlphaPowerValue> values = session(11, 100);
+  MBT_SessionAggregator aggregator(16);
+  for (const AlphaPowerValue& value : values) {
+    singleton.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+    aggregator.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+  }
+
+  SP_FloatVector history;
+  const SP_FloatVector alphaPowers = singleton.getSessionAlphaPowers();
+  aggregator.getSessionAlphaPowers(history);
+  XCTAssertTrue(history == SP_FloatVector(alphaPowers.end() - 16, alphaPowers.end()));
+  const SP_FloatVector qualities = singleton.getSessionQualities();
+  aggregator.getSessionQualities(history);
+  XCTAssertTrue(history == SP_FloatVector(qualities.end() - 32, qualities.end()));
+}
+
+/// Only the qualities of the first two channels are used, as in the singleton.
+- (void)testOnlyTheQualitiesOfTheChannelsAreUsed {
+  MelomindAnalysisSingleton& singleton = newSingletonSession();
+  MBT_SessionAggregator aggregator;
+  const SP_Vector qualities = {0.5, 0, 1};
+  singleton.addAlphaPower(2, 0.2, qualities);
+  aggregator.addAlphaPower(2, 0.2, qualities);
+  singleton.addAlphaPower(4, 0.4, {1, 0});
+  aggregator.addAlphaPower(4, 0.4, {1, 0});
+
+  XCTAssertEqual(aggregator.getSessionMeanAlphaPower(), singleton.getSessionMeanAlphaPower());
+  XCTAssertEqual(aggregator.getSessionConfidence(), singleton.getSessionConfidence());
+  XCTAssertEqual(aggregator.getSessionConfidence(), 0.5);
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Session
+//----------------------------------------------------------------------------
+
+- (void)testResetSessionAsTheSingleton {
+  MelomindAnalysisSingleton& singleton = newSingletonSession();
+  MBT_SessionAggregator aggregator(100);
+  for (const AlphaPowerValue& value : session(3, 40)) {
+    singleton.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+    aggregator.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+  }
+  singleton.resetSession();
+  aggregator.resetSession();
+
+  XCTAssertTrue(isSame(aggregator.getSessionMeanAlphaPower(), singleton.getSessionMeanAlphaPower()));
+  XCTAssertTrue(isSame(aggregator.getSessionConfidence(), singleton.getSessionConfidence()));
+  XCTAssertTrue(std::isnan(aggregator.getSessionConfidence()));
+  SP_FloatVector history;
+  aggregator.getSessionAlphaPowers(history);
+  XCTAssertTrue(history.empty());
+
+  for (const AlphaPowerValue& value : session(4, 40)) {
+    singleton.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+    aggregator.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+  }
+  XCTAssertEqual(aggregator.getSessionMeanAlphaPower(), singleton.getSessionMeanAlphaPower());
+  XCTAssertEqual(aggregator.getSessionConfidence(), singleton.getSessionConfidence());
+  aggregator.getSessionQualities(history);
+  XCTAssertTrue(history == singleton.getSessionQualities());
+}
+
+/// A NaN alpha power counts as a value of bad quality, where the means of the
+/// singleton become NaN.
+- (void)testNaNAlphaPowersCountAsBadQuality {
+  MelomindAnalysisSingleton& singleton = newSingletonSession();
+  MBT_SessionAggregator aggregator;
+  const std::vector<AlphaPowerValue> values = session(5, 60);
+  for (size_t index = 0; index < values.size(); ++index) {
+    const AlphaPowerValue& value = values[index];
+    if (index % 9 == 4) {
+      aggregator.addAlphaPower(SP_NAN, value.relativeAlphaPower, {1, 1});
+      singleton.addAlphaPower(value.alphaPower, value.relativeAlphaPower, {0, 0});
+    } else {
+      aggregator.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+      singleton.addAlphaPower(value.alphaPower, value.relativeAlphaPower, value.qualities);
+    }
+  }
+
+  XCTAssertEqual(aggregator.getSessionMeanAlphaPower(), singleton.getSessionMeanAlphaPower());
+  XCTAssertEqual(aggregator.getSessionMeanRelativeAlphaPower(), singleton.getSessionMeanRelativeAlphaPower());
+  XCTAssertEqual(aggregator.getSessionConfidence(), singleton.getSessionConfidence());
+}
+
+@end
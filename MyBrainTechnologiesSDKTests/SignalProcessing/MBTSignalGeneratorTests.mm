@@ -0,0 +1,154 @@
+//
+//  MBTSignalGeneratorTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <DataManipulation/MBT_SignalGenerator.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/// Parameters with all the kinds of artifacts, frequent enough to appear in
+/// a few seconds.
+static MBT_SignalGeneratorConfig configWithArtifacts() {
+  MBT_SignalGeneratorConfig config;
+  config.channels = 4;
+  config.muscleRate = 0.3f;
+  config.blinkRate = 0.5f;
+  config.flatRate = 0.1f;
+  config.flatDuration = 0.5f;
+  config.gapRate = 0.2f;
+  return config;
+}
+
+/// True if two matrices hold the same bits, NaN included.
+static bool isSameSignal(const SP_FloatMatrix& signal, const SP_FloatMatrix& expected) {
+  if (signal.size() != expected.size()) {
+    return false;
+  }
+  for (int channel = 0; channel < signal.size().first; ++channel) {
+    if (std::memcmp(signal.rowData(channel), expected.rowData(channel),
+                    signal.size().second * sizeof(SP_FloatType)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Columns [first, first + count) of a matrix.
+static SP_FloatMatrix columns(const SP_FloatMatrix& signal, int first, int count) {
+  SP_FloatMatrix result(signal.size().first, count);
+  for (int channel = 0; channel < signal.size().first; ++channel) {
+    std::memcpy(result.rowData(channel), signal.rowData(channel) + first, count * sizeof(SP_FloatType));
+  }
+  return result;
+}
+
+@interface MBTSignalGeneratorTests : XCTestCase
+@end
+
+@implementation MBTSignalGeneratorTests
+
+//----------------------------------------------------------------------------
+// MARK: - Seeded determinism
+//----------------------------------------------------------------------------
+
+- (void)testSameSeedGivesTheSameSignal {
+  for (uint64_t seed = 0; seed < 5; ++seed) {
+    MBT_SignalGenerator generator(configWithArtifacts(), seed);
+    MBT_SignalGenerator other(configWithArtifacts(), seed);
+    for (int packet = 0; packet < 20; ++packet) {
+      XCTAssertTrue(isSameSignal(generator.nextPacket(), other.nextPacket()), @"seed %llu, packet %d",
+                    (unsigned long long)seed, packet);
+      XCTAssertTrue(generator.labels() == other.labels(), @"seed %llu, packet %d", (unsigned long long)seed, packet);
+    }
+  }
+}
+
+- (void)testResetRestartsTheSignal {
+  MBT_SignalGenerator generator(configWithArtifacts(), 7);
+  const SP_FloatMatrix first = generator.generate(2000);
+  const std::vector<unsigned char> labels = generator.labels();
+
+  generator.generate(333);
+  generator.reset(7);
+  XCTAssertEqual(generator.sampleCount(), static_cast<uint64_t>(0));
+  XCTAssertTrue(isSameSignal(generator.generate(2000), first));
+  XCTAssertTrue(generator.labels() == labels);
+}
+
+/// The packets form one recording: the signal does not depend on how it is
+/// cut in packets.
+- (void)testSignalDoesNotDependOnThePacketLength {
+  MBT_SignalGenerator whole(configWithArtifacts(), 3);
+  const SP_FloatMatrix recording = whole.generate(3000);
+
+  MBT_SignalGenerator packets(configWithArtifacts(), 3);
+  const int lengths[] = {1, 250, 17, 1000, 1732};
+  int first = 0;
+  for (int length : lengths) {
+    SP_FloatMatrix packet(configWithArtifacts().channels, length);
+    packets.generate(packet);
+    XCTAssertTrue(isSameSignal(packet, columns(recording, first, length)), @"samples %d to %d", first,
+                  first + length);
+    first += length;
+  }
+  XCTAssertEqual(packets.sampleCount(), static_cast<uint64_t>(3000));
+}
+
+- (void)testDifferentSeedsGiveDifferentSignals {
+  MBT_SignalGenerator generator(configWithArtifacts(), 1);
+  MBT_SignalGenerator other(configWithArtifacts(), 2);
+  XCTAssertFalse(isSameSignal(generator.nextPacket(), other.nextPacket()));
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Artifacts
+//----------------------------------------------------------------------------
+
+/// The samples of the lost frames, and only them, are NaN, and the flat
+/// lines repeat the last value.
+- (void)testLabelsDescribeTheSamples {
+  MBT_SignalGenerator generator(configWithArtifacts(), 11);
+  const SP_FloatMatrix signal = generator.generate(20000);
+  const std::vector<unsigned char> labels = generator.labels();
+
+  int gaps = 0;
+  int flats = 0;
+  for (int i = 0; i < signal.size().second; ++i) {
+    const bool isGap = (labels[i] & MBT_SignalGenerator::GAP) != 0;
+    const bool isFlat = i > 0 && (labels[i] & MBT_SignalGenerator::FLAT) && (labels[i - 1] & MBT_SignalGenerator::FLAT) &&
+                        !(labels[i] & MBT_SignalGenerator::GAP) && !(labels[i - 1] & MBT_SignalGenerator::GAP);
+    gaps += isGap;
+    flats += isFlat;
+    for (int channel = 0; channel < signal.size().first; ++channel) {
+      const SP_FloatType* row = signal.rowData(channel);
+      XCTAssertEqual(std::isnan(row[i]), isGap, @"sample %d, channel %d", i, channel);
+      if (isFlat) {
+        XCTAssertEqual(row[i], row[i - 1], @"sample %d, channel %d", i, channel);
+      }
+    }
+  }
+  XCTAssertGreaterThan(gaps, 0);
+  XCTAssertGreaterThan(flats, 0);
+}
+
+- (void)testInvalidParametersAreRejected {
+  MBT_SignalGeneratorConfig config;
+  config.alphaFrequency = 200;
+  XCTAssertThrows(MBT_SignalGenerator generator(config));
+  config = MBT_SignalGeneratorConfig();
+  config.channels = 0;
+  XCTAssertThrows(MBT_SignalGenerator generator(config));
+
+  MBT_SignalGenerator generator;
+  SP_FloatMatrix packet(3, 10);
+  XCTAssertThrows(generator.generate(packet));
+}
+
+@end
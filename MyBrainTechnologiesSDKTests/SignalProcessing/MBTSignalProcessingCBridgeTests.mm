@@ -0,0 +1,375 @@
+//
+//  MBTSignalProcessingCBridgeTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MyBrainTechnologiesSDK/MBTSignalProcessingBridge.h>
+#import <MyBrainTechnologiesSDK/MBTSignalProcessingC.h>
+
+#include <DataManipulation/MBT_SignalGenerator.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+/// Methods of the bridge which are not in its header.
+@interface MBTRelaxIndexBridge (Tests)
+
++ (NSDictionary*)getSessionMetadata;
++ (void)reinitRelaxIndex;
+
+@end
+
+static const int32_t kChannels = 2;
+static const int32_t kPacketLength = 250;
+static const int32_t kSampRate = 250;
+static const float kAccuracy = 0.85f;
+static const int32_t kCalibrationPackets = 30;
+static const int32_t kSessionPackets = 20;
+/// Packets of the signal of a relax index: the last 4 seconds kept by the
+/// bridge.
+static const int32_t kWindowPackets = 4;
+
+/// Packets of synthetic EEG in volts, channel after channel.
+static std::vector<std::vector<float>> recordPackets(uint64_t seed,
+                                                     int32_t count) {
+  MBT_SignalGeneratorConfig config;
+  config.channels = kChannels;
+  config.packetLength = kPacketLength;
+  config.sampRate = kSampRate;
+  MBT_SignalGenerator generator(config, seed);
+
+  std::vector<std::vector<float>> packets;
+  for (int32_t packet = 0; packet < count; ++packet) {
+    const SP_FloatMatrix signal = generator.nextPacket();
+    std::vector<float> planar;
+    for (int32_t channel = 0; channel < kChannels; ++channel) {
+      const SP_FloatType* row = signal.rowData(channel);
+      for (int32_t sample = 0; sample < kPacketLength; ++sample) {
+        planar.push_back(1e-6f * row[sample]);
+      }
+    }
+    packets.push_back(planar);
+  }
+  return packets;
+}
+
+/// Packets one after the other for each channel, channel after channel.
+static std::vector<float> concatenate(
+  const std::vector<std::vector<float>>& packets,
+  size_t first,
+  size_t count) {
+  const size_t length = packets[first].size() / kChannels;
+  std::vector<float> planar;
+  for (int32_t channel = 0; channel < kChannels; ++channel) {
+    for (size_t packet = first; packet < first + count; ++packet) {
+      const float* row = packets[packet].data() + channel * length;
+      planar.insert(planar.end(), row, row + length);
+    }
+  }
+  return planar;
+}
+
+/// Qualities of the packets, packet after packet for each channel.
+static std::vector<float> qualitiesByChannel(
+  const std::vector<std::vector<float>>& qualities) {
+  std::vector<float> byChannel;
+  for (int32_t channel = 0; channel < kChannels; ++channel) {
+    for (const std::vector<float>& packet: qualities) {
+      byChannel.push_back(packet[channel]);
+    }
+  }
+  return byChannel;
+}
+
+static NSArray* toArray(const std::vector<float>& values) {
+  NSMutableArray* array = [[NSMutableArray alloc] init];
+  for (float value: values) {
+    [array addObject: @(value)];
+  }
+  return array;
+}
+
+/// Values of an array, or of the arrays of an array one after the other.
+static std::vector<float> toVector(NSArray* array) {
+  std::vector<float> values;
+  for (id value in array) {
+    if ([value isKindOfClass: [NSArray class]]) {
+      const std::vector<float> row = toVector(value);
+      values.insert(values.end(), row.begin(), row.end());
+    } else {
+      values.push_back([value floatValue]);
+    }
+  }
+  return values;
+}
+
+/// Outputs of the processing of the same recording.
+struct ProcessingResult {
+  /// Qualities and modified data of each packet, calibration then session.
+  std::vector<std::vector<float>> qualities;
+  std::vector<std::vector<float>> modifiedData;
+  std::map<std::string, std::vector<float>> calibration;
+  /// Volume of each packet of the session.
+  std::vector<float> volumes;
+  std::vector<float> rawRelaxIndex;
+  std::vector<float> smoothedRelaxIndex;
+  std::vector<float> frequencies;
+  std::vector<float> analysis;
+  std::vector<float> alphaPowers;
+  std::vector<float> sessionQualities;
+};
+
+/// Processing of a recording with the C interface, as the applications do
+/// with the bridge: the signal of a relax index is the last kWindowPackets
+/// packets of the session.
+static ProcessingResult processWithC(
+  const std::vector<std::vector<float>>& packets) {
+  ProcessingResult result;
+  MBTQualitySessionRef quality = NULL;
+  MBTQualitySessionCreate(kSampRate, kAccuracy, &quality);
+  for (const std::vector<float>& data: packets) {
+    std::vector<float> qualities(kChannels);
+    std::vector<float> modified(data.size());
+    const MBTSignalBuffer packet =
+      MBTSignalBufferMakePlanar(data.data(), kChannels, kPacketLength);
+    const MBTMutableSignalBuffer modifiedData =
+      MBTMutableSignalBufferMakePlanar(modified.data(), kChannels, kPacketLength);
+    MBTQualitySessionCompute(quality,
+                             &packet,
+                             qualities.data(),
+                             kChannels,
+                             &modifiedData);
+    result.qualities.push_back(qualities);
+    result.modifiedData.push_back(modified);
+  }
+  MBTQualitySessionRelease(quality);
+
+  const std::vector<float> recordings =
+    concatenate(result.modifiedData, 0, kCalibrationPackets);
+  const std::vector<float> recordingsQualities = qualitiesByChannel(
+    std::vector<std::vector<float>>(result.qualities.begin(),
+                                    result.qualities.begin() + kCalibrationPackets));
+  const MBTSignalBuffer recordingsBuffer =
+    MBTSignalBufferMakePlanar(recordings.data(),
+                              kChannels,
+                              kCalibrationPackets * kPacketLength);
+  const MBTSignalBuffer qualitiesBuffer =
+    MBTSignalBufferMakePlanar(recordingsQualities.data(),
+                              kChannels,
+                              kCalibrationPackets);
+  MBTCalibrationRef calibration = NULL;
+  MBTCalibrationCreate(&calibration);
+  MBTCalibrationCompute(calibration,
+                        &recordingsBuffer,
+                        &qualitiesBuffer,
+                        kPacketLength,
+                        kSampRate);
+  for (int32_t i = 0; i < MBTCalibrationParameterCount(calibration); ++i) {
+    const char* name = MBTCalibrationParameterName(calibration, i);
+    int32_t count = 0;
+    MBTCalibrationGetParameter(calibration, name, NULL, 0, &count);
+    std::vector<float> values(count);
+    MBTCalibrationGetParameter(calibration, name, values.data(), count, &count);
+    result.calibration[name] = values;
+  }
+
+  MBTRelaxIndexSessionRef relax = NULL;
+  MBTRelaxIndexSessionCreate(calibration,
+                             kSampRate,
+                             kWindowPackets * kPacketLength,
+                             &relax);
+  MBTCalibrationRelease(calibration);
+  for (size_t last = kCalibrationPackets;
+       last < result.modifiedData.size();
+       ++last) {
+    const size_t first =
+      std::max<size_t>(kCalibrationPackets, last + 1 - kWindowPackets);
+    const std::vector<float> window =
+      concatenate(result.modifiedData, first, last + 1 - first);
+    const MBTSignalBuffer signal =
+      MBTSignalBufferMakePlanar(window.data(),
+                                kChannels,
+                                static_cast<int32_t>(window.size() / kChannels));
+    float volume = 0;
+    MBTRelaxIndexSessionCompute(relax,
+                                &signal,
+                                result.qualities[last].data(),
+                                kChannels,
+                                &volume);
+    result.volumes.push_back(volume);
+  }
+
+  const MBTRelaxIndexHistory histories[] = {
+    MBTRelaxIndexHistoryRaw,
+    MBTRelaxIndexHistorySmoothed,
+    MBTRelaxIndexHistoryFrequencies,
+    MBTRelaxIndexHistoryAlphaPowers,
+    MBTRelaxIndexHistoryQualities
+  };
+  std::vector<float>* outputs[] = {
+    &result.rawRelaxIndex,
+    &result.smoothedRelaxIndex,
+    &result.frequencies,
+    &result.alphaPowers,
+    &result.sessionQualities
+  };
+  for (int i = 0; i < 5; ++i) {
+    int32_t count = 0;
+    MBTRelaxIndexSessionGetHistory(relax, histories[i], NULL, 0, &count);
+    outputs[i]->resize(count);
+    MBTRelaxIndexSessionGetHistory(relax,
+                                   histories[i],
+                                   outputs[i]->data(),
+                                   count,
+                                   &count);
+  }
+  MBTRelaxIndexAnalysis analysis;
+  MBTRelaxIndexSessionGetAnalysis(relax, &analysis);
+  result.analysis = {
+    analysis.meanRelativeAlphaPower,
+    analysis.meanAlphaPower,
+    analysis.confidence
+  };
+  MBTRelaxIndexSessionRelease(relax);
+  return result;
+}
+
+/// Processing of a recording with the Objective-C bridge.
+static ProcessingResult processWithBridge(
+  const std::vector<std::vector<float>>& packets) {
+  ProcessingResult result;
+  [MBTQualityCheckerBridge initializeMainQualityChecker: kSampRate
+                                               accuracy: kAccuracy];
+  for (const std::vector<float>& data: packets) {
+    NSArray* qualities =
+      [MBTQualityCheckerBridge computeQuality: toArray(data)
+                                     sampRate: kSampRate
+                                   nbChannels: kChannels
+                                 packetLength: kPacketLength];
+    result.qualities.push_back(toVector(qualities));
+    result.modifiedData.push_back(
+      toVector([MBTQualityCheckerBridge getModifiedEEGData]));
+  }
+  [MBTQualityCheckerBridge deInitializeMainQualityChecker];
+
+  const std::vector<float> recordings =
+    concatenate(result.modifiedData, 0, kCalibrationPackets);
+  const std::vector<float> recordingsQualities = qualitiesByChannel(
+    std::vector<std::vector<float>>(result.qualities.begin(),
+                                    result.qualities.begin() + kCalibrationPackets));
+  NSDictionary* parameters =
+    [MBTCalibrationBridge computeCalibration: toArray(recordings)
+                                   qualities: toArray(recordingsQualities)
+                                packetLength: kPacketLength
+                                packetsCount: kCalibrationPackets
+                                    sampRate: kSampRate];
+  for (NSString* name in parameters) {
+    result.calibration[name.UTF8String] = toVector(parameters[name]);
+  }
+
+  [MBTMelomindAnalysis resetSession];
+  [MBTRelaxIndexBridge reinitRelaxIndex];
+  for (size_t last = kCalibrationPackets;
+       last < result.modifiedData.size();
+       ++last) {
+    const float volume =
+      [MBTRelaxIndexBridge computeRelaxIndex: toArray(result.modifiedData[last])
+                                    sampRate: kSampRate
+                                  nbChannels: kChannels
+                         lastPacketQualities: toArray(result.qualities[last])];
+    result.volumes.push_back(volume);
+  }
+
+  NSDictionary* metadata = [MBTRelaxIndexBridge getSessionMetadata];
+  result.rawRelaxIndex = toVector(metadata[@"rawRelaxIndexes"]);
+  result.smoothedRelaxIndex = toVector(metadata[@"smoothedRelaxIndex"]);
+  result.frequencies = toVector(metadata[@"histFrequencies"]);
+  result.alphaPowers = toVector([MBTMelomindAnalysis sessionAlphaPowers]);
+  result.sessionQualities = toVector([MBTMelomindAnalysis sessionQualities]);
+  // same order as MBTRelaxIndexSessionGetAnalysis, the confidence is the one
+  // of the last mean computed
+  const float meanRelativeAlphaPower =
+    [MBTMelomindAnalysis sessionMeanRelativeAlphaPower];
+  const float meanAlphaPower = [MBTMelomindAnalysis sessionMeanAlphaPower];
+  const float confidence = [MBTMelomindAnalysis sessionConfidence];
+  result.analysis = { meanRelativeAlphaPower, meanAlphaPower, confidence };
+  [MBTRelaxIndexBridge reinitRelaxIndex];
+  return result;
+}
+
+@interface MBTSignalProcessingCBridgeTests : XCTestCase
+@end
+
+@implementation MBTSignalProcessingCBridgeTests
+
+//----------------------------------------------------------------------------
+// MARK: - Same values as the Objective-C bridge
+//----------------------------------------------------------------------------
+
+- (void)testQualitiesAreTheBridgeQualities {
+  for (uint64_t seed = 1; seed <= 2; ++seed) {
+    const std::vector<std::vector<float>> packets =
+      recordPackets(seed, kCalibrationPackets + kSessionPackets);
+    const ProcessingResult c = processWithC(packets);
+    const ProcessingResult bridge = processWithBridge(packets);
+
+    XCTAssertEqual(c.qualities.size(), packets.size());
+    XCTAssertTrue(c.qualities == bridge.qualities, @"seed %llu",
+                  (unsigned long long)seed);
+    XCTAssertTrue(c.modifiedData == bridge.modifiedData, @"seed %llu",
+                  (unsigned long long)seed);
+  }
+}
+
+- (void)testCalibrationIsTheBridgeCalibration {
+  for (uint64_t seed = 1; seed <= 2; ++seed) {
+    const std::vector<std::vector<float>> packets =
+      recordPackets(seed, kCalibrationPackets + kSessionPackets);
+    const ProcessingResult c = processWithC(packets);
+    const ProcessingResult bridge = processWithBridge(packets);
+
+    XCTAssertFalse(c.calibration.empty(), @"seed %llu",
+                   (unsigned long long)seed);
+    XCTAssertTrue(c.calibration == bridge.calibration, @"seed %llu",
+                  (unsigned long long)seed);
+  }
+}
+
+- (void)testVolumesAreTheBridgeVolumes {
+  for (uint64_t seed = 1; seed <= 2; ++seed) {
+    const std::vector<std::vector<float>> packets =
+      recordPackets(seed, kCalibrationPackets + kSessionPackets);
+    const ProcessingResult c = processWithC(packets);
+    const ProcessingResult bridge = processWithBridge(packets);
+
+    XCTAssertEqual(c.volumes.size(), static_cast<size_t>(kSessionPackets));
+    XCTAssertTrue(c.volumes == bridge.volumes, @"seed %llu",
+                  (unsigned long long)seed);
+    XCTAssertTrue(c.rawRelaxIndex == bridge.rawRelaxIndex, @"seed %llu",
+                  (unsigned long long)seed);
+    XCTAssertTrue(c.smoothedRelaxIndex == bridge.smoothedRelaxIndex,
+                  @"seed %llu", (unsigned long long)seed);
+    XCTAssertTrue(c.frequencies == bridge.frequencies, @"seed %llu",
+                  (unsigned long long)seed);
+  }
+}
+
+- (void)testSessionAnalysisIsTheBridgeAnalysis {
+  const std::vector<std::vector<float>> packets =
+    recordPackets(3, kCalibrationPackets + kSessionPackets);
+  const ProcessingResult c = processWithC(packets);
+  const ProcessingResult bridge = processWithBridge(packets);
+
+  XCTAssertFalse(c.alphaPowers.empty());
+  XCTAssertTrue(c.alphaPowers == bridge.alphaPowers);
+  XCTAssertTrue(c.sessionQualities == bridge.sessionQualities);
+  XCTAssertTrue(c.analysis == bridge.analysis);
+}
+
+@end
@@ -0,0 +1,424 @@
+//
+//  MBTSignalProcessingCTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MyBrainTechnologiesSDK/MBTSignalProcessingC.h>
+
+#include <NF_Melomind/MBT_ComputeCalibration.h>
+#include <NF_Melomind/MelomindAnalysisSingleton.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/// Value of the caller arrays which the SDK must not overwrite.
+static const float kUntouched = -12345;
+
+/// Calibration which a relax index session can be created with.
+static MBTCalibrationRef restoredCalibration() {
+  MBTCalibrationRef calibration = NULL;
+  MBTCalibrationCreate(&calibration);
+  const float smoothedRms[] = { 1, 2, 3, 4 };
+  const float frequencies[] = { 9.5f, 10.5f };
+  MBTCalibrationSetParameter(calibration,
+                             CalibrationOutputKeys::SMOOTHED_RMS.c_str(),
+                             smoothedRms,
+                             4);
+  MBTCalibrationSetParameter(calibration,
+                             CalibrationOutputKeys::HIST_FREQ.c_str(),
+                             frequencies,
+                             2);
+  return calibration;
+}
+
+/// Deterministic EEG-like packet of `channels` rows, channel after channel.
+static std::vector<float> planarPacket(int32_t channels, int32_t samples) {
+  std::vector<float> data(channels * samples);
+  uint32_t state = 1;
+  for (int32_t channel = 0; channel < channels; ++channel) {
+    for (int32_t sample = 0; sample < samples; ++sample) {
+      state = state * 1664525u + 1013904223u;
+      const float noise = static_cast<float>(state >> 8) / 16777216 - 0.5f;
+      const float alpha = std::sin(2 * 3.14159265f * 10 * sample / 250.0f);
+      data[channel * samples + sample] = 1e-5f * (alpha + noise);
+    }
+  }
+  return data;
+}
+
+/// Same samples as a planar packet, the channels of a sample together.
+static std::vector<float> interleaved(const std::vector<float>& planar,
+                                      int32_t channels,
+                                      int32_t samples) {
+  std::vector<float> data(planar.size());
+  for (int32_t channel = 0; channel < channels; ++channel) {
+    for (int32_t sample = 0; sample < samples; ++sample) {
+      data[sample * channels + channel] = planar[channel * samples + sample];
+    }
+  }
+  return data;
+}
+
+@interface MBTSignalProcessingCTests : XCTestCase
+@end
+
+@implementation MBTSignalProcessingCTests
+
+//----------------------------------------------------------------------------
+// MARK: - Statuses
+//----------------------------------------------------------------------------
+
+- (void)testEveryStatusHasItsOwnDescription {
+  const MBTStatus statuses[] = {
+    MBTStatusOK,
+    MBTStatusInvalidArgument,
+    MBTStatusBufferTooSmall,
+    MBTStatusNotCalibrated,
+    MBTStatusFailure,
+    MBTStatusSessionInProgress
+  };
+  const size_t count = sizeof(statuses) / sizeof(statuses[0]);
+  for (size_t i = 0; i < count; ++i) {
+    XCTAssertTrue(MBTStatusDescription(statuses[i]) != NULL);
+    for (size_t j = 0; j < i; ++j) {
+      XCTAssertTrue(std::strcmp(MBTStatusDescription(statuses[i]),
+                                MBTStatusDescription(statuses[j])) != 0);
+    }
+  }
+  XCTAssertTrue(std::strcmp(MBTStatusDescription(static_cast<MBTStatus>(42)),
+                            "unknown status") == 0);
+}
+
+- (void)testNullAndNonPositiveArgumentsAreInvalid {
+  MBTQualitySessionRef quality = NULL;
+  XCTAssertEqual(MBTQualitySessionCreate(250, 0.85f, NULL),
+                 MBTStatusInvalidArgument);
+  XCTAssertEqual(MBTQualitySessionCreate(0, 0.85f, &quality),
+                 MBTStatusInvalidArgument);
+  XCTAssertTrue(quality == NULL);
+
+  XCTAssertEqual(MBTCalibrationCreate(NULL), MBTStatusInvalidArgument);
+
+  MBTCalibrationRef calibration = NULL;
+  XCTAssertEqual(MBTCalibrationCreate(&calibration), MBTStatusOK);
+  MBTRelaxIndexSessionRef relax = NULL;
+  XCTAssertEqual(MBTRelaxIndexSessionCreate(NULL, 250, 250, &relax),
+                 MBTStatusInvalidArgument);
+  XCTAssertEqual(MBTRelaxIndexSessionCreate(calibration, 250, 0, &relax),
+                 MBTStatusInvalidArgument);
+  XCTAssertEqual(MBTRelaxIndexSessionCreate(calibration, 250, 250, NULL),
+                 MBTStatusInvalidArgument);
+  XCTAssertTrue(relax == NULL);
+  MBTCalibrationRelease(calibration);
+
+  // releasing NULL is allowed
+  MBTQualitySessionRelease(NULL);
+  MBTCalibrationRelease(NULL);
+  MBTRelaxIndexSessionRelease(NULL);
+}
+
+- (void)testRelaxIndexSessionNeedsACalibration {
+  MBTCalibrationRef calibration = NULL;
+  XCTAssertEqual(MBTCalibrationCreate(&calibration), MBTStatusOK);
+
+  MBTRelaxIndexSessionRef relax = NULL;
+  XCTAssertEqual(MBTRelaxIndexSessionCreate(calibration, 250, 250, &relax),
+                 MBTStatusNotCalibrated);
+  XCTAssertTrue(relax == NULL);
+  MBTCalibrationRelease(calibration);
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Caller owned buffers
+//----------------------------------------------------------------------------
+
+- (void)testCalibrationParameterIsCopiedIntoTheCallerBuffer {
+  MBTCalibrationRef calibration = NULL;
+  XCTAssertEqual(MBTCalibrationCreate(&calibration), MBTStatusOK);
+  const float saved[] = { 1.5f, 2.5f, 3.5f };
+  XCTAssertEqual(MBTCalibrationSetParameter(calibration, "rms", saved, 3),
+                 MBTStatusOK);
+
+  // the count is given even when the buffer is too small or missing
+  int32_t count = 0;
+  XCTAssertEqual(MBTCalibrationGetParameter(calibration, "rms", NULL, 0, &count),
+                 MBTStatusBufferTooSmall);
+  XCTAssertEqual(count, 3);
+
+  float small[2] = { kUntouched, kUntouched };
+  count = 0;
+  XCTAssertEqual(MBTCalibrationGetParameter(calibration, "rms", small, 2, &count),
+                 MBTStatusBufferTooSmall);
+  XCTAssertEqual(count, 3);
+  XCTAssertEqual(small[0], kUntouched);
+  XCTAssertEqual(small[1], kUntouched);
+
+  // only `count` values are written in a larger buffer
+  float large[4] = { kUntouched, kUntouched, kUntouched, kUntouched };
+  XCTAssertEqual(MBTCalibrationGetParameter(calibration, "rms", large, 4, &count),
+                 MBTStatusOK);
+  XCTAssertEqual(count, 3);
+  XCTAssertEqual(large[0], 1.5f);
+  XCTAssertEqual(large[1], 2.5f);
+  XCTAssertEqual(large[2], 3.5f);
+  XCTAssertEqual(large[3], kUntouched);
+
+  XCTAssertEqual(MBTCalibrationGetParameter(calibration, "rms", large, 4, NULL),
+                 MBTStatusInvalidArgument);
+  XCTAssertEqual(MBTCalibrationGetParameter(calibration, "missing", large, 4, &count),
+                 MBTStatusInvalidArgument);
+  MBTCalibrationRelease(calibration);
+}
+
+- (void)testCalibrationParameterNames {
+  MBTCalibrationRef calibration = NULL;
+  XCTAssertEqual(MBTCalibrationCreate(&calibration), MBTStatusOK);
+  const float value = 1;
+  XCTAssertEqual(MBTCalibrationSetParameter(calibration, "b", &value, 1), MBTStatusOK);
+  XCTAssertEqual(MBTCalibrationSetParameter(calibration, "a", &value, 1), MBTStatusOK);
+  XCTAssertEqual(MBTCalibrationSetParameter(calibration, "b", NULL, 0), MBTStatusOK);
+  XCTAssertEqual(MBTCalibrationSetParameter(calibration, "c", NULL, 1),
+                 MBTStatusInvalidArgument);
+
+  XCTAssertEqual(MBTCalibrationParameterCount(calibration), 2);
+  XCTAssertTrue(std::strcmp(MBTCalibrationParameterName(calibration, 0), "a") == 0);
+  XCTAssertTrue(std::strcmp(MBTCalibrationParameterName(calibration, 1), "b") == 0);
+  XCTAssertTrue(MBTCalibrationParameterName(calibration, 2) == NULL);
+  XCTAssertTrue(MBTCalibrationParameterName(calibration, -1) == NULL);
+  XCTAssertEqual(MBTCalibrationParameterCount(NULL), 0);
+  MBTCalibrationRelease(calibration);
+}
+
+- (void)testRelaxIndexHistoryIsCopiedIntoTheCallerBuffer {
+  MBTCalibrationRef calibration = restoredCalibration();
+  MBTRelaxIndexSessionRef relax = NULL;
+  XCTAssertEqual(MBTRelaxIndexSessionCreate(calibration, 250, 250, &relax),
+                 MBTStatusOK);
+  // the session keeps its own copy of the calibration
+  MBTCalibrationRelease(calibration);
+
+  int32_t count = -1;
+  float values[2] = { kUntouched, kUntouched };
+  XCTAssertEqual(MBTRelaxIndexSessionGetHistory(relax,
+                                                MBTRelaxIndexHistoryVolume,
+                                                values,
+                                                2,
+                                                &count),
+                 MBTStatusOK);
+  XCTAssertEqual(count, 0);
+  XCTAssertEqual(values[0], kUntouched);
+
+  XCTAssertEqual(MBTRelaxIndexSessionGetHistory(relax,
+                                                MBTRelaxIndexHistoryFrequencies,
+                                                values,
+                                                1,
+                                                &count),
+                 MBTStatusBufferTooSmall);
+  XCTAssertEqual(count, 2);
+  XCTAssertEqual(values[0], kUntouched);
+  XCTAssertEqual(MBTRelaxIndexSessionGetHistory(relax,
+                                                MBTRelaxIndexHistoryFrequencies,
+                                                values,
+                                                2,
+                                                &count),
+                 MBTStatusOK);
+  XCTAssertEqual(values[0], 9.5f);
+  XCTAssertEqual(values[1], 10.5f);
+
+  XCTAssertEqual(MBTRelaxIndexSessionGetHistory(relax,
+                                                static_cast<MBTRelaxIndexHistory>(42),
+                                                values,
+                                                2,
+                                                &count),
+                 MBTStatusInvalidArgument);
+  XCTAssertEqual(MBTRelaxIndexSessionGetHistory(NULL,
+                                                MBTRelaxIndexHistoryRaw,
+                                                values,
+                                                2,
+                                                &count),
+                 MBTStatusInvalidArgument);
+  MBTRelaxIndexSessionRelease(relax);
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Session analysis
+//----------------------------------------------------------------------------
+
+/// The relax index sessions share the session analysis of the libraries.
+- (void)testOneRelaxIndexSessionAtATime {
+  MBTCalibrationRef calibration = restoredCalibration();
+  MBTRelaxIndexSessionRef relax = NULL;
+  XCTAssertEqual(MBTRelaxIndexSessionCreate(calibration, 250, 250, &relax),
+                 MBTStatusOK);
+
+  MBTRelaxIndexSessionRef other = NULL;
+  XCTAssertEqual(MBTRelaxIndexSessionCreate(calibration, 250, 250, &other),
+                 MBTStatusSessionInProgress);
+  XCTAssertTrue(other == NULL);
+  MBTRelaxIndexSessionReset(relax);
+  XCTAssertEqual(MBTRelaxIndexSessionCreate(calibration, 250, 250, &other),
+                 MBTStatusSessionInProgress);
+
+  MBTRelaxIndexSessionRelease(relax);
+  XCTAssertEqual(MBTRelaxIndexSessionCreate(calibration, 250, 250, &other),
+                 MBTStatusOK);
+  MBTRelaxIndexSessionRelease(other);
+  MBTCalibrationRelease(calibration);
+}
+
+/// A session starts without the packets of the previous one, and gives the
+/// values of the session analysis of the libraries.
+- (void)testSessionAnalysisIsTheOneOfTheSession {
+  auto& singleton = MelomindAnalysisSingleton::getInstance();
+  singleton.addAlphaPower(1, 0.1, SP_Vector(2, 1));
+
+  MBTCalibrationRef calibration = restoredCalibration();
+  MBTRelaxIndexSessionRef relax = NULL;
+  XCTAssertEqual(MBTRelaxIndexSessionCreate(calibration, 250, 250, &relax),
+                 MBTStatusOK);
+  MBTCalibrationRelease(calibration);
+
+  int32_t count = -1;
+  XCTAssertEqual(MBTRelaxIndexSessionGetHistory(relax,
+                                                MBTRelaxIndexHistoryAlphaPowers,
+                                                NULL,
+                                                0,
+                                                &count),
+                 MBTStatusOK);
+  XCTAssertEqual(count, 0);
+
+  singleton.addAlphaPower(2, 0.2, SP_Vector(2, 1));
+  singleton.addAlphaPower(4, 0.3, SP_Vector(2, 0.5));
+  const MBTRelaxIndexHistory histories[] = {
+    MBTRelaxIndexHistoryAlphaPowers,
+    MBTRelaxIndexHistoryRelativeAlphaPowers,
+    MBTRelaxIndexHistoryQualities
+  };
+  const SP_FloatVector expected[] = {
+    singleton.getSessionAlphaPowers(),
+    singleton.getSessionRelativeAlphaPowers(),
+    singleton.getSessionQualities()
+  };
+  for (int i = 0; i < 3; ++i) {
+    float values[4] = { kUntouched, kUntouched, kUntouched, kUntouched };
+    XCTAssertEqual(MBTRelaxIndexSessionGetHistory(relax, histories[i], values, 4, &count),
+                   MBTStatusOK);
+    XCTAssertEqual(count, static_cast<int32_t>(expected[i].size()));
+    XCTAssertTrue(std::equal(expected[i].begin(), expected[i].end(), values));
+  }
+  XCTAssertEqual(expected[0].size(), static_cast<size_t>(2));
+
+  MBTRelaxIndexAnalysis analysis;
+  XCTAssertEqual(MBTRelaxIndexSessionGetAnalysis(relax, NULL),
+                 MBTStatusInvalidArgument);
+  XCTAssertEqual(MBTRelaxIndexSessionGetAnalysis(NULL, &analysis),
+                 MBTStatusInvalidArgument);
+  XCTAssertEqual(MBTRelaxIndexSessionGetAnalysis(relax, &analysis),
+                 MBTStatusOK);
+  XCTAssertEqual(analysis.meanRelativeAlphaPower,
+                 static_cast<float>(singleton.getSessionMeanRelativeAlphaPower()));
+  XCTAssertEqual(analysis.meanAlphaPower,
+                 static_cast<float>(singleton.getSessionMeanAlphaPower()));
+  XCTAssertEqual(analysis.confidence,
+                 static_cast<float>(singleton.getSessionConfidence()));
+
+  MBTRelaxIndexSessionReset(relax);
+  XCTAssertEqual(MBTRelaxIndexSessionGetHistory(relax,
+                                                MBTRelaxIndexHistoryQualities,
+                                                NULL,
+                                                0,
+                                                &count),
+                 MBTStatusOK);
+  XCTAssertEqual(count, 0);
+  MBTRelaxIndexSessionRelease(relax);
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Quality checker
+//----------------------------------------------------------------------------
+
+- (void)testQualitiesNeedOneValuePerChannel {
+  MBTQualitySessionRef session = NULL;
+  XCTAssertEqual(MBTQualitySessionCreate(250, 0.85f, &session), MBTStatusOK);
+  const std::vector<float> data = planarPacket(2, 250);
+  const MBTSignalBuffer packet = MBTSignalBufferMakePlanar(data.data(), 2, 250);
+
+  float qualities[2] = { kUntouched, kUntouched };
+  XCTAssertEqual(MBTQualitySessionCompute(session, &packet, qualities, 1, NULL),
+                 MBTStatusBufferTooSmall);
+  XCTAssertEqual(qualities[0], kUntouched);
+  XCTAssertEqual(MBTQualitySessionCompute(session, &packet, NULL, 2, NULL),
+                 MBTStatusInvalidArgument);
+
+  // the modified data must have the shape of the packet
+  std::vector<float> modified(2 * 249, kUntouched);
+  const MBTMutableSignalBuffer wrongShape =
+    MBTMutableSignalBufferMakePlanar(modified.data(), 2, 249);
+  XCTAssertEqual(MBTQualitySessionCompute(session, &packet, qualities, 2, &wrongShape),
+                 MBTStatusInvalidArgument);
+  XCTAssertEqual(qualities[0], kUntouched);
+  XCTAssertEqual(modified[0], kUntouched);
+
+  XCTAssertEqual(MBTQualitySessionCompute(session, &packet, qualities, 2, NULL),
+                 MBTStatusOK);
+  XCTAssertTrue(qualities[0] != kUntouched);
+  XCTAssertTrue(qualities[1] != kUntouched);
+  MBTQualitySessionRelease(session);
+}
+
+- (void)testStridesGiveTheSameQualities {
+  const int32_t channels = 2;
+  const int32_t samples = 250;
+  const std::vector<float> planar = planarPacket(channels, samples);
+  const std::vector<float> mixed = interleaved(planar, channels, samples);
+
+  MBTQualitySessionRef planarSession = NULL;
+  MBTQualitySessionRef interleavedSession = NULL;
+  XCTAssertEqual(MBTQualitySessionCreate(250, 0.85f, &planarSession), MBTStatusOK);
+  XCTAssertEqual(MBTQualitySessionCreate(250, 0.85f, &interleavedSession),
+                 MBTStatusOK);
+
+  const MBTSignalBuffer planarPacket =
+    MBTSignalBufferMakePlanar(planar.data(), channels, samples);
+  const MBTSignalBuffer interleavedPacket =
+    MBTSignalBufferMakeInterleaved(mixed.data(), channels, samples);
+  std::vector<float> planarModified(channels * samples);
+  std::vector<float> interleavedModified(channels * samples);
+  const MBTMutableSignalBuffer planarOutput =
+    MBTMutableSignalBufferMakePlanar(planarModified.data(), channels, samples);
+  const MBTMutableSignalBuffer interleavedOutput =
+    MBTMutableSignalBufferMakeInterleaved(interleavedModified.data(),
+                                          channels,
+                                          samples);
+
+  float planarQualities[2];
+  float interleavedQualities[2];
+  XCTAssertEqual(MBTQualitySessionCompute(planarSession,
+                                          &planarPacket,
+                                          planarQualities,
+                                          channels,
+                                          &planarOutput),
+                 MBTStatusOK);
+  XCTAssertEqual(MBTQualitySessionCompute(interleavedSession,
+                                          &interleavedPacket,
+                                          interleavedQualities,
+                                          channels,
+                                          &interleavedOutput),
+                 MBTStatusOK);
+
+  for (int32_t channel = 0; channel < channels; ++channel) {
+    XCTAssertEqual(planarQualities[channel], interleavedQualities[channel]);
+  }
+  XCTAssertTrue(interleaved(planarModified, channels, samples)
+                == interleavedModified);
+  MBTQualitySessionRelease(planarSession);
+  MBTQualitySessionRelease(interleavedSession);
+}
+
+@end
@@ -0,0 +1,223 @@
+//
+//  MBTWorkspaceTests.mm
+//  MyBrainTechnologiesSDKTests
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <DataManipulation/MBT_Workspace.h>
+#include <PreProcessing/MBT_PreProcessing.h>
+#include <QualityChecker/MBT_MainQCOperations.h>
+
+/// Reproducible EEG like values around an offset, with outliers for odd
+/// seeds.
+static SP_Vector randomSignal(unsigned int seed, size_t size) {
+  unsigned int state = seed;
+  SP_Vector values;
+  for (size_t i = 0; i < size; ++i) {
+    state = state * 1664525u + 1013904223u;
+    const SP_RealType random = (state >> 8) / 16777216.0;
+    values.push_back(12 + 0.1 * i + 40 * random - 20);
+  }
+  if (seed % 2 == 1) {
+    for (size_t i = seed % 5; i < values.size(); i += 17 + seed % 7) {
+      values[i] = (i % 2 == 0) ? 300 : -300;
+    }
+  }
+  return values;
+}
+
+static SP_FloatVector toFloat(SP_Vector const& values) {
+  return SP_FloatVector(values.begin(), values.end());
+}
+
+/// Lengths of the packets: the usual ones, short ones and odd ones.
+static const size_t signalLengths[] = {2, 3, 4, 5, 17, 100, 250, 255, 256, 257, 500, 512, 777, 1000};
+
+@interface MBTWorkspaceTests : XCTestCase
+@end
+
+@implementation MBTWorkspaceTests
+
+//----------------------------------------------------------------------------
+// MARK: - Same values as the compiled functions
+//----------------------------------------------------------------------------
+
+- (void)testRemoveDCIsRemoveDC {
+  SP_Vector result;
+  SP_FloatVector floatResult;
+  for (size_t length : signalLengths) {
+    for (unsigned int seed = 1; seed <= 4; ++seed) {
+      const SP_Vector data = randomSignal(seed, length);
+      const SP_Vector expected = RemoveDC(data);
+      RemoveDC(data, result);
+      XCTAssertTrue(result == expected, @"length %zu, seed %u", length, seed);
+      SP_Vector inPlace(data);
+      RemoveDC(inPlace, inPlace);
+      XCTAssertTrue(inPlace == expected, @"length %zu, seed %u", length, seed);
+
+      const SP_FloatVector floatData = toFloat(data);
+      RemoveDC(floatData, floatResult);
+      XCTAssertTrue(floatResult == RemoveDC(floatData), @"length %zu, seed %u", length, seed);
+    }
+  }
+}
+
+- (void)testCalculateBoundsIsCalculateBounds {
+  MBT_Workspace workspace(MBT_WorkspaceConfig{1, 250, 0});
+  SP_Vector bounds;
+  SP_FloatVector floatBounds;
+  for (size_t length : signalLengths) {
+    for (unsigned int seed = 1; seed <= 4; ++seed) {
+      const SP_Vector data = randomSignal(seed, length);
+      CalculateBounds(data, bounds, workspace);
+      XCTAssertTrue(bounds == CalculateBounds(data), @"length %zu, seed %u", length, seed);
+
+      const SP_FloatVector floatData = toFloat(data);
+      CalculateBounds(floatData, floatBounds, workspace);
+      XCTAssertTrue(floatBounds == CalculateBounds(floatData), @"length %zu, seed %u", length, seed);
+    }
+  }
+}
+
+- (void)testInterpolateOutliersIsInterpolateOutliers {
+  MBT_Workspace workspace(MBT_WorkspaceConfig{1, 250, 0});
+  SP_Vector bounds;
+  SP_Vector result;
+  for (size_t length : signalLengths) {
+    for (unsigned int seed = 1; seed <= 4; ++seed) {
+      const SP_Vector data = randomSignal(seed, length);
+      CalculateBounds(data, bounds, workspace);
+      const SP_Vector expected = InterpolateOutliers(data, bounds);
+      InterpolateOutliers(data, bounds, result);
+      XCTAssertTrue(result == expected, @"length %zu, seed %u", length, seed);
+      SP_Vector inPlace(data);
+      InterpolateOutliers(inPlace, bounds, inPlace);
+      XCTAssertTrue(inPlace == expected, @"length %zu, seed %u", length, seed);
+    }
+  }
+}
+
+- (void)testDetrendIsDetrend {
+  const SP_RealType rates[] = {250, 500, 333.3};
+  SP_Vector result;
+  for (SP_RealType fs : rates) {
+    for (size_t length : signalLengths) {
+      for (unsigned int seed = 1; seed <= 4; ++seed) {
+        const SP_Vector data = randomSignal(seed, length);
+        const SP_Vector expected = detrend(data, fs);
+        detrend(data, fs, result);
+        XCTAssertTrue(result == expected, @"fs %g, length %zu, seed %u", fs, length, seed);
+        SP_Vector inPlace(data);
+        detrend(inPlace, fs, inPlace);
+        XCTAssertTrue(inPlace == expected, @"fs %g, length %zu, seed %u", fs, length, seed);
+      }
+    }
+  }
+}
+
+/// The vectorized loop of the prebuilt library differs from the fourth value
+/// of the signals of more than 5 samples, see MBT_Workspace.h.
+- (void)testTimeFirstDerivativeIsTimeFirstDerivative {
+  const SP_FloatType rates[] = {250, 500, 333.3f};
+  SP_Vector result;
+  for (SP_FloatType sampRate : rates) {
+    for (size_t length : signalLengths) {
+      for (unsigned int seed = 1; seed <= 4; ++seed) {
+        const SP_Vector data = randomSignal(seed, length);
+        const SP_Vector expected = timeFirstDerivative(data, sampRate);
+        const size_t compared = length <= 5 ? expected.size() : 3;
+        timeFirstDerivative(data, sampRate, result);
+        XCTAssertEqual(result.size(), expected.size(), @"rate %g, length %zu, seed %u", sampRate, length, seed);
+        XCTAssertTrue(std::equal(expected.begin(), expected.begin() + compared, result.begin()),
+                      @"rate %g, length %zu, seed %u", sampRate, length, seed);
+
+        SP_Vector inPlace(data);
+        timeFirstDerivative(inPlace, sampRate, inPlace);
+        XCTAssertTrue(inPlace == result, @"rate %g, length %zu, seed %u", sampRate, length, seed);
+      }
+    }
+  }
+}
+
+/// The derivative of each sample, on a signal whose derivative is known.
+- (void)testTimeFirstDerivativeOfAParabola {
+  SP_Vector data;
+  for (int i = 0; i < 300; ++i) {
+    data.push_back(0.5 * i * i);
+  }
+  SP_Vector result;
+  timeFirstDerivative(data, 1.0f, result);
+  XCTAssertEqual(result.size(), static_cast<size_t>(299));
+  for (size_t i = 0; i < result.size(); ++i) {
+    XCTAssertEqual(result[i], i + 0.5, @"sample %zu", i);
+  }
+}
+
+- (void)testPowerOfTwoWithoutDCIsPowerOfTwoWithoutDC {
+  SP_Vector result;
+  for (size_t length : signalLengths) {
+    for (unsigned int seed = 1; seed <= 4; ++seed) {
+      const SP_Vector data = randomSignal(seed, length);
+      const SP_Vector expected = powerOfTwoWithoutDC(data);
+      powerOfTwoWithoutDC(data, result);
+      XCTAssertTrue(result == expected, @"length %zu, seed %u", length, seed);
+      SP_Vector inPlace(data);
+      powerOfTwoWithoutDC(inPlace, inPlace);
+      XCTAssertTrue(inPlace == expected, @"length %zu, seed %u", length, seed);
+    }
+  }
+}
+
+- (void)testZeroPaddingIsZeroPadding {
+  MBT_Workspace workspace(MBT_WorkspaceConfig{1, 250, 0});
+  for (size_t length : signalLengths) {
+    const SP_Vector data = randomSignal(3, length);
+    SP_Vector expected(data);
+    unsigned int expectedN, expectedNfft, expectedZeros;
+    zeroPadding(expected, expectedN, expectedNfft, expectedZeros);
+
+    unsigned int N, nfft, zeros;
+    SP_Vector& padded = zeroPadding(data, N, nfft, zeros, workspace);
+    XCTAssertTrue(padded == expected, @"length %zu", length);
+    XCTAssertEqual(N, expectedN, @"length %zu", length);
+    XCTAssertEqual(nfft, expectedNfft, @"length %zu", length);
+    XCTAssertEqual(zeros, expectedZeros, @"length %zu", length);
+    XCTAssertEqual(&padded, &workspace.scratch(MBT_Workspace::SCRATCH_COUNT - 1));
+
+    // the padded signal may be padded again
+    zeroPadding(padded, N, nfft, zeros, workspace);
+    XCTAssertTrue(padded == expected, @"length %zu", length);
+    XCTAssertEqual(zeros, 0u, @"length %zu", length);
+  }
+}
+
+//----------------------------------------------------------------------------
+// MARK: - Allocations
+//----------------------------------------------------------------------------
+
+/// Once reserved, zero padding packets uses the buffer of the workspace and
+/// leaves the signal of the caller as it is.
+- (void)testZeroPaddingKeepsTheBuffers {
+  MBT_Workspace workspace(MBT_WorkspaceConfig{1, 250, 0});
+  SP_Vector& padded = workspace.scratch(MBT_Workspace::SCRATCH_COUNT - 1);
+  const SP_RealType* buffer = padded.data();
+  XCTAssertEqual(padded.capacity(), static_cast<size_t>(257));
+
+  for (unsigned int seed = 1; seed <= 10; ++seed) {
+    const SP_Vector data = randomSignal(seed, 250);
+    unsigned int N, nfft, zeros;
+    zeroPadding(data, N, nfft, zeros, workspace);
+    XCTAssertEqual(data.size(), static_cast<size_t>(250), @"seed %u", seed);
+    XCTAssertEqual(padded.size(), static_cast<size_t>(256), @"seed %u", seed);
+    XCTAssertEqual(padded.data(), buffer, @"seed %u", seed);
+  }
+}
+
+@end
@@ -0,0 +1,81 @@
+//
+//  MBTBridgeParameters.h
+//  MyBrainTechnologiesSDK
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#ifndef MBTBridgeParameters_h
+#define MBTBridgeParameters_h
+
+#include "MBTBridgeConstants.h"
+
+#include <DataManipulation/MBT_Matrix.h>
+#include <QualityChecker/MBT_MainQC.h>
+
+#include <vector>
+
+/*******************************************************************************
+ * Parameters of the bridge
+ *
+ * Parameters of the processing of MBTSignalProcessingBridge.mm, shared by the
+ * plain C interface and the command line tools of signalProcessingSDK/tools,
+ * which must compute the same values. The training data of the quality checker
+ * are in MBTBridgeConstants.mm, to be linked as well.
+ *
+ ******************************************************************************/
+
+/// Number of relax indexes averaged to smooth the current one.
+#define SMOOTHINGDURATION 2
+/// Duration of the signal of a relax index, in seconds: the last seconds of
+/// the session, packets included.
+#define RELAX_INDEX_WINDOW_DURATION 4
+/// Bounds of the RMS of the session, relative to the RMS of the calibration.
+#define RMS_MIN_FACTOR 0.9f
+#define RMS_MAX_FACTOR 1.5f
+/// Number of neighbours of the quality checker.
+#define MBT_BRIDGE_QC_KPPV 19
+/// Accuracy of the quality checker of the tools, the applications give theirs.
+#define MBT_BRIDGE_QC_ACCURACY 0.85f
+
+/// Create a quality checker with the training data of the bridge, to be
+/// deleted by the caller.
+inline MBT_MainQC* MBT_createBridgeQualityChecker(
+  float sampRate, float accuracy = MBT_BRIDGE_QC_ACCURACY) {
+  auto costClass = MBT_Matrix<float>(3, 3);
+  for (int t = 0; t < costClass.size().first; t++) {
+    for (int t1 = 0; t1 < costClass.size().second; t1++) {
+      costClass(t, t1) = t == t1 ? 0 : 1;
+    }
+  }
+  auto costClassBad = MBT_Matrix<float>(2, 2);
+  for (int t = 0; t < costClassBad.size().first; t++) {
+    for (int t1 = 0; t1 < costClassBad.size().second; t1++) {
+      costClassBad(t, t1) = t == t1 ? 0 : 1;
+    }
+  }
+  std::vector<std::vector<float>> potTrainingFeatures;
+  std::vector<std::vector<float>> dataClean;
+
+  return new MBT_MainQC(sampRate,
+                        trainingFeatures,
+                        trainingClasses,
+                        w,
+                        mu,
+                        sigma,
+                        MBT_BRIDGE_QC_KPPV,
+                        costClass,
+                        potTrainingFeatures,
+                        dataClean,
+                        spectrumClean,
+                        cleanItakuraDistance,
+                        accuracy,
+                        trainingFeaturesBad,
+                        trainingClassesBad,
+                        wBad,
+                        muBad,
+                        sigmaBad,
+                        costClassBad);
+}
+
+#endif /* MBTBridgeParameters_h */
@@ -62,6 +62,9 @@
 
 @interface MBTRelaxIndexBridge: NSObject
 
+/// Compute the volume of the last packet of the session: the relax index is
+/// computed on the last 4 seconds of the packets received since the session
+/// started, the packet included.
 + (float)computeRelaxIndex:(NSArray*)signal
                   sampRate:(NSInteger)sampRate
                 nbChannels:(NSInteger)nbChannels
@@ -104,4 +107,33 @@
 
 @end
 
+/*******************************************************************************
+* MBTInstrumentationBridge
+*
+* Bridge methods for the timers and counters of the processing stages, only
+* recorded when the SDK is built with SP_ENABLE_INSTRUMENTATION, and for the
+* latencies of the current session, always recorded.
+*
+*******************************************************************************/
+
+@interface MBTInstrumentationBridge: NSObject
+
++ (BOOL)isCompiled;
+
++ (void)setTracing:(BOOL)isEnabled;
+
++ (void)reset;
+
++ (NSDictionary*)snapshot;
+
++ (NSString*)chromeTrace;
+
++ (NSDictionary*)sessionLatency;
+
++ (void)setLatencyBudget:(double)milliseconds;
+
++ (void)resetSessionLatency;
+
+@end
+
 #endif /* MBTSignalProcessingBridge_h */
@@ -7,10 +7,11 @@
 //
 
 #import "MBTSignalProcessingBridge.h"
-#import "MBTBridgeConstants.h"
+#import "MBTBridgeParameters.h"
 
 #include <DataManipulation/MBT_Matrix.h>
 #include <DataManipulation/MBT_ReadInputOrWriteOutput.h>
+#include <DataManipulation/MBT_RingBuffer.h>
 #include <Transformations/MBT_PWelchComputer.h>
 #include <Algebra/MBT_Operations.h>
 #include <Algebra/MBT_FindClosest.h>
@@ -27,13 +28,23 @@
 #include <NF_Melomind/MBT_ComputeIAF.h>
 #include <NF_Melomind/Utils.h>
 #include <NF_Melomind/MBT_NFConfig.h>
+#include <NF_Melomind/MBT_NFResults.h>
 #include <NF_Melomind/MelomindAnalysisSingleton.h>
 #include <SNR/MBT_SNR_Stats.h>
 #include <QualityChecker/MBT_MainQC.h>
 
 #include <mbtsdk-version.h>
+#include <sp-instrumentation.h>
+#include <sp-latency.h>
 
-#define SMOOTHINGDURATION 2
+#include <algorithm>
+#include <memory>
+#include <sstream>
+
+/// Latencies of the quality checker and of the relax index of the current
+/// session, always recorded. Cleared when a session starts (reinitRelaxIndex
+/// or MBTMelomindAnalysis resetSession), the budget is kept.
+static MBT_SessionLatency sessionLatency;
 
 //==============================================================================
 // MARK: - MBTSignalProcessingHelper
@@ -52,15 +63,15 @@ extern const float IAFsup;
                                 andWidth:(int)width;
 + (std::vector<float>)fromNSArraytoVector:(NSArray *)array;
 + (void)setCalibrationParameters:
-(std::map<std::string, std::vector<float>>) calibParameters;
-+ (std::map<std::string, std::vector<float>>)getCalibrationParameters;
+(const std::map<std::string, std::vector<float>>&) calibParameters;
++ (const MBT_SessionCalibration&)getSessionCalibration;
 
 @end
 
 @implementation MBTSignalProcessingHelper
 static NSString* versionCPP = @MBT_SDK_VERSION;
 
-static std::map<std::string, std::vector<float>> calibParams;
+static MBT_SessionCalibration sessionCalibration;
 
 /// Converte *vector* to an Objective-C NSArray.
 + (NSArray*)fromVectorToNSArray:(std::vector<float>) vector {
@@ -113,13 +124,19 @@ static std::map<std::string, std::vector<float>> calibParams;
   return vector;
 }
 
+/// Build the session calibration once, so that relax index computations
+/// do not rebuild the calibration dictionnary every second. The compiled
+/// relax index still copies it into its by-value parameter at each call.
 + (void) setCalibrationParameters:
-(std::map<std::string, std::vector<float>>)calibParameters {
-  calibParams = calibParameters;
+(const std::map<std::string, std::vector<float>>&)calibParameters {
+  sessionCalibration =
+  MBT_SessionCalibration(MBT_CalibrationResult::fromMap(calibParameters),
+                         RMS_MIN_FACTOR,
+                         RMS_MAX_FACTOR);
 }
 
-+ (std::map<std::string, std::vector<float>>)getCalibrationParameters {
-  return calibParams;
++ (const MBT_SessionCalibration&)getSessionCalibration {
+  return sessionCalibration;
 }
 
 @end
@@ -135,59 +152,7 @@ static MBT_MainQC *mainQC;
 
 /// Initialize Main_QC, and save it.
 + (void)initializeMainQualityChecker:(float)sampRate accuracy:(float)accuracy {
-  // Construction de kppv
-  unsigned int kppv = 19;
-
-  // Construction de costClass
-  auto costClass = MBT_Matrix<float>(3, 3);
-  for (int t = 0; t < costClass.size().first;t++) {
-    for (int t1 = 0; t1 < costClass.size().second; t1++) {
-      if (t == t1) {
-        costClass(t, t1) = 0;
-      } else {
-        costClass(t, t1) = 1;
-      }
-    }
-  }
-
-  // Construction de costClassBad
-  auto costClassBad = MBT_Matrix<float>(2, 2);
-  for (int t = 0; t < costClassBad.size().first; t++) {
-    for (int t1 = 0; t1 < costClassBad.size().second; t1++) {
-      if (t == t1) {
-        costClassBad(t, t1) = 0;
-      } else {
-        costClassBad(t, t1) = 1;
-      }
-    }
-  }
-
-  // Construction de potTrainingFeatures
-  std::vector<std::vector<float>> potTrainingFeatures;
-
-  // Construction de dataClean
-  std::vector<std::vector<float>> dataClean;
-
-  // Init of Main_QC.
-  mainQC = new MBT_MainQC(sampRate,
-                          trainingFeatures,
-                          trainingClasses,
-                          w,
-                          mu,
-                          sigma,
-                          kppv,
-                          costClass,
-                          potTrainingFeatures,
-                          dataClean,
-                          spectrumClean,
-                          cleanItakuraDistance,
-                          accuracy,
-                          trainingFeaturesBad,
-                          trainingClassesBad,
-                          wBad,
-                          muBad,
-                          sigmaBad,
-                          costClassBad);
+  mainQC = MBT_createBridgeQualityChecker(sampRate, accuracy);
 }
 
 /// Dealloc MBT_MainQC instance when session is finished, for memory safety.
@@ -208,7 +173,11 @@ static MBT_MainQC *mainQC;
                                         andWidth:(int)packetLength];
 
   // Compute Quality
-  mainQC->MBT_ComputeQuality(signalMatrix);
+  {
+    SP_SCOPED_STAGE(SP_STAGE_QUALITY);
+    MBT_ScopedLatency latency(sessionLatency.quality);
+    mainQC->MBT_ComputeQuality(signalMatrix);
+  }
 
   // Getting the qualities in a cpp format
   std::vector<float> qualities = mainQC->MBT_get_m_quality();
@@ -258,12 +227,17 @@ static MBT_MainQC *mainQC;
                                         andWidth: static_cast<int>(packetCount)];
 
   // Getting the map.
-  auto iafMedian = MBT_ComputeIAFCalibration(calibrationRecordings,
-                                             calibrationRecordingsQuality,
-                                             sampleRate,
-                                             static_cast<int>(packetLength),
-                                             IAFinf,
-                                             IAFsup);
+  SP_SCOPED_STAGE(SP_STAGE_CALIBRATION);
+  std::vector<float> iafMedian;
+  {
+    SP_SCOPED_STAGE(SP_STAGE_IAF);
+    iafMedian = MBT_ComputeIAFCalibration(calibrationRecordings,
+                                          calibrationRecordingsQuality,
+                                          sampleRate,
+                                          static_cast<int>(packetLength),
+                                          IAFinf,
+                                          IAFsup);
+  }
 
   auto paramCalib = MBT_ComputeCalibration(calibrationRecordings,
                                            calibrationRecordingsQuality,
@@ -272,7 +246,7 @@ static MBT_MainQC *mainQC;
                                            iafMedian[0],
                                            iafMedian[1],
                                            SMOOTHINGDURATION);
-  paramCalib["iafCalib"] = iafMedian;
+  paramCalib[MBT_IAF_CALIBRATION_KEY] = iafMedian;
 
   // Save calibration parameters received.
   [MBTSignalProcessingHelper setCalibrationParameters: paramCalib];
@@ -306,46 +280,82 @@ static vector<float>smoothedRelaxIndex;
 static vector<float>volume;
 static vector<float>histFreq;
 
+/// Signal of the session, the relax index is computed on its last
+/// RELAX_INDEX_WINDOW_DURATION seconds. Emptied with the relax index.
+static std::unique_ptr<MBT_RingBuffer<float>> relaxIndexHistory;
+/// Window of the history given to the libraries, recreated only when its shape
+/// changes.
+static std::unique_ptr<MBT_Matrix<float>> relaxIndexWindow;
+
+/// Push the packet into the history and copy its last seconds into
+/// relaxIndexWindow.
+static const MBT_Matrix<float>& relaxIndexWindowOf(
+  const MBT_Matrix<float>& packet, NSInteger sampRate) {
+  const unsigned int channels = packet.size().first;
+  const size_t packetLength = packet.size().second;
+  const size_t windowLength = RELAX_INDEX_WINDOW_DURATION * sampRate;
+  if (!relaxIndexHistory
+      || relaxIndexHistory->channels() != channels
+      || relaxIndexHistory->capacity() < windowLength + packetLength) {
+    relaxIndexHistory.reset(
+      new MBT_RingBuffer<float>(channels, windowLength + packetLength));
+  }
+  relaxIndexHistory->push(packet);
+
+  const auto window = relaxIndexHistory->latest(
+    std::min(windowLength, relaxIndexHistory->available()));
+  if (!relaxIndexWindow
+      || relaxIndexWindow->size().first != static_cast<int>(channels)
+      || relaxIndexWindow->size().second != static_cast<int>(window.size())) {
+    relaxIndexWindow.reset(
+      new MBT_Matrix<float>(channels, static_cast<int>(window.size())));
+  }
+  window.copyTo(*relaxIndexWindow);
+  // the samples before the window will not be read again
+  relaxIndexHistory->release(window.start());
+  return *relaxIndexWindow;
+}
+
 + (float)computeRelaxIndex:(NSArray*)signal
                   sampRate:(NSInteger)sampRate
                 nbChannels:(NSInteger)nbChannels
        lastPacketQualities:(NSArray*)lastPacketQualities {
+  const auto received = MBT_LatencyHistogram::Clock::now();
   const unsigned int packetLength = static_cast<int>(signal.count / nbChannels);
 
-  auto signalMatrix =
-  [MBTSignalProcessingHelper fromNSArrayToMatrix: signal
-                                       andHeight: static_cast<int>(nbChannels)
-                                        andWidth: packetLength];
+  const auto& signalMatrix = relaxIndexWindowOf(
+    [MBTSignalProcessingHelper fromNSArrayToMatrix: signal
+                                         andHeight: static_cast<int>(nbChannels)
+                                          andWidth: packetLength],
+    sampRate);
 
-  auto calibrationParams = [MBTSignalProcessingHelper getCalibrationParameters];
+  const auto& calibration = [MBTSignalProcessingHelper getSessionCalibration];
 
   if (histFreq.size() == 0) {
-    histFreq = calibrationParams["histFrequencies"];
+    histFreq = calibration.result().histFreq;
   }
 
   const auto sampleRate = static_cast<float>(sampRate);
   const auto smoothingDuration = SMOOTHINGDURATION;
   const auto bufferSize = 1;
+  const auto windowLength =
+  static_cast<unsigned int>(signalMatrix.size().second);
   const auto configuration =
-  MBT_NFConfig { sampleRate, packetLength, smoothingDuration, bufferSize };
-
-  const auto minFactor = 0.9f;
-  const auto maxFactor = 1.5f;
-  const auto minMaxRmsCalibration = computeMinMax(calibrationParams["snrCalib"],
-                                    minFactor,
-                                    maxFactor);
+  MBT_NFConfig { sampleRate, windowLength, smoothingDuration, bufferSize };
 
   const auto lastPacketQualitiesVector =
   [MBTSignalProcessingHelper fromNSArraytoVector: lastPacketQualities];
 
+  const auto relaxIndexStart = MBT_LatencyHistogram::Clock::now();
   const auto newVolum = main_relaxIndex(configuration,
-                                        calibrationParams,
+                                        calibration,
                                         signalMatrix,
                                         pastRelaxIndex,
                                         smoothedRelaxIndex,
                                         volume,
-                                        minMaxRmsCalibration,
                                         lastPacketQualitiesVector);
+  sessionLatency.relaxIndex.recordSince(relaxIndexStart);
+  sessionLatency.recordPacketToVolume(received);
   return newVolum;
 }
 
@@ -371,6 +381,10 @@ static vector<float>histFreq;
   smoothedRelaxIndex.clear();
   volume.clear();
   histFreq.clear();
+  if (relaxIndexHistory) {
+    relaxIndexHistory->reset();
+  }
+  sessionLatency.reset();
 }
 
 @end
@@ -413,6 +427,11 @@ static vector<float>histFreq;
 
 + (void)resetSession {
   MelomindAnalysisSingleton::getInstance().resetSession();
+  // the signal of the previous session is not in the windows of this one
+  if (relaxIndexHistory) {
+    relaxIndexHistory->reset();
+  }
+  sessionLatency.reset();
 }
 
 + (float)sessionMeanAlphaPower {
@@ -447,3 +466,86 @@ static vector<float>histFreq;
 }
 
 @end
+
+//==============================================================================
+// MARK: - MBTInstrumentationBridge
+//==============================================================================
+
+@implementation MBTInstrumentationBridge
+
++ (BOOL)isCompiled {
+  return SP_INSTRUMENTATION_COMPILED;
+}
+
++ (void)setTracing:(BOOL)isEnabled {
+  MBT_Instrumentation::setTracing(isEnabled);
+}
+
++ (void)reset {
+  MBT_Instrumentation::reset();
+}
+
+/// Counters of each stage, by stage name.
++ (NSDictionary*)snapshot {
+  NSMutableDictionary* stages = [[NSMutableDictionary alloc] init];
+
+  for (const auto& stage: MBT_Instrumentation::snapshot()) {
+    NSDictionary* counters = @{
+      @"calls": @(stage.calls),
+      @"totalNs": @(stage.totalNs),
+      @"maxNs": @(stage.maxNs),
+      @"bytes": @(stage.bytes),
+      @"allocations": @(stage.allocations),
+      @"allocatedBytes": @(stage.allocatedBytes)
+    };
+    [stages setObject: counters forKey: @(stage.name)];
+  }
+  return stages;
+}
+
+/// Percentiles in nanoseconds of a latency histogram.
++ (NSDictionary*)latencyPercentiles:(const MBT_LatencyHistogram&)histogram {
+  MBT_LatencySnapshot snapshot;
+  histogram.snapshot(snapshot);
+
+  return @{
+    @"count": @(snapshot.count),
+    @"meanNs": @(snapshot.mean()),
+    @"p50Ns": @(snapshot.percentile(50)),
+    @"p90Ns": @(snapshot.percentile(90)),
+    @"p99Ns": @(snapshot.percentile(99)),
+    @"p999Ns": @(snapshot.percentile(99.9)),
+    @"maxNs": @(snapshot.max)
+  };
+}
+
+/// Latencies of the current session: quality checker, relax index and delay
+/// from a packet to its volume, with the packets over the budget.
++ (NSDictionary*)sessionLatency {
+  return @{
+    @"quality": [self latencyPercentiles: sessionLatency.quality],
+    @"relaxIndex": [self latencyPercentiles: sessionLatency.relaxIndex],
+    @"packetToVolume": [self latencyPercentiles: sessionLatency.packetToVolume],
+    @"budgetNs": @(sessionLatency.budget()),
+    @"overBudget": @(sessionLatency.overBudget())
+  };
+}
+
+/// Longest acceptable delay from a packet to its volume, 0 for none.
++ (void)setLatencyBudget:(double)milliseconds {
+  const double nanoseconds = milliseconds > 0 ? milliseconds * 1e6 : 0;
+  sessionLatency.setBudget(static_cast<uint64_t>(nanoseconds));
+}
+
++ (void)resetSessionLatency {
+  sessionLatency.reset();
+}
+
+/// Recorded events in the Trace Event format of chrome://tracing and Perfetto.
++ (NSString*)chromeTrace {
+  std::ostringstream trace;
+  MBT_Instrumentation::writeChromeTrace(trace);
+  return [NSString stringWithUTF8String: trace.str().c_str()];
+}
+
+@end
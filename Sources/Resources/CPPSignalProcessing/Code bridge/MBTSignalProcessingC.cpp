@@ -0,0 +1,620 @@
+//
+//  MBTSignalProcessingC.cpp
+//  MyBrainTechnologiesSDK
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#include "MBTSignalProcessingC.h"
+#include "MBTBridgeParameters.h"
+
+#include <DataManipulation/MBT_Matrix.h>
+#include <DataManipulation/MBT_RawFrameDecoder.h>
+
+#include <NF_Melomind/MBT_ComputeCalibration.h>
+#include <NF_Melomind/MBT_ComputeIAFCalibration.h>
+#include <NF_Melomind/MBT_NFConfig.h>
+#include <NF_Melomind/MBT_NFResults.h>
+#include <NF_Melomind/MelomindAnalysisSingleton.h>
+#include <NF_Melomind/Utils.h>
+#include <QualityChecker/MBT_MainQC.h>
+
+#include <mbtsdk-version.h>
+#include <sp-instrumentation.h>
+
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// MARK: - Sessions
+//==============================================================================
+
+struct MBTQualitySession {
+  MBT_MainQC* mainQC;
+  /// Packet gathered from the caller buffer, reused while the shape is the same.
+  std::unique_ptr<MBT_Matrix<float>> packet;
+};
+
+struct MBTRawFrameDecoder {
+  MBTRawFrameDecoder(unsigned int channels, MBT_LostFrameFill fill)
+  : decoder(channels, MBT_RAW_UNIT_VOLT, fill) {}
+
+  MBT_RawFrameDecoder decoder;
+};
+
+struct MBTCalibration {
+  std::map<std::string, std::vector<float>> parameters;
+  /// Names of the parameters, in the order of MBTCalibrationParameterName.
+  std::vector<std::string> names;
+};
+
+struct MBTRelaxIndexSession {
+  MBTRelaxIndexSession(const MBT_SessionCalibration& sessionCalibration,
+                       const MBT_NFConfig& nfConfig)
+  : calibration(sessionCalibration), configuration(nfConfig) {}
+
+  const MBT_SessionCalibration calibration;
+  const MBT_NFConfig configuration;
+  std::unique_ptr<MBT_Matrix<float>> packet;
+  std::vector<float> qualities;
+  std::vector<float> pastRelaxIndex;
+  std::vector<float> smoothedRelaxIndex;
+  std::vector<float> volume;
+};
+
+//==============================================================================
+// MARK: - Helpers
+//==============================================================================
+
+namespace {
+
+/// Held by the functions which call the libraries, whose global state is
+/// shared by all the sessions.
+std::mutex& libraryMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// Number of relax index sessions not released, at most 1 as they share the
+/// session analysis of MelomindAnalysisSingleton. Guarded by libraryMutex.
+int& liveRelaxIndexSessions() {
+  static int count = 0;
+  return count;
+}
+
+bool isValid(const MBTSignalBuffer* buffer) {
+  return buffer != NULL && buffer->data != NULL
+    && buffer->channels > 0 && buffer->samples > 0;
+}
+
+/// Copy a caller buffer into a matrix of the same shape, one row per channel.
+void gather(const MBTSignalBuffer& buffer, MBT_Matrix<float>& matrix) {
+  for (int32_t channel = 0; channel < buffer.channels; channel++) {
+    const float* source = buffer.data + channel * buffer.channelStride;
+    float* row = matrix.rowData(channel);
+    if (buffer.sampleStride == 1) {
+      std::copy(source, source + buffer.samples, row);
+    } else {
+      for (int32_t sample = 0; sample < buffer.samples; sample++) {
+        row[sample] = source[sample * buffer.sampleStride];
+      }
+    }
+  }
+}
+
+/// Copy a caller buffer into the packet of a session, only reallocated when
+/// the shape changes.
+const MBT_Matrix<float>& gather(const MBTSignalBuffer& buffer,
+                                std::unique_ptr<MBT_Matrix<float>>& packet) {
+  if (!packet
+      || packet->size().first != buffer.channels
+      || packet->size().second != buffer.samples) {
+    packet.reset(new MBT_Matrix<float>(buffer.channels, buffer.samples));
+  }
+  gather(buffer, *packet);
+  return *packet;
+}
+
+/// Copy a matrix into a caller buffer of the same shape.
+void scatter(const MBT_Matrix<float>& matrix,
+             const MBTMutableSignalBuffer& buffer) {
+  for (int32_t channel = 0; channel < buffer.channels; channel++) {
+    const float* row = matrix.rowData(channel);
+    float* destination = buffer.data + channel * buffer.channelStride;
+    for (int32_t sample = 0; sample < buffer.samples; sample++) {
+      destination[sample * buffer.sampleStride] = row[sample];
+    }
+  }
+}
+
+/// Copy a vector into a caller array, giving the required count.
+template <typename T>
+MBTStatus copyValues(const std::vector<T>& vector,
+                     float* values,
+                     int32_t capacity,
+                     int32_t* count) {
+  if (count == NULL || (values == NULL && capacity > 0)) {
+    return MBTStatusInvalidArgument;
+  }
+  *count = static_cast<int32_t>(vector.size());
+  if (capacity < *count) {
+    return MBTStatusBufferTooSmall;
+  }
+  std::copy(vector.begin(), vector.end(), values);
+  return MBTStatusOK;
+}
+
+void updateNames(MBTCalibration& calibration) {
+  calibration.names.clear();
+  for (const auto& parameter: calibration.parameters) {
+    calibration.names.push_back(parameter.first);
+  }
+}
+
+} // namespace
+
+//==============================================================================
+// MARK: - General
+//==============================================================================
+
+const char* MBTSignalProcessingVersion(void) {
+  return MBT_SDK_VERSION;
+}
+
+const char* MBTStatusDescription(MBTStatus status) {
+  switch (status) {
+    case MBTStatusOK:
+      return "ok";
+    case MBTStatusInvalidArgument:
+      return "invalid argument";
+    case MBTStatusBufferTooSmall:
+      return "output buffer too small";
+    case MBTStatusNotCalibrated:
+      return "no calibration";
+    case MBTStatusFailure:
+      return "processing failure";
+    case MBTStatusSessionInProgress:
+      return "relax index session in progress";
+  }
+  return "unknown status";
+}
+
+//==============================================================================
+// MARK: - Raw EEG decoding
+//==============================================================================
+
+MBTStatus MBTDecodeRawSamples(const uint8_t* bytes,
+                              int32_t size,
+                              int32_t channels,
+                              float* planar,
+                              int32_t capacity,
+                              int32_t* samples) {
+  if (bytes == NULL || size < 0 || channels <= 0 || samples == NULL
+      || capacity < 0 || (planar == NULL && capacity > 0)) {
+    return MBTStatusInvalidArgument;
+  }
+  try {
+    const MBT_RawFrameDecoder decoder(static_cast<unsigned int>(channels));
+    const size_t decoded = decoder.samplesIn(static_cast<size_t>(size));
+    *samples = static_cast<int32_t>(decoded);
+    if (static_cast<size_t>(capacity) < decoded * channels) {
+      return MBTStatusBufferTooSmall;
+    }
+    decoder.decode(bytes, static_cast<size_t>(size), planar, decoded);
+    return MBTStatusOK;
+  } catch (...) {
+    return MBTStatusFailure;
+  }
+}
+
+MBTStatus MBTRawFrameDecoderCreate(int32_t channels,
+                                   MBTLostFrameFill fill,
+                                   MBTRawFrameDecoderRef* decoder) {
+  if (decoder == NULL || channels <= 0
+      || (fill != MBTLostFrameFillBytes && fill != MBTLostFrameFillNaN)) {
+    return MBTStatusInvalidArgument;
+  }
+  *decoder = new (std::nothrow) MBTRawFrameDecoder(
+    static_cast<unsigned int>(channels),
+    fill == MBTLostFrameFillNaN ? MBT_LOST_FRAME_FILL_NAN
+                                : MBT_LOST_FRAME_FILL_BYTES);
+  return *decoder != NULL ? MBTStatusOK : MBTStatusFailure;
+}
+
+void MBTRawFrameDecoderRelease(MBTRawFrameDecoderRef decoder) {
+  delete decoder;
+}
+
+MBTStatus MBTRawFrameDecoderDecodeFrames(MBTRawFrameDecoderRef decoder,
+                                         const uint8_t* frames,
+                                         int32_t frameCount,
+                                         int32_t frameSize,
+                                         float* planar,
+                                         int32_t capacity,
+                                         int32_t* samples) {
+  if (decoder == NULL || frames == NULL || frameCount < 0
+      || frameSize <= MBT_RawFrameDetail::INDEX_BYTES || samples == NULL
+      || capacity < 0 || (planar == NULL && capacity > 0)) {
+    return MBTStatusInvalidArgument;
+  }
+  try {
+    const size_t count = static_cast<size_t>(frameCount);
+    const size_t size = static_cast<size_t>(frameSize);
+    const size_t decoded = decoder->decoder.samplesInFrames(frames, count, size);
+    *samples = static_cast<int32_t>(decoded);
+    if (static_cast<size_t>(capacity) < decoded * decoder->decoder.channels()) {
+      return MBTStatusBufferTooSmall;
+    }
+    decoder->decoder.decodeFrames(frames, count, size, planar, decoded);
+    return MBTStatusOK;
+  } catch (...) {
+    return MBTStatusFailure;
+  }
+}
+
+void MBTRawFrameDecoderReset(MBTRawFrameDecoderRef decoder) {
+  if (decoder != NULL) {
+    decoder->decoder.reset();
+  }
+}
+
+//==============================================================================
+// MARK: - Quality checker
+//==============================================================================
+
+MBTStatus MBTQualitySessionCreate(float sampRate,
+                                  float accuracy,
+                                  MBTQualitySessionRef* session) {
+  if (session == NULL || !(sampRate > 0)) {
+    return MBTStatusInvalidArgument;
+  }
+  try {
+    std::lock_guard<std::mutex> lock(libraryMutex());
+    MBTQualitySession* created = new MBTQualitySession();
+    created->mainQC = NULL;
+    try {
+      created->mainQC = MBT_createBridgeQualityChecker(sampRate, accuracy);
+    } catch (...) {
+      delete created;
+      throw;
+    }
+    *session = created;
+    return MBTStatusOK;
+  } catch (...) {
+    return MBTStatusFailure;
+  }
+}
+
+void MBTQualitySessionRelease(MBTQualitySessionRef session) {
+  if (session != NULL) {
+    std::lock_guard<std::mutex> lock(libraryMutex());
+    delete session->mainQC;
+    delete session;
+  }
+}
+
+MBTStatus MBTQualitySessionCompute(MBTQualitySessionRef session,
+                                   const MBTSignalBuffer* packet,
+                                   float* qualities,
+                                   int32_t qualitiesCapacity,
+                                   const MBTMutableSignalBuffer* modifiedData) {
+  if (session == NULL || !isValid(packet) || qualities == NULL) {
+    return MBTStatusInvalidArgument;
+  }
+  if (modifiedData != NULL
+      && (modifiedData->data == NULL
+          || modifiedData->channels != packet->channels
+          || modifiedData->samples != packet->samples)) {
+    return MBTStatusInvalidArgument;
+  }
+  if (qualitiesCapacity < packet->channels) {
+    return MBTStatusBufferTooSmall;
+  }
+  try {
+    const auto& signalMatrix = gather(*packet, session->packet);
+    std::lock_guard<std::mutex> lock(libraryMutex());
+    {
+      SP_SCOPED_STAGE(SP_STAGE_QUALITY);
+      session->mainQC->MBT_ComputeQuality(signalMatrix);
+    }
+
+    const std::vector<float> computed = session->mainQC->MBT_get_m_quality();
+    if (static_cast<int32_t>(computed.size()) > qualitiesCapacity) {
+      return MBTStatusBufferTooSmall;
+    }
+    if (modifiedData != NULL) {
+      const MBT_Matrix<float> modified = session->mainQC->MBT_get_m_inputData();
+      if (modified.size().first != modifiedData->channels
+          || modified.size().second != modifiedData->samples) {
+        return MBTStatusFailure;
+      }
+      scatter(modified, *modifiedData);
+    }
+    std::copy(computed.begin(), computed.end(), qualities);
+    return MBTStatusOK;
+  } catch (...) {
+    return MBTStatusFailure;
+  }
+}
+
+//==============================================================================
+// MARK: - Calibration
+//==============================================================================
+
+MBTStatus MBTCalibrationCreate(MBTCalibrationRef* calibration) {
+  if (calibration == NULL) {
+    return MBTStatusInvalidArgument;
+  }
+  *calibration = new (std::nothrow) MBTCalibration();
+  return *calibration != NULL ? MBTStatusOK : MBTStatusFailure;
+}
+
+void MBTCalibrationRelease(MBTCalibrationRef calibration) {
+  delete calibration;
+}
+
+MBTStatus MBTCalibrationCompute(MBTCalibrationRef calibration,
+                                const MBTSignalBuffer* recordings,
+                                const MBTSignalBuffer* qualities,
+                                int32_t packetLength,
+                                float sampRate) {
+  if (calibration == NULL || !isValid(recordings) || !isValid(qualities)
+      || packetLength <= 0 || !(sampRate > 0)
+      || qualities->channels != recordings->channels
+      || qualities->samples != recordings->samples / packetLength) {
+    return MBTStatusInvalidArgument;
+  }
+  try {
+    auto calibrationRecordings =
+    MBT_Matrix<float>(recordings->channels, recordings->samples);
+    auto calibrationRecordingsQuality =
+    MBT_Matrix<float>(qualities->channels, qualities->samples);
+    gather(*recordings, calibrationRecordings);
+    gather(*qualities, calibrationRecordingsQuality);
+
+    std::lock_guard<std::mutex> lock(libraryMutex());
+    SP_SCOPED_STAGE(SP_STAGE_CALIBRATION);
+    std::vector<float> iafMedian;
+    {
+      SP_SCOPED_STAGE(SP_STAGE_IAF);
+      iafMedian = MBT_ComputeIAFCalibration(calibrationRecordings,
+                                            calibrationRecordingsQuality,
+                                            sampRate,
+                                            packetLength,
+                                            IAFinf,
+                                            IAFsup);
+    }
+    if (iafMedian.size() < 2) {
+      return MBTStatusFailure;
+    }
+
+    auto paramCalib = MBT_ComputeCalibration(calibrationRecordings,
+                                             calibrationRecordingsQuality,
+                                             sampRate,
+                                             packetLength,
+                                             iafMedian[0],
+                                             iafMedian[1],
+                                             SMOOTHINGDURATION);
+    paramCalib[MBT_IAF_CALIBRATION_KEY] = iafMedian;
+
+    calibration->parameters.swap(paramCalib);
+    updateNames(*calibration);
+    return MBTStatusOK;
+  } catch (...) {
+    return MBTStatusFailure;
+  }
+}
+
+int32_t MBTCalibrationParameterCount(MBTCalibrationRef calibration) {
+  return calibration != NULL
+    ? static_cast<int32_t>(calibration->names.size())
+    : 0;
+}
+
+const char* MBTCalibrationParameterName(MBTCalibrationRef calibration,
+                                        int32_t index) {
+  if (calibration == NULL || index < 0
+      || index >= static_cast<int32_t>(calibration->names.size())) {
+    return NULL;
+  }
+  return calibration->names[index].c_str();
+}
+
+MBTStatus MBTCalibrationGetParameter(MBTCalibrationRef calibration,
+                                     const char* name,
+                                     float* values,
+                                     int32_t capacity,
+                                     int32_t* count) {
+  if (calibration == NULL || name == NULL) {
+    return MBTStatusInvalidArgument;
+  }
+  try {
+    const auto parameter = calibration->parameters.find(name);
+    if (parameter == calibration->parameters.end()) {
+      return MBTStatusInvalidArgument;
+    }
+    return copyValues(parameter->second, values, capacity, count);
+  } catch (...) {
+    return MBTStatusFailure;
+  }
+}
+
+MBTStatus MBTCalibrationSetParameter(MBTCalibrationRef calibration,
+                                     const char* name,
+                                     const float* values,
+                                     int32_t count) {
+  if (calibration == NULL || name == NULL || count < 0
+      || (values == NULL && count > 0)) {
+    return MBTStatusInvalidArgument;
+  }
+  try {
+    calibration->parameters[name].assign(values, values + count);
+    updateNames(*calibration);
+    return MBTStatusOK;
+  } catch (...) {
+    return MBTStatusFailure;
+  }
+}
+
+//==============================================================================
+// MARK: - Relax index
+//==============================================================================
+
+MBTStatus MBTRelaxIndexSessionCreate(MBTCalibrationRef calibration,
+                                     float sampRate,
+                                     int32_t packetLength,
+                                     MBTRelaxIndexSessionRef* session) {
+  if (calibration == NULL || session == NULL || !(sampRate > 0)
+      || packetLength <= 0) {
+    return MBTStatusInvalidArgument;
+  }
+  try {
+    std::lock_guard<std::mutex> lock(libraryMutex());
+    if (liveRelaxIndexSessions() > 0) {
+      return MBTStatusSessionInProgress;
+    }
+    const auto result = MBT_CalibrationResult::fromMap(calibration->parameters);
+    if (result.smoothedRms.empty()) {
+      return MBTStatusNotCalibrated;
+    }
+    const auto sessionCalibration =
+    MBT_SessionCalibration(result, RMS_MIN_FACTOR, RMS_MAX_FACTOR);
+    const auto configuration =
+    MBT_NFConfig { sampRate,
+                   static_cast<unsigned int>(packetLength),
+                   SMOOTHINGDURATION,
+                   1 };
+
+    *session = new MBTRelaxIndexSession(sessionCalibration, configuration);
+    MelomindAnalysisSingleton::getInstance().resetSession();
+    liveRelaxIndexSessions()++;
+    return MBTStatusOK;
+  } catch (...) {
+    return MBTStatusFailure;
+  }
+}
+
+void MBTRelaxIndexSessionRelease(MBTRelaxIndexSessionRef session) {
+  if (session != NULL) {
+    std::lock_guard<std::mutex> lock(libraryMutex());
+    liveRelaxIndexSessions()--;
+    delete session;
+  }
+}
+
+MBTStatus MBTRelaxIndexSessionCompute(MBTRelaxIndexSessionRef session,
+                                      const MBTSignalBuffer* packet,
+                                      const float* qualities,
+                                      int32_t qualitiesCount,
+                                      float* volume) {
+  if (session == NULL || !isValid(packet) || volume == NULL
+      || qualitiesCount < 0 || (qualities == NULL && qualitiesCount > 0)) {
+    return MBTStatusInvalidArgument;
+  }
+  try {
+    const auto& signalMatrix = gather(*packet, session->packet);
+    session->qualities.assign(qualities, qualities + qualitiesCount);
+
+    std::lock_guard<std::mutex> lock(libraryMutex());
+    *volume = main_relaxIndex(session->configuration,
+                              session->calibration,
+                              signalMatrix,
+                              session->pastRelaxIndex,
+                              session->smoothedRelaxIndex,
+                              session->volume,
+                              session->qualities);
+    return MBTStatusOK;
+  } catch (...) {
+    return MBTStatusFailure;
+  }
+}
+
+MBTStatus MBTRelaxIndexSessionGetHistory(MBTRelaxIndexSessionRef session,
+                                         MBTRelaxIndexHistory history,
+                                         float* values,
+                                         int32_t capacity,
+                                         int32_t* count) {
+  if (session == NULL) {
+    return MBTStatusInvalidArgument;
+  }
+  switch (history) {
+    case MBTRelaxIndexHistoryRaw:
+      return copyValues(session->pastRelaxIndex, values, capacity, count);
+    case MBTRelaxIndexHistorySmoothed:
+      return copyValues(session->smoothedRelaxIndex, values, capacity, count);
+    case MBTRelaxIndexHistoryVolume:
+      return copyValues(session->volume, values, capacity, count);
+    case MBTRelaxIndexHistoryFrequencies:
+      return copyValues(session->calibration.result().histFreq,
+                        values,
+                        capacity,
+                        count);
+    case MBTRelaxIndexHistoryAlphaPowers:
+    case MBTRelaxIndexHistoryRelativeAlphaPowers:
+    case MBTRelaxIndexHistoryQualities:
+      break;
+    default:
+      return MBTStatusInvalidArgument;
+  }
+  try {
+    std::lock_guard<std::mutex> lock(libraryMutex());
+    auto& analysis = MelomindAnalysisSingleton::getInstance();
+    switch (history) {
+      case MBTRelaxIndexHistoryAlphaPowers:
+        return copyValues(analysis.getSessionAlphaPowers(),
+                          values,
+                          capacity,
+                          count);
+      case MBTRelaxIndexHistoryRelativeAlphaPowers:
+        return copyValues(analysis.getSessionRelativeAlphaPowers(),
+                          values,
+                          capacity,
+                          count);
+      default:
+        return copyValues(analysis.getSessionQualities(),
+                          values,
+                          capacity,
+                          count);
+    }
+  } catch (...) {
+    return MBTStatusFailure;
+  }
+}
+
+MBTStatus MBTRelaxIndexSessionGetAnalysis(MBTRelaxIndexSessionRef session,
+                                          MBTRelaxIndexAnalysis* analysis) {
+  if (session == NULL || analysis == NULL) {
+    return MBTStatusInvalidArgument;
+  }
+  try {
+    std::lock_guard<std::mutex> lock(libraryMutex());
+    auto& singleton = MelomindAnalysisSingleton::getInstance();
+    MBTRelaxIndexAnalysis computed;
+    computed.meanRelativeAlphaPower =
+    static_cast<float>(singleton.getSessionMeanRelativeAlphaPower());
+    // the confidence is the one of the last mean computed
+    computed.meanAlphaPower =
+    static_cast<float>(singleton.getSessionMeanAlphaPower());
+    computed.confidence = static_cast<float>(singleton.getSessionConfidence());
+    *analysis = computed;
+    return MBTStatusOK;
+  } catch (...) {
+    return MBTStatusFailure;
+  }
+}
+
+void MBTRelaxIndexSessionReset(MBTRelaxIndexSessionRef session) {
+  if (session != NULL) {
+    std::lock_guard<std::mutex> lock(libraryMutex());
+    MelomindAnalysisSingleton::getInstance().resetSession();
+    session->pastRelaxIndex.clear();
+    session->smoothedRelaxIndex.clear();
+    session->volume.clear();
+  }
+}
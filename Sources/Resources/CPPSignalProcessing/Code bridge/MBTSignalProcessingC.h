@@ -0,0 +1,308 @@
+//
+//  MBTSignalProcessingC.h
+//  MyBrainTechnologiesSDK
+//
+//  Copyright © 2026 MyBrainTechnologies. All rights reserved.
+//
+
+#ifndef MBTSignalProcessingC_h
+#define MBTSignalProcessingC_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Plain C interface of the signal processing
+ *
+ * Same processing as MBTSignalProcessingBridge.mm, for the callers which are
+ * not Objective-C: the signals are read from float buffers described by their
+ * strides, and the results are written in arrays owned by the caller, without
+ * any NSNumber nor intermediate array.
+ *
+ * The sessions are opaque references created and released by the caller. A
+ * session must not be used by two threads at the same time. The libraries keep
+ * global state (MelomindAnalysisSingleton fed by the relax index, ...), so the
+ * functions which call them hold one lock of the process: different sessions
+ * may be used from different threads, but their computations run one at a
+ * time. The relax index sessions also share the session analysis of the
+ * libraries (MelomindAnalysisSingleton): a process runs one relax index session
+ * at a time, which must not run with MBTRelaxIndexBridge either.
+ *
+ * The functions never throw: they return a status, and leave their outputs
+ * unchanged when it is not MBTStatusOK.
+ *
+ ******************************************************************************/
+
+typedef enum MBTStatus {
+  MBTStatusOK = 0,
+  /// A pointer is NULL, or a size or a sampling rate is not positive.
+  MBTStatusInvalidArgument = 1,
+  /// An output array is too small, the required count is returned.
+  MBTStatusBufferTooSmall = 2,
+  /// The calibration has no parameter to compute the relax index with.
+  MBTStatusNotCalibrated = 3,
+  /// The processing failed (memory or library error).
+  MBTStatusFailure = 4,
+  /// Another relax index session has not been released.
+  MBTStatusSessionInProgress = 5
+} MBTStatus;
+
+/// Read only signal of `channels` channels of `samples` samples each. Sample
+/// `s` of channel `c` is `data[c * channelStride + s * sampleStride]`, the
+/// strides being counted in floats.
+typedef struct MBTSignalBuffer {
+  const float* data;
+  int32_t channels;
+  int32_t samples;
+  ptrdiff_t channelStride;
+  ptrdiff_t sampleStride;
+} MBTSignalBuffer;
+
+/// Signal written by the SDK, with the same layout as MBTSignalBuffer.
+typedef struct MBTMutableSignalBuffer {
+  float* data;
+  int32_t channels;
+  int32_t samples;
+  ptrdiff_t channelStride;
+  ptrdiff_t sampleStride;
+} MBTMutableSignalBuffer;
+
+/// Channels one after the other: `data[c * samples + s]`.
+static inline MBTSignalBuffer MBTSignalBufferMakePlanar(const float* data,
+                                                        int32_t channels,
+                                                        int32_t samples) {
+  MBTSignalBuffer buffer = { data, channels, samples, samples, 1 };
+  return buffer;
+}
+
+/// Samples one after the other, the channels of a sample together:
+/// `data[s * channels + c]`.
+static inline MBTSignalBuffer MBTSignalBufferMakeInterleaved(const float* data,
+                                                             int32_t channels,
+                                                             int32_t samples) {
+  MBTSignalBuffer buffer = { data, channels, samples, 1, channels };
+  return buffer;
+}
+
+static inline MBTMutableSignalBuffer MBTMutableSignalBufferMakePlanar(
+  float* data, int32_t channels, int32_t samples) {
+  MBTMutableSignalBuffer buffer = { data, channels, samples, samples, 1 };
+  return buffer;
+}
+
+static inline MBTMutableSignalBuffer MBTMutableSignalBufferMakeInterleaved(
+  float* data, int32_t channels, int32_t samples) {
+  MBTMutableSignalBuffer buffer = { data, channels, samples, 1, channels };
+  return buffer;
+}
+
+/// Version of the signal processing, as MBTQualityCheckerBridge getVersion.
+const char* MBTSignalProcessingVersion(void);
+
+/// Static description of a status, never NULL.
+const char* MBTStatusDescription(MBTStatus status);
+
+/*******************************************************************************
+ * Raw EEG decoding
+ *
+ * Same samples as EEGDeserializer, in volts: each sample is a big-endian 16
+ * bit word of the headset, the channels being interleaved. The samples are
+ * written channel after channel, `planar[c * samples + s]`.
+ ******************************************************************************/
+
+/// Decode `size` bytes of interleaved samples, without the index of the
+/// frames. The incomplete last sample is ignored. `samples` receives the number
+/// of samples of each channel, also when the capacity, in floats, is too small.
+MBTStatus MBTDecodeRawSamples(const uint8_t* bytes,
+                              int32_t size,
+                              int32_t channels,
+                              float* planar,
+                              int32_t capacity,
+                              int32_t* samples);
+
+typedef struct MBTRawFrameDecoder* MBTRawFrameDecoderRef;
+
+typedef enum MBTLostFrameFill {
+  /// 0xFF bytes decoded as the other samples, as EEGAcquisitionBuffer.
+  MBTLostFrameFillBytes = 0,
+  /// NaN samples.
+  MBTLostFrameFillNaN = 1
+} MBTLostFrameFill;
+
+/// Create a decoder of the frames of a stream, which keeps the index of the
+/// last frame to detect the lost frames.
+MBTStatus MBTRawFrameDecoderCreate(int32_t channels,
+                                   MBTLostFrameFill fill,
+                                   MBTRawFrameDecoderRef* decoder);
+
+/// Release a decoder, NULL is ignored.
+void MBTRawFrameDecoderRelease(MBTRawFrameDecoderRef decoder);
+
+/// Decode `frameCount` frames of `frameSize` bytes, each starting with the
+/// big-endian index of the frame. The frames lost before a frame are filled as
+/// chosen at the creation. `samples` receives the number of samples of each
+/// channel, also when the capacity, in floats, is too small, in which case the
+/// index of the last frame is unchanged.
+MBTStatus MBTRawFrameDecoderDecodeFrames(MBTRawFrameDecoderRef decoder,
+                                         const uint8_t* frames,
+                                         int32_t frameCount,
+                                         int32_t frameSize,
+                                         float* planar,
+                                         int32_t capacity,
+                                         int32_t* samples);
+
+/// Forget the index of the last frame, before decoding another stream.
+void MBTRawFrameDecoderReset(MBTRawFrameDecoderRef decoder);
+
+/*******************************************************************************
+ * Quality checker
+ ******************************************************************************/
+
+typedef struct MBTQualitySession* MBTQualitySessionRef;
+
+/// Create a quality checker with the training data of the bridge.
+MBTStatus MBTQualitySessionCreate(float sampRate,
+                                  float accuracy,
+                                  MBTQualitySessionRef* session);
+
+/// Release a quality checker, NULL is ignored.
+void MBTQualitySessionRelease(MBTQualitySessionRef session);
+
+/// Compute the quality of each channel of a packet.
+///
+/// - qualities: receives one quality per channel, `qualitiesCapacity` floats.
+/// - modifiedData: receives the packet modified according to the qualities,
+///   as getModifiedEEGData, with the shape of the packet. May be NULL.
+MBTStatus MBTQualitySessionCompute(MBTQualitySessionRef session,
+                                   const MBTSignalBuffer* packet,
+                                   float* qualities,
+                                   int32_t qualitiesCapacity,
+                                   const MBTMutableSignalBuffer* modifiedData);
+
+/*******************************************************************************
+ * Calibration
+ ******************************************************************************/
+
+typedef struct MBTCalibration* MBTCalibrationRef;
+
+/// Create an empty calibration, to compute or to restore from saved parameters.
+MBTStatus MBTCalibrationCreate(MBTCalibrationRef* calibration);
+
+/// Release a calibration, NULL is ignored.
+void MBTCalibrationRelease(MBTCalibrationRef calibration);
+
+/// Compute the calibration parameters, as MBTCalibrationBridge: IAF bounds
+/// then MBT_ComputeCalibration. The previous parameters are replaced.
+///
+/// - recordings: the modified EEG data of the calibration packets.
+/// - qualities: one quality per channel and packet, `recordings.samples /
+///   packetLength` samples per channel.
+MBTStatus MBTCalibrationCompute(MBTCalibrationRef calibration,
+                                const MBTSignalBuffer* recordings,
+                                const MBTSignalBuffer* qualities,
+                                int32_t packetLength,
+                                float sampRate);
+
+/// Number of parameters of the calibration.
+int32_t MBTCalibrationParameterCount(MBTCalibrationRef calibration);
+
+/// Name of a parameter, valid until the parameters change, NULL if the index
+/// is out of range.
+const char* MBTCalibrationParameterName(MBTCalibrationRef calibration,
+                                        int32_t index);
+
+/// Copy the values of a parameter. `count` receives the number of values,
+/// also when the capacity is too small.
+MBTStatus MBTCalibrationGetParameter(MBTCalibrationRef calibration,
+                                     const char* name,
+                                     float* values,
+                                     int32_t capacity,
+                                     int32_t* count);
+
+/// Set the values of a parameter, to restore a saved calibration.
+MBTStatus MBTCalibrationSetParameter(MBTCalibrationRef calibration,
+                                     const char* name,
+                                     const float* values,
+                                     int32_t count);
+
+/*******************************************************************************
+ * Relax index
+ ******************************************************************************/
+
+typedef struct MBTRelaxIndexSession* MBTRelaxIndexSessionRef;
+
+typedef enum MBTRelaxIndexHistory {
+  /// Relax index of each packet, not smoothed.
+  MBTRelaxIndexHistoryRaw = 0,
+  /// Smoothed relax index of each packet.
+  MBTRelaxIndexHistorySmoothed = 1,
+  /// Volume of each packet.
+  MBTRelaxIndexHistoryVolume = 2,
+  /// Frequencies of the alpha peaks of the calibration.
+  MBTRelaxIndexHistoryFrequencies = 3,
+  /// Alpha power of each packet, as MBTMelomindAnalysis sessionAlphaPowers.
+  MBTRelaxIndexHistoryAlphaPowers = 4,
+  /// Relative alpha power of each packet.
+  MBTRelaxIndexHistoryRelativeAlphaPowers = 5,
+  /// Quality of each channel of each packet, the channels of a packet
+  /// together.
+  MBTRelaxIndexHistoryQualities = 6
+} MBTRelaxIndexHistory;
+
+/// Session analysis, as MBTMelomindAnalysis.
+typedef struct MBTRelaxIndexAnalysis {
+  float meanAlphaPower;
+  float meanRelativeAlphaPower;
+  /// Confidence rate of the mean alpha power.
+  float confidence;
+} MBTRelaxIndexAnalysis;
+
+/// Create a relax index session and reset the session analysis, as
+/// MBTMelomindAnalysis resetSession. The calibration is copied, it may be
+/// released or changed afterwards. MBTStatusSessionInProgress while another
+/// relax index session is not released.
+MBTStatus MBTRelaxIndexSessionCreate(MBTCalibrationRef calibration,
+                                     float sampRate,
+                                     int32_t packetLength,
+                                     MBTRelaxIndexSessionRef* session);
+
+/// Release a relax index session, NULL is ignored.
+void MBTRelaxIndexSessionRelease(MBTRelaxIndexSessionRef session);
+
+/// Compute the volume of a packet, as MBTRelaxIndexBridge computeRelaxIndex
+/// does with the last 4 seconds of the session: the packet is the whole
+/// signal of the relax index, the caller keeps the previous samples.
+///
+/// - qualities: quality of each channel of the last packet, may be NULL if
+///   `qualitiesCount` is 0.
+MBTStatus MBTRelaxIndexSessionCompute(MBTRelaxIndexSessionRef session,
+                                      const MBTSignalBuffer* packet,
+                                      const float* qualities,
+                                      int32_t qualitiesCount,
+                                      float* volume);
+
+/// Copy a history of the session. `count` receives the number of values, also
+/// when the capacity is too small.
+MBTStatus MBTRelaxIndexSessionGetHistory(MBTRelaxIndexSessionRef session,
+                                         MBTRelaxIndexHistory history,
+                                         float* values,
+                                         int32_t capacity,
+                                         int32_t* count);
+
+/// Compute the analysis of the packets of the session.
+MBTStatus MBTRelaxIndexSessionGetAnalysis(MBTRelaxIndexSessionRef session,
+                                          MBTRelaxIndexAnalysis* analysis);
+
+/// Clear the histories and the session analysis, to start a new session with
+/// the same calibration.
+void MBTRelaxIndexSessionReset(MBTRelaxIndexSessionRef session);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBTSignalProcessingC_h */
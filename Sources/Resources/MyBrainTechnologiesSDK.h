@@ -16,6 +16,7 @@ FOUNDATION_EXPORT const unsigned char MyBrainTechnologiesSDKVersionString[];
 
 // In this header, you should import all the public headers of your framework using statements like #import <MyBrainTechnologiesSDK/PublicHeader.h>
 #import <MyBrainTechnologiesSDK/MBTSignalProcessingBridge.h>
+#import <MyBrainTechnologiesSDK/MBTSignalProcessingC.h>
 //#import <MyBrainTechnologiesSDK/fftw3.h>
 //#import <MyBrainTechnologiesSDK/MBT_NormalizeRelaxIndex.h>
 //#import <MyBrainTechnologiesSDK/MBT_BandPass_fftw3.h>
@@ -0,0 +1,432 @@
+/**
+ * @file MBT_NFResults.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Strongly typed outputs of the calibration, IAF and RMS computations.
+ * The dictionnary format (keyed by @ref CalibrationOutputKeys, @ref IafOutputKeys and @ref RmsOutputKeys)
+ * is only kept as a conversion layer for compatibility with existing callers.
+ *
+ */
+
+#ifndef MBT_NFRESULTS_H
+#define MBT_NFRESULTS_H
+
+#include <sp-global.h>
+#include <sp-instrumentation.h>
+
+#include "NF_Melomind/MBT_NFConfig.h"
+#include "NF_Melomind/MBT_ComputeCalibration.h"
+#include "NF_Melomind/MBT_ComputeIAF.h"
+#include "NF_Melomind/MBT_ComputeRMS.h"
+#include "NF_Melomind/Utils.h"
+
+#include <DataManipulation/MBT_Matrix.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+/**
+ * @brief Key used by the bridges to store the IAF bounds inside the calibration dictionnary
+ *
+ */
+const std::string MBT_IAF_CALIBRATION_KEY = "iafCalib";
+
+namespace MBT_NFResultsDetail {
+    /**
+     * @brief Copy a dictionnary entry into a vector, keeping the capacity of the vector
+     *
+     * @param dictionnary The dictionnary to read
+     * @param key The key of the entry
+     * @param output The vector receiving the values, cleared if the key is missing
+     */
+    template <typename T>
+    inline void copyEntry(const std::map<std::string, std::vector<T> >& dictionnary, const std::string& key, std::vector<T>& output)
+    {
+        const typename std::map<std::string, std::vector<T> >::const_iterator entry = dictionnary.find(key);
+        if (entry == dictionnary.end()) {
+            output.clear();
+        } else {
+            output.assign(entry->second.begin(), entry->second.end());
+        }
+    }
+}
+
+/**
+ * @brief Typed output of MBT_ComputeCalibration, completed with the IAF bounds of MBT_ComputeIAFCalibration
+ *
+ */
+struct MBT_CalibrationResult {
+    /**
+     * @brief Absolute RMS values of the calibration (@ref CalibrationOutputKeys::RMS)
+     */
+    SP_FloatVector rms;
+    /**
+     * @brief Relative RMS values of the calibration (@ref CalibrationOutputKeys::RELATIVE_RMS)
+     */
+    SP_FloatVector relativeRms;
+    /**
+     * @brief Smoothed RMS values of the calibration (@ref CalibrationOutputKeys::SMOOTHED_RMS)
+     */
+    SP_FloatVector smoothedRms;
+    /**
+     * @brief Frequencies of the alpha peaks detected during calibration (@ref CalibrationOutputKeys::HIST_FREQ)
+     */
+    SP_FloatVector histFreq;
+    /**
+     * @brief Error value of the calibration (@ref CalibrationOutputKeys::ERROR_MSG)
+     */
+    SP_FloatVector errorMsg;
+    /**
+     * @brief Lower and upper IAF bounds (@ref MBT_IAF_CALIBRATION_KEY)
+     */
+    SP_FloatVector iaf;
+
+    /**
+     * @brief Construct an empty calibration result
+     *
+     */
+    MBT_CalibrationResult() {}
+
+    /**
+     * @brief Construct an empty calibration result with reserved capacity
+     *
+     * @param capacity Number of values expected per field, usually the calibration duration in seconds
+     */
+    explicit MBT_CalibrationResult(size_t capacity)
+    {
+        reserve(capacity);
+    }
+
+    /**
+     * @brief Reserve capacity for all the fields
+     *
+     * @param capacity Number of values expected per field
+     */
+    void reserve(size_t capacity)
+    {
+        rms.reserve(capacity);
+        relativeRms.reserve(capacity);
+        smoothedRms.reserve(capacity);
+        histFreq.reserve(capacity);
+        errorMsg.reserve(1);
+        iaf.reserve(2);
+    }
+
+    /**
+     * @brief Clear all the fields, keeping their capacity
+     *
+     */
+    void clear()
+    {
+        rms.clear();
+        relativeRms.clear();
+        smoothedRms.clear();
+        histFreq.clear();
+        errorMsg.clear();
+        iaf.clear();
+    }
+
+    /**
+     * @brief Fill the result from a calibration dictionnary, reusing the capacity of the fields
+     *
+     * @param paramCalib The calibration dictionnary
+     */
+    void assign(const std::map<std::string, SP_FloatVector >& paramCalib)
+    {
+        MBT_NFResultsDetail::copyEntry(paramCalib, CalibrationOutputKeys::RMS, rms);
+        MBT_NFResultsDetail::copyEntry(paramCalib, CalibrationOutputKeys::RELATIVE_RMS, relativeRms);
+        MBT_NFResultsDetail::copyEntry(paramCalib, CalibrationOutputKeys::SMOOTHED_RMS, smoothedRms);
+        MBT_NFResultsDetail::copyEntry(paramCalib, CalibrationOutputKeys::HIST_FREQ, histFreq);
+        MBT_NFResultsDetail::copyEntry(paramCalib, CalibrationOutputKeys::ERROR_MSG, errorMsg);
+        MBT_NFResultsDetail::copyEntry(paramCalib, MBT_IAF_CALIBRATION_KEY, iaf);
+    }
+
+    /**
+     * @brief Build a calibration result from a calibration dictionnary
+     *
+     * @param paramCalib The calibration dictionnary
+     * @return MBT_CalibrationResult The typed calibration result
+     */
+    static MBT_CalibrationResult fromMap(const std::map<std::string, SP_FloatVector >& paramCalib)
+    {
+        MBT_CalibrationResult result;
+        result.assign(paramCalib);
+        return result;
+    }
+
+    /**
+     * @brief Convert the result to the calibration dictionnary format
+     * The IAF bounds entry is only written if it is not empty.
+     *
+     * @return std::map<std::string, SP_FloatVector > The calibration dictionnary
+     */
+    std::map<std::string, SP_FloatVector > toMap() const
+    {
+        std::map<std::string, SP_FloatVector > paramCalib;
+        paramCalib[CalibrationOutputKeys::RMS] = rms;
+        paramCalib[CalibrationOutputKeys::RELATIVE_RMS] = relativeRms;
+        paramCalib[CalibrationOutputKeys::SMOOTHED_RMS] = smoothedRms;
+        paramCalib[CalibrationOutputKeys::HIST_FREQ] = histFreq;
+        paramCalib[CalibrationOutputKeys::ERROR_MSG] = errorMsg;
+        if (!iaf.empty()) {
+            paramCalib[MBT_IAF_CALIBRATION_KEY] = iaf;
+        }
+        return paramCalib;
+    }
+};
+
+/**
+ * @brief Typed output of MBT_ComputeIAF
+ *
+ */
+struct MBT_IafResult {
+    /**
+     * @brief One IAF value by channel (@ref IafOutputKeys::IAF)
+     */
+    SP_Vector iaf;
+    /**
+     * @brief One quality value by channel (@ref IafOutputKeys::QUALITY)
+     */
+    SP_Vector quality;
+
+    /**
+     * @brief Construct an empty IAF result
+     *
+     */
+    MBT_IafResult() {}
+
+    /**
+     * @brief Construct an empty IAF result with reserved capacity
+     *
+     * @param nbChannels Number of channels of the processed signal
+     */
+    explicit MBT_IafResult(size_t nbChannels)
+    {
+        iaf.reserve(nbChannels);
+        quality.reserve(nbChannels);
+    }
+
+    /**
+     * @brief Fill the result from an IAF dictionnary, reusing the capacity of the fields
+     *
+     * @param computeIAF The IAF dictionnary
+     */
+    void assign(const std::map<std::string, SP_Vector >& computeIAF)
+    {
+        MBT_NFResultsDetail::copyEntry(computeIAF, IafOutputKeys::IAF, iaf);
+        MBT_NFResultsDetail::copyEntry(computeIAF, IafOutputKeys::QUALITY, quality);
+    }
+
+    /**
+     * @brief Build an IAF result from an IAF dictionnary
+     *
+     * @param computeIAF The IAF dictionnary
+     * @return MBT_IafResult The typed IAF result
+     */
+    static MBT_IafResult fromMap(const std::map<std::string, SP_Vector >& computeIAF)
+    {
+        MBT_IafResult result;
+        result.assign(computeIAF);
+        return result;
+    }
+
+    /**
+     * @brief Convert the result to the IAF dictionnary format
+     *
+     * @return std::map<std::string, SP_Vector > The IAF dictionnary
+     */
+    std::map<std::string, SP_Vector > toMap() const
+    {
+        std::map<std::string, SP_Vector > computeIAF;
+        computeIAF[IafOutputKeys::IAF] = iaf;
+        computeIAF[IafOutputKeys::QUALITY] = quality;
+        return computeIAF;
+    }
+};
+
+/**
+ * @brief Typed output of MBT_ComputeRMS
+ *
+ */
+struct MBT_RmsResult {
+    /**
+     * @brief One absolute RMS value by channel (@ref RmsOutputKeys::ABSOLUTE)
+     */
+    SP_Vector absolute;
+    /**
+     * @brief One relative RMS value by channel (@ref RmsOutputKeys::RELATIVE)
+     */
+    SP_Vector relative;
+    /**
+     * @brief One quality value by channel (@ref RmsOutputKeys::QUALITY)
+     */
+    SP_Vector quality;
+
+    /**
+     * @brief Construct an empty RMS result
+     *
+     */
+    MBT_RmsResult() {}
+
+    /**
+     * @brief Construct an empty RMS result with reserved capacity
+     *
+     * @param nbChannels Number of channels of the processed signal
+     */
+    explicit MBT_RmsResult(size_t nbChannels)
+    {
+        absolute.reserve(nbChannels);
+        relative.reserve(nbChannels);
+        quality.reserve(nbChannels);
+    }
+
+    /**
+     * @brief Fill the result from a RMS dictionnary, reusing the capacity of the fields
+     *
+     * @param computeRMS The RMS dictionnary
+     */
+    void assign(const std::map<std::string, SP_Vector >& computeRMS)
+    {
+        MBT_NFResultsDetail::copyEntry(computeRMS, RmsOutputKeys::ABSOLUTE, absolute);
+        MBT_NFResultsDetail::copyEntry(computeRMS, RmsOutputKeys::RELATIVE, relative);
+        MBT_NFResultsDetail::copyEntry(computeRMS, RmsOutputKeys::QUALITY, quality);
+    }
+
+    /**
+     * @brief Build a RMS result from a RMS dictionnary
+     *
+     * @param computeRMS The RMS dictionnary
+     * @return MBT_RmsResult The typed RMS result
+     */
+    static MBT_RmsResult fromMap(const std::map<std::string, SP_Vector >& computeRMS)
+    {
+        MBT_RmsResult result;
+        result.assign(computeRMS);
+        return result;
+    }
+
+    /**
+     * @brief Convert the result to the RMS dictionnary format
+     *
+     * @return std::map<std::string, SP_Vector > The RMS dictionnary
+     */
+    std::map<std::string, SP_Vector > toMap() const
+    {
+        std::map<std::string, SP_Vector > computeRMS;
+        computeRMS[RmsOutputKeys::ABSOLUTE] = absolute;
+        computeRMS[RmsOutputKeys::RELATIVE] = relative;
+        computeRMS[RmsOutputKeys::QUALITY] = quality;
+        return computeRMS;
+    }
+};
+
+/**
+ * @brief Calibration state used during a session, built once after the calibration.
+ * It holds the typed calibration result, the RMS min/max used to compute the volum and
+ * the dictionnary expected by the compiled relax index, so that the caller neither rebuilds
+ * the dictionnary nor looks up its keys every second.
+ * The compiled main_relaxIndex takes the dictionnary by value and does not give it back:
+ * each call still deep copies it into the parameter, and the library still looks up its
+ * keys. This copy cannot be avoided until the library takes the dictionnary by reference.
+ *
+ */
+class MBT_SessionCalibration
+{
+    public:
+        /**
+         * @brief Construct an empty session calibration
+         *
+         */
+        MBT_SessionCalibration() : m_minMax(0, 0) {}
+
+        /**
+         * @brief Construct a session calibration from a typed calibration result
+         *
+         * @param result The calibration result
+         * @param minFactor Factor applied to the minimum of the smoothed RMS calibration
+         * @param maxFactor Factor applied to the maximum of the smoothed RMS calibration
+         */
+        MBT_SessionCalibration(const MBT_CalibrationResult& result, SP_FloatType minFactor, SP_FloatType maxFactor)
+        : m_result(result), m_paramCalib(result.toMap()), m_minMax(0, 0)
+        {
+            SP_FloatVector smoothedRms = m_result.smoothedRms;
+            m_minMax = computeMinMax(smoothedRms, minFactor, maxFactor);
+        }
+
+        /**
+         * @brief Get the typed calibration result
+         *
+         * @return const MBT_CalibrationResult& The calibration result
+         */
+        const MBT_CalibrationResult& result() const { return m_result; }
+
+        /**
+         * @brief Get the calibration dictionnary, built once at construction
+         *
+         * @return const std::map<std::string, SP_FloatVector >& The calibration dictionnary
+         */
+        const std::map<std::string, SP_FloatVector >& paramCalib() const { return m_paramCalib; }
+
+        /**
+         * @brief Get the min/max values of the smoothed RMS calibration
+         *
+         * @return const std::pair<SP_FloatType, SP_FloatType>& The min/max values
+         */
+        const std::pair<SP_FloatType, SP_FloatType>& minMax() const { return m_minMax; }
+
+    private:
+        /**
+         * @brief Typed calibration result
+         */
+        MBT_CalibrationResult m_result;
+        /**
+         * @brief Compatibility dictionnary, built once
+         */
+        std::map<std::string, SP_FloatVector > m_paramCalib;
+        /**
+         * @brief Min/max values of the smoothed RMS calibration
+         */
+        std::pair<SP_FloatType, SP_FloatType> m_minMax;
+};
+
+/**
+ * @brief Compute the calibration parameters into a typed result
+ *
+ * @param configuration Neurofeedback configuration
+ * @param calibrationRecordings The EEG signals as it's returned by the QualityChecker (number of rows = number of channels)
+ * @param calibrationRecordingsQuality The quality of each EEG signal as it's returned by the QualityChecker (number of rows = number of channels)
+ * @param result The typed calibration result, its capacity is reused
+ */
+inline void main_calibration(MBT_NFConfig configuration, SP_FloatMatrix calibrationRecordings,
+                                SP_FloatMatrix calibrationRecordingsQuality, MBT_CalibrationResult& result)
+{
+    result.assign(main_calibration(configuration, calibrationRecordings, calibrationRecordingsQuality));
+}
+
+/**
+ * @brief Play the session with a calibration built once by @ref MBT_SessionCalibration.
+ * The cached dictionnary is copied into the by-value parameter of the compiled main_relaxIndex
+ * at each call, see @ref MBT_SessionCalibration.
+ *
+ * @param configuration Neurofeedback configuration
+ * @param calibration The session calibration
+ * @param sessionPacket The EEG signals on real-time during session as it's returned by the QualityChecker (number of rows = number of channels)
+ * @param pastRelaxIndex Containing the previous relax index computed during the session (not smoothed).
+ * @param resultSmoothedRMS resultSmoothedRMS
+ * @param resultVolum resultVolum
+ * @param qualities qualities
+ * @return SP_FloatType Current session volume computed
+ */
+inline SP_FloatType main_relaxIndex(MBT_NFConfig configuration, const MBT_SessionCalibration& calibration,
+                                    const SP_FloatMatrix &sessionPacket, SP_FloatVector &pastRelaxIndex,
+                                    SP_FloatVector &resultSmoothedRMS, SP_FloatVector &resultVolum,
+                                    SP_FloatVector qualities = SP_FloatVector())
+{
+    SP_SCOPED_STAGE_BYTES(SP_STAGE_RELAX_INDEX, static_cast<size_t>(sessionPacket.size().first) * sessionPacket.size().second * sizeof(SP_FloatType));
+    return main_relaxIndex(configuration, calibration.paramCalib(), sessionPacket, pastRelaxIndex,
+                            resultSmoothedRMS, resultVolum, calibration.minMax(), qualities);
+}
+
+#endif // MBT_NFRESULTS_H
@@ -0,0 +1,305 @@
+/**
+ * @file MBT_SessionAggregator.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Per-session streaming aggregation of alpha powers and qualities.
+ * Same getters as @ref MelomindAnalysisSingleton, but the means and the confidence are O(1): running
+ * sums and confidence counts are maintained at each new value, and the histories of the alpha powers
+ * and of the qualities are optional and bounded.
+ *
+ * The aggregator is standalone: the relax index of the bridge still feeds @ref MelomindAnalysisSingleton,
+ * because the compiled main_relaxIndex adds the alpha powers to the singleton itself and does not return
+ * them. Integrations which compute the alpha powers on their side add them here.
+ *
+ * On the same values, the means, the confidence and the histories are the ones of the singleton, with
+ * the confidence read after one of its mean getters. Two differences remain: a NaN alpha power counts as
+ * a value of bad quality instead of making the means NaN, and the confidence is always the one of the
+ * values added so far, where the singleton returns the one computed by its last mean getter.
+ *
+ * Threading model: one writer (the DSP thread calling @ref MBT_SessionAggregator::addAlphaPower
+ * and @ref MBT_SessionAggregator::resetSession) and any number of readers (UI or metrics threads).
+ * Readers never block the writer: the running values are published through a sequence lock
+ * made of atomics only.
+ *
+ */
+
+#ifndef MBT_SESSIONAGGREGATOR_H
+#define MBT_SESSIONAGGREGATOR_H
+
+#include <sp-global.h>
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#define SESSION_AGGREGATOR_QUALITY_THRESHOLD 1.0
+
+/**
+ * @brief Consistent view of the running values of a session
+ *
+ */
+struct MBT_SessionSnapshot {
+    /**
+     * @brief Mean alpha power over the values of good quality, NaN if there is none
+     */
+    SP_RealType meanAlphaPower;
+    /**
+     * @brief Mean relative alpha power over the values of good quality, NaN if there is none
+     */
+    SP_RealType meanRelativeAlphaPower;
+    /**
+     * @brief Ratio of values of good quality over all the added values, NaN if there is none
+     */
+    SP_RealType confidence;
+    /**
+     * @brief Number of values of good quality
+     */
+    unsigned long cumulCount;
+    /**
+     * @brief Number of added values
+     */
+    unsigned long callCount;
+};
+
+/**
+ * @brief Streaming aggregator of the alpha powers of a session
+ *
+ */
+class MBT_SessionAggregator
+{
+    public:
+        /**
+         * @brief Construct a new aggregator
+         *
+         * @param historyCapacity Number of values kept in the history, 0 disables the history.
+         *                        When full, the oldest values are overwritten.
+         * @param qualityThreshold A value is used for the means if at least one channel quality reaches this threshold.
+         *                         The quality checker returns qualities up to 1, so the default threshold keeps the
+         *                         values with a channel of quality 1, as the singleton.
+         * @param channelCount Number of channel qualities checked and kept in the history for each value,
+         *                     the singleton uses the first 2
+         */
+        explicit MBT_SessionAggregator(unsigned int historyCapacity = 0,
+                                        SP_RealType qualityThreshold = SESSION_AGGREGATOR_QUALITY_THRESHOLD,
+                                        unsigned int channelCount = 2)
+        : m_qualityThreshold(qualityThreshold), m_channelCount(channelCount),
+          m_alphaHistory(historyCapacity), m_relativeAlphaHistory(historyCapacity),
+          m_qualitiesHistory(historyCapacity * channelCount)
+        {
+            m_sequence.store(0, std::memory_order_relaxed);
+            m_historySize.store(0, std::memory_order_relaxed);
+            clear();
+        }
+
+        /**
+         * @brief Add a new alpha power value to the current session. Writer thread only.
+         *
+         * @param alphaPower The alpha power value to add
+         * @param alphaPowerRelative The relative alpha power value to add
+         * @param qualities Current qualities for each channel for the current alpha power. Only the first
+         *                  channelCount of them are used, a missing channel is kept as NaN in the history.
+         */
+        void addAlphaPower(SP_RealType alphaPower, SP_RealType alphaPowerRelative, const SP_Vector& qualities)
+        {
+            bool isGood = false;
+            for (size_t channel = 0; channel < qualities.size() && channel < m_channelCount; ++channel) {
+                if (qualities[channel] >= m_qualityThreshold) {
+                    isGood = true;
+                    break;
+                }
+            }
+            isGood = isGood && !std::isnan(alphaPower) && !std::isnan(alphaPowerRelative);
+
+            beginWrite();
+            m_callCount.store(m_callCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (isGood) {
+                m_cumulCount.store(m_cumulCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                m_alphaSum.store(m_alphaSum.load(std::memory_order_relaxed) + alphaPower, std::memory_order_relaxed);
+                m_relativeAlphaSum.store(m_relativeAlphaSum.load(std::memory_order_relaxed) + alphaPowerRelative, std::memory_order_relaxed);
+            }
+            if (!m_alphaHistory.empty()) {
+                const unsigned long index = m_historyHead.load(std::memory_order_relaxed);
+                m_alphaHistory[index % m_alphaHistory.size()].store(alphaPower, std::memory_order_relaxed);
+                m_relativeAlphaHistory[index % m_alphaHistory.size()].store(alphaPowerRelative, std::memory_order_relaxed);
+                const size_t qualitiesOffset = (index % m_alphaHistory.size()) * m_channelCount;
+                for (size_t channel = 0; channel < m_channelCount; ++channel) {
+                    const SP_RealType quality = channel < qualities.size() ? qualities[channel] : SP_NAN;
+                    m_qualitiesHistory[qualitiesOffset + channel].store(quality, std::memory_order_relaxed);
+                }
+                m_historyHead.store(index + 1, std::memory_order_relaxed);
+                const unsigned long size = m_historySize.load(std::memory_order_relaxed);
+                if (size < m_alphaHistory.size()) {
+                    m_historySize.store(size + 1, std::memory_order_relaxed);
+                }
+            }
+            endWrite();
+        }
+
+        /**
+         * @brief Reset current session. Writer thread only.
+         *
+         */
+        void resetSession()
+        {
+            beginWrite();
+            clear();
+            endWrite();
+        }
+
+        /**
+         * @brief Get a consistent view of the running values, in O(1). Safe from any thread.
+         *
+         * @return MBT_SessionSnapshot The running values
+         */
+        MBT_SessionSnapshot snapshot() const
+        {
+            SP_RealType alphaSum, relativeAlphaSum;
+            unsigned long cumulCount, callCount;
+            unsigned long sequence;
+            do {
+                sequence = beginRead();
+                alphaSum = m_alphaSum.load(std::memory_order_relaxed);
+                relativeAlphaSum = m_relativeAlphaSum.load(std::memory_order_relaxed);
+                cumulCount = m_cumulCount.load(std::memory_order_relaxed);
+                callCount = m_callCount.load(std::memory_order_relaxed);
+            } while (!endRead(sequence));
+
+            MBT_SessionSnapshot result;
+            result.cumulCount = cumulCount;
+            result.callCount = callCount;
+            result.meanAlphaPower = cumulCount > 0 ? alphaSum / static_cast<SP_RealType>(cumulCount) : SP_NAN;
+            result.meanRelativeAlphaPower = cumulCount > 0 ? relativeAlphaSum / static_cast<SP_RealType>(cumulCount) : SP_NAN;
+            result.confidence = callCount > 0 ? static_cast<SP_RealType>(cumulCount) / static_cast<SP_RealType>(callCount) : SP_NAN;
+            return result;
+        }
+
+        /**
+         * @brief Get the mean alpha power of the current session, in O(1)
+         *
+         * @return SP_RealType Mean alpha power
+         */
+        SP_RealType getSessionMeanAlphaPower() const { return snapshot().meanAlphaPower; }
+
+        /**
+         * @brief Get the mean relative alpha power of the current session, in O(1)
+         *
+         * @return SP_RealType Mean relative alpha power
+         */
+        SP_RealType getSessionMeanRelativeAlphaPower() const { return snapshot().meanRelativeAlphaPower; }
+
+        /**
+         * @brief Get the confidence rate of the current session, in O(1)
+         *
+         * @return SP_RealType Confidence rate
+         */
+        SP_RealType getSessionConfidence() const { return snapshot().confidence; }
+
+        /**
+         * @brief Copy the alpha powers kept in the history, oldest first. Safe from any thread.
+         *
+         * @param alphaPowers Receives the alpha powers, its capacity is reused
+         */
+        void getSessionAlphaPowers(SP_FloatVector& alphaPowers) const
+        {
+            copyHistory(m_alphaHistory, alphaPowers);
+        }
+
+        /**
+         * @brief Copy the relative alpha powers kept in the history, oldest first. Safe from any thread.
+         *
+         * @param relativeAlphaPowers Receives the relative alpha powers, its capacity is reused
+         */
+        void getSessionRelativeAlphaPowers(SP_FloatVector& relativeAlphaPowers) const
+        {
+            copyHistory(m_relativeAlphaHistory, relativeAlphaPowers);
+        }
+
+        /**
+         * @brief Copy the qualities kept in the history, oldest first. Safe from any thread.
+         * Qualities are multiplexed by channels ([q1c1, q1c2, q2c1, q2c2, q3c1, ...]), as in
+         * @ref MelomindAnalysisSingleton::getSessionQualities
+         *
+         * @param qualities Receives the qualities, its capacity is reused
+         */
+        void getSessionQualities(SP_FloatVector& qualities) const
+        {
+            copyHistory(m_qualitiesHistory, qualities, m_channelCount);
+        }
+
+    private:
+        typedef std::vector< std::atomic<SP_RealType> > AtomicHistory;
+
+        MBT_SessionAggregator(const MBT_SessionAggregator&);
+        MBT_SessionAggregator& operator=(const MBT_SessionAggregator&);
+
+        void clear()
+        {
+            m_alphaSum.store(0, std::memory_order_relaxed);
+            m_relativeAlphaSum.store(0, std::memory_order_relaxed);
+            m_cumulCount.store(0, std::memory_order_relaxed);
+            m_callCount.store(0, std::memory_order_relaxed);
+            m_historyHead.store(0, std::memory_order_relaxed);
+            m_historySize.store(0, std::memory_order_relaxed);
+        }
+
+        void beginWrite()
+        {
+            m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        void endWrite()
+        {
+            m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        unsigned long beginRead() const
+        {
+            unsigned long sequence = m_sequence.load(std::memory_order_acquire);
+            while (sequence & 1) {
+                sequence = m_sequence.load(std::memory_order_acquire);
+            }
+            return sequence;
+        }
+
+        bool endRead(unsigned long sequence) const
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return m_sequence.load(std::memory_order_relaxed) == sequence;
+        }
+
+        void copyHistory(const AtomicHistory& history, SP_FloatVector& output, unsigned int valuesPerEntry = 1) const
+        {
+            unsigned long sequence;
+            do {
+                sequence = beginRead();
+                output.clear();
+                const unsigned long size = m_historySize.load(std::memory_order_relaxed);
+                const unsigned long head = m_historyHead.load(std::memory_order_relaxed);
+                for (unsigned long i = head - size; i < head; ++i) {
+                    const size_t offset = (i % m_alphaHistory.size()) * valuesPerEntry;
+                    for (unsigned int value = 0; value < valuesPerEntry; ++value) {
+                        output.push_back(static_cast<SP_FloatType>(history[offset + value].load(std::memory_order_relaxed)));
+                    }
+                }
+            } while (!endRead(sequence));
+        }
+
+        const SP_RealType m_qualityThreshold; // quality needed on at least one channel
+        const unsigned int m_channelCount; // number of qualities kept for each value
+
+        std::atomic<unsigned long> m_sequence; // odd while the writer updates the values
+        std::atomic<SP_RealType> m_alphaSum; // sum of the alpha powers of good quality
+        std::atomic<SP_RealType> m_relativeAlphaSum; // sum of the relative alpha powers of good quality
+        std::atomic<unsigned long> m_cumulCount; // number of values of good quality
+        std::atomic<unsigned long> m_callCount; // number of added values
+
+        AtomicHistory m_alphaHistory; // bounded history of the alpha powers
+        AtomicHistory m_relativeAlphaHistory; // bounded history of the relative alpha powers
+        AtomicHistory m_qualitiesHistory; // bounded history of the qualities, multiplexed by channels
+        std::atomic<unsigned long> m_historyHead; // total number of values written in the history
+        std::atomic<unsigned long> m_historySize; // number of values available in the history
+};
+
+#endif // MBT_SESSIONAGGREGATOR_H
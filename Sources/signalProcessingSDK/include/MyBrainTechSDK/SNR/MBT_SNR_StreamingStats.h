@@ -0,0 +1,351 @@
+/**
+ * @file MBT_SNR_StreamingStats.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Online accumulator of the SNR statistics of a session.
+ * Each SNR value updates the switch count and the areas above and below the threshold in O(1),
+ * with O(1) memory per session, so that the statistics can be queried at any time of the session
+ * without recomputation.
+ *
+ * The switch count and the areas are the ones of the exercises of SNR_Statistics
+ * (ExerciseSwitch, ExerciseAreaUpAndPerformance and ExerciseAreaDown) computed on the values
+ * pushed so far: the switch count is equal, the areas are equal up to the float rounding of the
+ * compiled code. The performance, mean and standard deviation are live indicators of their own.
+ * SNR_Statistics has no NaN handling, NaN values are skipped here.
+ *
+ */
+
+#ifndef MBT_SNR_STREAMINGSTATS_H
+#define MBT_SNR_STREAMINGSTATS_H
+
+#include <sp-global.h>
+
+#include <cmath>
+#include <map>
+#include <string>
+
+/**
+ * @brief Statistics of a session, as known after the last pushed SNR value
+ *
+ */
+struct SNR_StatisticsSnapshot {
+    /**
+     * @brief Number of valid (not NaN) SNR values pushed
+     */
+    unsigned long count;
+    /**
+     * @brief Running mean of the SNR values
+     */
+    SP_RealType mean;
+    /**
+     * @brief Running standard deviation of the SNR values (N-1 normalization)
+     */
+    SP_RealType standardDeviation;
+    /**
+     * @brief Number of switches between the high and the low levels, as SNR_Statistics::ExerciseSwitch
+     */
+    int switchCount;
+    /**
+     * @brief Sum of the areas above the exercise threshold, as SNR_Statistics::ExerciseAreaUpAndPerformance
+     */
+    SP_RealType areaUp;
+    /**
+     * @brief Sum of the areas below the exercise threshold, as SNR_Statistics::ExerciseAreaDown
+     */
+    SP_RealType areaDown;
+    /**
+     * @brief Ratio of the area above the threshold to the overall area, between 0 and 1
+     */
+    SP_RealType performance;
+};
+
+/**
+ * @brief Online SNR statistics of a session
+ *
+ */
+class SNR_StreamingStatistics
+{
+    public:
+        /**
+         * @brief Construct a new accumulator
+         *
+         * @param threshold The exercise threshold used for the areas and the performance
+         */
+        explicit SNR_StreamingStatistics(SP_RealType threshold)
+        : m_threshold(threshold)
+        {
+            reset();
+        }
+
+        /**
+         * @brief Reset the accumulator for a new session, keeping the threshold
+         *
+         */
+        void reset()
+        {
+            m_count = 0;
+            m_mean = 0;
+            m_m2 = 0;
+            for (int kind = 0; kind < TRANSITION_KINDS; ++kind) {
+                m_transitions[kind].pending = false;
+                m_transitions[kind].nonDecreasing = true;
+                m_transitions[kind].nonIncreasing = true;
+                m_transitions[kind].start = 0;
+            }
+            m_hasTransition = false;
+            m_directSwitchCount = 0;
+            m_transitionSwitchCount = 0;
+            m_sumUp = 0;
+            m_sumDown = 0;
+            m_hasUp = false;
+            m_hasDown = false;
+            m_firstExcess = 0;
+            m_lastExcess = 0;
+        }
+
+        /**
+         * @brief Add the next SNR value of the session
+         * NaN values are ignored.
+         *
+         * @param snr The SNR value, one per second
+         */
+        void push(SP_RealType snr)
+        {
+            if (std::isnan(snr)) {
+                return;
+            }
+
+            m_values[m_count & HISTORY_MASK] = snr;
+            m_levels[m_count & HISTORY_MASK] = levelOf(snr);
+            ++m_count;
+            updateMoments(snr);
+            updateAreas(snr - m_threshold);
+            // the level patterns of ExerciseSwitch look 3 values ahead and start at the 4th value
+            if (m_count >= 7) {
+                updateSwitch(m_count - 4);
+            }
+        }
+
+        /**
+         * @brief Get the statistics of the values pushed so far, in O(1)
+         *
+         * @return SNR_StatisticsSnapshot The current statistics
+         */
+        SNR_StatisticsSnapshot snapshot() const
+        {
+            SNR_StatisticsSnapshot result;
+            result.count = m_count;
+            result.mean = m_count > 0 ? m_mean : SP_NAN;
+            result.standardDeviation = m_count > 1 ? std::sqrt(m_m2 / static_cast<SP_RealType>(m_count - 1)) : SP_NAN;
+            // ExerciseSwitch returns 0 when no level is reached through the middle band
+            result.switchCount = m_hasTransition ? m_directSwitchCount + m_transitionSwitchCount : 0;
+            result.areaUp = areaUp();
+            result.areaDown = areaDown();
+            const SP_RealType overallArea = result.areaUp + result.areaDown;
+            result.performance = overallArea > 0 ? result.areaUp / overallArea : 0;
+            return result;
+        }
+
+        /**
+         * @brief Convert the current statistics to a dictionnary, for logs and dashboards.
+         * The keys are the names of the fields of SNR_StatisticsSnapshot, they are not the keys of
+         * SNR_Statistics::CalculateSNRStatistics and the dictionnary cannot replace its result.
+         *
+         * @return std::map<std::string, SP_FloatType> The current statistics
+         */
+        std::map<std::string, SP_FloatType> toMap() const
+        {
+            const SNR_StatisticsSnapshot current = snapshot();
+            std::map<std::string, SP_FloatType> statistics;
+            statistics["switchCount"] = static_cast<SP_FloatType>(current.switchCount);
+            statistics["areaUp"] = static_cast<SP_FloatType>(current.areaUp);
+            statistics["areaDown"] = static_cast<SP_FloatType>(current.areaDown);
+            statistics["performance"] = static_cast<SP_FloatType>(current.performance);
+            return statistics;
+        }
+
+        /**
+         * @brief Get the exercise threshold
+         *
+         * @return SP_RealType The exercise threshold
+         */
+        SP_RealType threshold() const { return m_threshold; }
+
+    private:
+        /**
+         * @brief Levels of the SNR for the exercise Switch, with the fixed thresholds of SNR_Statistics
+         */
+        enum Level { LOW_LEVEL = -1, MIDDLE_LEVEL = 0, HIGH_LEVEL = 1 };
+
+        /**
+         * @brief Transitions through the middle band, from the high to the low level and back
+         */
+        enum TransitionKind { HIGH_TO_LOW, LOW_TO_HIGH, TRANSITION_KINDS };
+
+        /**
+         * @brief Number of values kept for the level patterns, a power of two
+         */
+        enum { HISTORY_SIZE = 8, HISTORY_MASK = HISTORY_SIZE - 1 };
+
+        /**
+         * @brief Transition started at the end of a level, waiting for the start of the opposite one
+         */
+        struct Transition {
+            bool pending; // a level ended and the opposite one has not started yet
+            bool nonDecreasing; // the values of the middle band are non decreasing so far
+            bool nonIncreasing; // the values of the middle band are non increasing so far
+            unsigned long start; // position of the first value in the middle band
+        };
+
+        static Level levelOf(SP_RealType snr)
+        {
+            if (snr >= 0.75) {
+                return HIGH_LEVEL;
+            }
+            return snr <= 0.25 ? LOW_LEVEL : MIDDLE_LEVEL;
+        }
+
+        Level levelAt(unsigned long position) const { return m_levels[position & HISTORY_MASK]; }
+
+        SP_RealType valueAt(unsigned long position) const { return m_values[position & HISTORY_MASK]; }
+
+        /**
+         * @brief True if the values [first, first + 2] are all at the given level
+         */
+        bool isLevel(unsigned long first, Level level) const
+        {
+            return levelAt(first) == level && levelAt(first + 1) == level && levelAt(first + 2) == level;
+        }
+
+        /**
+         * @brief Welford update of the mean and the sum of squared differences
+         *
+         * @param snr The new SNR value
+         */
+        void updateMoments(SP_RealType snr)
+        {
+            const SP_RealType delta = snr - m_mean;
+            m_mean += delta / static_cast<SP_RealType>(m_count);
+            m_m2 += delta * (snr - m_mean);
+        }
+
+        /**
+         * @brief Update the switch count with the level patterns around a position, as ExerciseSwitch.
+         * A level ends after 3 values followed by the middle band, and starts after the middle band
+         * with 3 values. A transition from the end of a level to the start of the opposite one is a
+         * switch when its values in the middle band are monotonic, 3 values of a level directly
+         * followed by 3 values of the opposite one are a switch too.
+         *
+         * @param position The position of the value, 3 values are known after it
+         */
+        void updateSwitch(unsigned long position)
+        {
+            for (int kind = 0; kind < TRANSITION_KINDS; ++kind) {
+                Transition& transition = m_transitions[kind];
+                if (transition.pending && position > transition.start) {
+                    const SP_RealType previous = valueAt(position - 1);
+                    const SP_RealType current = valueAt(position);
+                    transition.nonDecreasing = transition.nonDecreasing && !(current < previous);
+                    transition.nonIncreasing = transition.nonIncreasing && !(current > previous);
+                }
+            }
+
+            const Level current = levelAt(position);
+            const Level next = levelAt(position + 1);
+            if (isLevel(position - 2, HIGH_LEVEL) && next == MIDDLE_LEVEL) {
+                beginTransition(HIGH_TO_LOW, position + 1);
+            } else if (current == MIDDLE_LEVEL && isLevel(position + 1, LOW_LEVEL)) {
+                endTransition(HIGH_TO_LOW);
+            } else if (isLevel(position - 2, LOW_LEVEL) && next == MIDDLE_LEVEL) {
+                beginTransition(LOW_TO_HIGH, position + 1);
+            } else if (current == MIDDLE_LEVEL && isLevel(position + 1, HIGH_LEVEL)) {
+                endTransition(LOW_TO_HIGH);
+            } else if ((isLevel(position - 2, HIGH_LEVEL) && isLevel(position + 1, LOW_LEVEL))
+                       || (isLevel(position - 2, LOW_LEVEL) && isLevel(position + 1, HIGH_LEVEL))) {
+                ++m_directSwitchCount;
+            }
+        }
+
+        void beginTransition(TransitionKind kind, unsigned long start)
+        {
+            Transition& transition = m_transitions[kind];
+            transition.pending = true;
+            transition.nonDecreasing = true;
+            transition.nonIncreasing = true;
+            transition.start = start;
+        }
+
+        void endTransition(TransitionKind kind)
+        {
+            Transition& transition = m_transitions[kind];
+            if (!transition.pending) {
+                return;
+            }
+            m_hasTransition = true;
+            if (transition.nonDecreasing || transition.nonIncreasing) {
+                ++m_transitionSwitchCount;
+            }
+            transition.pending = false;
+        }
+
+        /**
+         * @brief Sum of the distances to the threshold, one value per second.
+         *
+         * @param excess The new value minus the threshold
+         */
+        void updateAreas(SP_RealType excess)
+        {
+            if (excess > 0) {
+                m_sumUp += excess;
+                m_hasUp = true;
+            } else {
+                m_sumDown -= excess;
+                m_hasDown = true;
+            }
+            if (m_count == 1) {
+                m_firstExcess = excess;
+            }
+            m_lastExcess = excess;
+        }
+
+        /**
+         * @brief Area above the threshold, the first and last values of a session which never goes below
+         * the threshold count for half a second as in the trapezoidal rule of SNR_Statistics
+         */
+        SP_RealType areaUp() const
+        {
+            return m_hasDown ? m_sumUp : m_sumUp - (m_firstExcess + m_lastExcess) / 2;
+        }
+
+        /**
+         * @brief Area below the threshold, with the same rule as areaUp() for a session which never goes
+         * above the threshold
+         */
+        SP_RealType areaDown() const
+        {
+            return m_hasUp || !m_hasDown ? m_sumDown : m_sumDown + (m_firstExcess + m_lastExcess) / 2;
+        }
+
+        SP_RealType m_threshold; // exercise threshold
+
+        unsigned long m_count; // number of valid values
+        SP_RealType m_mean; // running mean
+        SP_RealType m_m2; // running sum of squared differences to the mean
+
+        SP_RealType m_values[HISTORY_SIZE]; // last values, indexed by position
+        Level m_levels[HISTORY_SIZE]; // levels of the last values, indexed by position
+        Transition m_transitions[TRANSITION_KINDS]; // transitions through the middle band
+        bool m_hasTransition; // a level was followed by the start of the opposite one
+        int m_directSwitchCount; // switches without the middle band
+        int m_transitionSwitchCount; // monotonic transitions through the middle band
+
+        SP_RealType m_sumUp; // sum of the values above the threshold
+        SP_RealType m_sumDown; // sum of the values below the threshold
+        bool m_hasUp; // a value is above the threshold
+        bool m_hasDown; // a value is at or below the threshold
+        SP_RealType m_firstExcess; // first value minus the threshold
+        SP_RealType m_lastExcess; // last value minus the threshold
+};
+
+#endif // MBT_SNR_STREAMINGSTATS_H
@@ -0,0 +1,236 @@
+/**
+ * @file MBT_ClusterIndex.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Index of the bounding boxes of the clusters of a time-frequency map, for the overlap and
+ * distance queries along the time axis.
+ * The boxes are sorted by their minimum x, with the running maximum of their maximum x: the clusters
+ * overlapping an interval are found by a binary search on the minima followed by a backward scan that
+ * stops as soon as the running maximum is before the interval, and the nearest cluster by two binary
+ * searches. A query only visits the clusters starting between the first cluster overlapping the
+ * interval and the end of the interval, instead of all the clusters of the session.
+ *
+ * The intervals are closed, as in @ref TF_Statistics::FixPartiallyOverlappingClusters: two clusters
+ * overlap when the minimum x of each one is not after the maximum x of the other. The distance between
+ * two clusters is the gap between them along x, zero when they overlap.
+ *
+ */
+
+#ifndef MBT_CLUSTERINDEX_H
+#define MBT_CLUSTERINDEX_H
+
+#include <sp-global.h>
+
+#include "TimeFrequency/MBT_ClusterTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Bounding boxes of clusters sorted along the time axis. The index is a snapshot: it must be
+ * built again when the clusters change.
+ *
+ */
+class MBT_ClusterIndex
+{
+    public:
+        MBT_ClusterIndex()
+        {}
+
+        /**
+         * @brief Build the index of the clusters of a table, its buffers are reused
+         *
+         * @param table The table, after @ref MBT_ClusterTable::computeExtents
+         */
+        void build(MBT_ClusterTable const& table)
+        {
+            build(table.minX(), table.maxX(), table.minY(), table.maxY());
+        }
+
+        /**
+         * @brief Build the index from the bounding boxes of the clusters, its buffers are reused
+         *
+         * @param minX The minimum x of each cluster
+         * @param maxX The maximum x of each cluster
+         * @param minY The minimum y of each cluster
+         * @param maxY The maximum y of each cluster
+         * @throws std::invalid_argument if the vectors do not have the same size
+         */
+        void build(SP_Vector const& minX, SP_Vector const& maxX, SP_Vector const& minY, SP_Vector const& maxY)
+        {
+            const size_t n = minX.size();
+            if (maxX.size() != n || minY.size() != n || maxY.size() != n) {
+                throw std::invalid_argument("MBT_ClusterIndex: there must be one bound of each kind per cluster");
+            }
+            m_minX.assign(minX.begin(), minX.end());
+            m_maxX.assign(maxX.begin(), maxX.end());
+            m_minY.assign(minY.begin(), minY.end());
+            m_maxY.assign(maxY.begin(), maxY.end());
+
+            m_order.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                m_order[i] = static_cast<int>(i);
+            }
+            std::sort(m_order.begin(), m_order.end(), MinXLess(m_minX));
+
+            m_sortedMinX.resize(n);
+            m_runningMax.resize(n);
+            for (size_t k = 0; k < n; ++k) {
+                const int cluster = m_order[k];
+                m_sortedMinX[k] = m_minX[cluster];
+                m_runningMax[k] = k > 0 && m_maxX[m_order[m_runningMax[k - 1]]] >= m_maxX[cluster] ? m_runningMax[k - 1] : static_cast<int>(k);
+            }
+        }
+
+        /**
+         * @brief Get the number of clusters in the index
+         */
+        int count() const { return static_cast<int>(m_order.size()); }
+
+        /**
+         * @brief Find the clusters overlapping an interval of x
+         *
+         * @param firstX The beginning of the interval
+         * @param lastX The end of the interval
+         * @param clusters Receives the indices of the clusters, sorted by decreasing minimum x, its capacity is reused
+         * @return size_t The number of clusters found
+         */
+        size_t overlapping(SP_RealType firstX, SP_RealType lastX, std::vector<int>& clusters) const
+        {
+            return overlapping(firstX, lastX, -std::numeric_limits<SP_RealType>::infinity(),
+                               std::numeric_limits<SP_RealType>::infinity(), clusters);
+        }
+
+        /**
+         * @brief Find the clusters whose bounding box overlaps a box
+         *
+         * @param firstX The beginning of the box along x
+         * @param lastX The end of the box along x
+         * @param firstY The beginning of the box along y
+         * @param lastY The end of the box along y
+         * @param clusters Receives the indices of the clusters, sorted by decreasing minimum x, its capacity is reused
+         * @return size_t The number of clusters found
+         */
+        size_t overlapping(SP_RealType firstX, SP_RealType lastX, SP_RealType firstY, SP_RealType lastY,
+                           std::vector<int>& clusters) const
+        {
+            clusters.clear();
+            // clusters starting after the interval cannot overlap it
+            size_t k = static_cast<size_t>(std::upper_bound(m_sortedMinX.begin(), m_sortedMinX.end(), lastX) - m_sortedMinX.begin());
+            while (k > 0 && m_maxX[m_order[m_runningMax[k - 1]]] >= firstX) {
+                --k;
+                const int cluster = m_order[k];
+                if (m_maxX[cluster] >= firstX && m_minY[cluster] <= lastY && m_maxY[cluster] >= firstY) {
+                    clusters.push_back(cluster);
+                }
+            }
+            return clusters.size();
+        }
+
+        /**
+         * @brief Find the clusters overlapping a cluster of the index along x, the cluster itself excluded
+         *
+         * @param cluster The index of the cluster
+         * @param clusters Receives the indices of the clusters, sorted by decreasing minimum x, its capacity is reused
+         * @return size_t The number of clusters found
+         */
+        size_t overlapping(int cluster, std::vector<int>& clusters) const
+        {
+            checkCluster(cluster);
+            overlapping(m_minX[cluster], m_maxX[cluster], clusters);
+            clusters.erase(std::remove(clusters.begin(), clusters.end(), cluster), clusters.end());
+            return clusters.size();
+        }
+
+        /**
+         * @brief Find the cluster nearest to an interval of x
+         *
+         * @param firstX The beginning of the interval
+         * @param lastX The end of the interval
+         * @param distance Receives the distance to the cluster, 0 if it overlaps the interval
+         * @return int The index of the cluster, -1 if the index is empty
+         */
+        int nearest(SP_RealType firstX, SP_RealType lastX, SP_RealType& distance) const
+        {
+            distance = std::numeric_limits<SP_RealType>::infinity();
+            int result = -1;
+            // the cluster ending last among the ones starting before the end of the interval
+            const size_t before = static_cast<size_t>(std::upper_bound(m_sortedMinX.begin(), m_sortedMinX.end(), lastX) - m_sortedMinX.begin());
+            if (before > 0) {
+                const int cluster = m_order[m_runningMax[before - 1]];
+                distance = std::max<SP_RealType>(firstX - m_maxX[cluster], 0);
+                result = cluster;
+            }
+            // the first cluster starting after the interval
+            if (before < m_order.size() && m_sortedMinX[before] - lastX < distance) {
+                distance = m_sortedMinX[before] - lastX;
+                result = m_order[before];
+            }
+            return result;
+        }
+
+        /**
+         * @brief Find the cluster nearest to a cluster of the index along x, the cluster itself excluded
+         *
+         * @param cluster The index of the cluster
+         * @param distance Receives the distance to the nearest cluster, 0 if they overlap
+         * @return int The index of the nearest cluster (one of the overlapping ones if any), -1 if there is no other cluster
+         */
+        int nearest(int cluster, SP_RealType& distance) const
+        {
+            checkCluster(cluster);
+            distance = 0;
+            size_t k = static_cast<size_t>(std::upper_bound(m_sortedMinX.begin(), m_sortedMinX.end(), m_maxX[cluster]) - m_sortedMinX.begin());
+            while (k > 0 && m_maxX[m_order[m_runningMax[k - 1]]] >= m_minX[cluster]) {
+                --k;
+                const int other = m_order[k];
+                if (other != cluster && m_maxX[other] >= m_minX[cluster]) {
+                    return other;
+                }
+            }
+            // no overlap: the nearest cluster is either the one ending last before it or the first one after it
+            distance = std::numeric_limits<SP_RealType>::infinity();
+            int result = -1;
+            const size_t before = static_cast<size_t>(std::lower_bound(m_sortedMinX.begin(), m_sortedMinX.end(), m_minX[cluster]) - m_sortedMinX.begin());
+            if (before > 0) {
+                const int candidate = m_order[m_runningMax[before - 1]];
+                distance = m_minX[cluster] - m_maxX[candidate];
+                result = candidate;
+            }
+            const size_t after = static_cast<size_t>(std::upper_bound(m_sortedMinX.begin(), m_sortedMinX.end(), m_maxX[cluster]) - m_sortedMinX.begin());
+            if (after < m_order.size() && m_sortedMinX[after] - m_maxX[cluster] < distance) {
+                distance = m_sortedMinX[after] - m_maxX[cluster];
+                result = m_order[after];
+            }
+            return result;
+        }
+
+    private:
+        struct MinXLess {
+            explicit MinXLess(SP_Vector const& minX) : minX(minX) {}
+            bool operator()(int a, int b) const { return minX[a] < minX[b] || (minX[a] == minX[b] && a < b); }
+            SP_Vector const& minX;
+        };
+
+        void checkCluster(int cluster) const
+        {
+            if (cluster < 0 || cluster >= count()) {
+                throw std::out_of_range("Out of range accessor");
+            }
+        }
+
+        SP_Vector m_minX; // minimum x of each cluster
+        SP_Vector m_maxX; // maximum x of each cluster
+        SP_Vector m_minY; // minimum y of each cluster
+        SP_Vector m_maxY; // maximum y of each cluster
+        std::vector<int> m_order; // clusters sorted by minimum x
+        SP_Vector m_sortedMinX; // minimum x of the sorted clusters
+        std::vector<int> m_runningMax; // position in m_order of the largest maximum x up to each position
+};
+
+#endif // MBT_CLUSTERINDEX_H
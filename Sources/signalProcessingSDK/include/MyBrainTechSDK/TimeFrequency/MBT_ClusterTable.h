@@ -0,0 +1,656 @@
+/**
+ * @file MBT_ClusterTable.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Statistics of the clusters of a time-frequency map computed in one table.
+ * @ref CalculateStatistics chains the methods of @ref TF_Statistics, which all take their matrices and
+ * vectors of vectors by value and return new ones: every stage copies all the points of all the clusters,
+ * sometimes several times. The table below keeps the points of all the clusters in one x array and one
+ * y array indexed by offsets, with the statistics of each cluster in parallel arrays, and each stage
+ * updates it in place. The buffers are kept between the maps, so a table reused for a whole session
+ * only allocates when a map has more points than the previous ones.
+ *
+ * The stages and their results are the ones of @ref CalculateStatistics, including its peculiarities
+ * (the last overlap is never checked, the merged clusters are compared with the overlap computed before
+ * the merge...), so that the results can be compared with the ones of the previous sessions.
+ *
+ */
+
+#ifndef MBT_CLUSTERTABLE_H
+#define MBT_CLUSTERTABLE_H
+
+#include <sp-global.h>
+#include <sp-instrumentation.h>
+
+#include "DataManipulation/MBT_Matrix.h"
+#include "TimeFrequency/MBT_MarchingSquares.h"
+#include "TimeFrequency/MBT_TF_Stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// The areas and the centers are rounded as in CalculateStatistics, FMA contraction is off
+SP_FP_CONTRACT_OFF_BEGIN
+
+/**
+ * @brief Clusters of a time-frequency map and their statistics, stored cluster after cluster.
+ * Not thread safe: use one table per thread.
+ *
+ */
+class MBT_ClusterTable
+{
+    public:
+        MBT_ClusterTable()
+        : m_offsets(1, 0), m_rowCount(5)
+        {}
+
+        /**
+         * @brief Forget all the clusters, the buffers keep their capacity
+         */
+        void clear()
+        {
+            m_x.clear();
+            m_y.clear();
+            m_offsets.assign(1, 0);
+            resizeStatistics(0);
+        }
+
+        /**
+         * @brief Fill the table with the contours given by @ref Contourc and their bounds given by @ref C2xyz
+         *
+         * @param contours The contours, one column (level, number of points) before the points of each contour
+         * @param bounds The columns of the first and of the last points of each contour
+         * @throws std::invalid_argument if a bound is outside of the contours
+         */
+        void assign(SP_Matrix const& contours, MBT_Matrix<int> const& bounds)
+        {
+            clear();
+            const int columns = contours.size().second;
+            const int count = bounds.size().second;
+            if (count == 0) {
+                return;
+            }
+            const SP_RealType* xs = contours.rowData(0);
+            const SP_RealType* ys = contours.rowData(1);
+            const int* firsts = bounds.rowData(0);
+            const int* lasts = bounds.rowData(1);
+            for (int i = 0; i < count; ++i) {
+                if (firsts[i] < 0 || lasts[i] >= columns || lasts[i] < firsts[i]) {
+                    throw std::invalid_argument("MBT_ClusterTable: the bounds must be inside of the contours");
+                }
+                m_x.insert(m_x.end(), xs + firsts[i], xs + lasts[i] + 1);
+                m_y.insert(m_y.end(), ys + firsts[i], ys + lasts[i] + 1);
+                m_offsets.push_back(static_cast<int>(m_x.size()));
+            }
+            resizeStatistics(count);
+        }
+
+        /**
+         * @brief Fill the table with the contours given by @ref MBT_MarchingSquares
+         */
+        void assign(MBT_Polylines const& contours)
+        {
+            clear();
+            m_x.assign(contours.x.begin(), contours.x.end());
+            m_y.assign(contours.y.begin(), contours.y.end());
+            m_offsets.assign(contours.offsets.begin(), contours.offsets.end());
+            resizeStatistics(count());
+        }
+
+        /**
+         * @brief Get the number of clusters
+         */
+        int count() const { return static_cast<int>(m_offsets.size()) - 1; }
+
+        /**
+         * @brief Get the number of points of a cluster
+         */
+        int size(int cluster) const
+        {
+            checkCluster(cluster);
+            return m_offsets[cluster + 1] - m_offsets[cluster];
+        }
+
+        /**
+         * @brief Get the x coordinates (columns of the map, from 1) of the points of a cluster
+         */
+        const SP_RealType* x(int cluster) const
+        {
+            checkCluster(cluster);
+            return m_x.data() + m_offsets[cluster];
+        }
+
+        /**
+         * @brief Get the y coordinates (rows of the map, from 1) of the points of a cluster
+         */
+        const SP_RealType* y(int cluster) const
+        {
+            checkCluster(cluster);
+            return m_y.data() + m_offsets[cluster];
+        }
+
+        /**
+         * @brief Get the statistics of the clusters, one value per cluster, as computed by the last stages
+         */
+        SP_Vector const& minX() const { return m_minX; }
+        SP_Vector const& maxX() const { return m_maxX; }
+        SP_Vector const& minY() const { return m_minY; }
+        SP_Vector const& maxY() const { return m_maxY; }
+        SP_Vector const& centerX() const { return m_centerX; }
+        SP_Vector const& centerY() const { return m_centerY; }
+        SP_Vector const& area() const { return m_area; }
+        SP_Vector const& timeLength() const { return m_timeLength; }
+        /**
+         * @brief Get the distance of each cluster to the previous one (to the column 1 for the first cluster)
+         */
+        SP_Vector const& distance() const { return m_distance; }
+
+        /**
+         * @brief Run all the stages of @ref CalculateStatistics on the clusters of the table
+         *
+         * @param TFMap The time-frequency map of the clusters
+         */
+        void computeStatistics(SP_Matrix const& TFMap)
+        {
+            SP_SCOPED_STAGE(SP_STAGE_CLUSTERS);
+            sortByMinX();
+            removeEdgePoints(TFMap);
+            computeExtents();
+            if (joinOpenClusters()) {
+                computeExtents();
+            }
+            computeAreaAndCenters();
+            removeFullyOverlappingClusters();
+            mergePartiallyOverlappingClusters();
+            computeDistances();
+        }
+
+        /**
+         * @brief Sort the clusters by their minimum x, as @ref TF_Statistics::SortClustersFromMinXToMaxX.
+         * The minimum of a cluster does not include its last point, which closes the closed contours.
+         */
+        void sortByMinX()
+        {
+            const int n = count();
+            m_keys.resize(n);
+            m_order.resize(n);
+            for (int i = 0; i < n; ++i) {
+                const int first = m_offsets[i];
+                const int last = std::max(m_offsets[i + 1] - 1, first + 1);
+                m_keys[i] = *std::min_element(m_x.begin() + first, m_x.begin() + last);
+                m_order[i] = i;
+            }
+            std::sort(m_order.begin(), m_order.end(), KeyLess(m_keys));
+
+            m_scratchX.clear();
+            m_scratchY.clear();
+            m_scratchOffsets.assign(1, 0);
+            for (int i = 0; i < n; ++i) {
+                const int cluster = m_order[i];
+                m_scratchX.insert(m_scratchX.end(), m_x.begin() + m_offsets[cluster], m_x.begin() + m_offsets[cluster + 1]);
+                m_scratchY.insert(m_scratchY.end(), m_y.begin() + m_offsets[cluster], m_y.begin() + m_offsets[cluster + 1]);
+                m_scratchOffsets.push_back(static_cast<int>(m_scratchX.size()));
+            }
+            swapScratch();
+        }
+
+        /**
+         * @brief Remove the points lying on a row of the map outside of its non zero columns, as
+         * @ref TF_Statistics::FindEdgePoints. The clusters left without points are removed, whereas
+         * @ref CalculateStatistics fails on them.
+         *
+         * @param TFMap The time-frequency map of the clusters, its last row is also the one used to find the open clusters
+         */
+        void removeEdgePoints(SP_Matrix const& TFMap)
+        {
+            const int rows = TFMap.size().first;
+            const int columns = TFMap.size().second;
+            m_rowCount = rows;
+
+            // first and last non zero columns of each row, from 1, the last transitions win
+            m_edges.assign(2 * rows, 0);
+            for (int r = 0; r < rows; ++r) {
+                const SP_RealType* values = TFMap.rowData(r);
+                for (int c = 0; c + 1 < columns; ++c) {
+                    if (values[c] == 0 && values[c + 1] != 0) {
+                        m_edges[2 * r] = c + 1;
+                    } else if (values[c] != 0 && values[c + 1] == 0) {
+                        m_edges[2 * r + 1] = c + 1;
+                    }
+                }
+            }
+
+            int kept = 0;
+            int clusters = 0;
+            int first = 0;
+            for (int i = 0; i < count(); ++i) {
+                // the offsets are rewritten on the way, the end of a cluster is read before
+                const int end = m_offsets[i + 1];
+                for (int point = first; point < end; ++point) {
+                    if (!isEdgePoint(m_x[point], m_y[point])) {
+                        m_x[kept] = m_x[point];
+                        m_y[kept] = m_y[point];
+                        ++kept;
+                    }
+                }
+                if (kept > m_offsets[clusters]) {
+                    m_offsets[++clusters] = kept;
+                }
+                first = end;
+            }
+            m_x.resize(kept);
+            m_y.resize(kept);
+            m_offsets.resize(clusters + 1);
+            resizeStatistics(clusters);
+        }
+
+        /**
+         * @brief Compute the minimum and maximum x and y of the clusters, as @ref TF_Statistics::CalculateMinMax
+         */
+        void computeExtents()
+        {
+            const int n = count();
+            resizeStatistics(n);
+            for (int i = 0; i < n; ++i) {
+                const int first = m_offsets[i];
+                const int last = m_offsets[i + 1];
+                m_minX[i] = *std::min_element(m_x.begin() + first, m_x.begin() + last);
+                m_maxX[i] = *std::max_element(m_x.begin() + first, m_x.begin() + last);
+                m_minY[i] = *std::min_element(m_y.begin() + first, m_y.begin() + last);
+                m_maxY[i] = *std::max_element(m_y.begin() + first, m_y.begin() + last);
+            }
+        }
+
+        /**
+         * @brief Join the open clusters (from the first to the last row of the map) two by two, as
+         * @ref TF_Statistics::JoinOpenClusters: the second cluster of a pair is appended to the first one,
+         * reversed if it does not start on the row where the first one ends. Needs @ref computeExtents,
+         * which must be run again after a join.
+         *
+         * @return true if clusters have been joined
+         */
+        bool joinOpenClusters()
+        {
+            const int n = count();
+            m_order.clear();
+            for (int i = 0; i < n; ++i) {
+                if (m_minY[i] == 1 && m_maxY[i] == m_rowCount) {
+                    m_order.push_back(i);
+                }
+            }
+            if (m_order.size() < 2) {
+                return false;
+            }
+
+            // partner of the first cluster of each pair, -2 for the second ones
+            m_partners.assign(n, -1);
+            for (size_t i = 0; i + 1 < m_order.size(); i += 2) {
+                m_partners[m_order[i]] = m_order[i + 1];
+                m_partners[m_order[i + 1]] = -2;
+            }
+
+            m_scratchX.clear();
+            m_scratchY.clear();
+            m_scratchOffsets.assign(1, 0);
+            for (int i = 0; i < n; ++i) {
+                if (m_partners[i] == -2) {
+                    continue;
+                }
+                m_scratchX.insert(m_scratchX.end(), m_x.begin() + m_offsets[i], m_x.begin() + m_offsets[i + 1]);
+                m_scratchY.insert(m_scratchY.end(), m_y.begin() + m_offsets[i], m_y.begin() + m_offsets[i + 1]);
+                const int partner = m_partners[i];
+                if (partner >= 0) {
+                    const int first = m_offsets[partner];
+                    const int last = m_offsets[partner + 1];
+                    if (m_y[m_offsets[i + 1] - 1] != m_y[first]) {
+                        m_scratchX.insert(m_scratchX.end(), m_x.rbegin() + (m_x.size() - last), m_x.rbegin() + (m_x.size() - first));
+                        m_scratchY.insert(m_scratchY.end(), m_y.rbegin() + (m_y.size() - last), m_y.rbegin() + (m_y.size() - first));
+                    } else {
+                        m_scratchX.insert(m_scratchX.end(), m_x.begin() + first, m_x.begin() + last);
+                        m_scratchY.insert(m_scratchY.end(), m_y.begin() + first, m_y.begin() + last);
+                    }
+                }
+                m_scratchOffsets.push_back(static_cast<int>(m_scratchX.size()));
+            }
+            swapScratch();
+            resizeStatistics(count());
+            return true;
+        }
+
+        /**
+         * @brief Compute the area, the center of gravity and the time length of the clusters, as
+         * @ref TF_Statistics::CalculateAreaAndGC and @ref TF_Statistics::CalculateTimeLength.
+         * The clusters are closed polygons, the center of a cluster of one point is NaN.
+         * Needs @ref computeExtents.
+         */
+        void computeAreaAndCenters()
+        {
+            for (int i = 0; i < count(); ++i) {
+                const SP_RealType* xs = m_x.data() + m_offsets[i];
+                const SP_RealType* ys = m_y.data() + m_offsets[i];
+                const int points = m_offsets[i + 1] - m_offsets[i];
+                // the sums are accumulated separately and in this order to keep the rounding of TF_Statistics
+                SP_RealType cross = 0;
+                for (int k = 0; k < points; ++k) {
+                    const int next = (k + 1) % points;
+                    cross += xs[next] * ys[k] - xs[k] * ys[next];
+                }
+                const SP_RealType signedArea = cross * 0.5;
+                SP_RealType momentX = 0;
+                SP_RealType momentY = 0;
+                for (int k = 0; k < points; ++k) {
+                    const int next = (k + 1) % points;
+                    const SP_RealType weight = (xs[next] * ys[k] - xs[k] * ys[next]) / 6.0;
+                    momentX += (xs[next] + xs[k]) * weight;
+                }
+                for (int k = 0; k < points; ++k) {
+                    const int next = (k + 1) % points;
+                    const SP_RealType weight = (xs[next] * ys[k] - xs[k] * ys[next]) / 6.0;
+                    momentY += (ys[next] + ys[k]) * weight;
+                }
+                m_area[i] = std::fabs(signedArea);
+                m_centerX[i] = momentX / signedArea;
+                m_centerY[i] = momentY / signedArea;
+                m_timeLength[i] = m_maxX[i] - m_minX[i];
+            }
+        }
+
+        /**
+         * @brief Remove the clusters which are inside of the previous one along x, as
+         * @ref TF_Statistics::FixFullyOverlappingClusters: if both touch the first or the last row of the
+         * map, the area of the removed cluster is subtracted, otherwise if they do not cover the same rows,
+         * it is added and the centers of gravity are averaged. Needs @ref computeAreaAndCenters.
+         */
+        void removeFullyOverlappingClusters()
+        {
+            const int n = count();
+            m_keep.assign(n, 1);
+            int reference = 0;
+            for (int i = 0; i + 1 < n; ++i) {
+                // a removed cluster is replaced by the one which absorbed it
+                const int current = m_keep[i] ? i : reference;
+                const int next = i + 1;
+                if (!(m_minX[next] - m_maxX[current] < 0 && m_maxX[next] - m_maxX[current] < 0)) {
+                    continue;
+                }
+                if ((m_minY[current] == 1 && m_minY[next] == 1) || (m_maxY[current] == m_rowCount && m_maxY[next] == m_rowCount)) {
+                    m_area[current] -= m_area[next];
+                } else if (m_minY[current] != m_minY[next] || m_maxY[current] != m_maxY[next]) {
+                    m_area[current] += m_area[next];
+                    m_centerX[current] = (m_centerX[current] + m_centerX[next]) * 0.5;
+                    m_centerY[current] = (m_centerY[current] + m_centerY[next]) * 0.5;
+                } else {
+                    continue;
+                }
+                m_keep[next] = 0;
+                reference = current;
+            }
+            removeClusters();
+        }
+
+        /**
+         * @brief Merge the clusters which overlap the next one along x, as
+         * @ref TF_Statistics::FixPartiallyOverlappingClusters. The overlaps are the ones between the
+         * clusters before any merge, and the last one is never checked. Needs @ref computeAreaAndCenters.
+         */
+        void mergePartiallyOverlappingClusters()
+        {
+            const int n = count();
+            if (n < 3) {
+                return;
+            }
+            m_keys.resize(n - 1);
+            for (int i = 0; i + 1 < n; ++i) {
+                m_keys[i] = m_minX[i + 1] - m_maxX[i];
+            }
+
+            // the cluster `current` is at the index current + merged in the overlaps and in the input clusters
+            int current = 0;
+            int merged = 0;
+            while (n - 2 - merged > current) {
+                const int next = current + merged + 1;
+                if (m_keys[current + merged] > 0) {
+                    ++current;
+                    moveCluster(next, current);
+                    continue;
+                }
+                appendPoints(next, current);
+                m_area[current] += m_area[next];
+                m_centerX[current] = (m_centerX[current] + m_centerX[next]) * 0.5;
+                m_centerY[current] = (m_centerY[current] + m_centerY[next]) * 0.5;
+                m_minX[current] = std::min(m_minX[current], m_minX[next]);
+                m_maxX[current] = std::max(m_maxX[current], m_maxX[next]);
+                m_minY[current] = std::min(m_minY[current], m_minY[next]);
+                m_maxY[current] = std::max(m_maxY[current], m_maxY[next]);
+                m_timeLength[current] = m_maxX[current] - m_minX[current];
+                ++merged;
+            }
+            for (int cluster = current + merged + 1; cluster < n; ++cluster) {
+                moveCluster(cluster, cluster - merged);
+            }
+            m_offsets.resize(n - merged + 1);
+            resizeStatistics(n - merged);
+        }
+
+        /**
+         * @brief Compute the distance along x of each cluster to the previous one, as
+         * @ref TF_Statistics::CalculateDistances. Needs @ref computeExtents.
+         */
+        void computeDistances()
+        {
+            for (int i = 0; i < count(); ++i) {
+                m_distance[i] = std::fabs(i == 0 ? 1 - m_minX[0] : m_maxX[i - 1] - m_minX[i]);
+            }
+        }
+
+        /**
+         * @brief Get the statistics in the format of @ref CalculateStatistics: the rows minimum x, maximum x,
+         * minimum y, maximum y, center of gravity x and y, area, time length and distance, then the x and the y
+         * coordinates of each cluster.
+         */
+        pair<VVDouble, vector<VVDouble>> toStatistics() const
+        {
+            const int n = count();
+            pair<VVDouble, vector<VVDouble>> statistics;
+            VVDouble& rows = statistics.first;
+            rows.reserve(9);
+            rows.push_back(m_minX);
+            rows.push_back(m_maxX);
+            rows.push_back(m_minY);
+            rows.push_back(m_maxY);
+            rows.push_back(m_centerX);
+            rows.push_back(m_centerY);
+            rows.push_back(m_area);
+            rows.push_back(m_timeLength);
+            rows.push_back(m_distance);
+
+            statistics.second.resize(2, VVDouble(n));
+            for (int i = 0; i < n; ++i) {
+                statistics.second[0][i].assign(m_x.begin() + m_offsets[i], m_x.begin() + m_offsets[i + 1]);
+                statistics.second[1][i].assign(m_y.begin() + m_offsets[i], m_y.begin() + m_offsets[i + 1]);
+            }
+            return statistics;
+        }
+
+    private:
+        struct KeyLess {
+            explicit KeyLess(SP_Vector const& sortKeys) : keys(sortKeys) {}
+            bool operator()(int a, int b) const { return keys[a] < keys[b]; }
+            SP_Vector const& keys;
+        };
+
+        void checkCluster(int cluster) const
+        {
+            if (cluster < 0 || cluster >= count()) {
+                throw std::out_of_range("Out of range accessor");
+            }
+        }
+
+        /**
+         * @brief Check if a point lies on a row of the map outside of its non zero columns
+         */
+        bool isEdgePoint(SP_RealType x, SP_RealType y) const
+        {
+            for (int r = 0; r < m_rowCount; ++r) {
+                if (y == r + 1 && (x > m_edges[2 * r + 1] || x <= m_edges[2 * r])) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void resizeStatistics(int n)
+        {
+            m_minX.resize(n);
+            m_maxX.resize(n);
+            m_minY.resize(n);
+            m_maxY.resize(n);
+            m_centerX.resize(n);
+            m_centerY.resize(n);
+            m_area.resize(n);
+            m_timeLength.resize(n);
+            m_distance.resize(n);
+        }
+
+        void swapScratch()
+        {
+            m_x.swap(m_scratchX);
+            m_y.swap(m_scratchY);
+            m_offsets.swap(m_scratchOffsets);
+        }
+
+        /**
+         * @brief Move a cluster and its statistics to a lower index, the clusters in between are overwritten
+         */
+        void moveCluster(int from, int to)
+        {
+            if (from == to) {
+                return;
+            }
+            const int first = m_offsets[from];
+            const int last = m_offsets[from + 1];
+            const int start = m_offsets[to];
+            std::copy(m_x.begin() + first, m_x.begin() + last, m_x.begin() + start);
+            std::copy(m_y.begin() + first, m_y.begin() + last, m_y.begin() + start);
+            m_offsets[to + 1] = start + last - first;
+            m_minX[to] = m_minX[from];
+            m_maxX[to] = m_maxX[from];
+            m_minY[to] = m_minY[from];
+            m_maxY[to] = m_maxY[from];
+            m_centerX[to] = m_centerX[from];
+            m_centerY[to] = m_centerY[from];
+            m_area[to] = m_area[from];
+            m_timeLength[to] = m_timeLength[from];
+            m_distance[to] = m_distance[from];
+        }
+
+        /**
+         * @brief Append the points of a cluster to the ones of a cluster at a lower index
+         */
+        void appendPoints(int from, int to)
+        {
+            const int first = m_offsets[from];
+            const int last = m_offsets[from + 1];
+            const int end = m_offsets[to + 1];
+            if (first != end) {
+                std::copy(m_x.begin() + first, m_x.begin() + last, m_x.begin() + end);
+                std::copy(m_y.begin() + first, m_y.begin() + last, m_y.begin() + end);
+            }
+            m_offsets[to + 1] = end + last - first;
+        }
+
+        /**
+         * @brief Remove the clusters which are not kept, in one pass
+         */
+        void removeClusters()
+        {
+            const int n = count();
+            int kept = 0;
+            for (int i = 0; i < n; ++i) {
+                if (m_keep[i]) {
+                    moveCluster(i, kept);
+                    ++kept;
+                }
+            }
+            m_x.resize(m_offsets[kept]);
+            m_y.resize(m_offsets[kept]);
+            m_offsets.resize(kept + 1);
+            resizeStatistics(kept);
+        }
+
+        SP_Vector m_x; // x coordinates of all the points
+        SP_Vector m_y; // y coordinates of all the points
+        std::vector<int> m_offsets; // index of the first point of each cluster, plus the total number of points
+        int m_rowCount; // number of rows of the map, the open clusters go from the row 1 to this one
+
+        SP_Vector m_minX; // minimum x of each cluster
+        SP_Vector m_maxX; // maximum x of each cluster
+        SP_Vector m_minY; // minimum y of each cluster
+        SP_Vector m_maxY; // maximum y of each cluster
+        SP_Vector m_centerX; // x of the center of gravity of each cluster
+        SP_Vector m_centerY; // y of the center of gravity of each cluster
+        SP_Vector m_area; // area of each cluster
+        SP_Vector m_timeLength; // length along x of each cluster
+        SP_Vector m_distance; // distance along x of each cluster to the previous one
+
+        SP_Vector m_scratchX; // reordered x coordinates, swapped with m_x
+        SP_Vector m_scratchY; // reordered y coordinates, swapped with m_y
+        std::vector<int> m_scratchOffsets; // offsets of the reordered clusters
+        SP_Vector m_keys; // sort keys, then overlaps between consecutive clusters
+        std::vector<int> m_order; // sorted clusters, then open clusters
+        std::vector<int> m_partners; // cluster joined to each open cluster
+        std::vector<int> m_edges; // first and last non zero columns of each row of the map
+        std::vector<char> m_keep; // clusters kept after the removal of the overlapping ones
+};
+
+/**
+ * @brief Same statistics as @ref CalculateStatistics, computed in a table which is reused between the calls
+ *
+ * @param table The table, its buffers are reused
+ * @param contours The contours of the map, as given by @ref Contourc
+ * @param bounds The bounds of the contours, as given by @ref C2xyz
+ * @param TFMap The time-frequency map
+ */
+inline pair<VVDouble, vector<VVDouble>> CalculateStatistics(MBT_ClusterTable& table, SP_Matrix const& contours, MBT_Matrix<int> const& bounds, SP_Matrix const& TFMap)
+{
+    table.assign(contours, bounds);
+    table.computeStatistics(TFMap);
+    return table.toStatistics();
+}
+
+/**
+ * @brief Same statistics as @ref CalculateStatistics on the output of @ref Contourc and @ref C2xyz,
+ * computed from the contours of @ref MBT_MarchingSquares: the points are copied once into the table,
+ * without building the contour matrix and its bounds
+ *
+ * @param table The table, its buffers are reused
+ * @param contours The contours of the map
+ * @param TFMap The time-frequency map
+ */
+inline pair<VVDouble, vector<VVDouble>> CalculateStatistics(MBT_ClusterTable& table, MBT_Polylines const& contours, SP_Matrix const& TFMap)
+{
+    table.assign(contours);
+    table.computeStatistics(TFMap);
+    return table.toStatistics();
+}
+
+/**
+ * @brief Same as above, with a table used for this call only
+ *
+ * @param contours The contours of the map
+ * @param TFMap The time-frequency map
+ */
+inline pair<VVDouble, vector<VVDouble>> CalculateStatistics(MBT_Polylines const& contours, SP_Matrix const& TFMap)
+{
+    MBT_ClusterTable table;
+    return CalculateStatistics(table, contours, TFMap);
+}
+
+SP_FP_CONTRACT_OFF_END
+
+#endif // MBT_CLUSTERTABLE_H
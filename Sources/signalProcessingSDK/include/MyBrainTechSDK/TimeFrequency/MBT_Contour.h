@@ -4,6 +4,7 @@
 // 
 // Update on 03/04/2017 by Katerina Pandremmenou (convert everything from float to double)
 // Update on 5/07/2017 by Katerina Pandremmenou (fix all the warnings, put all static functions in the corresponding .cpp file)
+// Update on 19/10/2026: MBT_MarchingSquares.h gives the same contours as Contourc and C2xyz into flat buffers
 
 #ifndef _MBT_Contour_
 #define _MBT_Contour_
@@ -27,6 +28,7 @@ const int isolines = 1;
 SP_RealType ContourThresholds(SP_Matrix TFMap);
 
 // Calls all the necessary functions for drawing contours
+// (MBT_MarchingSquares extracts the same contours without growing and copying the output)
 SP_Matrix Contourc(SP_Matrix TFMap, SP_RealType threshold);
 
 // Returns the bounds of each submatrix of contour
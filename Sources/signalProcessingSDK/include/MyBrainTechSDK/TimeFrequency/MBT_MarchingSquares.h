@@ -0,0 +1,425 @@
+/**
+ * @file MBT_MarchingSquares.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Contour lines of a time-frequency map written into flat, pre-sized buffers.
+ * @ref Contourc grows its output CONTOUR_QUANT points at a time and appends each contour by copying
+ * whole matrices, then @ref C2xyz parses the result again to find the bounds of the contours.
+ * The extractor below marks the cells crossed by the level (marching squares, optionally one
+ * tile of rows per thread), counts the crossed edges to size the output once, and then traces
+ * the contours into one array of coordinates indexed by contour.
+ *
+ * The contours are the ones of @ref Contourc: same cells, same tracing, same points, and the last
+ * traced contour first, with the columns of the map as x coordinates and its rows as y coordinates,
+ * both starting at 1. Contourc also keeps the contours of its previous calls after the new ones,
+ * whereas the extractor only returns the contours of the map it is given.
+ *
+ */
+
+#ifndef MBT_MARCHINGSQUARES_H
+#define MBT_MARCHINGSQUARES_H
+
+#include <sp-global.h>
+#include <sp-instrumentation.h>
+
+#include "DataManipulation/MBT_Matrix.h"
+#include "TimeFrequency/MBT_TF_Stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// The contour points are interpolated as in Contourc, FMA contraction is off
+SP_FP_CONTRACT_OFF_BEGIN
+
+/**
+ * @brief Contour lines of one level, stored contour after contour
+ *
+ */
+struct MBT_Polylines {
+    /**
+     * @brief Level of the contours
+     */
+    SP_RealType level;
+    /**
+     * @brief x coordinates (columns of the map, from 1) of all the points
+     */
+    SP_Vector x;
+    /**
+     * @brief y coordinates (rows of the map, from 1) of all the points
+     */
+    SP_Vector y;
+    /**
+     * @brief Index of the first point of each contour, plus the total number of points
+     */
+    std::vector<int> offsets;
+
+    MBT_Polylines()
+    : level(0), offsets(1, 0)
+    {}
+
+    /**
+     * @brief Get the number of contours
+     */
+    int count() const { return static_cast<int>(offsets.size()) - 1; }
+
+    /**
+     * @brief Get the number of points of a contour
+     */
+    int size(int contour) const { return offsets[contour + 1] - offsets[contour]; }
+
+    /**
+     * @brief Get the contours in the format of @ref Contourc: for each contour, a column (level, number
+     * of points) followed by one column (x, y) per point
+     */
+    SP_Matrix toContourMatrix() const
+    {
+        const int columns = static_cast<int>(x.size()) + count();
+        SP_Matrix contours(2, columns);
+        SP_RealType* xs = contours.rowData(0);
+        SP_RealType* ys = contours.rowData(1);
+        int column = 0;
+        for (int i = 0; i < count(); ++i) {
+            xs[column] = level;
+            ys[column] = size(i);
+            ++column;
+            for (int point = offsets[i]; point < offsets[i + 1]; ++point, ++column) {
+                xs[column] = x[point];
+                ys[column] = y[point];
+            }
+        }
+        return contours;
+    }
+
+    /**
+     * @brief Get the bounds of the contours in the format of @ref C2xyz: the columns of the first and of the
+     * last points of each contour in the matrix given by @ref toContourMatrix
+     */
+    MBT_Matrix<int> toBounds() const
+    {
+        MBT_Matrix<int> bounds(2, count());
+        int* firsts = bounds.rowData(0);
+        int* lasts = bounds.rowData(1);
+        for (int i = 0; i < count(); ++i) {
+            // each contour is shifted by the header columns of the contours before it and its own
+            firsts[i] = offsets[i] + i + 1;
+            lasts[i] = offsets[i + 1] + i;
+        }
+        return bounds;
+    }
+
+    /**
+     * @brief Get the coordinates of each contour, as @ref TF_Statistics::AssignClusterValuesToVectors
+     * returns them from the contour matrix and its bounds
+     */
+    pair<VVDouble, VVDouble> toVectors() const
+    {
+        pair<VVDouble, VVDouble> coordinates;
+        coordinates.first.resize(count());
+        coordinates.second.resize(count());
+        for (int i = 0; i < count(); ++i) {
+            coordinates.first[i].assign(x.begin() + offsets[i], x.begin() + offsets[i + 1]);
+            coordinates.second[i].assign(y.begin() + offsets[i], y.begin() + offsets[i + 1]);
+        }
+        return coordinates;
+    }
+};
+
+namespace MBT_MarchingSquaresDetail {
+
+/**
+ * @brief Distance of a value to the level, values closer than epsilon are moved above it as in @ref Contourc
+ */
+inline SP_RealType levelDistance(SP_RealType value, SP_RealType level)
+{
+    const SP_RealType epsilon = std::numeric_limits<SP_RealType>::epsilon();
+    const SP_RealType distance = value - level;
+    return std::fabs(distance) < epsilon ? epsilon : distance;
+}
+
+/**
+ * @brief Mark the cells of the rows [first, last) of the map: bit 0 for the top edge crossed by the level,
+ * 1 for the right one, 2 for the bottom one and 3 for the left one
+ *
+ * @return size_t The number of crossed edges counted from these cells
+ */
+inline size_t markRows(const SP_Matrix& map, SP_RealType level, int first, int last, signed char* marks)
+{
+    const int columns = map.size().second;
+    std::vector<SP_RealType> above(columns);
+    std::vector<SP_RealType> below(columns);
+    size_t crossings = 0;
+    if (first < last) {
+        const SP_RealType* values = map.rowData(first);
+        for (int c = 0; c < columns; ++c) {
+            above[c] = levelDistance(values[c], level);
+        }
+    }
+    for (int r = first; r < last; ++r) {
+        const SP_RealType* values = map.rowData(r + 1);
+        for (int c = 0; c < columns; ++c) {
+            below[c] = levelDistance(values[c], level);
+        }
+        signed char* rowMarks = marks + static_cast<size_t>(r) * (columns - 1);
+        for (int c = 0; c + 1 < columns; ++c) {
+            const int top = above[c] * above[c + 1] < 0;
+            const int right = above[c + 1] * below[c + 1] < 0;
+            const int bottom = below[c] * below[c + 1] < 0;
+            const int left = above[c] * below[c] < 0;
+            rowMarks[c] = static_cast<signed char>(top | right << 1 | bottom << 2 | left << 3);
+            crossings += top + right + bottom + left;
+        }
+        above.swap(below);
+    }
+    return crossings;
+}
+
+} // namespace MBT_MarchingSquaresDetail
+
+/**
+ * @brief Contour extractor, which keeps its cell marks between the maps. Not thread safe: use one
+ * extractor per calling thread, it runs its own worker threads.
+ *
+ */
+class MBT_MarchingSquares
+{
+    public:
+        /**
+         * @brief Construct a new extractor
+         *
+         * @param threadCount Number of tiles of rows marked in parallel, 1 to mark the cells in the calling thread
+         */
+        explicit MBT_MarchingSquares(unsigned int threadCount = 1)
+        : m_threadCount(std::max(threadCount, 1u)), m_rows(0), m_columns(0)
+        {}
+
+        /**
+         * @brief Extract the contours of a level, same contours as @ref Contourc
+         *
+         * @param map The map, the x axis being its columns and the y axis its rows
+         * @param level The level of the contours
+         * @param contours Receives the contours, its capacity is reused
+         */
+        void extract(SP_Matrix const& map, SP_RealType level, MBT_Polylines& contours)
+        {
+            SP_SCOPED_STAGE_BYTES(SP_STAGE_CONTOURS, static_cast<size_t>(map.size().first) * map.size().second * sizeof(SP_RealType));
+            contours.level = level;
+            contours.x.clear();
+            contours.y.clear();
+            contours.offsets.assign(1, 0);
+
+            m_rows = map.size().first - 1;
+            m_columns = map.size().second - 1;
+            if (m_rows < 1 || m_columns < 1) {
+                return;
+            }
+
+            const size_t crossings = markCells(map, level);
+            // boundary edges belong to one cell only, the others to two
+            size_t boundary = 0;
+            for (int c = 0; c < m_columns; ++c) {
+                boundary += (mark(0, c) & 1) + ((mark(m_rows - 1, c) & 4) >> 2);
+            }
+            for (int r = 0; r < m_rows; ++r) {
+                boundary += ((mark(r, 0) & 8) >> 3) + ((mark(r, m_columns - 1) & 2) >> 1);
+            }
+            const size_t edges = (crossings + boundary) / 2;
+            // one point per crossed edge, plus the first point repeated by the closed contours (4 edges at least)
+            contours.x.reserve(edges + edges / 4 + 1);
+            contours.y.reserve(edges + edges / 4 + 1);
+            contours.offsets.reserve(edges / 2 + 2);
+
+            // contours starting on a boundary first, then the closed ones
+            for (int c = 0; c < m_columns; ++c) {
+                if (mark(0, c) & 1) {
+                    trace(map, level, 0, c, 0, contours);
+                }
+                if (mark(m_rows - 1, c) & 4) {
+                    trace(map, level, m_rows - 1, c, 2, contours);
+                }
+            }
+            for (int r = 0; r < m_rows; ++r) {
+                if (mark(r, 0) & 8) {
+                    trace(map, level, r, 0, 3, contours);
+                }
+                if (mark(r, m_columns - 1) & 2) {
+                    trace(map, level, r, m_columns - 1, 1, contours);
+                }
+            }
+            for (int r = 0; r < m_rows; ++r) {
+                for (int c = 0; c < m_columns; ++c) {
+                    if (mark(r, c) > 0) {
+                        trace(map, level, r, c, NO_EDGE, contours);
+                    }
+                }
+            }
+            reverseContours(contours);
+        }
+
+    private:
+        enum { NO_EDGE = 255 };
+
+        signed char& mark(int r, int c) { return m_marks[static_cast<size_t>(r) * m_columns + c]; }
+
+        size_t markCells(SP_Matrix const& map, SP_RealType level)
+        {
+            m_marks.resize(static_cast<size_t>(m_rows) * m_columns);
+            const int tiles = static_cast<int>(std::min(m_threadCount, static_cast<unsigned int>(m_rows)));
+            if (tiles == 1) {
+                return MBT_MarchingSquaresDetail::markRows(map, level, 0, m_rows, m_marks.data());
+            }
+
+            std::vector<size_t> crossings(tiles, 0);
+            std::vector<std::thread> threads;
+            threads.reserve(tiles - 1);
+            for (int tile = 1; tile < tiles; ++tile) {
+                threads.push_back(std::thread(&MBT_MarchingSquares::markTile, this, std::cref(map), level, tile, tiles,
+                                              std::ref(crossings[tile])));
+            }
+            markTile(map, level, 0, tiles, crossings[0]);
+            size_t total = crossings[0];
+            for (int tile = 1; tile < tiles; ++tile) {
+                threads[tile - 1].join();
+                total += crossings[tile];
+            }
+            return total;
+        }
+
+        void markTile(SP_Matrix const& map, SP_RealType level, int tile, int tiles, size_t& crossings)
+        {
+            const int first = static_cast<int>(static_cast<long long>(m_rows) * tile / tiles);
+            const int last = static_cast<int>(static_cast<long long>(m_rows) * (tile + 1) / tiles);
+            crossings = MBT_MarchingSquaresDetail::markRows(map, level, first, last, m_marks.data());
+        }
+
+        /**
+         * @brief Follow a contour from a cell and an entry edge (NO_EDGE for the last edge of the cell), with the
+         * operations of the drawcn function of @ref Contourc. Contours of less than 2 points are dropped.
+         */
+        void trace(SP_Matrix const& map, SP_RealType level, int r, int c, unsigned int startEdge, MBT_Polylines& contours)
+        {
+            const size_t start = contours.x.size();
+            bool isFirst = true;
+
+            while (r >= 0 && c >= 0 && r < m_rows && c < m_columns && mark(r, c) > 0) {
+                const SP_RealType left = c + 1;
+                const SP_RealType right = c + 2;
+                const SP_RealType top = r + 1;
+                const SP_RealType bottom = r + 2;
+                const SP_RealType px[4] = {left, right, right, left};
+                const SP_RealType py[4] = {top, top, bottom, bottom};
+                const SP_RealType* topValues = map.rowData(r);
+                const SP_RealType* bottomValues = map.rowData(r + 1);
+                const SP_RealType pz[4] = {topValues[c] - level, topValues[c + 1] - level,
+                                           bottomValues[c + 1] - level, bottomValues[c] - level};
+
+                const int id = mark(r, c);
+                if (startEdge == NO_EDGE) {
+                    for (unsigned int edge = 0; edge < 4; ++edge) {
+                        if (id & (1 << edge)) {
+                            startEdge = edge;
+                        }
+                    }
+                    if (startEdge == NO_EDGE) {
+                        break;
+                    }
+                }
+                mark(r, c) = static_cast<signed char>(mark(r, c) - (1 << startEdge));
+
+                if (isFirst) {
+                    addPoint(px, py, pz, startEdge, contours);
+                    isFirst = false;
+                }
+
+                // the exit edge is searched clockwise from the top and bottom edges, counterclockwise otherwise
+                unsigned int stopEdge = startEdge;
+                for (unsigned int k = 1; k <= 4; ++k) {
+                    stopEdge = (startEdge == 0 || startEdge == 2) ? (startEdge + k) & 3 : (startEdge - k) & 3;
+                    if (id & (1 << stopEdge)) {
+                        break;
+                    }
+                }
+                addPoint(px, py, pz, stopEdge, contours);
+                mark(r, c) = static_cast<signed char>(mark(r, c) - (1 << stopEdge));
+
+                switch (stopEdge) {
+                    case 0: --r; break;
+                    case 1: ++c; break;
+                    case 2: ++r; break;
+                    default: --c; break;
+                }
+                startEdge = (stopEdge + 2) & 3;
+            }
+
+            if (contours.x.size() - start < 2) {
+                contours.x.resize(start);
+                contours.y.resize(start);
+            } else {
+                contours.offsets.push_back(static_cast<int>(contours.x.size()));
+            }
+        }
+
+        /**
+         * @brief Reverse the order of the contours, keeping the order of their points: @ref Contourc puts each
+         * new contour before the previous ones
+         */
+        static void reverseContours(MBT_Polylines& contours)
+        {
+            const int total = contours.offsets.back();
+            std::reverse(contours.x.begin(), contours.x.end());
+            std::reverse(contours.y.begin(), contours.y.end());
+            std::reverse(contours.offsets.begin(), contours.offsets.end());
+            for (size_t i = 0; i < contours.offsets.size(); ++i) {
+                contours.offsets[i] = total - contours.offsets[i];
+            }
+            for (int i = 0; i < contours.count(); ++i) {
+                std::reverse(contours.x.begin() + contours.offsets[i], contours.x.begin() + contours.offsets[i + 1]);
+                std::reverse(contours.y.begin() + contours.offsets[i], contours.y.begin() + contours.offsets[i + 1]);
+            }
+        }
+
+        /**
+         * @brief Add the point of an edge where the map crosses the level, linearly interpolated
+         */
+        static void addPoint(const SP_RealType* px, const SP_RealType* py, const SP_RealType* pz, unsigned int edge,
+                             MBT_Polylines& contours)
+        {
+            const unsigned int next = (edge + 1) & 3;
+            const SP_RealType ratio = std::fabs(pz[next]) / std::fabs(pz[edge]);
+            if (std::isnan(ratio)) {
+                contours.x.push_back(0.5);
+                contours.y.push_back(0.5);
+                return;
+            }
+            contours.x.push_back(px[edge] + (px[next] - px[edge]) / (ratio + 1));
+            contours.y.push_back(py[edge] + (py[next] - py[edge]) / (ratio + 1));
+        }
+
+        unsigned int m_threadCount; // number of tiles marked in parallel
+        int m_rows; // number of rows of cells
+        int m_columns; // number of columns of cells
+        std::vector<signed char> m_marks; // crossed edges of each cell, row after row
+};
+
+/**
+ * @brief Extract the contours of a level of a map, same contours as @ref Contourc
+ *
+ * @param map The map
+ * @param level The level of the contours
+ * @return MBT_Polylines The contours
+ */
+inline MBT_Polylines MBT_contourPolylines(SP_Matrix const& map, SP_RealType level)
+{
+    MBT_Polylines contours;
+    MBT_MarchingSquares().extract(map, level, contours);
+    return contours;
+}
+
+SP_FP_CONTRACT_OFF_END
+
+#endif // MBT_MARCHINGSQUARES_H
@@ -0,0 +1,481 @@
+/**
+ * @file MBT_TF_Engine.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Time-frequency maps computed in the frequency domain, with cached wavelet spectra and FFT plans.
+ * @ref TF convolves the signal with the Morlet wavelet of each frequency through @ref fft_convolve,
+ * which pads, plans and transforms both the signal and the wavelet again for every frequency.
+ * The engine below transforms the signal once, keeps the spectra of the wavelets for each
+ * (signal length, frequency set) and the FFT plans for each transform size, and then runs one
+ * inverse transform per frequency, the frequencies being shared between worker threads.
+ * The cache is bounded: the least recently used spectra are dropped, with the plans no longer
+ * used by the remaining ones, once the engine has seen more (signal length, frequency set) pairs
+ * than its capacity.
+ *
+ * The wavelets are the ones of @ref TF and the maps are the same up to floating point round-off,
+ * since the transforms are not of the same size.
+ *
+ */
+
+#ifndef MBT_TF_ENGINE_H
+#define MBT_TF_ENGINE_H
+
+#include <sp-global.h>
+#include <sp-instrumentation.h>
+
+#include "DataManipulation/MBT_Matrix.h"
+#include "TimeFrequency/MBT_TF_map.h"
+
+#include <fftw3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#define TF_ENGINE_KERNEL_CACHE_CAPACITY 8
+
+namespace MBT_TFEngineDetail {
+
+/**
+ * @brief Standard deviation in time of the wavelets times their frequency, as TF_map::sigma_tc
+ */
+inline SP_RealType sigmaTime()
+{
+    return 3 / std::sqrt(8 * std::log(static_cast<SP_RealType>(2)));
+}
+
+/**
+ * @brief Imaginary unit of @ref TF, computed as the square root of -1 with the polar form:
+ * its real part is the rounding error of cos(pi / 2), kept so that the wavelets are the same
+ */
+inline SP_Complex imaginaryUnit()
+{
+    const SP_Complex minusOne(-1, 0);
+    return std::polar(std::sqrt(std::abs(minusOne)), std::arg(minusOne) / 2);
+}
+
+/**
+ * @brief Morlet wavelet of a frequency, sampled every 1 / fs from -3 to 3 standard deviations,
+ * with the same operations as @ref TF
+ *
+ * @param frequency The frequency of the wavelet, in Hz
+ * @param fs The sampling rate
+ * @return SP_ComplexVector The samples of the wavelet
+ */
+inline SP_ComplexVector morletWavelet(const SP_RealType frequency, const SP_RealType fs)
+{
+    const SP_RealType sigma = sigmaTime();
+    const SP_RealType dt = 1 / fs;
+    const SP_RealType deviation = sigma / frequency;
+    const SP_RealType last = deviation * 3;
+    const SP_RealType amplitude = std::sqrt(frequency) * std::pow(std::sqrt(SP_PI) * sigma, static_cast<SP_RealType>(-0.5));
+    const SP_RealType denominator = -2 * sigma * sigma;
+    const SP_Complex unit = imaginaryUnit();
+    const SP_RealType turnReal = unit.real() * (SP_PI * 2);
+    const SP_RealType turnImaginary = unit.imag() * (SP_PI * 2);
+
+    SP_ComplexVector wavelet;
+    for (SP_RealType t = deviation * -3; t <= last; t += dt) {
+        const SP_RealType phase = t * frequency;
+        const SP_RealType envelope = std::exp(phase * phase / denominator) * amplitude;
+        // exp(x + iy) in polar form, as the complex exponential of libc++
+        const SP_RealType magnitude = std::exp(phase * turnReal);
+        const SP_RealType angle = phase * turnImaginary;
+        wavelet.push_back(SP_Complex(envelope * (magnitude * std::cos(angle)), envelope * (magnitude * std::sin(angle))));
+    }
+    return wavelet;
+}
+
+/**
+ * @brief Smallest size at least equal to the given one whose prime factors are 2, 3 and 5,
+ * for which FFTW is the fastest
+ */
+inline int fastFFTSize(int minimum)
+{
+    for (int size = std::max(minimum, 1); ; ++size) {
+        int rest = size;
+        const int factors[3] = {2, 3, 5};
+        for (int i = 0; i < 3; ++i) {
+            while (rest % factors[i] == 0) {
+                rest /= factors[i];
+            }
+        }
+        if (rest == 1) {
+            return size;
+        }
+    }
+}
+
+/**
+ * @brief Number of complex values between two transforms stored in the same buffer,
+ * rounded so that each transform keeps the alignment of the buffer
+ */
+inline size_t alignedStride(int fftSize)
+{
+    return (static_cast<size_t>(fftSize) + 3) & ~static_cast<size_t>(3);
+}
+
+/**
+ * @brief The FFTW planner is not thread safe: all the plans are created and destroyed under this lock
+ */
+inline std::mutex& plannerMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+/**
+ * @brief Buffer of complex values allocated by FFTW, aligned for its SIMD code
+ *
+ */
+class FFTBuffer
+{
+    public:
+        FFTBuffer()
+        : m_data(0), m_size(0)
+        {}
+
+        ~FFTBuffer()
+        {
+            if (m_data) {
+                fftw_free(m_data);
+            }
+        }
+
+        FFTBuffer(const FFTBuffer&) = delete;
+        FFTBuffer& operator=(const FFTBuffer&) = delete;
+
+        /**
+         * @brief Get a buffer of at least the given size, the values are not kept
+         */
+        void reserve(size_t size)
+        {
+            if (size <= m_size) {
+                return;
+            }
+            if (m_data) {
+                fftw_free(m_data);
+                m_data = 0;
+                m_size = 0;
+            }
+            m_data = static_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex) * size));
+            if (!m_data) {
+                throw std::bad_alloc();
+            }
+            m_size = size;
+        }
+
+        fftw_complex* data() { return m_data; }
+        const fftw_complex* data() const { return m_data; }
+
+    private:
+        fftw_complex* m_data; // values, allocated by fftw_malloc
+        size_t m_size; // number of values
+};
+
+} // namespace MBT_TFEngineDetail
+
+/**
+ * @brief Engine computing the time-frequency maps of signals sampled at the same rate.
+ * The cached spectra and plans are reused by all the signals of the same length. The engine
+ * is not thread safe: use one engine per calling thread, it runs its own worker threads.
+ *
+ */
+class MBT_TFEngine
+{
+    public:
+        /**
+         * @brief Construct a new engine
+         *
+         * @param fs The sampling rate of the signals
+         * @param threadCount The number of threads sharing the frequencies, 0 for one per hardware thread
+         * @param kernelCacheCapacity The number of (signal length, frequency set) pairs whose spectra are kept
+         * @throws std::invalid_argument if the sampling rate or the cache capacity is not positive
+         */
+        explicit MBT_TFEngine(const SP_RealType fs, unsigned int threadCount = 0,
+                              size_t kernelCacheCapacity = TF_ENGINE_KERNEL_CACHE_CAPACITY)
+        : m_fs(fs), m_threadCount(threadCount > 0 ? threadCount : std::max(std::thread::hardware_concurrency(), 1u)),
+          m_kernelCacheCapacity(kernelCacheCapacity), m_useCount(0)
+        {
+            if (!(fs > 0)) {
+                throw std::invalid_argument("MBT_TFEngine: the sampling rate must be positive");
+            }
+            if (kernelCacheCapacity == 0) {
+                throw std::invalid_argument("MBT_TFEngine: the kernel cache capacity must be positive");
+            }
+        }
+
+        /**
+         * @brief Compute the power of the signal convolved with the Morlet wavelet of each frequency,
+         * as @ref TF does before applying its mask
+         *
+         * @param signal The signal
+         * @param frequencies The frequencies of the wavelets, in Hz
+         * @return SP_Matrix The map, one row per frequency and one column per sample
+         * @throws std::invalid_argument if a frequency is not positive
+         */
+        SP_Matrix compute(SP_Vector const& signal, SP_Vector const& frequencies)
+        {
+            using namespace MBT_TFEngineDetail;
+            SP_SCOPED_STAGE_BYTES(SP_STAGE_TIME_FREQUENCY, signal.size() * sizeof(SP_RealType));
+
+            const int length = static_cast<int>(signal.size());
+            const int rows = static_cast<int>(frequencies.size());
+            SP_Matrix map(rows, length);
+            if (length == 0 || rows == 0) {
+                return map;
+            }
+
+            const Kernels& kernels = getKernels(length, frequencies);
+            const Plans& plans = getPlans(kernels.fftSize);
+            const size_t stride = alignedStride(kernels.fftSize);
+
+            m_signalSpectrum.reserve(stride);
+            fftw_complex* spectrum = m_signalSpectrum.data();
+            for (int i = 0; i < kernels.fftSize; ++i) {
+                spectrum[i][0] = i < length ? static_cast<double>(signal[i]) : 0;
+                spectrum[i][1] = 0;
+            }
+            fftw_execute_dft(plans.forward, spectrum, spectrum);
+
+            const unsigned int workers = std::min(m_threadCount, static_cast<unsigned int>(rows));
+            m_workspace.reserve(stride * workers);
+            if (workers == 1) {
+                computeRows(kernels, plans, 0, 1, map);
+                return map;
+            }
+
+            std::vector<std::thread> threads;
+            threads.reserve(workers - 1);
+            for (unsigned int worker = 1; worker < workers; ++worker) {
+                threads.push_back(std::thread(&MBT_TFEngine::computeRows, this, std::cref(kernels), std::cref(plans),
+                                              worker, workers, std::ref(map)));
+            }
+            computeRows(kernels, plans, 0, workers, map);
+            for (size_t i = 0; i < threads.size(); ++i) {
+                threads[i].join();
+            }
+            return map;
+        }
+
+        /**
+         * @brief Same map as @ref TF: the frequencies are the integers from 2 Hz below to 2 Hz above the
+         * peak frequency given by @ref get_freqPeak, and the edges are masked by @ref TF_mask
+         *
+         * @param signal The signal
+         * @param powers The spectrum of the signal
+         * @param frequencies The frequencies of the spectrum
+         * @return SP_Matrix The masked map, 5 rows and one column per sample
+         */
+        SP_Matrix computeTF(SP_Vector const& signal, SP_Vector const& powers, SP_Vector const& frequencies)
+        {
+            const int peak = get_freqPeak(powers, frequencies);
+            SP_Vector band;
+            for (int frequency = peak - 2; frequency <= peak + 2; ++frequency) {
+                band.push_back(frequency);
+            }
+
+            SP_Matrix map = compute(signal, band);
+            MBT_Matrix<int> mask = TF_mask(static_cast<int>(signal.size()), peak);
+            const size_t size = static_cast<size_t>(map.size().first) * map.size().second;
+            SP_RealType* values = map.data();
+            const int* masked = mask.data();
+            for (size_t i = 0; i < size; ++i) {
+                values[i] = values[i] * static_cast<SP_RealType>(masked[i]);
+            }
+            return map;
+        }
+
+        /**
+         * @brief Get the number of cached (signal length, frequency set) pairs
+         */
+        size_t cachedKernelCount() const { return m_kernels.size(); }
+
+        /**
+         * @brief Get the number of cached transform sizes
+         */
+        size_t cachedPlanCount() const { return m_plans.size(); }
+
+        /**
+         * @brief Forget the cached spectra and plans
+         */
+        void clear()
+        {
+            m_kernels.clear();
+            m_plans.clear();
+        }
+
+    private:
+        /**
+         * @brief Forward and inverse in-place plans of a transform size
+         */
+        struct Plans {
+            fftw_plan forward;
+            fftw_plan backward;
+
+            Plans()
+            : forward(0), backward(0)
+            {}
+
+            ~Plans()
+            {
+                std::lock_guard<std::mutex> lock(MBT_TFEngineDetail::plannerMutex());
+                if (forward) {
+                    fftw_destroy_plan(forward);
+                }
+                if (backward) {
+                    fftw_destroy_plan(backward);
+                }
+            }
+
+            Plans(const Plans&) = delete;
+            Plans& operator=(const Plans&) = delete;
+        };
+
+        /**
+         * @brief Spectra of the wavelets of a frequency set for a signal length
+         */
+        struct Kernels {
+            uint64_t lastUse; // value of the use counter when the spectra were last used
+            int fftSize; // size of the transforms
+            std::vector<int> offsets; // index of the first sample of the centered convolution, per frequency
+            MBT_TFEngineDetail::FFTBuffer spectra; // spectra of the wavelets, scaled by dt / fftSize, one per stride
+        };
+
+        const Kernels& getKernels(int length, SP_Vector const& frequencies)
+        {
+            using namespace MBT_TFEngineDetail;
+
+            const std::pair<int, SP_Vector> key(length, frequencies);
+            std::map<std::pair<int, SP_Vector>, Kernels>::iterator found = m_kernels.find(key);
+            if (found != m_kernels.end()) {
+                found->second.lastUse = ++m_useCount;
+                return found->second;
+            }
+
+            std::vector<SP_ComplexVector> wavelets(frequencies.size());
+            size_t longest = 0;
+            for (size_t f = 0; f < frequencies.size(); ++f) {
+                if (!(frequencies[f] > 0)) {
+                    throw std::invalid_argument("MBT_TFEngine: the frequencies must be positive");
+                }
+                wavelets[f] = morletWavelet(frequencies[f], m_fs);
+                longest = std::max(longest, wavelets[f].size());
+            }
+
+            if (m_kernels.size() >= m_kernelCacheCapacity) {
+                evictLeastRecentlyUsed();
+            }
+
+            Kernels& kernels = m_kernels[key];
+            kernels.lastUse = ++m_useCount;
+            kernels.fftSize = fastFFTSize(length + static_cast<int>(longest) - 1);
+            const size_t stride = alignedStride(kernels.fftSize);
+            const Plans& plans = getPlans(kernels.fftSize);
+            const double scale = (1 / m_fs) / kernels.fftSize;
+
+            kernels.spectra.reserve(stride * wavelets.size());
+            for (size_t f = 0; f < wavelets.size(); ++f) {
+                const int size = static_cast<int>(wavelets[f].size());
+                fftw_complex* spectrum = kernels.spectra.data() + f * stride;
+                for (int i = 0; i < kernels.fftSize; ++i) {
+                    spectrum[i][0] = i < size ? static_cast<double>(wavelets[f][i].real()) : 0;
+                    spectrum[i][1] = i < size ? static_cast<double>(wavelets[f][i].imag()) : 0;
+                }
+                fftw_execute_dft(plans.forward, spectrum, spectrum);
+                for (int i = 0; i < kernels.fftSize; ++i) {
+                    spectrum[i][0] *= scale;
+                    spectrum[i][1] *= scale;
+                }
+                kernels.offsets.push_back(size / 2);
+            }
+            return kernels;
+        }
+
+        /**
+         * @brief Drop the least recently used spectra, and their plans if no other spectra use them
+         */
+        void evictLeastRecentlyUsed()
+        {
+            std::map<std::pair<int, SP_Vector>, Kernels>::iterator oldest = m_kernels.begin();
+            for (std::map<std::pair<int, SP_Vector>, Kernels>::iterator it = m_kernels.begin(); it != m_kernels.end(); ++it) {
+                if (it->second.lastUse < oldest->second.lastUse) {
+                    oldest = it;
+                }
+            }
+            const int fftSize = oldest->second.fftSize;
+            m_kernels.erase(oldest);
+            for (std::map<std::pair<int, SP_Vector>, Kernels>::const_iterator it = m_kernels.begin(); it != m_kernels.end(); ++it) {
+                if (it->second.fftSize == fftSize) {
+                    return;
+                }
+            }
+            m_plans.erase(fftSize);
+        }
+
+        const Plans& getPlans(int fftSize)
+        {
+            std::map<int, Plans>::iterator found = m_plans.find(fftSize);
+            if (found != m_plans.end()) {
+                return found->second;
+            }
+
+            MBT_TFEngineDetail::FFTBuffer buffer;
+            buffer.reserve(fftSize);
+            Plans& plans = m_plans[fftSize];
+            std::lock_guard<std::mutex> lock(MBT_TFEngineDetail::plannerMutex());
+            plans.forward = fftw_plan_dft_1d(fftSize, buffer.data(), buffer.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+            plans.backward = fftw_plan_dft_1d(fftSize, buffer.data(), buffer.data(), FFTW_BACKWARD, FFTW_ESTIMATE);
+            return plans;
+        }
+
+        /**
+         * @brief Compute the rows first, first + step, ... of the map, in the workspace of the worker first
+         */
+        void computeRows(const Kernels& kernels, const Plans& plans, unsigned int first, unsigned int step, SP_Matrix& map)
+        {
+            const size_t stride = MBT_TFEngineDetail::alignedStride(kernels.fftSize);
+            fftw_complex* work = m_workspace.data() + first * stride;
+            const fftw_complex* spectrum = m_signalSpectrum.data();
+            const int length = map.size().second;
+
+            for (size_t row = first; row < kernels.offsets.size(); row += step) {
+                const fftw_complex* kernel = kernels.spectra.data() + row * stride;
+                for (int i = 0; i < kernels.fftSize; ++i) {
+                    const double real = spectrum[i][0] * kernel[i][0] - spectrum[i][1] * kernel[i][1];
+                    const double imaginary = spectrum[i][0] * kernel[i][1] + spectrum[i][1] * kernel[i][0];
+                    work[i][0] = real;
+                    work[i][1] = imaginary;
+                }
+                fftw_execute_dft(plans.backward, work, work);
+
+                SP_RealType* values = map.rowData(static_cast<int>(row));
+                const fftw_complex* convolution = work + kernels.offsets[row];
+                for (int i = 0; i < length; ++i) {
+                    const SP_RealType amplitude = static_cast<SP_RealType>(std::hypot(convolution[i][0], convolution[i][1]));
+                    values[i] = amplitude * amplitude;
+                }
+            }
+        }
+
+        SP_RealType m_fs; // sampling rate of the signals
+        unsigned int m_threadCount; // maximum number of threads computing the rows
+        size_t m_kernelCacheCapacity; // maximum number of cached (signal length, frequency set) pairs
+        uint64_t m_useCount; // number of uses of the cached spectra, orders them for the eviction
+        std::map<std::pair<int, SP_Vector>, Kernels> m_kernels; // wavelet spectra by (signal length, frequency set)
+        std::map<int, Plans> m_plans; // plans by transform size
+        MBT_TFEngineDetail::FFTBuffer m_signalSpectrum; // spectrum of the current signal
+        MBT_TFEngineDetail::FFTBuffer m_workspace; // one transform per worker
+};
+
+#endif // MBT_TF_ENGINE_H
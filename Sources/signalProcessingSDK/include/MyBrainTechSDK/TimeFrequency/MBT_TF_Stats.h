@@ -5,6 +5,7 @@
 // Copyright (c) 2017 myBrain Technologies. All rights reserved.
 //
 // Update on 03/04/2017 by Katerina Pandremmenou: Convert everything from float to double
+// Update on 19/10/2026: MBT_ClusterTable.h computes the same statistics as CalculateStatistics in place, in one reusable table
 
 #ifndef MBT_TF_STATS_H
 #define MBT_TF_STATS_H
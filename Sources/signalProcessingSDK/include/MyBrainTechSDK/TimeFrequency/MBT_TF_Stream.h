@@ -0,0 +1,287 @@
+/**
+ * @file MBT_TF_Stream.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Time-frequency map computed column by column while the samples arrive.
+ * @ref TF needs the whole signal and returns the whole map, which @ref TF_mask and @ref MinMaxTFMap
+ * then scan again. The stream below keeps only the samples covered by the wavelets: a column is
+ * emitted as soon as the samples up to half the longest wavelet after it are known (or the edge mask
+ * width, if it is larger), already masked, and the minimum and maximum of the map are updated on the way.
+ * The memory used does not depend on the length of the recording.
+ *
+ * The wavelets are the ones of @ref TF and the columns are the same up to floating point round-off,
+ * since the convolution is computed directly instead of through FFTs.
+ *
+ */
+
+#ifndef MBT_TF_STREAM_H
+#define MBT_TF_STREAM_H
+
+#include <sp-global.h>
+
+#include "DataManipulation/MBT_Matrix.h"
+#include "TimeFrequency/MBT_TF_Engine.h"
+#include "TimeFrequency/MBT_TF_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Streaming time-frequency map, one row per frequency. The columns are written column after
+ * column in the output vectors: the value of the row r of a column is at index r of the column.
+ *
+ */
+class MBT_TFStream
+{
+    public:
+        /**
+         * @brief Construct a new stream
+         *
+         * @param fs The sampling rate
+         * @param frequencies The frequencies of the wavelets, in Hz
+         * @param edges Number of columns set to zero at the beginning and at the end of each row, as @ref TF_mask does
+         * @throws std::invalid_argument if a frequency is not positive or if there is not one edge per frequency
+         */
+        MBT_TFStream(const SP_RealType fs, SP_Vector const& frequencies, std::vector<int> const& edges)
+        {
+            init(fs, frequencies, edges);
+        }
+
+        /**
+         * @brief Construct a stream giving the same map as @ref TF: the frequencies are the integers from
+         * 2 Hz below to 2 Hz above the peak frequency, and the edges are the ones of @ref TF_mask
+         *
+         * @param fs The sampling rate
+         * @param peak The peak frequency, as given by @ref get_freqPeak
+         * @throws std::invalid_argument if the peak is not between 7 and 13 Hz
+         */
+        MBT_TFStream(const SP_RealType fs, const int peak)
+        {
+            if (peak < 7 || peak > 13) {
+                throw std::invalid_argument("MBT_TFStream: the peak frequency must be between 7 and 13 Hz");
+            }
+            SP_Vector frequencies;
+            std::vector<int> edges;
+            for (int row = 0; row < 5; ++row) {
+                frequencies.push_back(peak - 2 + row);
+                edges.push_back(AllEdgePoints[peak - 7 + row]);
+            }
+            init(fs, frequencies, edges);
+        }
+
+        /**
+         * @brief Add samples and get the columns which do not depend on the following samples anymore
+         *
+         * @param samples The new samples
+         * @param count The number of new samples
+         * @param columns Receives the new columns, appended after its current values
+         * @return size_t The number of new columns
+         */
+        size_t push(const SP_RealType* samples, size_t count, SP_Vector& columns)
+        {
+            m_samples.insert(m_samples.end(), samples, samples + count);
+            m_received += count;
+            const size_t ready = m_received > m_lag ? m_received - m_lag : 0;
+            return emit(ready, false, columns);
+        }
+
+        /**
+         * @brief Add samples and get the columns which do not depend on the following samples anymore
+         */
+        size_t push(SP_Vector const& samples, SP_Vector& columns)
+        {
+            return push(samples.data(), samples.size(), columns);
+        }
+
+        /**
+         * @brief End the signal: the last columns are computed with zeros after the last sample and
+         * masked with the end edges. The stream can then be used for a new signal after @ref reset.
+         *
+         * @param columns Receives the last columns, appended after its current values
+         * @return size_t The number of new columns
+         */
+        size_t finish(SP_Vector& columns)
+        {
+            return emit(m_received, true, columns);
+        }
+
+        /**
+         * @brief Forget the samples, the columns and the minimum and maximum, to start a new signal
+         */
+        void reset()
+        {
+            m_samples.clear();
+            m_first = 0;
+            m_received = 0;
+            m_emitted = 0;
+            m_minimum = SP_NAN;
+            m_maximum = SP_NAN;
+        }
+
+        /**
+         * @brief Get the number of rows (frequencies) of the map
+         */
+        int rowCount() const { return static_cast<int>(m_rows.size()); }
+
+        /**
+         * @brief Get the number of columns emitted since the beginning of the signal
+         */
+        size_t columnCount() const { return m_emitted; }
+
+        /**
+         * @brief Get the number of samples a column waits for after its own sample before it is emitted
+         */
+        size_t lag() const { return m_lag; }
+
+        /**
+         * @brief Get the minimum of the positive values and the maximum of the columns emitted so far,
+         * as @ref MinMaxTFMap returns on the whole map (NaN before any column)
+         */
+        SP_Vector minMax() const
+        {
+            SP_Vector result(2);
+            result[0] = m_minimum;
+            result[1] = m_maximum;
+            return result;
+        }
+
+    private:
+        /**
+         * @brief Wavelet of a row, stored reversed so that a value is a dot product with the samples
+         */
+        struct Row {
+            SP_Vector real; // real parts of the wavelet, last sample first
+            SP_Vector imaginary; // imaginary parts of the wavelet, last sample first
+            size_t before; // number of samples before the column used by the wavelet
+            size_t after; // number of samples after the column used by the wavelet
+            size_t edge; // number of masked columns at each end of the row
+        };
+
+        void init(const SP_RealType fs, SP_Vector const& frequencies, std::vector<int> const& edges)
+        {
+            if (!(fs > 0)) {
+                throw std::invalid_argument("MBT_TFStream: the sampling rate must be positive");
+            }
+            if (edges.size() != frequencies.size()) {
+                throw std::invalid_argument("MBT_TFStream: there must be one edge per frequency");
+            }
+
+            m_dt = 1 / fs;
+            m_history = 0;
+            m_lag = 0;
+            m_rows.resize(frequencies.size());
+            for (size_t r = 0; r < frequencies.size(); ++r) {
+                if (!(frequencies[r] > 0)) {
+                    throw std::invalid_argument("MBT_TFStream: the frequencies must be positive");
+                }
+                const SP_ComplexVector wavelet = MBT_TFEngineDetail::morletWavelet(frequencies[r], fs);
+                Row& row = m_rows[r];
+                const size_t size = wavelet.size();
+                for (size_t i = size; i > 0; --i) {
+                    row.real.push_back(wavelet[i - 1].real());
+                    row.imaginary.push_back(wavelet[i - 1].imag());
+                }
+                // centered part of the full convolution, as fft_convolve keeps it
+                row.after = size / 2;
+                row.before = size > 0 ? size - 1 - row.after : 0;
+                row.edge = edges[r] > 0 ? static_cast<size_t>(edges[r]) : 0;
+                m_history = std::max(m_history, row.before);
+                m_lag = std::max(m_lag, std::max(row.after, row.edge));
+            }
+            reset();
+        }
+
+        /**
+         * @brief Compute and append the columns up to end (excluded)
+         */
+        size_t emit(size_t end, bool isFinished, SP_Vector& columns)
+        {
+            const size_t rows = m_rows.size();
+            const size_t count = end > m_emitted ? end - m_emitted : 0;
+            columns.reserve(columns.size() + count * rows);
+
+            for (; m_emitted < end; ++m_emitted) {
+                const size_t column = m_emitted;
+                for (size_t r = 0; r < rows; ++r) {
+                    const SP_RealType value = computeValue(m_rows[r], column);
+                    const Row& row = m_rows[r];
+                    // the end edge is only known once the signal is finished
+                    const bool isMasked = column < row.edge || (isFinished && column + row.edge >= m_received);
+                    const SP_RealType masked = value * static_cast<SP_RealType>(isMasked ? 0 : 1);
+                    columns.push_back(masked);
+                    if (masked > 0 && !(m_minimum <= masked)) {
+                        m_minimum = masked;
+                    }
+                    if (!(m_maximum >= masked)) {
+                        m_maximum = masked;
+                    }
+                }
+            }
+
+            discardSamples();
+            return count;
+        }
+
+        /**
+         * @brief Power of the convolution of the row at a column, zero outside of the received samples
+         */
+        SP_RealType computeValue(const Row& row, size_t column) const
+        {
+            // samples [column - before, column + after] against the reversed wavelet
+            const size_t size = row.real.size();
+            size_t first = 0;
+            if (column < row.before) {
+                first = row.before - column;
+            }
+            const size_t start = column + first - row.before;
+            size_t last = size;
+            if (start + (size - first) > m_received) {
+                last = first + (m_received > start ? m_received - start : 0);
+            }
+            if (first >= last) {
+                return 0;
+            }
+
+            const SP_RealType* samples = m_samples.data() + (start - m_first);
+            SP_RealType real = 0;
+            SP_RealType imaginary = 0;
+            for (size_t i = first; i < last; ++i) {
+                const SP_RealType sample = samples[i - first];
+                real += sample * row.real[i];
+                imaginary += sample * row.imaginary[i];
+            }
+            const SP_RealType amplitude = m_dt * std::hypot(real, imaginary);
+            return amplitude * amplitude;
+        }
+
+        /**
+         * @brief Drop the samples which are before all the wavelets of the next column, the buffer is
+         * only shifted when more than half of it is dropped
+         */
+        void discardSamples()
+        {
+            const size_t needed = m_emitted > m_history ? m_emitted - m_history : 0;
+            const size_t unused = needed - m_first;
+            if (unused > 0 && unused * 2 >= m_samples.size()) {
+                m_samples.erase(m_samples.begin(), m_samples.begin() + unused);
+                m_first = needed;
+            }
+        }
+
+        SP_RealType m_dt; // sampling period
+        std::vector<Row> m_rows; // wavelet of each frequency
+        size_t m_history; // samples kept before the next column
+        size_t m_lag; // samples needed after a column before it is emitted
+        SP_Vector m_samples; // received samples from the index m_first
+        size_t m_first; // index of the first kept sample
+        size_t m_received; // number of received samples
+        size_t m_emitted; // number of emitted columns
+        SP_RealType m_minimum; // minimum of the positive values emitted
+        SP_RealType m_maximum; // maximum of the values emitted
+};
+
+#endif // MBT_TF_STREAM_H
@@ -6,6 +6,7 @@
 //  Copyright (c) 2015 Emma Barme. All rights reserved.
 //
 // 	Update: Fanny Grosselin 23/03/2017 --> Change float by double
+// 	Update: 19/10/2026 --> Add binary search and uniform grid variants of findClosestIndex
 //
 
 #ifndef __MBT_iOS__MBT_FindClosest__
@@ -18,6 +19,10 @@
 #include <vector>
 #include <algorithm>
 #include <errno.h>
+#include <cmath>
+
+//The grid values of findClosestIndexUniform are rounded as the frequencies built by the library, without FMA
+SP_FP_CONTRACT_OFF_BEGIN
 
 //Find values in double vectors (the vectors are supposed to be dense)
 class MBT_FindClosest {
@@ -28,6 +33,76 @@ public:
     
     //Static method: Find the indices of the closest values to two reference values in a double vector.
     static std::pair<int, int> findClosetIndices(SP_Vector const& inputReference, const SP_RealType startValueToFind, const SP_RealType endValueToFind);
+
+    //Static method: Same result as findClosestIndex for a vector sorted in increasing order, in O(log n).
+    //The first index of the closest value is returned, the lower value wins in case of equality.
+    static int findClosestIndexSorted(SP_Vector const& inputReference, const SP_RealType valueToFind)
+    {
+        if (inputReference.empty() || std::isnan(valueToFind)) {
+            return 0;
+        }
+        SP_Vector::const_iterator upper = std::lower_bound(inputReference.begin(), inputReference.end(), valueToFind);
+        if (upper == inputReference.begin()) {
+            return 0;
+        }
+        SP_Vector::const_iterator lower = upper - 1;
+        if (upper != inputReference.end() && squaredDistance(*upper, valueToFind) < squaredDistance(*lower, valueToFind)) {
+            return static_cast<int>(upper - inputReference.begin());
+        }
+        //first occurrence of the lower value
+        lower = std::lower_bound(inputReference.begin(), upper, *lower);
+        return static_cast<int>(lower - inputReference.begin());
+    }
+
+    //Static method: Same result as findClosetIndices for a vector sorted in increasing order, in O(log n).
+    static std::pair<int, int> findClosestIndicesSorted(SP_Vector const& inputReference, const SP_RealType startValueToFind, const SP_RealType endValueToFind)
+    {
+        return std::pair<int, int>(findClosestIndexSorted(inputReference, startValueToFind),
+                                   findClosestIndexSorted(inputReference, endValueToFind));
+    }
+
+    //Static method: Same result as findClosestIndex for the uniform grid start + step * i, 0 <= i < size, in O(1).
+    //As the frequencies of MBT_PWelchComputer, whose values are (fs / nfft) * i: start is 0 and step is fs / nfft.
+    static int findClosestIndexUniform(const SP_RealType start, const SP_RealType step, const int size, const SP_RealType valueToFind)
+    {
+        if (size <= 0 || std::isnan(valueToFind) || !(step > 0)) {
+            return 0;
+        }
+        const SP_RealType position = std::floor((valueToFind - start) / step);
+        if (position < 0) {
+            return 0;
+        }
+        if (position >= size - 1) {
+            return size - 1;
+        }
+        //the division may be one step off, the grid values are compared as the linear search does
+        int lower = static_cast<int>(position);
+        while (lower > 0 && gridValue(start, step, lower) > valueToFind) {
+            --lower;
+        }
+        while (lower < size - 1 && gridValue(start, step, lower + 1) <= valueToFind) {
+            ++lower;
+        }
+        if (lower < size - 1 && squaredDistance(gridValue(start, step, lower + 1), valueToFind) < squaredDistance(gridValue(start, step, lower), valueToFind)) {
+            return lower + 1;
+        }
+        return lower;
+    }
+
+private:
+    static SP_RealType gridValue(const SP_RealType start, const SP_RealType step, const int index)
+    {
+        const SP_RealType offset = step * index;
+        return start + offset;
+    }
+
+    static SP_RealType squaredDistance(const SP_RealType reference, const SP_RealType valueToFind)
+    {
+        const SP_RealType difference = valueToFind - reference;
+        return difference * difference;
+    }
 };
 
+SP_FP_CONTRACT_OFF_END
+
 #endif /* defined(__MBT_iOS__MBT_FindClosest__) */
@@ -7,19 +7,27 @@
 // 	Update: Fanny Grosselin 23/03/2017 --> Change float by double
 // 			Fanny Grosselin 2017/03/27 --> Change '\' by '/' for the paths
 //  Update: Katerina Pandremmenou 2017/09/20 --> Change a comment to make it clearer
+//  Update: 2026/10/19 --> Add merge based variants for sorted inputs, in O(n + m) without allocation
+//  Update: 2026/10/19 --> Instrumentation probes on the merge based variants (sp-instrumentation.h)
+//  Update: 2026/10/19 --> Merge based variants compiled without FMA contraction (SP_FP_CONTRACT_OFF_BEGIN)
 //
 
 #ifndef MBT_INTERPOLATION_H_INCLUDED
 #define MBT_INTERPOLATION_H_INCLUDED
 
 #include <sp-global.h>
+#include <sp-instrumentation.h>
 
 #include "Algebra/MBT_FindClosest.h"
+#include "DataManipulation/MBT_Matrix.h"
 
 #include <stdio.h>
 #include <iostream>
 #include <math.h>
 #include <vector>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
 
 //File to interpolate data
 
@@ -34,6 +42,235 @@
  */
 SP_Vector MBT_linearInterp(SP_Vector &x, SP_Vector &y, SP_Vector &xInterp);
 
+// The merge based variants round each product and sum as MBT_linearInterp, FMA contraction is off
+SP_FP_CONTRACT_OFF_BEGIN
+
+namespace MBT_InterpolationDetail {
+
+/*
+ * @brief Segment used by MBT_linearInterp for one interpolated point.
+ * The line goes through the points first and second and is anchored on the point closest to xInterp.
+ */
+struct Segment {
+    size_t first;
+    size_t second;
+    size_t anchor;
+    bool isValid; // false when xInterp is outside the known values: the result is NaN
+    bool isSingle; // true when the anchor is the last known value: the result is its value
+};
+
+/*
+ * @brief Same value as MBT_linearInterp on a segment.
+ */
+inline SP_RealType evaluate(const SP_RealType* x, const SP_RealType* y, const Segment& segment, const SP_RealType xInterp)
+{
+    if (!segment.isValid) {
+        return SP_NAN;
+    }
+    if (segment.isSingle) {
+        return y[segment.anchor];
+    }
+    const SP_RealType slope = (y[segment.second] - y[segment.first]) / (x[segment.second] - x[segment.first]);
+    const SP_RealType anchorProduct = x[segment.anchor] * slope;
+    const SP_RealType intercept = y[segment.anchor] - anchorProduct;
+    const SP_RealType product = xInterp * slope;
+    return product + intercept;
+}
+
+/*
+ * @brief Merge walk on the sorted known positions x.
+ * upper is the first index such as x[upper] >= xInterp and runStart the first index of the values equal to x[upper - 1],
+ * they only move forward while xInterp increases.
+ */
+class SortedWalker {
+public:
+    SortedWalker(const SP_RealType* x, const size_t size)
+    : m_x(x), m_size(size), m_upper(0), m_runStart(0), m_previous(-INFINITY)
+    {}
+
+    Segment find(const SP_RealType xInterp)
+    {
+        Segment segment;
+        segment.first = segment.second = segment.anchor = 0;
+        segment.isValid = m_size > 0 && !std::isnan(xInterp) && xInterp >= m_x[0] && xInterp <= m_x[m_size - 1];
+        segment.isSingle = false;
+        if (!segment.isValid) {
+            return segment;
+        }
+
+        if (xInterp < m_previous) {
+            // not sorted, restart the walk
+            m_upper = 0;
+            m_runStart = 0;
+        }
+        m_previous = xInterp;
+        while (m_upper < m_size && m_x[m_upper] < xInterp) {
+            if (m_upper == 0 || m_x[m_upper] != m_x[m_upper - 1]) {
+                m_runStart = m_upper;
+            }
+            ++m_upper;
+        }
+
+        // closest known position, the first one in case of equality as MBT_FindClosest::findClosestIndex
+        size_t closest = m_upper;
+        if (m_upper > 0) {
+            const SP_RealType lowerDistance = (xInterp - m_x[m_upper - 1]) * (xInterp - m_x[m_upper - 1]);
+            const SP_RealType upperDistance = m_upper < m_size ? (xInterp - m_x[m_upper]) * (xInterp - m_x[m_upper]) : INFINITY;
+            closest = upperDistance < lowerDistance ? m_upper : m_runStart;
+        }
+
+        segment.anchor = closest;
+        if (m_x[closest] > xInterp) {
+            segment.first = closest - 1;
+            segment.second = closest;
+        } else if (closest + 1 < m_size) {
+            segment.first = closest;
+            segment.second = closest + 1;
+        } else {
+            segment.isSingle = true;
+        }
+        return segment;
+    }
+
+private:
+    const SP_RealType* m_x;
+    size_t m_size;
+    size_t m_upper;
+    size_t m_runStart;
+    SP_RealType m_previous;
+};
+
+} // namespace MBT_InterpolationDetail
+
+/*
+ * @brief Linear interpolation with the same results as MBT_linearInterp, in O(n + m) and without allocation
+ * when x and xInterp are sorted in increasing order (unsorted xInterp are still supported, but slower).
+ * The values outside [x[0], x[n - 1]] are NaN. At x[n - 1], where MBT_linearInterp reads past the end of
+ * x and y, the value is y[n - 1].
+ * @param x The positions of the known values, sorted in increasing order.
+ * @param y The known values.
+ * @param size The number of known values.
+ * @param xInterp The positions of the values to interpolate.
+ * @param yInterp Receives the interpolated values, can be the same buffer as xInterp.
+ * @param interpSize The number of values to interpolate.
+ */
+inline void MBT_linearInterpSorted(const SP_RealType* x, const SP_RealType* y, const size_t size,
+                                   const SP_RealType* xInterp, SP_RealType* yInterp, const size_t interpSize)
+{
+    SP_SCOPED_STAGE_BYTES(SP_STAGE_INTERPOLATION, interpSize * sizeof(SP_RealType));
+    MBT_InterpolationDetail::SortedWalker walker(x, size);
+    for (size_t i = 0; i < interpSize; ++i) {
+        const SP_RealType position = xInterp[i];
+        yInterp[i] = MBT_InterpolationDetail::evaluate(x, y, walker.find(position), position);
+    }
+}
+
+/*
+ * @brief Linear interpolation with the same results as MBT_linearInterp, for sorted x and xInterp.
+ * @param x A vector of double containing the positions of the known values, sorted in increasing order.
+ * @param y A vector of double containing the known values.
+ * @param xInterp A vector of double containing the positions of the values to interpolate.
+ * @param yInterp Receives the interpolated values, its capacity is reused.
+ */
+inline void MBT_linearInterpSorted(SP_Vector const& x, SP_Vector const& y, SP_Vector const& xInterp, SP_Vector& yInterp)
+{
+    if (x.size() != y.size()) {
+        throw std::invalid_argument("MBT_linearInterpSorted: x and y must have the same size");
+    }
+    yInterp.resize(xInterp.size());
+    MBT_linearInterpSorted(x.data(), y.data(), x.size(), xInterp.data(), yInterp.data(), xInterp.size());
+}
+
+/*
+ * @brief Linear interpolation of several channels sharing the same positions, for sorted x and xInterp.
+ * The segments are found once for all the channels.
+ * @param x A vector of double containing the positions of the known values, sorted in increasing order.
+ * @param y A matrix of double containing the known values, one channel per row.
+ * @param xInterp A vector of double containing the positions of the values to interpolate.
+ * @return A matrix of double with the interpolated values, one channel per row.
+ */
+inline SP_Matrix MBT_linearInterpBatch(SP_Vector const& x, SP_Matrix const& y, SP_Vector const& xInterp)
+{
+    const int channels = y.size().first;
+    if (static_cast<size_t>(y.size().second) != x.size()) {
+        throw std::invalid_argument("MBT_linearInterpBatch: x and the rows of y must have the same size");
+    }
+    SP_SCOPED_STAGE_BYTES(SP_STAGE_INTERPOLATION, xInterp.size() * channels * sizeof(SP_RealType));
+
+    SP_Matrix yInterp(channels, static_cast<int>(xInterp.size()));
+    MBT_InterpolationDetail::SortedWalker walker(x.data(), x.size());
+    for (size_t i = 0; i < xInterp.size(); ++i) {
+        const MBT_InterpolationDetail::Segment segment = walker.find(xInterp[i]);
+        for (int channel = 0; channel < channels; ++channel) {
+            yInterp.rowData(channel)[i] = MBT_InterpolationDetail::evaluate(x.data(), y.rowData(channel), segment, xInterp[i]);
+        }
+    }
+    return yInterp;
+}
+
+/*
+ * @brief Replace in place the samples of a signal for which isMissing(value) is true, with the same values
+ * as MBT_linearInterp using the sample indexes as positions. Missing samples at the edges become NaN.
+ * @param signal The signal to repair.
+ * @param isMissing Predicate on the sample values.
+ * @return The number of replaced samples.
+ */
+template<typename IsMissing>
+size_t MBT_linearInterpInPlace(SP_Vector& signal, IsMissing isMissing)
+{
+    SP_SCOPED_STAGE_BYTES(SP_STAGE_INTERPOLATION, signal.size() * sizeof(SP_RealType));
+    const size_t size = signal.size();
+    size_t replaced = 0;
+    size_t left = size; // last kept sample, none yet
+    size_t i = 0;
+    while (i < size) {
+        if (!isMissing(signal[i])) {
+            left = i++;
+            continue;
+        }
+        size_t right = i;
+        while (right < size && isMissing(signal[right])) {
+            ++right;
+        }
+
+        // each missing sample is anchored on the closest kept sample, the left one in case of equality
+        const bool isInside = left < size && right < size;
+        const SP_RealType positions[2] = {static_cast<SP_RealType>(left), static_cast<SP_RealType>(right)};
+        const SP_RealType values[2] = {isInside ? signal[left] : 0, isInside ? signal[right] : 0};
+        MBT_InterpolationDetail::Segment segment;
+        segment.first = 0;
+        segment.second = 1;
+        segment.isValid = isInside;
+        segment.isSingle = false;
+        for (size_t j = i; j < right; ++j) {
+            segment.anchor = j - left <= right - j ? 0 : 1;
+            signal[j] = MBT_InterpolationDetail::evaluate(positions, values, segment, static_cast<SP_RealType>(j));
+        }
+        replaced += right - i;
+        i = right;
+    }
+    return replaced;
+}
+
+/*
+ * @brief Same result as InterpolateOutliers, in place and in O(n): the samples outside the bounds
+ * (and the NaN samples) are replaced by a linear interpolation of the other ones.
+ * @param data The signal.
+ * @param bounds The low bound and the up bound to detect the outliers.
+ * @return The number of replaced samples.
+ */
+inline size_t MBT_interpolateOutliersInPlace(SP_Vector& data, SP_Vector const& bounds)
+{
+    if (bounds.size() < 2) {
+        throw std::invalid_argument("MBT_interpolateOutliersInPlace: bounds must hold the low and the up bounds");
+    }
+    const SP_RealType low = bounds[0];
+    const SP_RealType up = bounds[1];
+    return MBT_linearInterpInPlace(data, [low, up](SP_RealType value) { return !(value >= low) || value > up; });
+}
+
+SP_FP_CONTRACT_OFF_END
+
 
 
 #endif // MBT_INTERPOLATION_H_INCLUDED
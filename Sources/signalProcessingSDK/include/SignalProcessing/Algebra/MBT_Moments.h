@@ -0,0 +1,252 @@
+/**
+ * @file MBT_Moments.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Single pass descriptive statistics.
+ * The count, the mean and the central moments M2, M3 and M4 are accumulated together in one
+ * numerically stable pass (Welford updates, merged with the formulas of Chan and Pebay), so that
+ * the mean, the variance, the skewness and the kurtosis of a signal do not need one pass each.
+ * The accumulation runs on independent lanes without branch, which lets the compiler vectorize it,
+ * and works on any strided buffer, such as the rows and columns of a @ref MBT_Matrix.
+ *
+ */
+
+#ifndef MBT_MOMENTS_H
+#define MBT_MOMENTS_H
+
+#include <sp-global.h>
+#include <sp-instrumentation.h>
+
+#include "DataManipulation/MBT_Matrix.h"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace MBT_MomentsDetail {
+
+enum { LANES = 4 };
+
+/**
+ * @brief Branchless update of one lane, a skipped value leaves the lane unchanged
+ */
+inline void pushLane(SP_RealType value, SP_RealType& count, SP_RealType& mean, SP_RealType& m2,
+                     SP_RealType& m3, SP_RealType& m4, bool skipNaN)
+{
+    const bool valid = !skipNaN || !std::isnan(value);
+    const SP_RealType previousCount = count;
+    count += valid ? 1 : 0;
+    const SP_RealType delta = valid ? value - mean : 0;
+    const SP_RealType deltaN = delta / (count > 0 ? count : 1);
+    const SP_RealType deltaN2 = deltaN * deltaN;
+    const SP_RealType term = delta * deltaN * previousCount;
+    mean += deltaN;
+    m4 += term * deltaN2 * (count * count - 3 * count + 3) + 6 * deltaN2 * m2 - 4 * deltaN * m3;
+    m3 += term * deltaN * (count - 2) - 3 * deltaN * m2;
+    m2 += term;
+}
+
+} // namespace MBT_MomentsDetail
+
+/**
+ * @brief Count, mean and central moments of a set of values
+ *
+ */
+struct MBT_Moments {
+    /**
+     * @brief Number of values
+     */
+    SP_RealType count;
+    /**
+     * @brief Mean of the values
+     */
+    SP_RealType mean;
+    /**
+     * @brief Sum of the squared differences to the mean
+     */
+    SP_RealType m2;
+    /**
+     * @brief Sum of the cubed differences to the mean
+     */
+    SP_RealType m3;
+    /**
+     * @brief Sum of the differences to the mean to the power 4
+     */
+    SP_RealType m4;
+
+    MBT_Moments()
+    : count(0), mean(0), m2(0), m3(0), m4(0)
+    {}
+
+    /**
+     * @brief Add a value
+     *
+     * @param value The new value
+     */
+    void push(SP_RealType value)
+    {
+        MBT_MomentsDetail::pushLane(value, count, mean, m2, m3, m4, false);
+    }
+
+    /**
+     * @brief Add the values accumulated in other moments
+     *
+     * @param other The moments to merge
+     */
+    void merge(const MBT_Moments& other)
+    {
+        if (other.count == 0) {
+            return;
+        }
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+
+        const SP_RealType na = count;
+        const SP_RealType nb = other.count;
+        const SP_RealType n = na + nb;
+        const SP_RealType delta = other.mean - mean;
+        const SP_RealType delta2 = delta * delta;
+        const SP_RealType delta3 = delta2 * delta;
+        const SP_RealType delta4 = delta2 * delta2;
+
+        const SP_RealType mergedM4 = m4 + other.m4
+            + delta4 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n)
+            + 6 * delta2 * (na * na * other.m2 + nb * nb * m2) / (n * n)
+            + 4 * delta * (na * other.m3 - nb * m3) / n;
+        const SP_RealType mergedM3 = m3 + other.m3
+            + delta3 * na * nb * (na - nb) / (n * n)
+            + 3 * delta * (na * other.m2 - nb * m2) / n;
+        const SP_RealType mergedM2 = m2 + other.m2 + delta2 * na * nb / n;
+
+        mean += delta * nb / n;
+        m2 = mergedM2;
+        m3 = mergedM3;
+        m4 = mergedM4;
+        count = n;
+    }
+
+    /**
+     * @brief Mean of the values, NaN if there is none (as @ref mean and @ref nanmean)
+     */
+    SP_RealType getMean() const { return count > 0 ? mean : SP_NAN; }
+
+    /**
+     * @brief Variance with N-1 normalization (as @ref var)
+     */
+    SP_RealType variance() const { return count > 1 ? m2 / (count - 1) : SP_NAN; }
+
+    /**
+     * @brief Standard deviation with N-1 normalization (as @ref standardDeviation)
+     */
+    SP_RealType standardDeviation() const { return std::sqrt(variance()); }
+
+    /**
+     * @brief Biased skewness, third central moment over the second one to the power 1.5 (as @ref skewness)
+     */
+    SP_RealType skewness() const { return count > 0 ? std::sqrt(count) * m3 / std::pow(m2, 1.5) : SP_NAN; }
+
+    /**
+     * @brief Kurtosis (not excess), fourth central moment over the squared second one (as @ref kurtosis)
+     */
+    SP_RealType kurtosis() const { return count > 0 ? count * m4 / (m2 * m2) : SP_NAN; }
+};
+
+/**
+ * @brief Compute the moments of a strided buffer in one pass
+ *
+ * @param data Pointer to the first value
+ * @param size Number of values
+ * @param skipNaN If true, NaN values are ignored (as @ref nanmean), otherwise they propagate to the results
+ * @param stride Distance between two consecutive values, 1 for contiguous values
+ * @return MBT_Moments The moments of the values
+ */
+template<typename T>
+MBT_Moments computeMoments(const T* data, size_t size, bool skipNaN = false, size_t stride = 1)
+{
+    using namespace MBT_MomentsDetail;
+    SP_SCOPED_STAGE_BYTES(SP_STAGE_FEATURES, size * sizeof(T));
+
+    SP_RealType count[LANES] = {0, 0, 0, 0};
+    SP_RealType mean[LANES] = {0, 0, 0, 0};
+    SP_RealType m2[LANES] = {0, 0, 0, 0};
+    SP_RealType m3[LANES] = {0, 0, 0, 0};
+    SP_RealType m4[LANES] = {0, 0, 0, 0};
+
+    const size_t blocks = size / LANES;
+    for (size_t block = 0; block < blocks; ++block) {
+        const T* values = data + block * LANES * stride;
+        for (int lane = 0; lane < LANES; ++lane) {
+            pushLane(static_cast<SP_RealType>(values[lane * stride]),
+                     count[lane], mean[lane], m2[lane], m3[lane], m4[lane], skipNaN);
+        }
+    }
+    for (size_t i = blocks * LANES; i < size; ++i) {
+        const int lane = static_cast<int>(i - blocks * LANES);
+        pushLane(static_cast<SP_RealType>(data[i * stride]),
+                 count[lane], mean[lane], m2[lane], m3[lane], m4[lane], skipNaN);
+    }
+
+    MBT_Moments result;
+    for (int lane = 0; lane < LANES; ++lane) {
+        MBT_Moments laneMoments;
+        laneMoments.count = count[lane];
+        laneMoments.mean = mean[lane];
+        laneMoments.m2 = m2[lane];
+        laneMoments.m3 = m3[lane];
+        laneMoments.m4 = m4[lane];
+        result.merge(laneMoments);
+    }
+    return result;
+}
+
+/**
+ * @brief Compute the moments of a vector in one pass
+ *
+ * @param input The values
+ * @param skipNaN If true, NaN values are ignored, otherwise they propagate to the results
+ * @return MBT_Moments The moments of the values
+ */
+template<typename T>
+MBT_Moments computeMoments(std::vector<T> const& input, bool skipNaN = false)
+{
+    return computeMoments(input.data(), input.size(), skipNaN);
+}
+
+/**
+ * @brief Compute the moments of a row of a matrix in one pass, without copy
+ *
+ * @param input The matrix
+ * @param rowIndex The index of the row
+ * @param skipNaN If true, NaN values are ignored, otherwise they propagate to the results
+ * @return MBT_Moments The moments of the row
+ */
+template<typename T>
+MBT_Moments computeRowMoments(MBT_Matrix<T> const& input, int rowIndex, bool skipNaN = false)
+{
+    return computeMoments(input.rowData(rowIndex), static_cast<size_t>(input.size().second), skipNaN);
+}
+
+/**
+ * @brief Compute the moments of a column of a matrix in one pass, without copy
+ *
+ * @param input The matrix
+ * @param columnIndex The index of the column
+ * @param skipNaN If true, NaN values are ignored, otherwise they propagate to the results
+ * @return MBT_Moments The moments of the column
+ * @throws std::out_of_range if the column does not exist
+ */
+template<typename T>
+MBT_Moments computeColumnMoments(MBT_Matrix<T> const& input, int columnIndex, bool skipNaN = false)
+{
+    if (columnIndex < 0 || columnIndex >= input.size().second) {
+        throw std::out_of_range("Out of range accessor");
+    }
+    return computeMoments(input.data() + columnIndex, static_cast<size_t>(input.size().first), skipNaN,
+                          static_cast<size_t>(input.size().second));
+}
+
+#endif // MBT_MOMENTS_H
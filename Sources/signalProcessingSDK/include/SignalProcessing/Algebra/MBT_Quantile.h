@@ -0,0 +1,387 @@
+/**
+ * @file MBT_Quantile.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Selection based median and quantiles, and streaming quantile estimation.
+ * The selection functions give exactly the same results as @ref median, @ref Quantile and
+ * @ref CalculateBounds (same interpolation, same floating point operations) in O(n) average
+ * time instead of sorting the whole vector. The inputs are expected without NaN values, as
+ * for the sorting implementations. The selection functions are compiled without FMA contraction
+ * (SP_FP_CONTRACT_OFF_BEGIN), so that every product and sum is rounded as in the library.
+ *
+ */
+
+#ifndef MBT_QUANTILE_H
+#define MBT_QUANTILE_H
+
+#include <sp-global.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+SP_FP_CONTRACT_OFF_BEGIN
+
+namespace MBT_QuantileDetail {
+
+/**
+ * @brief Position of the p-quantile in a sorted vector of size n, as in @ref Quantile
+ */
+inline SP_RealType quantilePosition(size_t size, SP_RealType probability)
+{
+    const SP_RealType upper = probability * (static_cast<SP_RealType>(size) - 0.5);
+    const SP_RealType lower = (1.0 - probability) * 0.5;
+    return upper - lower;
+}
+
+/**
+ * @brief Same operations as @ref Lerp
+ */
+inline SP_RealType lerp(SP_RealType v0, SP_RealType v1, SP_RealType t)
+{
+    const SP_RealType left = (1.0 - t) * v0;
+    const SP_RealType right = t * v1;
+    return left + right;
+}
+
+/**
+ * @brief Indices of the two sorted values interpolated for the p-quantile, as in @ref Quantile
+ */
+inline void quantileIndices(size_t size, SP_RealType position, size_t& left, size_t& right)
+{
+    const long floorIndex = static_cast<long>(std::floor(position));
+    const long ceilIndex = static_cast<long>(std::ceil(position));
+    left = floorIndex > 0 ? static_cast<size_t>(floorIndex) : 0;
+    right = static_cast<long>(size) - 1 < ceilIndex ? size - 1 : static_cast<size_t>(ceilIndex);
+}
+
+} // namespace MBT_QuantileDetail
+
+/**
+ * @brief Compute the median of [first, last) by selection, the range is reordered.
+ *
+ * @param first Beginning of the values
+ * @param last End of the values
+ * @return SP_RealType The median value, NaN if the range is empty
+ */
+template<typename RandomIt>
+SP_RealType medianInPlace(RandomIt first, RandomIt last)
+{
+    const size_t size = static_cast<size_t>(std::distance(first, last));
+    if (size == 0) {
+        return SP_NAN;
+    }
+
+    RandomIt middle = first + size / 2;
+    std::nth_element(first, middle, last);
+    const SP_RealType upper = static_cast<SP_RealType>(*middle);
+    if (size % 2 != 0) {
+        return upper;
+    }
+    const SP_RealType lower = static_cast<SP_RealType>(*std::max_element(first, middle));
+    return (lower + upper) * 0.5;
+}
+
+/**
+ * @brief Compute the median of a vector, same result as @ref median
+ *
+ * @param input Vector of values, reordered
+ * @return SP_RealType The median value, NaN if the vector is empty
+ */
+inline SP_RealType medianInPlace(SP_Vector& input)
+{
+    return medianInPlace(input.begin(), input.end());
+}
+
+/**
+ * @brief Compute the median of a vector, same result as @ref median
+ *
+ * @param input Vector of values
+ * @return SP_RealType The median value, NaN if the vector is empty
+ */
+inline SP_RealType fastMedian(SP_Vector const& input)
+{
+    SP_Vector values(input);
+    return medianInPlace(values.begin(), values.end());
+}
+
+/**
+ * @brief Compute the quantiles of [first, last) by selection, the range is reordered.
+ *
+ * @param first Beginning of the values
+ * @param last End of the values
+ * @param probabilities Probabilities of the quantiles, in increasing order
+ * @param quantiles Receives one quantile per probability
+ * @throws std::out_of_range if the range is empty
+ */
+template<typename RandomIt>
+void quantilesInPlace(RandomIt first, RandomIt last, SP_Vector const& probabilities, SP_Vector& quantiles)
+{
+    if (first == last) {
+        throw std::out_of_range("quantilesInPlace: empty input");
+    }
+
+    const size_t size = static_cast<size_t>(std::distance(first, last));
+    quantiles.resize(probabilities.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < probabilities.size(); ++i) {
+        const SP_RealType position = MBT_QuantileDetail::quantilePosition(size, probabilities[i]);
+        size_t left, right;
+        MBT_QuantileDetail::quantileIndices(size, position, left, right);
+        // the values before offset are already smaller than the others, the selection only
+        // looks at the remaining ones when the probabilities are increasing
+        if (left < offset) {
+            offset = 0;
+        }
+
+        std::nth_element(first + offset, first + left, last);
+        const SP_RealType leftValue = static_cast<SP_RealType>(*(first + left));
+        SP_RealType rightValue = leftValue;
+        if (right > left) {
+            // every value after the left one is greater or equal, the next one in order is their minimum
+            rightValue = static_cast<SP_RealType>(*std::min_element(first + left + 1, last));
+        }
+        quantiles[i] = MBT_QuantileDetail::lerp(leftValue, rightValue, position - static_cast<SP_RealType>(left));
+        offset = left;
+    }
+}
+
+/**
+ * @brief Compute the first, second and third quartiles, same result as @ref Quantile
+ *
+ * @param input Vector of values, reordered
+ * @return SP_Vector The 0.25, 0.5 and 0.75 quantiles
+ * @throws std::out_of_range if the vector is empty
+ */
+inline SP_Vector quantileInPlace(SP_Vector& input)
+{
+    SP_Vector probabilities(3);
+    probabilities[0] = 0.25;
+    probabilities[1] = 0.5;
+    probabilities[2] = 0.75;
+    SP_Vector quantiles;
+    quantilesInPlace(input.begin(), input.end(), probabilities, quantiles);
+    return quantiles;
+}
+
+/**
+ * @brief Compute the first, second and third quartiles, same result as @ref Quantile
+ *
+ * @param input Vector of values
+ * @return SP_Vector The 0.25, 0.5 and 0.75 quantiles
+ * @throws std::out_of_range if the vector is empty
+ */
+inline SP_Vector fastQuantile(SP_Vector const& input)
+{
+    SP_Vector values(input);
+    return quantileInPlace(values);
+}
+
+/**
+ * @brief Compute the lower and upper bounds used to detect the outliers, same result as @ref CalculateBounds
+ * The bounds are the first and third quartiles extended by 1.5 times the interquartile range.
+ *
+ * @param input Vector of values
+ * @return SP_Vector The lower and the upper bounds
+ * @throws std::out_of_range if the vector is empty
+ */
+inline SP_Vector fastCalculateBounds(SP_Vector const& input)
+{
+    SP_Vector values(input);
+    SP_Vector probabilities(2);
+    probabilities[0] = 0.25;
+    probabilities[1] = 0.75;
+    SP_Vector quartiles;
+    quantilesInPlace(values.begin(), values.end(), probabilities, quartiles);
+
+    const SP_RealType range = (quartiles[1] - quartiles[0]) * 1.5;
+    SP_Vector bounds(2);
+    bounds[0] = quartiles[0] - range;
+    bounds[1] = quartiles[1] + range;
+    return bounds;
+}
+
+#ifndef SP_FLOAT_OR_NOT_LEGACY
+/**
+ * @brief Compute the lower and upper bounds used to detect the outliers, same result as @ref CalculateBounds
+ * The quartiles are computed in double, the bounds are then converted to float.
+ *
+ * @param input Vector of values
+ * @return SP_FloatVector The lower and the upper bounds
+ * @throws std::out_of_range if the vector is empty
+ */
+inline SP_FloatVector fastCalculateBounds(SP_FloatVector const& input)
+{
+    const SP_Vector bounds = fastCalculateBounds(SP_Vector(input.begin(), input.end()));
+    SP_FloatVector result(2);
+    result[0] = static_cast<SP_FloatType>(bounds[0]);
+    result[1] = static_cast<SP_FloatType>(bounds[1]);
+    return result;
+}
+#endif
+
+SP_FP_CONTRACT_OFF_END
+
+/**
+ * @brief Streaming estimation of a quantile with the P-square algorithm (Jain and Chlamtac, 1985).
+ * O(1) memory and O(1) time per value, the quantile is exact until 5 values are received,
+ * then an estimation that does not need to keep the values.
+ *
+ */
+class MBT_StreamingQuantile
+{
+    public:
+        /**
+         * @brief Construct a new estimator
+         *
+         * @param probability Probability of the estimated quantile, between 0 and 1
+         * @throws std::invalid_argument if the probability is not between 0 and 1
+         */
+        explicit MBT_StreamingQuantile(SP_RealType probability)
+        : m_probability(probability)
+        {
+            if (!(probability >= 0 && probability <= 1)) {
+                throw std::invalid_argument("MBT_StreamingQuantile: the probability must be between 0 and 1");
+            }
+            m_increments[0] = 0;
+            m_increments[1] = probability / 2;
+            m_increments[2] = probability;
+            m_increments[3] = (1 + probability) / 2;
+            m_increments[4] = 1;
+            reset();
+        }
+
+        /**
+         * @brief Forget all the received values
+         *
+         */
+        void reset()
+        {
+            m_count = 0;
+            for (int i = 0; i < MARKERS; ++i) {
+                m_heights[i] = 0;
+                m_positions[i] = i + 1;
+                m_desired[i] = 1 + 4 * m_increments[i];
+            }
+        }
+
+        /**
+         * @brief Add a value, NaN values are ignored
+         *
+         * @param value The new value
+         */
+        void push(SP_RealType value)
+        {
+            if (std::isnan(value)) {
+                return;
+            }
+
+            if (m_count < MARKERS) {
+                m_heights[m_count++] = value;
+                std::sort(m_heights, m_heights + m_count);
+                return;
+            }
+            ++m_count;
+
+            int cell;
+            if (value < m_heights[0]) {
+                m_heights[0] = value;
+                cell = 0;
+            } else if (value >= m_heights[MARKERS - 1]) {
+                m_heights[MARKERS - 1] = value;
+                cell = MARKERS - 2;
+            } else {
+                cell = 0;
+                while (value >= m_heights[cell + 1]) {
+                    ++cell;
+                }
+            }
+
+            for (int i = cell + 1; i < MARKERS; ++i) {
+                ++m_positions[i];
+            }
+            for (int i = 0; i < MARKERS; ++i) {
+                m_desired[i] += m_increments[i];
+            }
+
+            for (int i = 1; i < MARKERS - 1; ++i) {
+                const SP_RealType offset = m_desired[i] - m_positions[i];
+                if ((offset >= 1 && m_positions[i + 1] - m_positions[i] > 1) ||
+                    (offset <= -1 && m_positions[i - 1] - m_positions[i] < -1)) {
+                    const int direction = offset >= 0 ? 1 : -1;
+                    SP_RealType height = parabolic(i, direction);
+                    if (!(m_heights[i - 1] < height && height < m_heights[i + 1])) {
+                        height = linear(i, direction);
+                    }
+                    m_heights[i] = height;
+                    m_positions[i] += direction;
+                }
+            }
+        }
+
+        /**
+         * @brief Get the current estimation of the quantile
+         *
+         * @return SP_RealType The quantile, NaN if no value was received
+         */
+        SP_RealType value() const
+        {
+            if (m_count == 0) {
+                return SP_NAN;
+            }
+            if (m_count <= MARKERS) {
+                // the values are still all known and sorted
+                const SP_RealType position = MBT_QuantileDetail::quantilePosition(m_count, m_probability);
+                size_t left, right;
+                MBT_QuantileDetail::quantileIndices(m_count, position, left, right);
+                return MBT_QuantileDetail::lerp(m_heights[left], m_heights[right], position - static_cast<SP_RealType>(left));
+            }
+            return m_heights[2];
+        }
+
+        /**
+         * @brief Get the number of valid values received
+         *
+         * @return unsigned long The number of values
+         */
+        unsigned long count() const { return m_count; }
+
+        /**
+         * @brief Get the probability of the estimated quantile
+         *
+         * @return SP_RealType The probability
+         */
+        SP_RealType probability() const { return m_probability; }
+
+    private:
+        enum { MARKERS = 5 };
+
+        SP_RealType parabolic(int i, int direction) const
+        {
+            const SP_RealType d = static_cast<SP_RealType>(direction);
+            const SP_RealType previousSpan = m_positions[i] - m_positions[i - 1];
+            const SP_RealType nextSpan = m_positions[i + 1] - m_positions[i];
+            const SP_RealType span = m_positions[i + 1] - m_positions[i - 1];
+            return m_heights[i] + d / span *
+                ((previousSpan + d) * (m_heights[i + 1] - m_heights[i]) / nextSpan +
+                 (nextSpan - d) * (m_heights[i] - m_heights[i - 1]) / previousSpan);
+        }
+
+        SP_RealType linear(int i, int direction) const
+        {
+            return m_heights[i] + direction * (m_heights[i + direction] - m_heights[i]) /
+                (m_positions[i + direction] - m_positions[i]);
+        }
+
+        SP_RealType m_probability; // probability of the estimated quantile
+        unsigned long m_count; // number of valid values
+        SP_RealType m_heights[MARKERS]; // marker heights, the middle one is the estimation
+        SP_RealType m_positions[MARKERS]; // actual marker positions
+        SP_RealType m_desired[MARKERS]; // desired marker positions
+        SP_RealType m_increments[MARKERS]; // increments of the desired positions per value
+};
+
+#endif // MBT_QUANTILE_H
@@ -0,0 +1,391 @@
+/**
+ * @file MBT_kmeans1D.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief K-means clustering of one-dimensional data on flat arrays.
+ * @ref ApplyKMeans copies every value into a @ref Point holding its own vector, and every
+ * cluster into a vector of points, so that most of its time is spent in allocations. The
+ * clustering below works on the values directly and keeps the members of each cluster in
+ * linked index lists, while doing the same floating point operations in the same order:
+ * its labels and centers are identical to the ones of @ref ApplyKMeans.
+ *
+ * Two other deterministic clusterings are given for one-dimensional data: the optimal one,
+ * computed by dynamic programming on the sorted values, and the Lloyd iterations started from
+ * centers chosen by k-means++ with a fixed seed.
+ *
+ * All the labels go from 1 to K, as the ones of @ref ApplyKMeans.
+ *
+ */
+
+#ifndef MBT_KMEANS1D_H
+#define MBT_KMEANS1D_H
+
+#include <sp-global.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace MBT_KMeans1DDetail {
+
+/**
+ * @brief Euclidean distance between a value and a center, computed as @ref KMeans does
+ */
+inline SP_RealType distance(SP_RealType value, SP_RealType center)
+{
+    const SP_RealType difference = value - center;
+    const SP_RealType squared = difference * difference;
+    return std::sqrt(squared);
+}
+
+/**
+ * @brief Sum of the squared differences to their mean of the sorted values [first, last),
+ * from the prefix sums of the values and of their squares
+ */
+inline SP_RealType segmentCost(const std::vector<SP_RealType>& sums, const std::vector<SP_RealType>& squaredSums,
+                               int first, int last)
+{
+    const SP_RealType sum = sums[last] - sums[first];
+    const SP_RealType cost = squaredSums[last] - squaredSums[first] - sum * sum / (last - first);
+    return cost > 0 ? cost : 0;
+}
+
+/**
+ * @brief Fill the row of the dynamic programming table for the ends [firstEnd, lastEnd],
+ * knowing that the optimal splits are in [firstSplit, lastSplit] (they increase with the end)
+ */
+inline void fillRow(const std::vector<SP_RealType>& sums, const std::vector<SP_RealType>& squaredSums,
+                    const SP_RealType* previousCosts, SP_RealType* costs, int* splits,
+                    int firstEnd, int lastEnd, int firstSplit, int lastSplit)
+{
+    while (firstEnd <= lastEnd) {
+        const int end = firstEnd + (lastEnd - firstEnd) / 2;
+        SP_RealType bestCost = std::numeric_limits<SP_RealType>::infinity();
+        int bestSplit = firstSplit;
+        for (int split = firstSplit; split <= std::min(lastSplit, end - 1); ++split) {
+            const SP_RealType cost = previousCosts[split] + segmentCost(sums, squaredSums, split, end);
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = split;
+            }
+        }
+        costs[end] = bestCost;
+        splits[end] = bestSplit;
+
+        // left half recursively, right half in the loop
+        fillRow(sums, squaredSums, previousCosts, costs, splits, firstEnd, end - 1, firstSplit, bestSplit);
+        firstEnd = end + 1;
+        firstSplit = bestSplit;
+    }
+}
+
+} // namespace MBT_KMeans1DDetail
+
+/**
+ * @brief Lloyd k-means of one-dimensional values, on flat arrays reused from one call to the next.
+ * Not thread safe: use one instance per processing thread.
+ *
+ */
+class MBT_KMeans1D
+{
+    public:
+        /**
+         * @brief Construct a new clustering
+         *
+         * @param maxIterations Maximum number of Lloyd iterations, 100 as in @ref ApplyKMeans
+         */
+        explicit MBT_KMeans1D(int maxIterations = 100)
+        : m_maxIterations(maxIterations)
+        {}
+
+        /**
+         * @brief Same result as @ref ApplyKMeans: two clusters, started from the smallest and the largest values
+         *
+         * @param values The values to cluster
+         * @return std::pair<std::vector<int>, SP_Vector> The label (1 or 2) of each value and the two centers
+         * @throws std::invalid_argument if there are less than two distinct values (@ref ApplyKMeans does not
+         * return any clustering in this case)
+         */
+        std::pair<std::vector<int>, SP_Vector> apply(SP_Vector const& values)
+        {
+            std::pair<std::vector<int>, SP_Vector> result(std::vector<int>(values.size()), SP_Vector(2));
+            apply(values.data(), static_cast<int>(values.size()), result.first.data(), result.second.data());
+            return result;
+        }
+
+        /**
+         * @brief Same result as @ref ApplyKMeans on a flat array
+         *
+         * @param values The values to cluster
+         * @param size The number of values
+         * @param labels Receives the label (1 or 2) of each value, size values
+         * @param centers Receives the two centers
+         * @return int The number of iterations
+         * @throws std::invalid_argument if there are less than two distinct values
+         */
+        int apply(const SP_RealType* values, int size, int* labels, SP_RealType* centers)
+        {
+            int seeds[2] = {0, 0};
+            for (int i = 1; i < size; ++i) {
+                if (values[i] < values[seeds[0]]) {
+                    seeds[0] = i;
+                }
+                if (values[seeds[1]] < values[i]) {
+                    seeds[1] = i;
+                }
+            }
+            if (size < 2 || seeds[0] == seeds[1]) {
+                throw std::invalid_argument("MBT_KMeans1D: the values cannot be split in two clusters");
+            }
+            return run(values, size, 2, seeds, labels, centers);
+        }
+
+        /**
+         * @brief Lloyd iterations started from centers chosen by k-means++, with a fixed seed so that
+         * the clustering of the same values is always the same
+         *
+         * @param values The values to cluster
+         * @param size The number of values
+         * @param clusterCount The number of clusters K
+         * @param seed The seed of the random generator
+         * @param labels Receives the label (1 to K) of each value, size values
+         * @param centers Receives the K centers
+         * @return int The number of iterations
+         * @throws std::invalid_argument if there are less values than clusters
+         */
+        int applyPlusPlus(const SP_RealType* values, int size, int clusterCount, unsigned int seed,
+                          int* labels, SP_RealType* centers)
+        {
+            using MBT_KMeans1DDetail::distance;
+
+            if (clusterCount < 1 || size < clusterCount) {
+                throw std::invalid_argument("MBT_KMeans1D: less values than clusters");
+            }
+            // the generator is used directly, the distributions are not the same in all the standard libraries
+            std::mt19937 generator(seed);
+            std::vector<int> seeds(clusterCount);
+            m_weights.assign(size, std::numeric_limits<SP_RealType>::infinity());
+
+            seeds[0] = static_cast<int>(generator() % static_cast<unsigned int>(size));
+            for (int k = 1; k < clusterCount; ++k) {
+                SP_RealType total = 0;
+                for (int i = 0; i < size; ++i) {
+                    const SP_RealType d = distance(values[i], values[seeds[k - 1]]);
+                    m_weights[i] = std::min(m_weights[i], d * d);
+                    total += m_weights[i];
+                }
+
+                const SP_RealType target = total * (generator() / 4294967296.0);
+                int chosen = -1;
+                SP_RealType cumulated = 0;
+                for (int i = 0; i < size && chosen < 0; ++i) {
+                    cumulated += m_weights[i];
+                    if (m_weights[i] > 0 && cumulated > target) {
+                        chosen = i;
+                    }
+                }
+                // all the remaining values are on a center: take the first one not chosen yet
+                for (int i = 0; i < size && chosen < 0; ++i) {
+                    if (std::find(seeds.begin(), seeds.begin() + k, i) == seeds.begin() + k) {
+                        chosen = i;
+                    }
+                }
+                seeds[k] = chosen;
+            }
+            return run(values, size, clusterCount, seeds.data(), labels, centers);
+        }
+
+    private:
+        /**
+         * @brief Lloyd iterations of @ref KMeans::run: cluster k starts with the value seeds[k] as member and
+         * center, and the centers are the sums of the members in the order they joined the cluster
+         */
+        int run(const SP_RealType* values, int size, int clusterCount, const int* seeds, int* labels, SP_RealType* centers)
+        {
+            using MBT_KMeans1DDetail::distance;
+
+            m_next.assign(size, -1);
+            m_previous.assign(size, -1);
+            m_first.assign(clusterCount, -1);
+            m_last.assign(clusterCount, -1);
+            m_count.assign(clusterCount, 0);
+            std::fill(labels, labels + size, -1);
+            for (int k = 0; k < clusterCount; ++k) {
+                labels[seeds[k]] = k;
+                link(seeds[k], k);
+                centers[k] = values[seeds[k]];
+            }
+
+            int iteration = 1;
+            while (true) {
+                bool done = true;
+                for (int i = 0; i < size; ++i) {
+                    int nearest = 0;
+                    SP_RealType nearestDistance = distance(values[i], centers[0]);
+                    for (int k = 1; k < clusterCount; ++k) {
+                        const SP_RealType d = distance(values[i], centers[k]);
+                        if (d < nearestDistance) {
+                            nearestDistance = d;
+                            nearest = k;
+                        }
+                    }
+                    if (labels[i] != nearest) {
+                        if (labels[i] != -1) {
+                            unlink(i, labels[i]);
+                        }
+                        labels[i] = nearest;
+                        link(i, nearest);
+                        done = false;
+                    }
+                }
+
+                for (int k = 0; k < clusterCount; ++k) {
+                    if (m_count[k] > 0) {
+                        SP_RealType sum = 0;
+                        for (int i = m_first[k]; i != -1; i = m_next[i]) {
+                            sum += values[i];
+                        }
+                        centers[k] = sum / m_count[k];
+                    }
+                }
+
+                if (done || iteration >= m_maxIterations) {
+                    break;
+                }
+                ++iteration;
+            }
+
+            for (int i = 0; i < size; ++i) {
+                ++labels[i];
+            }
+            return iteration;
+        }
+
+        void link(int index, int cluster)
+        {
+            m_previous[index] = m_last[cluster];
+            m_next[index] = -1;
+            if (m_last[cluster] != -1) {
+                m_next[m_last[cluster]] = index;
+            } else {
+                m_first[cluster] = index;
+            }
+            m_last[cluster] = index;
+            ++m_count[cluster];
+        }
+
+        void unlink(int index, int cluster)
+        {
+            if (m_previous[index] != -1) {
+                m_next[m_previous[index]] = m_next[index];
+            } else {
+                m_first[cluster] = m_next[index];
+            }
+            if (m_next[index] != -1) {
+                m_previous[m_next[index]] = m_previous[index];
+            } else {
+                m_last[cluster] = m_previous[index];
+            }
+            --m_count[cluster];
+        }
+
+        int m_maxIterations; // maximum number of Lloyd iterations
+        std::vector<int> m_next; // next member of the cluster of each value, -1 for the last one
+        std::vector<int> m_previous; // previous member of the cluster of each value, -1 for the first one
+        std::vector<int> m_first; // first member of each cluster
+        std::vector<int> m_last; // last member of each cluster
+        std::vector<int> m_count; // number of members of each cluster
+        std::vector<SP_RealType> m_weights; // squared distance of each value to its closest k-means++ center
+};
+
+/**
+ * @brief Optimal k-means of sorted one-dimensional values: the clusters are consecutive runs of the
+ * sorted values, and the split minimizing the sum of the squared distances to the centers is found by
+ * dynamic programming in O(K n log n).
+ *
+ * @param sorted The values, sorted in increasing order and without NaN
+ * @param size The number of values
+ * @param clusterCount The number of clusters K
+ * @param labels Receives the label (1 to K) of each value, size values
+ * @param centers Receives the K centers, in increasing order
+ * @return SP_RealType The sum of the squared distances of the values to their centers
+ * @throws std::invalid_argument if there are less values than clusters
+ */
+inline SP_RealType MBT_kmeans1DOptimal(const SP_RealType* sorted, int size, int clusterCount, int* labels, SP_RealType* centers)
+{
+    using namespace MBT_KMeans1DDetail;
+
+    if (clusterCount < 1 || size < clusterCount) {
+        throw std::invalid_argument("MBT_kmeans1DOptimal: less values than clusters");
+    }
+
+    // prefix sums of the values shifted by the median, which keeps the costs accurate
+    const SP_RealType shift = sorted[size / 2];
+    std::vector<SP_RealType> sums(size + 1, 0);
+    std::vector<SP_RealType> squaredSums(size + 1, 0);
+    for (int i = 0; i < size; ++i) {
+        const SP_RealType value = sorted[i] - shift;
+        sums[i + 1] = sums[i] + value;
+        squaredSums[i + 1] = squaredSums[i] + value * value;
+    }
+
+    // costs[k * (size + 1) + j]: best cost of the first j values in k + 1 clusters
+    std::vector<SP_RealType> costs(static_cast<size_t>(clusterCount) * (size + 1), std::numeric_limits<SP_RealType>::infinity());
+    std::vector<int> splits(static_cast<size_t>(clusterCount) * (size + 1), 0);
+    for (int j = 1; j <= size; ++j) {
+        costs[j] = segmentCost(sums, squaredSums, 0, j);
+    }
+    for (int k = 1; k < clusterCount; ++k) {
+        fillRow(sums, squaredSums, &costs[(k - 1) * (size + 1)], &costs[k * (size + 1)], &splits[k * (size + 1)],
+                k + 1, size, k, size - 1);
+    }
+
+    int end = size;
+    for (int k = clusterCount - 1; k >= 0; --k) {
+        const int first = k > 0 ? splits[k * (size + 1) + end] : 0;
+        std::fill(labels + first, labels + end, k + 1);
+        centers[k] = (sums[end] - sums[first]) / (end - first) + shift;
+        end = first;
+    }
+    return costs[(clusterCount - 1) * (size + 1) + size];
+}
+
+/**
+ * @brief Optimal k-means of one-dimensional values in any order, see @ref MBT_kmeans1DOptimal
+ *
+ * @param values The values to cluster
+ * @param clusterCount The number of clusters K
+ * @return std::pair<std::vector<int>, SP_Vector> The label (1 to K, by increasing center) of each value and the K centers
+ * @throws std::invalid_argument if a value is NaN or if there are less values than clusters
+ */
+inline std::pair<std::vector<int>, SP_Vector> MBT_kmeans1DOptimal(SP_Vector const& values, int clusterCount = 2)
+{
+    const int size = static_cast<int>(values.size());
+    std::vector<std::pair<SP_RealType, int> > order(size);
+    for (int i = 0; i < size; ++i) {
+        if (std::isnan(values[i])) {
+            throw std::invalid_argument("MBT_kmeans1DOptimal: NaN value");
+        }
+        order[i] = std::make_pair(values[i], i);
+    }
+    std::sort(order.begin(), order.end());
+
+    SP_Vector sorted(size);
+    for (int i = 0; i < size; ++i) {
+        sorted[i] = order[i].first;
+    }
+    std::vector<int> sortedLabels(size);
+    std::pair<std::vector<int>, SP_Vector> result(std::vector<int>(size), SP_Vector(clusterCount > 0 ? clusterCount : 0));
+    MBT_kmeans1DOptimal(sorted.data(), size, clusterCount, sortedLabels.data(), result.second.data());
+    for (int i = 0; i < size; ++i) {
+        result.first[order[i].second] = sortedLabels[i];
+    }
+    return result;
+}
+
+#endif // MBT_KMEANS1D_H
@@ -0,0 +1,315 @@
+/**
+ * @file MBT_FixedShape.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Kernels specialised at compile time for the shapes of the headsets: Melomind (2 channels) and
+ * Q+ (4 channels) at 250 Hz, on 1 s and 2 s quality checker windows and 4 s relax index windows.
+ * The number of samples, the sampling rate and the zero padded length are template parameters, so that
+ * the loops have constant trip counts which the compiler unrolls and vectorises, and the band indexes of
+ * the frequency grid are constant expressions.
+ *
+ * The kernels are the ones of the overloads of @ref MBT_Workspace.h with a constant number of samples, and
+ * give exactly the same results: the element-wise loops vectorise, the sums keep their order. The shape is
+ * selected at runtime with @ref MBT_selectShape, and @ref MBT_runWithShape calls the specialised or the
+ * generic path of a kernel:
+ *
+ *     struct Kernel {
+ *         typedef size_t Result;
+ *         template<typename Shape> Result run();  // Shape is a MBT_FixedShape
+ *         Result runGeneric();
+ *     };
+ *     MBT_runWithShape(MBT_selectShape(config, channels, samples), kernel);
+ *
+ */
+
+#ifndef MBT_FIXEDSHAPE_H
+#define MBT_FIXEDSHAPE_H
+
+#include <sp-global.h>
+
+#include "DataManipulation/MBT_Matrix.h"
+#include "DataManipulation/MBT_Workspace.h"
+
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief Get the zero padded length of a signal, as @ref MBT_zeroPaddedLength: the next power of two, at least 256
+ */
+constexpr unsigned int MBT_fixedNfft(unsigned int samples, unsigned int nfft = 256)
+{
+    return nfft >= samples ? nfft : MBT_fixedNfft(samples, nfft * 2);
+}
+
+/**
+ * @brief Shape of the signals processed by the specialised kernels
+ *
+ */
+template<unsigned int Channels, unsigned int Samples, unsigned int SampRate>
+struct MBT_FixedShape {
+    enum {
+        CHANNELS = Channels, // number of channels
+        SAMPLES = Samples, // number of samples of each channel
+        SAMP_RATE = SampRate, // sampling rate in Hz
+        NFFT = MBT_fixedNfft(Samples) // zero padded length
+    };
+};
+
+/**
+ * @brief Index bounds of frequency bands on the grid of @ref MBT_PWelchComputer (Nfft bins of SampRate / Nfft),
+ * same results as @ref MBT_frequencyBoundsUniform, as constant expressions:
+ *
+ *     constexpr int first = MBT_FixedFrequencyGrid<256, 250>::first(6);
+ *
+ */
+template<unsigned int Nfft, unsigned int SampRate>
+class MBT_FixedFrequencyGrid
+{
+    public:
+        static constexpr SP_RealType step()
+        {
+            return static_cast<SP_RealType>(SampRate) / static_cast<int>(Nfft);
+        }
+
+        static constexpr SP_RealType frequency(int index)
+        {
+            return step() * static_cast<SP_RealType>(index);
+        }
+
+        /**
+         * @brief Get the index of the first frequency not below a bound, Nfft if there is none
+         */
+        static constexpr int first(SP_RealType lower)
+        {
+            return adjustFirst(lower, clamp(lower / step(), 0, static_cast<int>(Nfft)));
+        }
+
+        /**
+         * @brief Get the index of the last frequency not above a bound, -1 if there is none
+         */
+        static constexpr int last(SP_RealType upper)
+        {
+            return adjustLast(upper, clamp(upper / step(), -1, static_cast<int>(Nfft) - 1));
+        }
+
+        /**
+         * @brief Get the number of frequencies of a band
+         *
+         * @throws std::invalid_argument if no frequency is inside the band
+         */
+        static constexpr int count(SP_RealType lower, SP_RealType upper)
+        {
+            return first(lower) <= last(upper) ? last(upper) - first(lower) + 1
+                                               : throw std::invalid_argument("MBT_FixedFrequencyGrid: no frequency inside the band");
+        }
+
+    private:
+        static constexpr int clamp(SP_RealType position, int low, int high)
+        {
+            return position < low ? low : (position > high ? high : static_cast<int>(position));
+        }
+
+        // the truncated division may be one bin off, the bins are then compared as the linear search does
+        static constexpr int adjustFirst(SP_RealType lower, int index)
+        {
+            return index > 0 && frequency(index - 1) >= lower ? adjustFirst(lower, index - 1)
+                 : (index < static_cast<int>(Nfft) && frequency(index) < lower ? adjustFirst(lower, index + 1) : index);
+        }
+
+        static constexpr int adjustLast(SP_RealType upper, int index)
+        {
+            return index < static_cast<int>(Nfft) - 1 && frequency(index + 1) <= upper ? adjustLast(upper, index + 1)
+                 : (index >= 0 && frequency(index) > upper ? adjustLast(upper, index - 1) : index);
+        }
+};
+
+/**
+ * @brief Matrix of a fixed shape, stored row by row in aligned memory, without allocation
+ *
+ */
+template<typename Shape>
+class MBT_FixedMatrix
+{
+    public:
+        MBT_FixedMatrix() {}
+
+        /**
+         * @brief Copy a matrix of the same shape, converted to SP_RealType
+         *
+         * @throws std::invalid_argument if the matrix does not have the shape
+         */
+        template<typename T>
+        void load(MBT_Matrix<T> const& matrix)
+        {
+            if (matrix.size().first != Shape::CHANNELS || matrix.size().second != Shape::SAMPLES) {
+                throw std::invalid_argument("MBT_FixedMatrix: the matrix does not have the fixed shape");
+            }
+            for (int row = 0; row < Shape::CHANNELS; ++row) {
+                const T* data = matrix.rowData(row);
+                SP_RealType* destination = rowData(row);
+                for (int column = 0; column < Shape::SAMPLES; ++column) {
+                    destination[column] = static_cast<SP_RealType>(data[column]);
+                }
+            }
+        }
+
+        SP_RealType* rowData(int row) { return m_data + row * Shape::SAMPLES; }
+        const SP_RealType* rowData(int row) const { return m_data + row * Shape::SAMPLES; }
+
+    private:
+        alignas(64) SP_RealType m_data[Shape::CHANNELS * Shape::SAMPLES]; // values, row by row
+};
+
+/**
+ * @brief Kernels on one channel of a fixed shape: the kernels of the overloads of @ref MBT_Workspace.h,
+ * with the number of samples as a constant. The outputs may be the inputs.
+ *
+ */
+template<typename Shape>
+struct MBT_FixedKernels {
+    typedef std::integral_constant<size_t, Shape::SAMPLES> Size; // number of samples, trip count of the loops
+
+    /**
+     * @brief Same sum as @ref mean: in order
+     */
+    static SP_RealType mean(const SP_RealType* input)
+    {
+        return MBT_WorkspaceDetail::sequentialMean(input, Size());
+    }
+
+    /**
+     * @brief Same result as @ref RemoveDC
+     */
+    static void removeDC(const SP_RealType* input, SP_RealType* output)
+    {
+        MBT_WorkspaceDetail::removeDC(input, Size(), output);
+    }
+
+    /**
+     * @brief Same result as @ref powerOfTwoWithoutDC
+     */
+    static void powerOfTwoWithoutDC(const SP_RealType* input, SP_RealType* output)
+    {
+        MBT_WorkspaceDetail::powerOfTwoWithoutDC(input, Size(), output);
+    }
+
+    /**
+     * @brief Same result as @ref detrend at the sampling rate of the shape
+     */
+    static void detrend(const SP_RealType* input, SP_RealType* output)
+    {
+        MBT_WorkspaceDetail::detrend(input, Size(), static_cast<SP_RealType>(Shape::SAMP_RATE), output);
+    }
+
+    /**
+     * @brief Same result as the @ref timeFirstDerivative overload of MBT_Workspace.h at the sampling rate of the
+     * shape, SAMPLES - 1 values: the time steps of the fixed shapes are never null, no sample is skipped.
+     *
+     * @return size_t The number of derivatives written
+     */
+    static size_t timeFirstDerivative(const SP_RealType* input, SP_RealType* output)
+    {
+        const SP_RealType rate = static_cast<SP_RealType>(static_cast<SP_FloatType>(Shape::SAMP_RATE));
+        return MBT_WorkspaceDetail::timeFirstDerivative(input, Size(), rate, output);
+    }
+};
+
+/**
+ * @brief Shapes with specialised kernels
+ *
+ */
+enum MBT_ShapeId {
+    MBT_SHAPE_GENERIC, // any other shape, processed by the generic kernels
+    MBT_SHAPE_MELOMIND_1S, // 2 channels, 250 samples at 250 Hz
+    MBT_SHAPE_MELOMIND_2S, // 2 channels, 500 samples at 250 Hz
+    MBT_SHAPE_MELOMIND_4S, // 2 channels, 1000 samples at 250 Hz
+    MBT_SHAPE_QPLUS_1S, // 4 channels, 250 samples at 250 Hz
+    MBT_SHAPE_QPLUS_2S, // 4 channels, 500 samples at 250 Hz
+    MBT_SHAPE_QPLUS_4S // 4 channels, 1000 samples at 250 Hz
+};
+
+/**
+ * @brief Select the specialised kernels of a shape
+ *
+ * @param sampRate The sampling rate
+ * @param channels The number of channels
+ * @param samples The number of samples of each channel
+ * @return MBT_ShapeId The shape, MBT_SHAPE_GENERIC if it has no specialised kernels
+ */
+inline MBT_ShapeId MBT_selectShape(SP_FloatType sampRate, unsigned int channels, unsigned int samples)
+{
+    if (sampRate != 250 || (channels != 2 && channels != 4)) {
+        return MBT_SHAPE_GENERIC;
+    }
+    const bool isMelomind = channels == 2;
+    switch (samples) {
+        case 250:
+            return isMelomind ? MBT_SHAPE_MELOMIND_1S : MBT_SHAPE_QPLUS_1S;
+        case 500:
+            return isMelomind ? MBT_SHAPE_MELOMIND_2S : MBT_SHAPE_QPLUS_2S;
+        case 1000:
+            return isMelomind ? MBT_SHAPE_MELOMIND_4S : MBT_SHAPE_QPLUS_4S;
+        default:
+            return MBT_SHAPE_GENERIC;
+    }
+}
+
+/**
+ * @brief Select the specialised kernels of a window, from the sampling rate of a MBT_QCConfig or a MBT_NFConfig.
+ * Only configuration classes select this overload, a sampling rate of any arithmetic type selects the one above.
+ *
+ * @param config The configuration
+ * @param channels The number of channels
+ * @param samples The number of samples of each channel of the window
+ * @return MBT_ShapeId The shape, MBT_SHAPE_GENERIC if it has no specialised kernels
+ */
+template<typename Config>
+typename std::enable_if<std::is_class<Config>::value, MBT_ShapeId>::type
+MBT_selectShape(Config const& config, unsigned int channels, unsigned int samples)
+{
+    return MBT_selectShape(static_cast<SP_FloatType>(config.sampRate), channels, samples);
+}
+
+/**
+ * @brief Select the specialised kernels of the packets of a MBT_NFConfig
+ *
+ * @param config The configuration
+ * @param channels The number of channels
+ * @return MBT_ShapeId The shape, MBT_SHAPE_GENERIC if it has no specialised kernels
+ */
+template<typename Config>
+MBT_ShapeId MBT_selectPacketShape(Config const& config, unsigned int channels)
+{
+    return MBT_selectShape(static_cast<SP_FloatType>(config.sampRate), channels, config.packetLength);
+}
+
+/**
+ * @brief Run the specialised or the generic path of a kernel
+ *
+ * @param shape The shape selected by @ref MBT_selectShape
+ * @param kernel A kernel with a Result type, a run<Shape>() template and a runGeneric() method
+ * @return Kernel::Result The result of the path
+ */
+template<typename Kernel>
+typename Kernel::Result MBT_runWithShape(MBT_ShapeId shape, Kernel& kernel)
+{
+    switch (shape) {
+        case MBT_SHAPE_MELOMIND_1S:
+            return kernel.template run<MBT_FixedShape<2, 250, 250> >();
+        case MBT_SHAPE_MELOMIND_2S:
+            return kernel.template run<MBT_FixedShape<2, 500, 250> >();
+        case MBT_SHAPE_MELOMIND_4S:
+            return kernel.template run<MBT_FixedShape<2, 1000, 250> >();
+        case MBT_SHAPE_QPLUS_1S:
+            return kernel.template run<MBT_FixedShape<4, 250, 250> >();
+        case MBT_SHAPE_QPLUS_2S:
+            return kernel.template run<MBT_FixedShape<4, 500, 250> >();
+        case MBT_SHAPE_QPLUS_4S:
+            return kernel.template run<MBT_FixedShape<4, 1000, 250> >();
+        default:
+            return kernel.runGeneric();
+    }
+}
+
+#endif // MBT_FIXEDSHAPE_H
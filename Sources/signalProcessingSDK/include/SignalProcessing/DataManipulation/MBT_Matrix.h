@@ -179,6 +179,50 @@ public:
         return extractedColumn;
     }
 
+    /*
+     * @brief Access a row of the matrix without copy. The values of a row are contiguous.
+     * @param rowIndex The index of the desired row.
+     * @return A pointer to the first value of the row, valid until the matrix is resized or destroyed.
+     */
+    const T* rowData(const int rowIndex) const
+    {
+        if (rowIndex < 0 || rowIndex >= m_height) {
+            throw std::out_of_range("Out of range accessor");
+        }
+        return m_data.data() + rowIndex * m_width;
+    }
+
+    /*
+     * @brief Access a row of the matrix without copy. The values of a row are contiguous.
+     * @param rowIndex The index of the desired row.
+     * @return A pointer to the first value of the row, valid until the matrix is resized or destroyed.
+     */
+    T* rowData(const int rowIndex)
+    {
+        if (rowIndex < 0 || rowIndex >= m_height) {
+            throw std::out_of_range("Out of range accessor");
+        }
+        return m_data.data() + rowIndex * m_width;
+    }
+
+    /*
+     * @brief Access the values of the matrix without copy, stored row after row.
+     * @return A pointer to the first value, valid until the matrix is resized or destroyed.
+     */
+    const T* data() const
+    {
+        return m_data.data();
+    }
+
+    /*
+     * @brief Access the values of the matrix without copy, stored row after row.
+     * @return A pointer to the first value, valid until the matrix is resized or destroyed.
+     */
+    T* data()
+    {
+        return m_data.data();
+    }
+
 private:
     /** @brief The number of row */
     int m_height;
@@ -0,0 +1,470 @@
+/**
+ * @file MBT_RawFrameDecoder.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Decoding of the EEG bytes sent by the headsets, from the raw buffer to a planar matrix.
+ * The decoding is the one of EEGDeserializer in the iOS SDK: each sample is a big-endian 16 bit word,
+ * the most significant bits of the 20 bit ADS1299 code (the Swift convert24to32Bit reads 2 bytes per
+ * sample and shifts them by 4), multiplied by 0.286e-6 / 8 V. The samples of the channels are interleaved,
+ * sample i of the buffer belonging to channel i % channels. The decoder writes channel after channel,
+ * one row per channel, which is the layout of the matrices given to @ref MBT_MainQC.
+ *
+ * The results are identical, bit for bit, to the Swift code: the 20 bit code is converted exactly to
+ * float and multiplied once by the single precision scale. The 2 and 4 channel layouts of the headsets
+ * are decoded with SSE2 or NEON: the bytes are swapped, sign extended and de-interleaved in registers.
+ * The other layouts, the last samples and the builds defining MBT_RAW_FRAME_DECODER_NO_SIMD use the
+ * scalar path, which gives the same values.
+ *
+ * Frames, such as the notifications of a raw BLE capture, start with the big-endian index of the packet.
+ * @ref MBT_RawFrameDecoder::decodeFrames removes the indexes and fills the lost frames with 0xFF bytes,
+ * as EEGAcquisitionBuffer, so that the signal keeps its timing. With MBT_LOST_FRAME_FILL_NAN, the samples
+ * of the lost frames are NaN instead, as the missing values that the preprocessing interpolates.
+ *
+ */
+
+#ifndef MBT_RAWFRAMEDECODER_H
+#define MBT_RAWFRAMEDECODER_H
+
+#include <sp-global.h>
+
+#include "DataManipulation/MBT_Matrix.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#if !defined(MBT_RAW_FRAME_DECODER_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define MBT_RAW_FRAME_DECODER_NEON
+#include <arm_neon.h>
+#elif !defined(MBT_RAW_FRAME_DECODER_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define MBT_RAW_FRAME_DECODER_SSE2
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Unit of the decoded samples
+ */
+enum MBT_RawUnit {
+    MBT_RAW_UNIT_VOLT, // as EEGDeserializer, the unit of the signals given to MBT_MainQC
+    MBT_RAW_UNIT_MICROVOLT // the same samples in uV, scaled once from the ADC code
+};
+
+/**
+ * @brief Samples of the frames lost before a frame
+ */
+enum MBT_LostFrameFill {
+    MBT_LOST_FRAME_FILL_BYTES, // 0xFF bytes decoded as the other samples, as EEGAcquisitionBuffer
+    MBT_LOST_FRAME_FILL_NAN // NaN samples, including the samples shared with a received frame
+};
+
+namespace MBT_RawFrameDetail {
+
+enum {
+    BYTES_PER_SAMPLE = 2, // one big-endian word per sample
+    INDEX_BYTES = 2 // big-endian index at the start of a frame
+};
+
+/**
+ * @brief Scale from the 20 bit ADC code to the unit, in single precision as the Swift constant
+ * (0.286 * pow(10, -6)) / 8, pow(10, -6) being 1e-6f
+ */
+inline float scaleOf(MBT_RawUnit unit)
+{
+    return unit == MBT_RAW_UNIT_MICROVOLT ? 0.286f / 8 : 0.286f * 1e-6f / 8;
+}
+
+/**
+ * @brief Decode one sample: the sign extended 20 bit code, converted exactly to float, times the scale
+ */
+inline float decodeSample(const uint8_t* bytes, float scale)
+{
+    int32_t word = (static_cast<int32_t>(bytes[0]) << 8) | bytes[1];
+    word -= (word & 0x8000) << 1;
+    return static_cast<float>(word * 16) * scale;
+}
+
+/**
+ * @brief Decode the samples [first, samples) of each channel, without SIMD
+ */
+inline void decodeScalar(const uint8_t* bytes, unsigned int channels, size_t first, size_t samples,
+                         float scale, float* planar, size_t rowStride)
+{
+    for (size_t sample = first; sample < samples; ++sample) {
+        const uint8_t* word = bytes + sample * channels * BYTES_PER_SAMPLE;
+        for (unsigned int channel = 0; channel < channels; ++channel) {
+            planar[channel * rowStride + sample] = decodeSample(word + channel * BYTES_PER_SAMPLE, scale);
+        }
+    }
+}
+
+#if defined(MBT_RAW_FRAME_DECODER_NEON)
+
+/**
+ * @brief Scale 8 codes of one channel and store them
+ */
+inline void storeCodes(int16x8_t words, float32x4_t scale, float* out)
+{
+    const int32x4_t low = vshlq_n_s32(vmovl_s16(vget_low_s16(words)), 4);
+    const int32x4_t high = vshlq_n_s32(vmovl_s16(vget_high_s16(words)), 4);
+    vst1q_f32(out, vmulq_f32(vcvtq_f32_s32(low), scale));
+    vst1q_f32(out + 4, vmulq_f32(vcvtq_f32_s32(high), scale));
+}
+
+/**
+ * @brief Load 8 big-endian words as signed integers
+ */
+inline int16x8_t loadWords(const uint8_t* bytes)
+{
+    return vreinterpretq_s16_u8(vrev16q_u8(vld1q_u8(bytes)));
+}
+
+/**
+ * @brief Decode the samples of 2 channels by blocks of 8, return the number of samples decoded
+ */
+inline size_t decodeTwoChannels(const uint8_t* bytes, size_t samples, float scale, float* planar, size_t rowStride)
+{
+    const float32x4_t scales = vdupq_n_f32(scale);
+    size_t sample = 0;
+    for (; sample + 8 <= samples; sample += 8) {
+        const uint8_t* block = bytes + sample * 2 * BYTES_PER_SAMPLE;
+        const int16x8x2_t channels = vuzpq_s16(loadWords(block), loadWords(block + 16));
+        storeCodes(channels.val[0], scales, planar + sample);
+        storeCodes(channels.val[1], scales, planar + rowStride + sample);
+    }
+    return sample;
+}
+
+/**
+ * @brief Decode the samples of 4 channels by blocks of 8, return the number of samples decoded
+ */
+inline size_t decodeFourChannels(const uint8_t* bytes, size_t samples, float scale, float* planar, size_t rowStride)
+{
+    const float32x4_t scales = vdupq_n_f32(scale);
+    size_t sample = 0;
+    for (; sample + 8 <= samples; sample += 8) {
+        const uint8_t* block = bytes + sample * 4 * BYTES_PER_SAMPLE;
+        // channels 0 and 2, then 1 and 3, of samples 0 to 3 and 4 to 7
+        const int16x8x2_t first = vuzpq_s16(loadWords(block), loadWords(block + 16));
+        const int16x8x2_t second = vuzpq_s16(loadWords(block + 32), loadWords(block + 48));
+        const int16x8x2_t even = vuzpq_s16(first.val[0], second.val[0]);
+        const int16x8x2_t odd = vuzpq_s16(first.val[1], second.val[1]);
+        storeCodes(even.val[0], scales, planar + sample);
+        storeCodes(odd.val[0], scales, planar + rowStride + sample);
+        storeCodes(even.val[1], scales, planar + 2 * rowStride + sample);
+        storeCodes(odd.val[1], scales, planar + 3 * rowStride + sample);
+    }
+    return sample;
+}
+
+#elif defined(MBT_RAW_FRAME_DECODER_SSE2)
+
+/**
+ * @brief Load 8 big-endian words, swapped to the byte order of the 16 bit lanes
+ */
+inline __m128i loadWords(const uint8_t* bytes)
+{
+    const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    return _mm_or_si128(_mm_slli_epi16(words, 8), _mm_srli_epi16(words, 8));
+}
+
+/**
+ * @brief Codes of the even 16 bit lanes, sign extended to 32 bits and multiplied by 16, as floats
+ */
+inline __m128 evenCodes(__m128i words)
+{
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(words, 16), 12));
+}
+
+/**
+ * @brief Codes of the odd 16 bit lanes, sign extended to 32 bits and multiplied by 16, as floats
+ */
+inline __m128 oddCodes(__m128i words)
+{
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_and_si128(words, _mm_set1_epi32(static_cast<int>(0xFFFF0000))), 12));
+}
+
+/**
+ * @brief Decode the samples of 2 channels by blocks of 8, return the number of samples decoded
+ */
+inline size_t decodeTwoChannels(const uint8_t* bytes, size_t samples, float scale, float* planar, size_t rowStride)
+{
+    const __m128 scales = _mm_set1_ps(scale);
+    size_t sample = 0;
+    for (; sample + 8 <= samples; sample += 8) {
+        const uint8_t* block = bytes + sample * 2 * BYTES_PER_SAMPLE;
+        // one sample of the 2 channels in each 32 bit lane
+        const __m128i first = loadWords(block);
+        const __m128i second = loadWords(block + 16);
+        _mm_storeu_ps(planar + sample, _mm_mul_ps(evenCodes(first), scales));
+        _mm_storeu_ps(planar + sample + 4, _mm_mul_ps(evenCodes(second), scales));
+        _mm_storeu_ps(planar + rowStride + sample, _mm_mul_ps(oddCodes(first), scales));
+        _mm_storeu_ps(planar + rowStride + sample + 4, _mm_mul_ps(oddCodes(second), scales));
+    }
+    return sample;
+}
+
+/**
+ * @brief Decode the samples of 4 channels by blocks of 4, return the number of samples decoded
+ */
+inline size_t decodeFourChannels(const uint8_t* bytes, size_t samples, float scale, float* planar, size_t rowStride)
+{
+    const __m128 scales = _mm_set1_ps(scale);
+    size_t sample = 0;
+    for (; sample + 4 <= samples; sample += 4) {
+        const uint8_t* block = bytes + sample * 4 * BYTES_PER_SAMPLE;
+        // channels 0 and 2, then 1 and 3, of samples 0 and 1, then 2 and 3
+        const __m128i first = loadWords(block);
+        const __m128i second = loadWords(block + 16);
+        const __m128 evenFirst = evenCodes(first);
+        const __m128 evenSecond = evenCodes(second);
+        const __m128 oddFirst = oddCodes(first);
+        const __m128 oddSecond = oddCodes(second);
+        _mm_storeu_ps(planar + sample, _mm_mul_ps(_mm_shuffle_ps(evenFirst, evenSecond, _MM_SHUFFLE(2, 0, 2, 0)), scales));
+        _mm_storeu_ps(planar + rowStride + sample, _mm_mul_ps(_mm_shuffle_ps(oddFirst, oddSecond, _MM_SHUFFLE(2, 0, 2, 0)), scales));
+        _mm_storeu_ps(planar + 2 * rowStride + sample, _mm_mul_ps(_mm_shuffle_ps(evenFirst, evenSecond, _MM_SHUFFLE(3, 1, 3, 1)), scales));
+        _mm_storeu_ps(planar + 3 * rowStride + sample, _mm_mul_ps(_mm_shuffle_ps(oddFirst, oddSecond, _MM_SHUFFLE(3, 1, 3, 1)), scales));
+    }
+    return sample;
+}
+
+#else
+
+inline size_t decodeTwoChannels(const uint8_t*, size_t, float, float*, size_t) { return 0; }
+inline size_t decodeFourChannels(const uint8_t*, size_t, float, float*, size_t) { return 0; }
+
+#endif
+
+/**
+ * @brief Decode the first `samples` samples of each channel into `planar`, row `channel` starting at
+ * planar + channel * rowStride
+ */
+inline void decode(const uint8_t* bytes, unsigned int channels, size_t samples, float scale, float* planar, size_t rowStride)
+{
+    size_t decoded = 0;
+    if (channels == 2) {
+        decoded = decodeTwoChannels(bytes, samples, scale, planar, rowStride);
+    }
+    else if (channels == 4) {
+        decoded = decodeFourChannels(bytes, samples, scale, planar, rowStride);
+    }
+    decodeScalar(bytes, channels, decoded, samples, scale, planar, rowStride);
+}
+
+/**
+ * @brief Decode into SP_FloatType rows when SP_FloatType is not float
+ */
+template<typename T>
+inline void decode(const uint8_t* bytes, unsigned int channels, size_t samples, float scale, T* planar, size_t rowStride)
+{
+    for (size_t sample = 0; sample < samples; ++sample) {
+        const uint8_t* word = bytes + sample * channels * BYTES_PER_SAMPLE;
+        for (unsigned int channel = 0; channel < channels; ++channel) {
+            planar[channel * rowStride + sample] = decodeSample(word + channel * BYTES_PER_SAMPLE, scale);
+        }
+    }
+}
+
+} // namespace MBT_RawFrameDetail
+
+/**
+ * @brief Decoder of the EEG bytes of a headset into planar signals
+ *
+ * The decoder keeps the index of the last frame given to @ref decodeFrames, to detect the frames lost
+ * between two calls, and a buffer for the payloads of the frames: one decoder per stream, used by one
+ * thread at a time.
+ */
+class MBT_RawFrameDecoder
+{
+    public:
+        /**
+         * @brief Decoder of the samples of `channels` interleaved channels, 2 for Melomind and 4 for Q+
+         * @throws std::invalid_argument if there is no channel
+         */
+        explicit MBT_RawFrameDecoder(unsigned int channels, MBT_RawUnit unit = MBT_RAW_UNIT_VOLT,
+                                     MBT_LostFrameFill fill = MBT_LOST_FRAME_FILL_BYTES) :
+            m_channels(channels), m_scale(MBT_RawFrameDetail::scaleOf(unit)), m_fill(fill), m_previousIndex(-1)
+        {
+            if (channels == 0) {
+                throw std::invalid_argument("MBT_RawFrameDecoder: the number of channels must be positive");
+            }
+        }
+
+        unsigned int channels() const { return m_channels; }
+
+        /**
+         * @brief Number of samples of each channel in `size` bytes of samples, the incomplete last samples
+         * being ignored as by EEGDeserializer
+         */
+        size_t samplesIn(size_t size) const { return size / (MBT_RawFrameDetail::BYTES_PER_SAMPLE * m_channels); }
+
+        /**
+         * @brief Decode bytes of samples without allocation
+         * @param bytes Interleaved samples, without the index of the frames
+         * @param size Number of bytes
+         * @param planar Receives samplesIn(size) samples of each channel, channel c from planar + c * rowStride
+         * @param rowStride Distance between the first samples of two channels, at least samplesIn(size)
+         * @return The number of samples of each channel
+         */
+        size_t decode(const uint8_t* bytes, size_t size, SP_FloatType* planar, size_t rowStride) const
+        {
+            const size_t samples = samplesIn(size);
+            if (samples > rowStride && m_channels > 1) {
+                throw std::invalid_argument("MBT_RawFrameDecoder: the rows overlap");
+            }
+            MBT_RawFrameDetail::decode(bytes, m_channels, samples, m_scale, planar, rowStride);
+            return samples;
+        }
+
+        /**
+         * @brief Decode bytes of samples into a matrix of one row per channel
+         */
+        SP_FloatMatrix decode(const uint8_t* bytes, size_t size) const
+        {
+            const size_t samples = samplesIn(size);
+            SP_FloatMatrix signal(m_channels, static_cast<unsigned int>(samples));
+            MBT_RawFrameDetail::decode(bytes, m_channels, samples, m_scale, signal.data(), samples);
+            return signal;
+        }
+
+        /**
+         * @brief Decode consecutive frames of `frameSize` bytes, each starting with the big-endian index of
+         * the frame. The frames lost before a frame, according to the indexes, are filled as chosen at the
+         * construction. The index of the last frame is kept for the next call.
+         * @throws std::invalid_argument if a frame has no sample byte
+         */
+        SP_FloatMatrix decodeFrames(const uint8_t* frames, size_t frameCount, size_t frameSize)
+        {
+            gatherFrames(frames, frameCount, frameSize);
+            const size_t samples = samplesIn(m_payloads.size());
+            SP_FloatMatrix signal(m_channels, static_cast<unsigned int>(samples));
+            decodePayloads(signal.data(), samples);
+            return signal;
+        }
+
+        /**
+         * @brief Decode consecutive frames without allocation once the buffer of the payloads has grown,
+         * as @ref decodeFrames
+         * @param planar Receives samplesInFrames(frames, frameCount, frameSize) samples of each channel,
+         * channel c from planar + c * rowStride
+         * @return The number of samples of each channel
+         * @throws std::invalid_argument if a frame has no sample byte or if the rows overlap
+         */
+        size_t decodeFrames(const uint8_t* frames, size_t frameCount, size_t frameSize, SP_FloatType* planar,
+                            size_t rowStride)
+        {
+            if (samplesInFrames(frames, frameCount, frameSize) > rowStride && m_channels > 1) {
+                throw std::invalid_argument("MBT_RawFrameDecoder: the rows overlap");
+            }
+            gatherFrames(frames, frameCount, frameSize);
+            return decodePayloads(planar, rowStride);
+        }
+
+        /**
+         * @brief Number of samples of each channel that decodeFrames would give for the same frames, the lost
+         * frames included, without changing the index of the last frame
+         * @throws std::invalid_argument if a frame has no sample byte
+         */
+        size_t samplesInFrames(const uint8_t* frames, size_t frameCount, size_t frameSize) const
+        {
+            const size_t payloadSize = payloadSizeOf(frameSize);
+            int32_t previousIndex = m_previousIndex;
+            size_t payloadCount = 0;
+            for (size_t frame = 0; frame < frameCount; ++frame) {
+                const int32_t lost = lostFramesBefore(indexOf(frames + frame * frameSize), previousIndex);
+                payloadCount += (lost > 0 ? static_cast<size_t>(lost) : 0) + 1;
+            }
+            return samplesIn(payloadCount * payloadSize);
+        }
+
+        /**
+         * @brief Forget the index of the last frame, before decoding another stream
+         */
+        void reset() { m_previousIndex = -1; }
+
+    private:
+        static size_t payloadSizeOf(size_t frameSize)
+        {
+            if (frameSize <= MBT_RawFrameDetail::INDEX_BYTES) {
+                throw std::invalid_argument("MBT_RawFrameDecoder: the frames have no sample");
+            }
+            return frameSize - MBT_RawFrameDetail::INDEX_BYTES;
+        }
+
+        static int16_t indexOf(const uint8_t* frame) { return static_cast<int16_t>((frame[0] << 8) | frame[1]); }
+
+        /**
+         * @brief Number of frames lost before a frame, with the rules of EEGAcquisitionBuffer: the first
+         * frame and the frames of index 0 lose nothing, the index restarts from 0 after 32767
+         */
+        static int32_t lostFramesBefore(int16_t index, int32_t& previousIndex)
+        {
+            if (index == 0) {
+                previousIndex = 0;
+            }
+            if (previousIndex == -1) {
+                previousIndex = index - 1;
+            }
+            if (previousIndex >= 32767) {
+                previousIndex = 0;
+            }
+            const int32_t lost = index - previousIndex - 1;
+            previousIndex = index < 0 ? 0 : index;
+            return lost;
+        }
+
+        /**
+         * @brief Copy the payloads of the frames in m_payloads, 0xFF bytes for the lost frames, whose byte
+         * ranges are kept in m_lostRanges
+         */
+        void gatherFrames(const uint8_t* frames, size_t frameCount, size_t frameSize)
+        {
+            const size_t payloadSize = payloadSizeOf(frameSize);
+            m_payloads.clear();
+            m_payloads.reserve(frameCount * payloadSize);
+            m_lostRanges.clear();
+            for (size_t frame = 0; frame < frameCount; ++frame) {
+                const uint8_t* bytes = frames + frame * frameSize;
+                const int32_t lost = lostFramesBefore(indexOf(bytes), m_previousIndex);
+                if (lost > 0) {
+                    const size_t begin = m_payloads.size();
+                    m_payloads.insert(m_payloads.end(), static_cast<size_t>(lost) * payloadSize, 0xFF);
+                    m_lostRanges.push_back(std::make_pair(begin, m_payloads.size()));
+                }
+                m_payloads.insert(m_payloads.end(), bytes + MBT_RawFrameDetail::INDEX_BYTES, bytes + frameSize);
+            }
+        }
+
+        /**
+         * @brief Decode m_payloads, then replace the samples of the lost frames by NaN if requested
+         */
+        size_t decodePayloads(SP_FloatType* planar, size_t rowStride) const
+        {
+            const size_t samples = decode(m_payloads.data(), m_payloads.size(), planar, rowStride);
+            if (m_fill == MBT_LOST_FRAME_FILL_NAN) {
+                const size_t sampleBytes = MBT_RawFrameDetail::BYTES_PER_SAMPLE * m_channels;
+                for (size_t range = 0; range < m_lostRanges.size(); ++range) {
+                    const size_t first = m_lostRanges[range].first / sampleBytes;
+                    const size_t last = std::min(samples, (m_lostRanges[range].second + sampleBytes - 1) / sampleBytes);
+                    for (unsigned int channel = 0; channel < m_channels; ++channel) {
+                        SP_FloatType* row = planar + channel * rowStride;
+                        std::fill(row + first, row + std::max(first, last), std::numeric_limits<SP_FloatType>::quiet_NaN());
+                    }
+                }
+            }
+            return samples;
+        }
+
+        unsigned int m_channels; // number of interleaved channels
+        float m_scale; // unit of the ADC code
+        MBT_LostFrameFill m_fill; // samples of the lost frames
+        int32_t m_previousIndex; // index of the last frame, -1 before the first one
+        std::vector<uint8_t> m_payloads; // samples of the frames and of the lost frames
+        std::vector<std::pair<size_t, size_t> > m_lostRanges; // byte ranges of the lost frames in m_payloads
+};
+
+#endif // MBT_RAWFRAMEDECODER_H
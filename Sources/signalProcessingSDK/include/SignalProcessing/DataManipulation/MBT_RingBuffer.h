@@ -0,0 +1,307 @@
+/**
+ * @file MBT_RingBuffer.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief History of multi-channel samples shared by one producer thread and one consumer thread without lock.
+ * The producer, typically the acquisition with @ref MBT_RawFrameDecoder, pushes the samples of all the
+ * channels together. The consumer, the quality checker and the neurofeedback, reads windows of the history
+ * as @ref MBT_RingView, without copying them out of the ring, and releases the samples it will not read
+ * again so that the producer can overwrite them:
+ *
+ *     // consumer, every second, on 2 s windows
+ *     if (ring.available() >= 2 * sampRate) {
+ *         const MBT_RingView<SP_FloatType> window = ring.latest(2 * sampRate);
+ *         window.copyTo(packet);  // once, into a reused matrix, for the libraries
+ *         pipeline.process(window, 0);  // header-only stages read the ring directly
+ *         ring.release(window.end() - sampRate);  // the last second is kept for the next window
+ *     }
+ *
+ * A window which wraps around the end of the storage has two segments per channel, the second one
+ * starting at the beginning of the row. Each channel row starts on a cache line, and the counters of
+ * the producer and of the consumer are on separate cache lines.
+ *
+ */
+
+#ifndef MBT_RINGBUFFER_H
+#define MBT_RINGBUFFER_H
+
+#include <sp-global.h>
+
+#include "DataManipulation/MBT_Matrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <stdint.h>
+#include <vector>
+
+namespace MBT_RingBufferDetail {
+
+enum { CACHE_LINE = 64 };
+
+/**
+ * @brief Smallest power of two not below a size
+ */
+inline size_t powerOfTwoAbove(size_t size)
+{
+    size_t power = 1;
+    while (power < size) {
+        power *= 2;
+    }
+    return power;
+}
+
+/**
+ * @brief Counter written by one thread, alone on its cache line. The counter is padded rather than aligned,
+ * because operator new does not honour extended alignments before C++17.
+ */
+struct PaddedCounter {
+    char before[CACHE_LINE]; // keeps the previous fields off the line of the counter
+    std::atomic<uint64_t> value; // the counter
+    char after[CACHE_LINE]; // keeps the next fields off the line of the counter
+};
+
+/**
+ * @brief Counter of the producer, with the last value of the consumer counter it has read, so that it
+ * reads the line of the consumer only when the ring seems full
+ */
+struct ProducerCounter {
+    char before[CACHE_LINE]; // keeps the previous fields off the line of the counter
+    std::atomic<uint64_t> value; // the counter
+    uint64_t seen; // last value of the consumer counter read by the producer
+    char after[CACHE_LINE]; // keeps the next fields off the line of the counter
+};
+
+} // namespace MBT_RingBufferDetail
+
+/**
+ * @brief Window of samples of a @ref MBT_RingBuffer, read in place
+ *
+ * The view refers to the storage of the ring: it stays valid until the consumer releases its samples.
+ */
+template<typename T>
+class MBT_RingView
+{
+    public:
+        MBT_RingView()
+        : m_data(0), m_rowStride(0), m_channels(0), m_offset(0), m_first(0), m_size(0), m_start(0)
+        {}
+
+        MBT_RingView(const T* data, size_t rowStride, unsigned int channels, size_t offset, size_t capacity,
+                     size_t size, uint64_t start)
+        : m_data(data), m_rowStride(rowStride), m_channels(channels), m_offset(offset),
+          m_first(std::min(size, capacity - offset)), m_size(size), m_start(start)
+        {}
+
+        unsigned int channels() const { return m_channels; } // number of channels
+        size_t size() const { return m_size; } // number of samples of each channel
+        uint64_t start() const { return m_start; } // position of the first sample in the stream
+        uint64_t end() const { return m_start + m_size; } // position after the last sample in the stream
+        bool isContiguous() const { return m_first == m_size; } // true if the window does not wrap around
+
+        /**
+         * @brief Samples of a channel up to the end of the storage, `firstSize()` samples
+         */
+        const T* firstSegment(unsigned int channel) const { return m_data + channel * m_rowStride + m_offset; }
+        size_t firstSize() const { return m_first; }
+
+        /**
+         * @brief Samples of a channel from the beginning of the storage, `secondSize()` samples, none if
+         * the window is contiguous
+         */
+        const T* secondSegment(unsigned int channel) const { return m_data + channel * m_rowStride; }
+        size_t secondSize() const { return m_size - m_first; }
+
+        /**
+         * @brief Sample of a channel, 0 being the first sample of the window
+         */
+        const T& operator()(unsigned int channel, size_t sample) const
+        {
+            return sample < m_first ? firstSegment(channel)[sample] : secondSegment(channel)[sample - m_first];
+        }
+
+        /**
+         * @brief Copy the samples of a channel, in order, into `size()` values
+         */
+        void copyTo(unsigned int channel, T* output) const
+        {
+            const T* first = firstSegment(channel);
+            std::copy(first, first + m_first, output);
+            std::copy(secondSegment(channel), secondSegment(channel) + secondSize(), output + m_first);
+        }
+
+        /**
+         * @brief Copy the window into a matrix of one row per channel, to give it to the libraries
+         * @throws std::invalid_argument if the matrix does not have the shape of the window
+         */
+        void copyTo(MBT_Matrix<T>& matrix) const
+        {
+            if (matrix.size().first != static_cast<int>(m_channels) || matrix.size().second != static_cast<int>(m_size)) {
+                throw std::invalid_argument("MBT_RingView: the matrix does not have the shape of the window");
+            }
+            for (unsigned int channel = 0; channel < m_channels; ++channel) {
+                copyTo(channel, matrix.rowData(channel));
+            }
+        }
+
+    private:
+        const T* m_data; // first sample of the storage of the first channel
+        size_t m_rowStride; // distance between the storages of two channels
+        unsigned int m_channels; // number of channels
+        size_t m_offset; // index of the first sample in the storage of a channel
+        size_t m_first; // number of samples before the end of the storage
+        size_t m_size; // number of samples of each channel
+        uint64_t m_start; // position of the first sample in the stream
+};
+
+/**
+ * @brief Lock-free single producer, single consumer ring of multi-channel samples
+ *
+ * The samples are numbered from 0 since the construction or the last reset. The producer writes at
+ * `written()`; the consumer reads any window between `released()` and `written()`. Only the producer
+ * calls push and writable, only the consumer calls window, latest and release; available, written and
+ * released may be called by both.
+ */
+template<typename T>
+class MBT_RingBuffer
+{
+    public:
+        typedef MBT_RingView<T> View;
+
+        /**
+         * @brief Construct a ring keeping at least `capacity` samples of each channel, rounded up to a
+         * power of two
+         * @throws std::invalid_argument if there is no channel or no capacity
+         */
+        MBT_RingBuffer(unsigned int channels, size_t capacity)
+        : m_channels(channels), m_capacity(MBT_RingBufferDetail::powerOfTwoAbove(capacity)), m_data(0)
+        {
+            reset();
+            if (channels == 0 || capacity == 0) {
+                throw std::invalid_argument("MBT_RingBuffer: the number of channels and the capacity must be positive");
+            }
+            const size_t lineValues = std::max<size_t>(1, MBT_RingBufferDetail::CACHE_LINE / sizeof(T));
+            m_rowStride = (m_capacity + lineValues - 1) / lineValues * lineValues;
+            m_storage.resize(m_channels * m_rowStride + lineValues);
+            const uintptr_t address = reinterpret_cast<uintptr_t>(m_storage.data());
+            const uintptr_t aligned = (address + MBT_RingBufferDetail::CACHE_LINE - 1) & ~static_cast<uintptr_t>(MBT_RingBufferDetail::CACHE_LINE - 1);
+            m_data = m_storage.data() + (aligned - address) / sizeof(T);
+        }
+
+        unsigned int channels() const { return m_channels; } // number of channels
+        size_t capacity() const { return m_capacity; } // number of samples kept for each channel
+
+        uint64_t written() const { return m_written.value.load(std::memory_order_acquire); } // number of samples pushed
+        uint64_t released() const { return m_released.value.load(std::memory_order_acquire); } // number of samples released
+        size_t available() const { return static_cast<size_t>(written() - released()); } // samples readable by the consumer
+
+        /**
+         * @brief Producer: number of samples which can be pushed without overwriting unreleased samples
+         */
+        size_t writable() const
+        {
+            return m_capacity - static_cast<size_t>(m_written.value.load(std::memory_order_relaxed) - released());
+        }
+
+        /**
+         * @brief Producer: push the samples of each channel, channel c being read from planar + c * rowStride
+         * @return The number of samples pushed, less than `samples` if the ring is full
+         */
+        size_t push(const T* planar, size_t rowStride, size_t samples)
+        {
+            const uint64_t written = m_written.value.load(std::memory_order_relaxed);
+            if (written - m_written.seen + samples > m_capacity) {
+                m_written.seen = m_released.value.load(std::memory_order_acquire);
+            }
+            const size_t count = std::min(samples, m_capacity - static_cast<size_t>(written - m_written.seen));
+            const size_t offset = static_cast<size_t>(written) & (m_capacity - 1);
+            const size_t first = std::min(count, m_capacity - offset);
+            for (unsigned int channel = 0; channel < m_channels; ++channel) {
+                const T* input = planar + channel * rowStride;
+                T* row = m_data + channel * m_rowStride;
+                std::copy(input, input + first, row + offset);
+                std::copy(input + first, input + count, row);
+            }
+            m_written.value.store(written + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief Producer: push the rows of a matrix of one row per channel
+         * @throws std::invalid_argument if the matrix does not have one row per channel
+         */
+        size_t push(const MBT_Matrix<T>& matrix)
+        {
+            if (matrix.size().first != static_cast<int>(m_channels)) {
+                throw std::invalid_argument("MBT_RingBuffer: the matrix does not have one row per channel");
+            }
+            return push(matrix.data(), matrix.size().second, matrix.size().second);
+        }
+
+        /**
+         * @brief Consumer: window of `size` samples from the position `start` of the stream
+         * @throws std::out_of_range if the window is not between released() and written()
+         */
+        View window(uint64_t start, size_t size) const
+        {
+            if (start < m_released.value.load(std::memory_order_relaxed) || start + size > written()) {
+                throw std::out_of_range("MBT_RingBuffer: the window is not in the history");
+            }
+            return View(m_data, m_rowStride, m_channels, static_cast<size_t>(start) & (m_capacity - 1), m_capacity, size, start);
+        }
+
+        /**
+         * @brief Consumer: window of the last `size` samples pushed
+         * @throws std::out_of_range if fewer samples are available
+         */
+        View latest(size_t size) const
+        {
+            const uint64_t end = written();
+            if (size > end - m_released.value.load(std::memory_order_relaxed)) {
+                throw std::out_of_range("MBT_RingBuffer: the window is not in the history");
+            }
+            return View(m_data, m_rowStride, m_channels, static_cast<size_t>(end - size) & (m_capacity - 1), m_capacity, size, end - size);
+        }
+
+        /**
+         * @brief Consumer: let the producer overwrite the samples before the position `end`, the views
+         * on them become invalid. A position before released() is ignored.
+         * @throws std::out_of_range if the position is after written()
+         */
+        void release(uint64_t end)
+        {
+            if (end > written()) {
+                throw std::out_of_range("MBT_RingBuffer: the samples to release have not been written");
+            }
+            if (end > m_released.value.load(std::memory_order_relaxed)) {
+                m_released.value.store(end, std::memory_order_release);
+            }
+        }
+
+        /**
+         * @brief Empty the ring and number the samples from 0 again, while neither thread uses it
+         */
+        void reset()
+        {
+            m_written.value.store(0, std::memory_order_relaxed);
+            m_released.value.store(0, std::memory_order_relaxed);
+            m_written.seen = 0;
+        }
+
+    private:
+        MBT_RingBuffer(const MBT_RingBuffer&);
+        MBT_RingBuffer& operator=(const MBT_RingBuffer&);
+
+        const unsigned int m_channels; // number of channels
+        const size_t m_capacity; // number of samples of each channel, a power of two
+        size_t m_rowStride; // distance between the storages of two channels, whole cache lines
+        std::vector<T> m_storage; // storage of the channels, with room for the alignment
+        T* m_data; // storage of the first channel, aligned on a cache line
+
+        MBT_RingBufferDetail::ProducerCounter m_written; // number of samples pushed, written by the producer
+        MBT_RingBufferDetail::PaddedCounter m_released; // number of samples released, written by the consumer
+};
+
+#endif // MBT_RINGBUFFER_H
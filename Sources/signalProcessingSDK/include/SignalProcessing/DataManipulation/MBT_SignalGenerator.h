@@ -0,0 +1,362 @@
+/**
+ * @file MBT_SignalGenerator.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Synthetic EEG for load and accuracy tests of the processing pipeline, generated packet by packet.
+ * Each channel is the sum of a 1/f background (white noise through Paul Kellet's pink filter) and of an
+ * alpha rhythm (white noise through a two-pole resonator, which gives a peak of the requested frequency
+ * and bandwidth). Artifacts are added as random events shared by the channels: muscle bursts (high
+ * frequency noise), eye blinks (slow bumps), flat lines (the sensor holding its last value) and lost
+ * Bluetooth frames (NaN). Each kind of artifact starts with a given rate per second and lasts between
+ * half and one and a half times its mean duration.
+ *
+ * The random numbers are integers (xorshift64*) and the normal noise is the sum of four uniform numbers,
+ * so that a sample costs a few tens of operations per channel and does not depend on the distributions of
+ * the standard library. The same seed gives the same signal on the same platform. The filters and the
+ * artifact shapes go through std::exp, std::sin and std::cos and may be contracted in FMA, so the signals
+ * of two platforms may differ in the last bits.
+ *
+ */
+
+#ifndef MBT_SIGNALGENERATOR_H
+#define MBT_SIGNALGENERATOR_H
+
+#include <sp-global.h>
+
+#include "DataManipulation/MBT_Matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Parameters of the synthetic EEG, the amplitudes are in microvolts. All the artifacts are
+ * disabled by default (rates of 0)
+ *
+ */
+struct MBT_SignalGeneratorConfig {
+    SP_FloatType sampRate; // sampling rate in Hz
+    int channels; // number of channels
+    int packetLength; // number of samples per packet
+    SP_FloatType backgroundAmplitude; // standard deviation of the 1/f background
+    SP_FloatType alphaFrequency; // frequency of the alpha peak in Hz, between IAFinf and IAFsup to be found by the IAF
+    SP_FloatType alphaBandwidth; // width of the alpha peak in Hz
+    SP_FloatType alphaAmplitude; // standard deviation of the alpha rhythm
+    SP_FloatType muscleRate; // muscle bursts per second
+    SP_FloatType muscleDuration; // mean duration of a muscle burst in seconds
+    SP_FloatType muscleAmplitude; // standard deviation of a muscle burst at its maximum
+    SP_FloatType blinkRate; // eye blinks per second
+    SP_FloatType blinkDuration; // mean duration of an eye blink in seconds
+    SP_FloatType blinkAmplitude; // height of an eye blink on the most exposed channel
+    SP_FloatType flatRate; // flat lines per second
+    SP_FloatType flatDuration; // mean duration of a flat line in seconds
+    SP_FloatType gapRate; // lost frames per second
+    SP_FloatType gapDuration; // mean duration of a lost frame in seconds
+
+    MBT_SignalGeneratorConfig()
+    : sampRate(250), channels(2), packetLength(250),
+      backgroundAmplitude(10), alphaFrequency(10), alphaBandwidth(1), alphaAmplitude(8),
+      muscleRate(0), muscleDuration(1), muscleAmplitude(30),
+      blinkRate(0), blinkDuration(0.3f), blinkAmplitude(100),
+      flatRate(0), flatDuration(2),
+      gapRate(0), gapDuration(0.1f)
+    {}
+};
+
+/**
+ * @brief Seeded generator of synthetic EEG. The state carries over from one packet to the next, so that
+ * the packets form one continuous recording. Not thread safe: use one generator per simulated headset
+ *
+ */
+class MBT_SignalGenerator
+{
+    public:
+        /**
+         * @brief Artifacts affecting a sample, in @ref labels
+         */
+        enum Label {
+            MUSCLE = 1,
+            BLINK = 2,
+            FLAT = 4,
+            GAP = 8
+        };
+
+        /**
+         * @brief Construct a new generator
+         *
+         * @param config The parameters of the signal
+         * @param seed The seed, two generators with the same parameters and seed give the same signal on the same platform
+         * @throws std::invalid_argument if the parameters cannot give a signal
+         */
+        explicit MBT_SignalGenerator(MBT_SignalGeneratorConfig const& config = MBT_SignalGeneratorConfig(), uint64_t seed = 1)
+        : m_config(config)
+        {
+            if (!(config.sampRate > 0) || config.channels < 1 || config.packetLength < 1) {
+                throw std::invalid_argument("MBT_SignalGenerator: the sampling rate, the channels and the packet length must be positive");
+            }
+            if (!(config.alphaFrequency > 0) || !(config.alphaFrequency < config.sampRate / 2) || !(config.alphaBandwidth > 0)) {
+                throw std::invalid_argument("MBT_SignalGenerator: the alpha peak must be between 0 and the Nyquist frequency");
+            }
+            const SP_RealType pi = 3.14159265358979323846;
+            const SP_RealType radius = std::exp(-pi * config.alphaBandwidth / config.sampRate);
+            m_alphaA1 = 2 * radius * std::cos(2 * pi * config.alphaFrequency / config.sampRate);
+            m_alphaA2 = -radius * radius;
+            // stationary variance of the resonator driven by a unit white noise
+            const SP_RealType r2 = radius * radius;
+            const SP_RealType alphaVariance = (1 + r2) / ((1 - r2) * ((1 + r2) * (1 + r2) - m_alphaA1 * m_alphaA1));
+            m_alphaGain = config.alphaAmplitude / std::sqrt(alphaVariance);
+            m_backgroundGain = config.backgroundAmplitude / pinkDeviation();
+            m_channels.resize(config.channels);
+            reset(seed);
+        }
+
+        /**
+         * @brief Restart the signal from a seed
+         */
+        void reset(uint64_t seed)
+        {
+            // splitmix64 of the seed, the state of xorshift64* must not be 0
+            uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            m_state = (z ^ (z >> 31)) | 1;
+
+            for (size_t channel = 0; channel < m_channels.size(); ++channel) {
+                ChannelState& state = m_channels[channel];
+                for (int i = 0; i < 7; ++i) {
+                    state.pink[i] = 0;
+                }
+                state.alpha1 = 0;
+                state.alpha2 = 0;
+                state.muscle1 = 0;
+                state.held = 0;
+                // the channels nearest to the eyes see the largest blinks
+                state.blinkGain = 0.6 + 0.4 * uniform();
+            }
+            m_muscle = Event();
+            m_blink = Event();
+            m_flat = Event();
+            m_gap = Event();
+            m_sampleCount = 0;
+            m_labels.clear();
+        }
+
+        /**
+         * @brief Get the parameters of the signal
+         */
+        MBT_SignalGeneratorConfig const& config() const { return m_config; }
+
+        /**
+         * @brief Get the number of samples generated since the last reset
+         */
+        uint64_t sampleCount() const { return m_sampleCount; }
+
+        /**
+         * @brief Get the artifacts of each sample of the last call, a combination of @ref Label
+         */
+        std::vector<unsigned char> const& labels() const { return m_labels; }
+
+        /**
+         * @brief Generate the next packet
+         *
+         * @return SP_FloatMatrix The packet, one row per channel and the packet length of the parameters as width
+         */
+        SP_FloatMatrix nextPacket()
+        {
+            return generate(m_config.packetLength);
+        }
+
+        /**
+         * @brief Generate the next samples
+         *
+         * @param samples The number of samples per channel
+         * @return SP_FloatMatrix The samples, one row per channel
+         */
+        SP_FloatMatrix generate(int samples)
+        {
+            SP_FloatMatrix signal(m_config.channels, samples);
+            generate(signal);
+            return signal;
+        }
+
+        /**
+         * @brief Generate the next samples into an existing matrix, without allocation once the labels have their capacity
+         *
+         * @param signal Receives as many samples as its width, one row per channel
+         * @throws std::invalid_argument if the matrix does not have one row per channel
+         */
+        void generate(SP_FloatMatrix& signal)
+        {
+            if (signal.size().first != m_config.channels) {
+                throw std::invalid_argument("MBT_SignalGenerator: the matrix must have one row per channel");
+            }
+            const int samples = signal.size().second;
+            m_labels.resize(samples);
+            const SP_FloatType nan = std::numeric_limits<SP_FloatType>::quiet_NaN();
+
+            for (int i = 0; i < samples; ++i) {
+                const unsigned char label = nextLabel();
+                m_labels[i] = label;
+                const SP_RealType muscleEnvelope = (label & MUSCLE) ? m_config.muscleAmplitude * m_muscle.window() : 0;
+                const SP_RealType blink = (label & BLINK) ? m_config.blinkAmplitude * m_blink.bump() : 0;
+
+                for (int channel = 0; channel < m_config.channels; ++channel) {
+                    ChannelState& state = m_channels[channel];
+                    const SP_RealType background = m_backgroundGain * pinkStep(state.pink, normal());
+                    const SP_RealType alpha = m_alphaA1 * state.alpha1 + m_alphaA2 * state.alpha2 + m_alphaGain * normal();
+                    state.alpha2 = state.alpha1;
+                    state.alpha1 = alpha;
+                    SP_RealType value = background + alpha;
+                    if (label & MUSCLE) {
+                        // differentiated noise, mostly above 60 Hz at 250 Hz
+                        const SP_RealType noise = normal();
+                        value += muscleEnvelope * (noise - state.muscle1) * 0.70710678118654752;
+                        state.muscle1 = noise;
+                    }
+                    value += blink * state.blinkGain;
+                    if (label & FLAT) {
+                        value = state.held;
+                    } else {
+                        state.held = value;
+                    }
+                    signal.rowData(channel)[i] = (label & GAP) ? nan : static_cast<SP_FloatType>(value);
+                }
+            }
+            m_sampleCount += static_cast<uint64_t>(samples);
+        }
+
+    private:
+        /**
+         * @brief An artifact in progress
+         */
+        struct Event {
+            int length; // number of samples of the event
+            int position; // number of samples of the event already generated
+
+            Event() : length(0), position(0) {}
+
+            bool isActive() const { return position < length; }
+            // sine window over the event
+            SP_RealType window() const { return std::sin(3.14159265358979323846 * (position + 0.5) / length); }
+            // raised cosine over the event
+            SP_RealType bump() const { return 0.5 - 0.5 * std::cos(2 * 3.14159265358979323846 * (position + 0.5) / length); }
+        };
+
+        /**
+         * @brief State of the filters of a channel
+         */
+        struct ChannelState {
+            SP_RealType pink[7]; // state of the pink filter
+            SP_RealType alpha1; // last output of the resonator
+            SP_RealType alpha2; // output of the resonator before the last one
+            SP_RealType muscle1; // last muscle noise
+            SP_RealType held; // value repeated during a flat line
+            SP_RealType blinkGain; // share of the eye blinks seen by the channel
+        };
+
+        uint64_t nextRandom()
+        {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 0x2545F4914F6CDD1DULL;
+        }
+
+        SP_RealType uniform()
+        {
+            return static_cast<SP_RealType>(nextRandom() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        /**
+         * @brief Normal noise of unit variance: sum of four uniform numbers of 16 bits
+         */
+        SP_RealType normal()
+        {
+            const uint64_t r = nextRandom();
+            const SP_RealType sum = static_cast<SP_RealType>((r & 0xFFFF) + ((r >> 16) & 0xFFFF) + ((r >> 32) & 0xFFFF) + (r >> 48));
+            // the sum of four uniform numbers of [0, 1) has a mean of 2 and a variance of 1/3
+            return (sum * (1.0 / 65536.0) - 2) * 1.7320508075688772;
+        }
+
+        /**
+         * @brief Advance an event, start it with the given rate if it is not in progress
+         *
+         * @return bool true if the current sample belongs to the event
+         */
+        bool advance(Event& event, SP_FloatType rate, SP_FloatType duration)
+        {
+            if (event.isActive()) {
+                ++event.position;
+                if (event.isActive()) {
+                    return true;
+                }
+            }
+            if (!(rate > 0) || uniform() >= rate / m_config.sampRate) {
+                return false;
+            }
+            event.length = std::max(1, static_cast<int>(duration * m_config.sampRate * (0.5 + uniform()) + 0.5));
+            event.position = 0;
+            return true;
+        }
+
+        unsigned char nextLabel()
+        {
+            unsigned char label = 0;
+            label |= advance(m_muscle, m_config.muscleRate, m_config.muscleDuration) ? MUSCLE : 0;
+            label |= advance(m_blink, m_config.blinkRate, m_config.blinkDuration) ? BLINK : 0;
+            label |= advance(m_flat, m_config.flatRate, m_config.flatDuration) ? FLAT : 0;
+            label |= advance(m_gap, m_config.gapRate, m_config.gapDuration) ? GAP : 0;
+            return label;
+        }
+
+        /**
+         * @brief One sample of Paul Kellet's pink filter
+         */
+        static SP_RealType pinkStep(SP_RealType* b, SP_RealType white)
+        {
+            b[0] = 0.99886 * b[0] + white * 0.0555179;
+            b[1] = 0.99332 * b[1] + white * 0.0750759;
+            b[2] = 0.96900 * b[2] + white * 0.1538520;
+            b[3] = 0.86650 * b[3] + white * 0.3104856;
+            b[4] = 0.55000 * b[4] + white * 0.5329522;
+            b[5] = -0.7616 * b[5] - white * 0.0168980;
+            const SP_RealType pink = b[0] + b[1] + b[2] + b[3] + b[4] + b[5] + b[6] + white * 0.5362;
+            b[6] = white * 0.115926;
+            return pink;
+        }
+
+        /**
+         * @brief Standard deviation of the pink filter driven by a unit white noise, from its impulse response
+         */
+        static SP_RealType pinkDeviation()
+        {
+            SP_RealType b[7] = { 0, 0, 0, 0, 0, 0, 0 };
+            SP_RealType energy = 0;
+            for (int i = 0; i < 32768; ++i) {
+                const SP_RealType h = pinkStep(b, i == 0 ? 1 : 0);
+                energy += h * h;
+            }
+            return std::sqrt(energy);
+        }
+
+        MBT_SignalGeneratorConfig m_config; // parameters of the signal
+        SP_RealType m_alphaA1; // first coefficient of the resonator
+        SP_RealType m_alphaA2; // second coefficient of the resonator
+        SP_RealType m_alphaGain; // gain of the white noise driving the resonator
+        SP_RealType m_backgroundGain; // gain of the pink filter
+        std::vector<ChannelState> m_channels; // state of each channel
+        Event m_muscle; // muscle burst in progress
+        Event m_blink; // eye blink in progress
+        Event m_flat; // flat line in progress
+        Event m_gap; // lost frame in progress
+        uint64_t m_state; // state of the random numbers
+        uint64_t m_sampleCount; // samples generated since the last reset
+        std::vector<unsigned char> m_labels; // artifacts of each sample of the last call
+};
+
+#endif // MBT_SIGNALGENERATOR_H
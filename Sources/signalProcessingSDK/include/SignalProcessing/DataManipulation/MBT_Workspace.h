@@ -0,0 +1,527 @@
+/**
+ * @file MBT_Workspace.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Preallocated scratch buffers of a processing thread, and overloads of the preprocessing and
+ * quality checker operations writing into caller owned vectors instead of returning new ones.
+ * Once the workspace and the output vectors have reached the size of the signals, the overloads do not
+ * allocate: a thread processing packet after packet with the same configuration runs without heap
+ * allocation after its first packet, and without contention on the allocator when many sessions share a
+ * process.
+ *
+ * Each overload gives exactly the same result as the function it replaces (same order of the sums, same
+ * floating point operations): @ref RemoveDC, @ref CalculateBounds, @ref InterpolateOutliers, @ref detrend,
+ * @ref zero_padding, @ref zeroPadding and @ref powerOfTwoWithoutDC. @ref timeFirstDerivative differs from
+ * the prebuilt library on signals of more than 5 samples, see its overload. The outputs
+ * may be the inputs, to work in place, except for zeroPadding which pads in a scratch vector of the workspace. getAlphaBand and the other band extractions only call
+ * BandPassFilter, whose filter design allocates inside the library, and have no overload.
+ *
+ */
+
+#ifndef MBT_WORKSPACE_H
+#define MBT_WORKSPACE_H
+
+#include <sp-global.h>
+#include <sp-precision.h>
+
+#include "Algebra/MBT_Interpolation.h"
+#include "Algebra/MBT_Quantile.h"
+#include "DataManipulation/MBT_Matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Sizes of the signals processed with a workspace
+ *
+ */
+struct MBT_WorkspaceConfig {
+    /**
+     * @brief Number of channels processed at the same time
+     *
+     */
+    const unsigned int channels;
+    /**
+     * @brief Number of EEG data per EEGPacket
+     *
+     */
+    const unsigned int packetLength;
+    /**
+     * @brief Length of the zero padded signals, 0 to use the length chosen by @ref zeroPadding for packetLength
+     *
+     */
+    const unsigned int nfft;
+};
+
+/**
+ * @brief Get the length of a signal zero padded by @ref zeroPadding: the next power of two, at least 256
+ *
+ * @param length Length of the signal
+ * @return unsigned int The zero padded length
+ */
+inline unsigned int MBT_zeroPaddedLength(unsigned int length)
+{
+    // same operations as zeroPadding, so that the lengths are the same when log is not exact
+    const SP_RealType exponent = std::ceil(std::log(static_cast<SP_RealType>(length)) / std::log(static_cast<SP_RealType>(2)));
+    const int paddedLength = static_cast<int>(std::exp2(exponent));
+    return paddedLength > 255 ? static_cast<unsigned int>(paddedLength) : 256;
+}
+
+/**
+ * @brief Scratch buffers of a processing thread: one signal per channel, and general purpose vectors,
+ * all reserved for the zero padded length. A workspace must not be shared between threads.
+ *
+ */
+class MBT_Workspace
+{
+    public:
+        enum {
+            SCRATCH_COUNT = 4 // number of general purpose vectors, the last one is used by zeroPadding
+        };
+
+        explicit MBT_Workspace(MBT_WorkspaceConfig const& config)
+        : m_channels(0), m_packetLength(0), m_nfft(0)
+        {
+            reserve(config);
+        }
+
+        /**
+         * @brief Get the workspace of the calling thread, grown to the configuration if it is larger
+         *
+         * @param config Sizes of the signals
+         * @return MBT_Workspace& The workspace, destroyed with the thread
+         */
+        static MBT_Workspace& forThread(MBT_WorkspaceConfig const& config)
+        {
+            static thread_local MBT_Workspace workspace(config);
+            workspace.reserve(config);
+            return workspace;
+        }
+
+        /**
+         * @brief Grow the buffers to a configuration, they never shrink
+         *
+         * @param config Sizes of the signals
+         */
+        void reserve(MBT_WorkspaceConfig const& config)
+        {
+            const unsigned int nfft = config.nfft > 0 ? config.nfft : MBT_zeroPaddedLength(config.packetLength);
+            m_channels = config.channels > m_channels ? config.channels : m_channels;
+            m_packetLength = config.packetLength > m_packetLength ? config.packetLength : m_packetLength;
+            m_nfft = nfft > m_nfft ? nfft : m_nfft;
+            // a signal may be zero padded in place, the time vectors hold one more sample
+            const size_t capacity = (m_nfft > m_packetLength ? m_nfft : m_packetLength) + 1;
+
+            m_signals.resize(m_channels);
+            for (size_t channel = 0; channel < m_signals.size(); ++channel) {
+                m_signals[channel].reserve(capacity);
+            }
+            for (size_t i = 0; i < SCRATCH_COUNT; ++i) {
+                m_scratch[i].reserve(capacity);
+            }
+            m_selection.reserve(capacity);
+            m_probabilities.resize(2);
+            m_probabilities[0] = 0.25;
+            m_probabilities[1] = 0.75;
+            m_quartiles.reserve(2);
+        }
+
+        unsigned int channels() const { return m_channels; }
+        unsigned int packetLength() const { return m_packetLength; }
+        unsigned int nfft() const { return m_nfft; }
+
+        /**
+         * @brief Get the signal buffer of a channel
+         *
+         * @throws std::out_of_range if the channel is not in the configuration
+         */
+        SP_Vector& signal(unsigned int channel)
+        {
+            if (channel >= m_signals.size()) {
+                throw std::out_of_range("MBT_Workspace: channel out of range");
+            }
+            return m_signals[channel];
+        }
+
+        /**
+         * @brief Get a general purpose vector
+         *
+         * @throws std::out_of_range if index is not below SCRATCH_COUNT
+         */
+        SP_Vector& scratch(unsigned int index)
+        {
+            if (index >= SCRATCH_COUNT) {
+                throw std::out_of_range("MBT_Workspace: scratch index out of range");
+            }
+            return m_scratch[index];
+        }
+
+        /**
+         * @brief Copy a row of a matrix in the signal buffer of a channel, converted to SP_RealType
+         *
+         * @return SP_Vector& The signal buffer
+         */
+        template<typename T>
+        SP_Vector& loadSignal(unsigned int channel, MBT_Matrix<T> const& matrix, int row)
+        {
+            SP_Vector& buffer = signal(channel);
+            const T* data = matrix.rowData(row);
+            buffer.assign(data, data + matrix.size().second);
+            return buffer;
+        }
+
+        /**
+         * @brief Compute the bounds of the outliers with the selection buffer of the workspace
+         *
+         * @param first Beginning of the values
+         * @param last End of the values
+         * @param bounds Receives the lower and the upper bounds
+         */
+        template<typename InputIt>
+        void outlierBounds(InputIt first, InputIt last, SP_Vector& bounds)
+        {
+            m_selection.assign(first, last);
+            quantilesInPlace(m_selection.begin(), m_selection.end(), m_probabilities, m_quartiles);
+
+            const SP_RealType range = (m_quartiles[1] - m_quartiles[0]) * 1.5;
+            bounds.resize(2);
+            bounds[0] = m_quartiles[0] - range;
+            bounds[1] = m_quartiles[1] + range;
+        }
+
+    private:
+        MBT_Workspace(MBT_Workspace const&);
+        MBT_Workspace& operator=(MBT_Workspace const&);
+
+        unsigned int m_channels; // largest number of channels reserved
+        unsigned int m_packetLength; // largest packet length reserved
+        unsigned int m_nfft; // largest zero padded length reserved
+        std::vector<SP_Vector> m_signals; // one signal per channel
+        SP_Vector m_scratch[SCRATCH_COUNT]; // general purpose vectors
+        SP_Vector m_selection; // values reordered by the quantile selection
+        SP_Vector m_probabilities; // probabilities of the quartiles of the bounds
+        SP_Vector m_quartiles; // first and third quartiles
+};
+
+namespace MBT_WorkspaceDetail {
+
+/**
+ * @brief Same sum as @ref mean: in order, in SP_RealType
+ */
+template<typename T>
+SP_RealType sequentialMean(std::vector<T> const& input)
+{
+    SP_RealType sum = 0;
+    for (size_t i = 0; i < input.size(); ++i) {
+        sum += static_cast<SP_RealType>(input[i]);
+    }
+    return sum / static_cast<SP_RealType>(input.size());
+}
+
+/*
+ * Kernels of the overloads below on buffers of `size` samples, read, accumulated and written in T, the outputs
+ * may be the inputs. Size is size_t, or a std::integral_constant for the fixed shapes of MBT_FixedShape.h: the
+ * loops then have constant trip counts. T is SP_RealType for the overloads, or float for the single precision
+ * pipeline of MBT_PrecisionPipeline.h. The kernels are compiled without FMA contraction, so that in SP_RealType
+ * every product and sum is rounded as in the library.
+ */
+SP_FP_CONTRACT_OFF_BEGIN
+
+/**
+ * @brief Same sum as @ref mean: in order, in T
+ */
+template<typename T, typename Size>
+T sequentialMean(const T* input, Size size)
+{
+    T sum = 0;
+    for (size_t i = 0; i < size; ++i) {
+        sum += input[i];
+    }
+    return sum / static_cast<T>(size);
+}
+
+template<typename T, typename Size>
+void removeDC(const T* input, Size size, T* output)
+{
+    const T mean = sequentialMean(input, size);
+    for (size_t i = 0; i < size; ++i) {
+        output[i] = input[i] - mean;
+    }
+}
+
+template<typename T, typename Size>
+void powerOfTwoWithoutDC(const T* input, Size size, T* output)
+{
+    const T mean = sequentialMean(input, size);
+    for (size_t i = 0; i < size; ++i) {
+        const T centered = input[i] - mean;
+        output[i] = centered * centered;
+    }
+}
+
+template<typename T, typename Size>
+void detrend(const T* input, Size size, T fs, T* output)
+{
+    // the sums are accumulated in the order of the library, each one in its own loop
+    T sumTime = 0;
+    for (size_t i = 0; i < size; ++i) {
+        sumTime += static_cast<T>(static_cast<int>(i)) / fs;
+    }
+    T sumData = 0;
+    for (size_t i = 0; i < size; ++i) {
+        sumData += input[i];
+    }
+    T sumTime2 = 0;
+    T sumTimeData = 0;
+    for (size_t i = 0; i < size; ++i) {
+        const T time = static_cast<T>(static_cast<int>(i)) / fs;
+        const T time2 = time * time;
+        sumTime2 += time2;
+        const T timeData = time * input[i];
+        sumTimeData += timeData;
+    }
+
+    const T count = static_cast<T>(static_cast<int>(size));
+    const T slopeProduct = sumTimeData * count;
+    const T slopeCross = sumTime * sumData;
+    const T denominatorProduct = count * sumTime2;
+    const T denominatorCross = sumTime * sumTime;
+    const T denominator = denominatorProduct - denominatorCross;
+    const T interceptProduct = sumData * sumTime2;
+    const T interceptCross = sumTime * sumTimeData;
+    const T slope = (slopeProduct - slopeCross) / denominator;
+    const T intercept = (interceptProduct - interceptCross) / denominator;
+
+    for (size_t i = 0; i < size; ++i) {
+        const T scaled = static_cast<T>(static_cast<int>(i)) / fs * slope;
+        const T trend = scaled + intercept;
+        output[i] = input[i] - trend;
+    }
+}
+
+/**
+ * In SP_RealType the time step is the difference of the sample times, as in the library. In a narrower type,
+ * the sample times of a long window are rounded to a few ulps of the time step, which is computed from the
+ * difference of the indexes instead.
+ *
+ * @return size_t The number of derivatives written, one less than the kept samples
+ */
+template<typename T, typename Size>
+size_t timeFirstDerivative(const T* input, Size size, T rate, T* output)
+{
+    const bool isReference = SP_PrecisionTraits<T>::isReference();
+    size_t count = 0; // number of derivatives written
+    bool hasPrevious = false;
+    size_t previousIndex = 0;
+    T previousTime = 0;
+    T previousValue = 0;
+    for (size_t i = 0; i < size; ++i) {
+        const T time = static_cast<T>(static_cast<unsigned int>(i)) / rate;
+        const T nextTime = static_cast<T>(static_cast<unsigned int>(i + 1)) / rate;
+        if (nextTime - time == 0) {
+            continue;
+        }
+        // read before output[count] is written, count never exceeds i
+        const T value = input[i];
+        if (hasPrevious) {
+            const T step = isReference ? time - previousTime : static_cast<T>(i - previousIndex) / rate;
+            output[count++] = (value - previousValue) / step;
+        }
+        hasPrevious = true;
+        previousIndex = i;
+        previousTime = time;
+        previousValue = value;
+    }
+    return count;
+}
+
+SP_FP_CONTRACT_OFF_END
+
+} // namespace MBT_WorkspaceDetail
+
+/**
+ * @brief Remove the DC offset, same result as @ref RemoveDC
+ *
+ * @param data The signal
+ * @param result Receives the signal without its mean, may be data
+ */
+inline void RemoveDC(SP_Vector const& data, SP_Vector& result)
+{
+    result.resize(data.size());
+    MBT_WorkspaceDetail::removeDC(data.data(), data.size(), result.data());
+}
+
+#ifndef SP_FLOAT_OR_NOT_LEGACY
+/**
+ * @brief Remove the DC offset, same result as @ref RemoveDC: the mean and the differences are computed
+ * in SP_RealType, then converted to float
+ *
+ * @param data The signal
+ * @param result Receives the signal without its mean, may be data
+ */
+inline void RemoveDC(SP_FloatVector const& data, SP_FloatVector& result)
+{
+    const SP_RealType mean = MBT_WorkspaceDetail::sequentialMean(data);
+    result.resize(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        result[i] = static_cast<SP_FloatType>(static_cast<SP_RealType>(data[i]) - mean);
+    }
+}
+#endif
+
+/**
+ * @brief Compute the lower and upper bounds used to detect the outliers, same result as @ref CalculateBounds
+ *
+ * @param data The signal
+ * @param bounds Receives the lower and the upper bounds
+ * @param workspace Workspace of the calling thread
+ * @throws std::out_of_range if the signal is empty
+ */
+inline void CalculateBounds(SP_Vector const& data, SP_Vector& bounds, MBT_Workspace& workspace)
+{
+    workspace.outlierBounds(data.begin(), data.end(), bounds);
+}
+
+#ifndef SP_FLOAT_OR_NOT_LEGACY
+/**
+ * @brief Compute the lower and upper bounds used to detect the outliers, same result as @ref CalculateBounds
+ * The quartiles are computed in double, the bounds are then converted to float.
+ *
+ * @param data The signal
+ * @param bounds Receives the lower and the upper bounds
+ * @param workspace Workspace of the calling thread
+ * @throws std::out_of_range if the signal is empty
+ */
+inline void CalculateBounds(SP_FloatVector const& data, SP_FloatVector& bounds, MBT_Workspace& workspace)
+{
+    SP_Vector& realBounds = workspace.scratch(0);
+    workspace.outlierBounds(data.begin(), data.end(), realBounds);
+    bounds.resize(2);
+    bounds[0] = static_cast<SP_FloatType>(realBounds[0]);
+    bounds[1] = static_cast<SP_FloatType>(realBounds[1]);
+}
+#endif
+
+/**
+ * @brief Interpolate the outliers, same result as @ref InterpolateOutliers
+ *
+ * @param data The signal
+ * @param bounds The low bound and the up bound to detect the outliers
+ * @param result Receives the signal with the interpolated outliers, may be data
+ * @return size_t The number of interpolated samples
+ */
+inline size_t InterpolateOutliers(SP_Vector const& data, SP_Vector const& bounds, SP_Vector& result)
+{
+    if (&result != &data) {
+        result.assign(data.begin(), data.end());
+    }
+    return MBT_interpolateOutliersInPlace(result, bounds);
+}
+
+/**
+ * @brief Remove the best straight-line fit of a signal, same result as @ref detrend
+ *
+ * @param original The signal
+ * @param fs The sampling frequency
+ * @param result Receives the detrended signal, may be original
+ */
+inline void detrend(SP_Vector const& original, const SP_RealType fs, SP_Vector& result)
+{
+    result.resize(original.size());
+    MBT_WorkspaceDetail::detrend(original.data(), original.size(), fs, result.data());
+}
+
+/**
+ * @brief Add zeros before or after a signal, same result as @ref zero_padding
+ *
+ * @param input The signal
+ * @param length Number of zeros
+ * @param type 1 to add the zeros before the signal, -1 after, other values to keep only the zeros
+ * @param result Receives the zero padded signal, may be input
+ */
+template<typename T>
+void zero_padding(std::vector<T> const& input, int length, int type, std::vector<T>& result)
+{
+    const size_t zeros = length > 0 ? static_cast<size_t>(length) : 0;
+    if (type == 1) {
+        const size_t size = input.size();
+        result.resize(size + zeros);
+        // moved backwards, so that input may be result
+        for (size_t i = size; i > 0; --i) {
+            result[zeros + i - 1] = input[i - 1];
+        }
+        std::fill(result.begin(), result.begin() + zeros, T());
+    } else if (type == -1) {
+        if (&result != &input) {
+            result.assign(input.begin(), input.end());
+        }
+        result.resize(result.size() + zeros, T());
+    } else {
+        result.assign(zeros, T());
+    }
+}
+
+/**
+ * @brief Zero pad a signal to the next power of two, at least 256, same result as @ref zeroPadding.
+ * The signal is copied and padded in the last scratch vector of the workspace, reserved for the zero padded
+ * length, instead of being padded in place: the buffers of the caller and of the workspace keep their
+ * capacities.
+ *
+ * @param input The signal, may be the last scratch vector of the workspace
+ * @param N Receives the length of the zero padded signal
+ * @param nfft Receives the zero padded length
+ * @param nb_zero_added Receives the number of zeros added
+ * @param workspace Workspace of the calling thread
+ * @return SP_Vector& The zero padded signal, the last scratch vector of the workspace
+ */
+inline SP_Vector& zeroPadding(SP_Vector const& input, unsigned int& N, unsigned int& nfft, unsigned int& nb_zero_added, MBT_Workspace& workspace)
+{
+    SP_Vector& padded = workspace.scratch(MBT_Workspace::SCRATCH_COUNT - 1);
+    if (&padded != &input) {
+        padded.assign(input.begin(), input.end());
+    }
+    N = static_cast<unsigned int>(padded.size());
+    nfft = MBT_zeroPaddedLength(N);
+    nb_zero_added = nfft - N;
+    if (nfft > N) {
+        padded.resize(nfft, 0);
+    }
+    N = static_cast<unsigned int>(padded.size());
+    return padded;
+}
+
+/**
+ * @brief Compute the square of a signal without its mean, same result as @ref powerOfTwoWithoutDC
+ * (which computes the mean once per sample)
+ *
+ * @param input The signal
+ * @param result Receives the squares, may be input
+ */
+inline void powerOfTwoWithoutDC(SP_Vector const& input, SP_Vector& result)
+{
+    result.resize(input.size());
+    MBT_WorkspaceDetail::powerOfTwoWithoutDC(input.data(), input.size(), result.data());
+}
+
+/**
+ * @brief Compute the first derivative of a signal, as @ref timeFirstDerivative:
+ * the sample times are index / sampRate, the samples with a null time step are skipped.
+ * The results are the same for signals of at most 5 samples, and on the first three values of longer ones.
+ * From the fourth value on, the vectorized loop of the prebuilt library divides the difference over two
+ * samples by their time step, and leaves one of the last values at 0: this overload computes the derivative
+ * of each sample, as the scalar loop of the library does.
+ *
+ * @param input The signal
+ * @param sampRate The sampling rate
+ * @param result Receives the derivative, one value less than the kept samples, may be input
+ */
+inline void timeFirstDerivative(SP_Vector const& input, SP_FloatType sampRate, SP_Vector& result)
+{
+    result.resize(input.size());
+    result.resize(MBT_WorkspaceDetail::timeFirstDerivative(input.data(), input.size(), static_cast<SP_RealType>(sampRate), result.data()));
+}
+
+#endif // MBT_WORKSPACE_H
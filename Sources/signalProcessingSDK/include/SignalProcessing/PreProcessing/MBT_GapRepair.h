@@ -0,0 +1,351 @@
+/**
+ * @file MBT_GapRepair.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Repair of the NaN gaps left by the Bluetooth packet loss.
+ * Each channel is scanned once to find its runs of NaN values, which are then interpolated
+ * in place from their valid neighbours, without building index vectors. The runs are kept in a
+ * compact gap mask so that the following stages know which samples were missing.
+ *
+ * In linear mode, the repaired values are the ones given by @ref MBT_linearInterp with the valid
+ * samples as known values: the gaps at the beginning or at the end of a channel are left to NaN.
+ *
+ */
+
+#ifndef MBT_GAPREPAIR_H
+#define MBT_GAPREPAIR_H
+
+#include <sp-global.h>
+#include <sp-instrumentation.h>
+
+#include "Algebra/MBT_Interpolation.h"
+#include "DataManipulation/MBT_Matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Interpolation used to fill the gaps
+ */
+enum MBT_GapInterpolation {
+    MBT_GAP_LINEAR, // straight line between the two valid neighbours
+    MBT_GAP_CUBIC   // cubic Hermite spline with Catmull-Rom tangents
+};
+
+/**
+ * @brief Run of consecutive NaN values in a channel
+ *
+ */
+struct MBT_Gap {
+    /**
+     * @brief Index of the first missing sample
+     */
+    unsigned int start;
+    /**
+     * @brief Number of missing samples
+     */
+    unsigned int length;
+    /**
+     * @brief True if the gap has been interpolated, false if it is still NaN
+     * (gap at an edge of the channel or longer than the maximum gap length)
+     */
+    bool repaired;
+};
+
+/**
+ * @brief Gaps of all the channels of a signal, stored channel after channel
+ *
+ */
+class MBT_GapMask
+{
+    public:
+        MBT_GapMask()
+        : m_offsets(1, 0), m_sampleCount(0)
+        {}
+
+        /**
+         * @brief Forget all the gaps and prepare the mask for a new signal
+         *
+         * @param sampleCount Number of samples per channel
+         */
+        void reset(unsigned int sampleCount)
+        {
+            m_gaps.clear();
+            m_offsets.assign(1, 0);
+            m_sampleCount = sampleCount;
+        }
+
+        /**
+         * @brief Get the number of channels in the mask
+         */
+        unsigned int channelCount() const { return static_cast<unsigned int>(m_offsets.size() - 1); }
+
+        /**
+         * @brief Get the number of samples per channel
+         */
+        unsigned int sampleCount() const { return m_sampleCount; }
+
+        /**
+         * @brief Get the number of gaps of a channel
+         */
+        unsigned int gapCount(unsigned int channel) const
+        {
+            checkChannel(channel);
+            return m_offsets[channel + 1] - m_offsets[channel];
+        }
+
+        /**
+         * @brief Get a gap of a channel, the gaps are sorted by start index
+         */
+        const MBT_Gap& gap(unsigned int channel, unsigned int index) const
+        {
+            if (index >= gapCount(channel)) {
+                throw std::out_of_range("Out of range accessor");
+            }
+            return m_gaps[m_offsets[channel] + index];
+        }
+
+        /**
+         * @brief Check if a sample was missing in the input signal
+         *
+         * @param channel The channel index
+         * @param sample The sample index
+         * @return true if the sample was NaN before the repair
+         */
+        bool isMissing(unsigned int channel, unsigned int sample) const
+        {
+            checkChannel(channel);
+            const MBT_Gap* first = m_gaps.data() + m_offsets[channel];
+            const MBT_Gap* last = m_gaps.data() + m_offsets[channel + 1];
+            // first gap starting after the sample, the candidate is the one before
+            const MBT_Gap* next = std::upper_bound(first, last, sample, startsAfter);
+            return next != first && sample < (next - 1)->start + (next - 1)->length;
+        }
+
+        /**
+         * @brief Get the number of missing samples of a channel
+         *
+         * @param channel The channel index
+         * @param repairedOnly If true, only count the samples that have been interpolated
+         */
+        unsigned int missingCount(unsigned int channel, bool repairedOnly = false) const
+        {
+            checkChannel(channel);
+            unsigned int count = 0;
+            for (unsigned int i = m_offsets[channel]; i < m_offsets[channel + 1]; ++i) {
+                if (!repairedOnly || m_gaps[i].repaired) {
+                    count += m_gaps[i].length;
+                }
+            }
+            return count;
+        }
+
+        /**
+         * @brief Get the ratio of missing samples over all the channels, between 0 and 1
+         */
+        SP_RealType missingRatio() const
+        {
+            const SP_RealType total = static_cast<SP_RealType>(m_sampleCount) * channelCount();
+            if (total == 0) {
+                return 0;
+            }
+            SP_RealType missing = 0;
+            for (size_t i = 0; i < m_gaps.size(); ++i) {
+                missing += m_gaps[i].length;
+            }
+            return missing / total;
+        }
+
+        /**
+         * @brief Append the gaps of the next channel
+         */
+        void appendChannel(const std::vector<MBT_Gap>& gaps)
+        {
+            m_gaps.insert(m_gaps.end(), gaps.begin(), gaps.end());
+            m_offsets.push_back(static_cast<unsigned int>(m_gaps.size()));
+        }
+
+    private:
+        static bool startsAfter(unsigned int sample, const MBT_Gap& gap) { return sample < gap.start; }
+
+        void checkChannel(unsigned int channel) const
+        {
+            if (channel >= channelCount()) {
+                throw std::out_of_range("Out of range accessor");
+            }
+        }
+
+        std::vector<MBT_Gap> m_gaps; // gaps of all the channels
+        std::vector<unsigned int> m_offsets; // index of the first gap of each channel, plus the end
+        unsigned int m_sampleCount; // number of samples per channel
+};
+
+/**
+ * @brief Engine finding and interpolating the NaN gaps of the signals
+ *
+ */
+class MBT_GapRepair
+{
+    public:
+        /**
+         * @brief Construct a new engine
+         *
+         * @param interpolation Interpolation used to fill the gaps
+         * @param maxGapLength Gaps longer than this number of samples are left to NaN, 0 means no limit
+         */
+        explicit MBT_GapRepair(MBT_GapInterpolation interpolation = MBT_GAP_LINEAR, unsigned int maxGapLength = 0)
+        : m_interpolation(interpolation), m_maxGapLength(maxGapLength)
+        {}
+
+        /**
+         * @brief Repair one channel in place
+         *
+         * @param data The samples of the channel
+         * @param size The number of samples
+         * @param gaps Receives the gaps of the channel, its capacity is reused
+         * @return unsigned int The number of samples that are still NaN
+         */
+        template<typename T>
+        unsigned int repair(T* data, unsigned int size, std::vector<MBT_Gap>& gaps) const
+        {
+            SP_SCOPED_STAGE_BYTES(SP_STAGE_INTERPOLATION, size * sizeof(T));
+            findGaps(data, size, gaps);
+            unsigned int remaining = 0;
+            for (size_t i = 0; i < gaps.size(); ++i) {
+                MBT_Gap& gap = gaps[i];
+                const bool isInside = gap.start > 0 && gap.start + gap.length < size;
+                const bool isShort = m_maxGapLength == 0 || gap.length <= m_maxGapLength;
+                gap.repaired = isInside && isShort;
+                if (!gap.repaired) {
+                    remaining += gap.length;
+                } else if (m_interpolation == MBT_GAP_CUBIC) {
+                    fillCubic(data, size, gap);
+                } else {
+                    fillLinear(data, gap);
+                }
+            }
+            return remaining;
+        }
+
+        /**
+         * @brief Repair a vector in place
+         *
+         * @param signal The samples
+         * @param gaps Receives the gaps of the signal, its capacity is reused
+         * @return unsigned int The number of samples that are still NaN
+         */
+        template<typename T>
+        unsigned int repair(std::vector<T>& signal, std::vector<MBT_Gap>& gaps) const
+        {
+            return repair(signal.data(), static_cast<unsigned int>(signal.size()), gaps);
+        }
+
+        /**
+         * @brief Repair all the channels (rows) of a signal in place
+         *
+         * @param signal The signal, one channel per row
+         * @param mask Receives the gaps of all the channels
+         * @return unsigned int The number of samples that are still NaN
+         */
+        template<typename T>
+        unsigned int repair(MBT_Matrix<T>& signal, MBT_GapMask& mask) const
+        {
+            const unsigned int channels = static_cast<unsigned int>(signal.size().first);
+            const unsigned int samples = static_cast<unsigned int>(signal.size().second);
+            mask.reset(samples);
+            unsigned int remaining = 0;
+            std::vector<MBT_Gap> gaps;
+            for (unsigned int channel = 0; channel < channels; ++channel) {
+                remaining += repair(signal.rowData(channel), samples, gaps);
+                mask.appendChannel(gaps);
+            }
+            return remaining;
+        }
+
+    private:
+        template<typename T>
+        static void findGaps(const T* data, unsigned int size, std::vector<MBT_Gap>& gaps)
+        {
+            gaps.clear();
+            unsigned int i = 0;
+            while (i < size) {
+                if (!std::isnan(data[i])) {
+                    ++i;
+                    continue;
+                }
+                MBT_Gap gap;
+                gap.start = i;
+                while (i < size && std::isnan(data[i])) {
+                    ++i;
+                }
+                gap.length = i - gap.start;
+                gap.repaired = false;
+                gaps.push_back(gap);
+            }
+        }
+
+        /**
+         * @brief Same operations as @ref MBT_linearInterp: the line goes through the two neighbours and
+         * is anchored on the closest one, the left one in case of equality.
+         */
+        template<typename T>
+        static void fillLinear(T* data, const MBT_Gap& gap)
+        {
+            const unsigned int left = gap.start - 1;
+            const unsigned int right = gap.start + gap.length;
+            const SP_RealType positions[2] = {static_cast<SP_RealType>(left), static_cast<SP_RealType>(right)};
+            const SP_RealType values[2] = {static_cast<SP_RealType>(data[left]), static_cast<SP_RealType>(data[right])};
+            MBT_InterpolationDetail::Segment segment;
+            segment.first = 0;
+            segment.second = 1;
+            segment.isValid = true;
+            segment.isSingle = false;
+            for (unsigned int i = gap.start; i < right; ++i) {
+                segment.anchor = i - left <= right - i ? 0 : 1;
+                data[i] = static_cast<T>(MBT_InterpolationDetail::evaluate(positions, values, segment, static_cast<SP_RealType>(i)));
+            }
+        }
+
+        /**
+         * @brief Cubic Hermite spline between the two neighbours, the tangents use the samples around
+         * them when they are valid, the secant of the gap otherwise.
+         */
+        template<typename T>
+        static void fillCubic(T* data, unsigned int size, const MBT_Gap& gap)
+        {
+            const unsigned int left = gap.start - 1;
+            const unsigned int right = gap.start + gap.length;
+            const SP_RealType leftY = static_cast<SP_RealType>(data[left]);
+            const SP_RealType rightY = static_cast<SP_RealType>(data[right]);
+            const SP_RealType span = static_cast<SP_RealType>(right - left);
+            const SP_RealType secant = (rightY - leftY) / span;
+
+            SP_RealType leftTangent = secant;
+            if (left > 0 && !std::isnan(data[left - 1])) {
+                leftTangent = (rightY - static_cast<SP_RealType>(data[left - 1])) / (span + 1);
+            }
+            SP_RealType rightTangent = secant;
+            if (right + 1 < size && !std::isnan(data[right + 1])) {
+                rightTangent = (static_cast<SP_RealType>(data[right + 1]) - leftY) / (span + 1);
+            }
+
+            for (unsigned int i = gap.start; i < right; ++i) {
+                const SP_RealType t = static_cast<SP_RealType>(i - left) / span;
+                const SP_RealType t2 = t * t;
+                const SP_RealType t3 = t2 * t;
+                data[i] = static_cast<T>((2 * t3 - 3 * t2 + 1) * leftY
+                                         + (t3 - 2 * t2 + t) * span * leftTangent
+                                         + (-2 * t3 + 3 * t2) * rightY
+                                         + (t3 - t2) * span * rightTangent);
+            }
+        }
+
+        MBT_GapInterpolation m_interpolation; // interpolation used to fill the gaps
+        unsigned int m_maxGapLength; // longest gap repaired, 0 for no limit
+};
+
+#endif // MBT_GAPREPAIR_H
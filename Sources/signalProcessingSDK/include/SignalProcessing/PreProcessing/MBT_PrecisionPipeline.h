@@ -0,0 +1,296 @@
+/**
+ * @file MBT_PrecisionPipeline.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Preprocessing chain computed in a single floating point type, see sp-precision.h.
+ * The kernels read, accumulate and write in T only: with T = float, a row of an SP_FloatMatrix is
+ * processed without being converted to an SP_Matrix, and no intermediate vector is widened to double.
+ * With T = SP_RealType, the kernels do the same floating point operations in the same order as
+ * @ref RemoveDC, @ref CalculateBounds, @ref InterpolateOutliers, @ref detrend, @ref timeFirstDerivative
+ * and @ref powerOfTwoWithoutDC, and give exactly the same results, except for the derivatives that the
+ * prebuilt timeFirstDerivative gets wrong (see MBT_Workspace.h): this instantiation is the reference of the
+ * accuracy report (tools/MBT_AccuracyReport.cpp).
+ *
+ * The band-pass filters, the spectra and the features are computed inside the libraries in SP_RealType
+ * and are not part of this chain.
+ *
+ */
+
+#ifndef MBT_PRECISIONPIPELINE_H
+#define MBT_PRECISIONPIPELINE_H
+
+#include <sp-global.h>
+#include <sp-precision.h>
+
+#include "DataManipulation/MBT_Matrix.h"
+#include "DataManipulation/MBT_RingBuffer.h"
+#include "DataManipulation/MBT_Workspace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Preprocessing kernels in T, on buffers of size samples. The outputs may be the inputs, to work in place.
+ * The DC removal, the detrending, the derivative and the power are the kernels of @ref MBT_Workspace.h. The
+ * kernels are compiled without FMA contraction, so that each product is rounded as in the libraries.
+ *
+ */
+SP_FP_CONTRACT_OFF_BEGIN
+
+template<typename T>
+class MBT_PrecisionKernels
+{
+    public:
+        /**
+         * @brief Mean of a signal, summed in order
+         */
+        static T mean(const T* input, size_t size)
+        {
+            return MBT_WorkspaceDetail::sequentialMean(input, size);
+        }
+
+        /**
+         * @brief Remove the DC offset, as @ref RemoveDC
+         */
+        static void removeDC(const T* input, size_t size, T* output)
+        {
+            MBT_WorkspaceDetail::removeDC(input, size, output);
+        }
+
+        /**
+         * @brief Compute the bounds of the outliers, as @ref CalculateBounds: the first and third quartiles
+         * extended by 1.5 times the interquartile range
+         *
+         * @param selection Values of the signal, reordered
+         * @param size Number of values
+         * @param bounds Receives the lower and the upper bounds
+         * @throws std::out_of_range if there is no value
+         */
+        static void outlierBounds(T* selection, size_t size, T* bounds)
+        {
+            if (size == 0) {
+                throw std::out_of_range("MBT_PrecisionKernels: empty input");
+            }
+            const T probabilities[2] = { static_cast<T>(0.25), static_cast<T>(0.75) };
+            T quartiles[2];
+            size_t offset = 0;
+            for (size_t i = 0; i < 2; ++i) {
+                const T upper = probabilities[i] * (static_cast<T>(size) - static_cast<T>(0.5));
+                const T lower = (1 - probabilities[i]) * static_cast<T>(0.5);
+                const T position = upper - lower;
+                const long floorIndex = static_cast<long>(std::floor(position));
+                const long ceilIndex = static_cast<long>(std::ceil(position));
+                const size_t left = floorIndex > 0 ? static_cast<size_t>(floorIndex) : 0;
+                const size_t right = static_cast<long>(size) - 1 < ceilIndex ? size - 1 : static_cast<size_t>(ceilIndex);
+                if (left < offset) {
+                    offset = 0;
+                }
+
+                std::nth_element(selection + offset, selection + left, selection + size);
+                const T leftValue = selection[left];
+                const T rightValue = right > left ? *std::min_element(selection + left + 1, selection + size) : leftValue;
+                const T t = position - static_cast<T>(left);
+                const T leftWeight = (1 - t) * leftValue;
+                const T rightWeight = t * rightValue;
+                quartiles[i] = leftWeight + rightWeight;
+                offset = left;
+            }
+
+            const T range = (quartiles[1] - quartiles[0]) * static_cast<T>(1.5);
+            bounds[0] = quartiles[0] - range;
+            bounds[1] = quartiles[1] + range;
+        }
+
+        /**
+         * @brief Replace in place the samples outside the bounds (and the NaN samples) by a linear interpolation
+         * of the other ones, as @ref InterpolateOutliers. Missing samples at the edges become NaN.
+         * In SP_RealType the line is evaluated as in the library, from the sample index. In a narrower type,
+         * the product of a large index by the slope cancels with the intercept, the line is evaluated from
+         * the distance to its anchor instead.
+         *
+         * @return size_t The number of replaced samples
+         */
+        static size_t interpolateOutliers(T* signal, size_t size, const T* bounds)
+        {
+            const bool isReference = SP_PrecisionTraits<T>::isReference();
+            const T low = bounds[0];
+            const T up = bounds[1];
+            size_t replaced = 0;
+            size_t left = size; // last kept sample, none yet
+            size_t i = 0;
+            while (i < size) {
+                if (signal[i] >= low && !(signal[i] > up)) {
+                    left = i++;
+                    continue;
+                }
+                size_t right = i;
+                while (right < size && !(signal[right] >= low && !(signal[right] > up))) {
+                    ++right;
+                }
+
+                if (left >= size || right >= size) {
+                    std::fill(signal + i, signal + right, std::numeric_limits<T>::quiet_NaN());
+                } else {
+                    // each missing sample is anchored on the closest kept sample, the left one in case of equality
+                    const T leftPosition = static_cast<T>(left);
+                    const T rightPosition = static_cast<T>(right);
+                    const T slope = (signal[right] - signal[left]) / (rightPosition - leftPosition);
+                    for (size_t j = i; j < right; ++j) {
+                        const bool isLeft = j - left <= right - j;
+                        const T anchorValue = isLeft ? signal[left] : signal[right];
+                        if (isReference) {
+                            const T anchorProduct = (isLeft ? leftPosition : rightPosition) * slope;
+                            const T intercept = anchorValue - anchorProduct;
+                            const T product = static_cast<T>(j) * slope;
+                            signal[j] = product + intercept;
+                        } else {
+                            const T distance = isLeft ? static_cast<T>(j - left) : -static_cast<T>(right - j);
+                            const T product = distance * slope;
+                            signal[j] = anchorValue + product;
+                        }
+                    }
+                }
+                replaced += right - i;
+                i = right;
+            }
+            return replaced;
+        }
+
+        /**
+         * @brief Remove the best straight-line fit of a signal, as @ref detrend: the times are index / rate
+         */
+        static void detrend(const T* input, size_t size, T rate, T* output)
+        {
+            MBT_WorkspaceDetail::detrend(input, size, rate, output);
+        }
+
+        /**
+         * @brief Compute the first derivative of a signal, as @ref timeFirstDerivative: the samples with
+         * a null time step are skipped. In a type narrower than SP_RealType, the time step is computed from
+         * the difference of the indexes.
+         *
+         * @return size_t The number of derivatives written, one less than the kept samples
+         */
+        static size_t timeFirstDerivative(const T* input, size_t size, T rate, T* output)
+        {
+            return MBT_WorkspaceDetail::timeFirstDerivative(input, size, rate, output);
+        }
+
+        /**
+         * @brief Compute the square of a signal without its mean, as @ref powerOfTwoWithoutDC
+         */
+        static void powerOfTwoWithoutDC(const T* input, size_t size, T* output)
+        {
+            MBT_WorkspaceDetail::powerOfTwoWithoutDC(input, size, output);
+        }
+};
+
+SP_FP_CONTRACT_OFF_END
+
+/**
+ * @brief Preprocessing chain of a channel in T: DC removal, interpolation of the outliers, detrending,
+ * then the first derivative and the power of the preprocessed signal. The buffers are kept from one
+ * call to the next, the chain does not allocate once they have reached the size of the signals.
+ * A pipeline must not be shared between threads.
+ *
+ */
+template<typename T>
+class MBT_PrecisionPipeline
+{
+    public:
+        typedef MBT_PrecisionKernels<T> Kernels;
+        typedef std::vector<T> Vector;
+
+        /**
+         * @brief Construct a new pipeline
+         *
+         * @param sampRate The sampling rate, converted to T once
+         * @param capacity Number of samples to reserve the buffers for
+         */
+        explicit MBT_PrecisionPipeline(SP_FloatType sampRate, size_t capacity = 0)
+        : m_rate(static_cast<T>(sampRate)), m_replaced(0)
+        {
+            if (!(sampRate > 0)) {
+                throw std::invalid_argument("MBT_PrecisionPipeline: the sampling rate must be positive");
+            }
+            m_bounds[0] = m_bounds[1] = 0;
+            m_signal.reserve(capacity);
+            m_selection.reserve(capacity);
+            m_derivative.reserve(capacity);
+            m_power.reserve(capacity);
+        }
+
+        /**
+         * @brief Preprocess a channel
+         *
+         * @param data The samples of the channel
+         * @param size Number of samples
+         * @throws std::out_of_range if there is no sample
+         */
+        void process(const T* data, size_t size)
+        {
+            m_signal.resize(size);
+            Kernels::removeDC(data, size, m_signal.data());
+            processWithoutDC();
+        }
+
+        /**
+         * @brief Preprocess a row of a matrix of T, read in place
+         */
+        void process(MBT_Matrix<T> const& matrix, int row)
+        {
+            process(matrix.rowData(row), static_cast<size_t>(matrix.size().second));
+        }
+
+        /**
+         * @brief Preprocess a channel of a window of a ring buffer, even when it wraps around: its segments are
+         * read into the working signal, which the DC removal fills in any case
+         */
+        void process(MBT_RingView<T> const& window, unsigned int channel)
+        {
+            m_signal.resize(window.size());
+            window.copyTo(channel, m_signal.data());
+            Kernels::removeDC(m_signal.data(), m_signal.size(), m_signal.data());
+            processWithoutDC();
+        }
+
+        Vector const& signal() const { return m_signal; } // preprocessed signal
+        Vector const& derivative() const { return m_derivative; } // first derivative of the preprocessed signal
+        Vector const& power() const { return m_power; } // square of the preprocessed signal without its mean
+        T lowerBound() const { return m_bounds[0]; } // lower bound of the outliers
+        T upperBound() const { return m_bounds[1]; } // upper bound of the outliers
+        size_t replaced() const { return m_replaced; } // number of interpolated samples
+
+    private:
+        /**
+         * @brief Run the stages after the DC removal on m_signal
+         */
+        void processWithoutDC()
+        {
+            const size_t size = m_signal.size();
+            m_selection.assign(m_signal.begin(), m_signal.end());
+            Kernels::outlierBounds(m_selection.data(), size, m_bounds);
+            m_replaced = Kernels::interpolateOutliers(m_signal.data(), size, m_bounds);
+            Kernels::detrend(m_signal.data(), size, m_rate, m_signal.data());
+
+            m_derivative.resize(size);
+            m_derivative.resize(Kernels::timeFirstDerivative(m_signal.data(), size, m_rate, m_derivative.data()));
+            m_power.resize(size);
+            Kernels::powerOfTwoWithoutDC(m_signal.data(), size, m_power.data());
+        }
+
+        const T m_rate; // sampling rate
+        Vector m_signal; // preprocessed signal
+        Vector m_selection; // values reordered by the quartile selection
+        Vector m_derivative; // first derivative
+        Vector m_power; // power without DC
+        T m_bounds[2]; // bounds of the outliers
+        size_t m_replaced; // number of interpolated samples
+};
+
+#endif // MBT_PRECISIONPIPELINE_H
@@ -0,0 +1,170 @@
+/**
+ * @file MBT_BandIndex.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Index bounds of frequency bands without scanning the frequency vectors.
+ * The frequencies given by @ref MBT_PWelchComputer are sorted and uniformly spaced:
+ * nfft values (fs / nfft) * i. The bounds of a band can then be found by binary search,
+ * or in O(1) from (nfft, fs), and cached since the same bands are asked for every packet.
+ *
+ */
+
+#ifndef MBT_BANDINDEX_H
+#define MBT_BANDINDEX_H
+
+#include <sp-global.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+namespace MBT_BandIndexDetail {
+
+/**
+ * @brief Frequency of the bin i of a grid of step fs / nfft, as computed by @ref MBT_PWelchComputer
+ */
+inline SP_RealType binFrequency(SP_RealType step, int index)
+{
+    return step * static_cast<SP_RealType>(index);
+}
+
+} // namespace MBT_BandIndexDetail
+
+/**
+ * @brief Same result as @ref MBT_frequencyBounds for frequencies sorted in increasing order, in O(log n)
+ *
+ * @param frequencies The frequencies, sorted in increasing order
+ * @param IAFinf The lower bound of the band
+ * @param IAFsup The upper bound of the band
+ * @return std::pair<int,int> The indexes of the first and the last frequencies inside [IAFinf, IAFsup]
+ * @throws std::invalid_argument if no frequency is inside the band
+ */
+inline std::pair<int,int> MBT_frequencyBoundsSorted(SP_Vector const& frequencies, const SP_RealType IAFinf, const SP_RealType IAFsup)
+{
+    SP_Vector::const_iterator first = std::lower_bound(frequencies.begin(), frequencies.end(), IAFinf);
+    SP_Vector::const_iterator last = std::upper_bound(first, frequencies.end(), IAFsup);
+    if (first == last) {
+        throw std::invalid_argument("MBT_frequencyBoundsSorted: no frequency inside the band");
+    }
+    return std::pair<int,int>(static_cast<int>(first - frequencies.begin()),
+                              static_cast<int>(last - frequencies.begin()) - 1);
+}
+
+/**
+ * @brief Same result as @ref MBT_frequencyBounds on the frequencies of @ref MBT_PWelchComputer, in O(1)
+ *
+ * @param nfft The number of points of the FFT, which is also the number of frequencies
+ * @param fs The sampling rate
+ * @param IAFinf The lower bound of the band
+ * @param IAFsup The upper bound of the band
+ * @return std::pair<int,int> The indexes of the first and the last frequencies inside [IAFinf, IAFsup]
+ * @throws std::invalid_argument if the grid is empty or if no frequency is inside the band
+ */
+inline std::pair<int,int> MBT_frequencyBoundsUniform(const int nfft, const SP_RealType fs, const SP_RealType IAFinf, const SP_RealType IAFsup)
+{
+    using MBT_BandIndexDetail::binFrequency;
+
+    if (nfft <= 0 || !(fs > 0)) {
+        throw std::invalid_argument("MBT_frequencyBoundsUniform: empty frequency grid");
+    }
+    const SP_RealType step = fs / nfft;
+
+    // the divisions may be one bin off, the bins are then compared as the linear search does
+    SP_RealType position = std::ceil(IAFinf / step);
+    int first = position < 0 ? 0 : (position > nfft ? nfft : static_cast<int>(position));
+    while (first > 0 && binFrequency(step, first - 1) >= IAFinf) {
+        --first;
+    }
+    while (first < nfft && binFrequency(step, first) < IAFinf) {
+        ++first;
+    }
+
+    position = std::floor(IAFsup / step);
+    int last = position < -1 ? -1 : (position > nfft - 1 ? nfft - 1 : static_cast<int>(position));
+    while (last < nfft - 1 && binFrequency(step, last + 1) <= IAFsup) {
+        ++last;
+    }
+    while (last >= 0 && binFrequency(step, last) > IAFsup) {
+        --last;
+    }
+
+    if (first > last) {
+        throw std::invalid_argument("MBT_frequencyBoundsUniform: no frequency inside the band");
+    }
+    return std::pair<int,int>(first, last);
+}
+
+/**
+ * @brief Cache of the index bounds of the frequency bands, keyed by (nfft, fs, band).
+ * Not thread safe: use one cache per processing thread.
+ *
+ */
+class MBT_BandIndexCache
+{
+    public:
+        /**
+         * @brief Get the index bounds of a band on the frequencies of @ref MBT_PWelchComputer
+         *
+         * @param nfft The number of points of the FFT
+         * @param fs The sampling rate
+         * @param IAFinf The lower bound of the band
+         * @param IAFsup The upper bound of the band
+         * @return std::pair<int,int> The indexes of the first and the last frequencies inside [IAFinf, IAFsup]
+         * @throws std::invalid_argument if no frequency is inside the band
+         */
+        std::pair<int,int> bounds(const int nfft, const SP_RealType fs, const SP_RealType IAFinf, const SP_RealType IAFsup)
+        {
+            Key key;
+            key.nfft = nfft;
+            key.fs = fs;
+            key.IAFinf = IAFinf;
+            key.IAFsup = IAFsup;
+
+            std::map<Key, std::pair<int,int> >::const_iterator found = m_bounds.find(key);
+            if (found != m_bounds.end()) {
+                return found->second;
+            }
+            const std::pair<int,int> result = MBT_frequencyBoundsUniform(nfft, fs, IAFinf, IAFsup);
+            m_bounds.insert(std::make_pair(key, result));
+            return result;
+        }
+
+        /**
+         * @brief Get the number of cached bands
+         */
+        size_t size() const { return m_bounds.size(); }
+
+        /**
+         * @brief Forget all the cached bands
+         */
+        void clear() { m_bounds.clear(); }
+
+    private:
+        struct Key {
+            int nfft;
+            SP_RealType fs;
+            SP_RealType IAFinf;
+            SP_RealType IAFsup;
+
+            bool operator<(const Key& other) const
+            {
+                if (nfft != other.nfft) {
+                    return nfft < other.nfft;
+                }
+                if (fs != other.fs) {
+                    return fs < other.fs;
+                }
+                if (IAFinf != other.IAFinf) {
+                    return IAFinf < other.IAFinf;
+                }
+                return IAFsup < other.IAFsup;
+            }
+        };
+
+        std::map<Key, std::pair<int,int> > m_bounds; // cached bounds of each band
+};
+
+#endif // MBT_BANDINDEX_H
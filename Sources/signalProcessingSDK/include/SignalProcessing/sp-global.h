@@ -57,5 +57,20 @@ static const SP_RealType SP_PI = const_pi();
 static const SP_FloatType SP_PIFLOAT = SP_PI;
 static const SP_RealType SP_PIFROMFLOAT= SP_PIFLOAT; // TODO : replace this wrong usage when refactoring
 
+// Disable the contraction of a product and a sum into a FMA in the functions defined between
+// SP_FP_CONTRACT_OFF_BEGIN and SP_FP_CONTRACT_OFF_END, whatever -ffp-contract the includer uses,
+// for the code which must round each operation as the compiled libraries do.
+// With GCC, these functions are no longer inlined into functions compiled with other options.
+#if defined(__clang__)
+    #define SP_FP_CONTRACT_OFF_BEGIN _Pragma("float_control(push)") _Pragma("clang fp contract(off)")
+    #define SP_FP_CONTRACT_OFF_END _Pragma("float_control(pop)")
+#elif defined(__GNUC__)
+    #define SP_FP_CONTRACT_OFF_BEGIN _Pragma("GCC push_options") _Pragma("GCC optimize(\"fp-contract=off\")")
+    #define SP_FP_CONTRACT_OFF_END _Pragma("GCC pop_options")
+#else
+    #define SP_FP_CONTRACT_OFF_BEGIN
+    #define SP_FP_CONTRACT_OFF_END
+#endif
+
 
 #endif // __SIGNAL_PROCESSING_GLOBAL_H__
\ No newline at end of file
@@ -0,0 +1,403 @@
+/**
+ * @file sp-instrumentation.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Opt-in timers and counters of the processing stages.
+ * The probes (@ref SP_SCOPED_STAGE, @ref SP_SCOPED_STAGE_BYTES, @ref SP_COUNT_BYTES) are only compiled
+ * when SP_ENABLE_INSTRUMENTATION is defined, like the other SP_ENABLE_ flags, and cost nothing otherwise.
+ * When compiled, a probe reads the steady clock twice and updates the counters of its stage with relaxed
+ * atomic operations; the probes are placed around whole stages, never in their inner loops.
+ *
+ * The counters of each stage (calls, total and maximum duration, bytes processed, allocations made while
+ * the stage was the innermost one) are read with @ref MBT_Instrumentation::snapshot, and the histogram of
+ * its durations with @ref MBT_Instrumentation::latency. The allocations are
+ * only counted in the programs expanding @ref SP_DEFINE_ALLOCATION_COUNTERS in one of their source files,
+ * which replaces the global operator new. When tracing is enabled, each probe also records an event in a
+ * buffer of its thread, exported by @ref MBT_Instrumentation::writeChromeTrace in the Trace Event format
+ * read by chrome://tracing and Perfetto.
+ *
+ */
+
+#ifndef __SIGNAL_PROCESSING_INSTRUMENTATION_H__
+#define __SIGNAL_PROCESSING_INSTRUMENTATION_H__
+
+#include <sp-latency.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Instrumented stages. The stages of the prebuilt libraries are timed around their calls, by the
+ * callers, until the libraries are built with SP_ENABLE_INSTRUMENTATION
+ */
+enum SP_Stage {
+    SP_STAGE_INTERPOLATION,
+    SP_STAGE_FILTERING,
+    SP_STAGE_FEATURES,
+    SP_STAGE_KNN,
+    SP_STAGE_ITAKURA,
+    SP_STAGE_WELCH,
+    SP_STAGE_NOISE_FIT,
+    SP_STAGE_IAF,
+    SP_STAGE_RMS,
+    SP_STAGE_QUALITY,
+    SP_STAGE_CALIBRATION,
+    SP_STAGE_RELAX_INDEX,
+    SP_STAGE_TIME_FREQUENCY,
+    SP_STAGE_CONTOURS,
+    SP_STAGE_CLUSTERS,
+    SP_STAGE_COUNT
+};
+
+/**
+ * @brief Counters of a stage at the time of a snapshot
+ */
+struct MBT_StageSnapshot {
+    const char* name; // name of the stage
+    uint64_t calls; // number of probes which ended
+    uint64_t totalNs; // total duration in nanoseconds, nested probes included
+    uint64_t maxNs; // longest duration in nanoseconds
+    uint64_t bytes; // bytes processed
+    uint64_t allocations; // allocations made while the stage was the innermost one
+    uint64_t allocatedBytes; // bytes of these allocations
+};
+
+namespace SP_InstrumentationDetail {
+
+typedef std::chrono::steady_clock Clock;
+
+struct StageCounters {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> totalNs;
+    std::atomic<uint64_t> maxNs;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> allocatedBytes;
+    MBT_LatencyHistogram latency;
+};
+
+struct TraceEvent {
+    uint64_t startNs; // start since the creation of the registry
+    uint64_t durationNs;
+    int stage;
+};
+
+/**
+ * @brief Events of one thread, the mutex is only contended while exporting
+ */
+struct ThreadTrace {
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    uint64_t dropped; // events not recorded because the buffer was full
+    unsigned int threadIndex;
+};
+
+struct Registry {
+    StageCounters stages[SP_STAGE_COUNT];
+    std::atomic<bool> isTracing;
+    std::atomic<size_t> traceCapacity; // maximum number of events per thread
+    std::mutex mutex; // protects threads
+    std::vector<std::unique_ptr<ThreadTrace> > threads;
+    Clock::time_point epoch;
+
+    Registry()
+    : isTracing(false), traceCapacity(1 << 16), epoch(Clock::now())
+    {
+        for (int stage = 0; stage < SP_STAGE_COUNT; ++stage) {
+            clearStage(stage);
+        }
+    }
+
+    void clearStage(int stage)
+    {
+        stages[stage].calls.store(0, std::memory_order_relaxed);
+        stages[stage].totalNs.store(0, std::memory_order_relaxed);
+        stages[stage].maxNs.store(0, std::memory_order_relaxed);
+        stages[stage].bytes.store(0, std::memory_order_relaxed);
+        stages[stage].allocations.store(0, std::memory_order_relaxed);
+        stages[stage].allocatedBytes.store(0, std::memory_order_relaxed);
+        stages[stage].latency.reset();
+    }
+};
+
+/**
+ * @brief The registry is never destroyed, so that the threads still running at exit can record
+ */
+inline Registry& registry()
+{
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+inline uint64_t nanoseconds()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - registry().epoch).count());
+}
+
+/**
+ * @brief Innermost stage of the calling thread, -1 outside the probes
+ */
+inline int& currentStage()
+{
+    static thread_local int stage = -1;
+    return stage;
+}
+
+inline ThreadTrace& threadTrace()
+{
+    static thread_local ThreadTrace* trace = 0;
+    if (trace == 0) {
+        Registry& instance = registry();
+        std::lock_guard<std::mutex> lock(instance.mutex);
+        instance.threads.push_back(std::unique_ptr<ThreadTrace>(new ThreadTrace()));
+        trace = instance.threads.back().get();
+        trace->dropped = 0;
+        trace->threadIndex = static_cast<unsigned int>(instance.threads.size());
+    }
+    return *trace;
+}
+
+inline void record(int stage, uint64_t startNs, uint64_t durationNs)
+{
+    Registry& instance = registry();
+    StageCounters& counters = instance.stages[stage];
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.totalNs.fetch_add(durationNs, std::memory_order_relaxed);
+    uint64_t longest = counters.maxNs.load(std::memory_order_relaxed);
+    while (durationNs > longest && !counters.maxNs.compare_exchange_weak(longest, durationNs, std::memory_order_relaxed)) {
+    }
+    counters.latency.record(durationNs);
+
+    if (instance.isTracing.load(std::memory_order_relaxed)) {
+        ThreadTrace& trace = threadTrace();
+        std::lock_guard<std::mutex> lock(trace.mutex);
+        if (trace.events.size() < instance.traceCapacity.load(std::memory_order_relaxed)) {
+            const TraceEvent event = { startNs, durationNs, stage };
+            trace.events.push_back(event);
+        } else {
+            ++trace.dropped;
+        }
+    }
+}
+
+} // namespace SP_InstrumentationDetail
+
+/**
+ * @brief Access to the counters and to the trace of all the threads
+ *
+ */
+class MBT_Instrumentation
+{
+    public:
+        /**
+         * @brief Get the name of a stage
+         */
+        static const char* stageName(int stage)
+        {
+            static const char* const names[SP_STAGE_COUNT] = {
+                "interpolation", "filtering", "features", "knn", "itakura", "welch", "noiseFit", "iaf", "rms",
+                "quality", "calibration", "relaxIndex", "timeFrequency", "contours", "clusters"
+            };
+            return stage >= 0 && stage < SP_STAGE_COUNT ? names[stage] : "unknown";
+        }
+
+        /**
+         * @brief Enable or disable the recording of the trace events, the counters are always recorded
+         *
+         * @param isEnabled true to record the events
+         * @param capacity Maximum number of events kept per thread, the next ones are dropped and counted
+         */
+        static void setTracing(bool isEnabled, size_t capacity = 1 << 16)
+        {
+            SP_InstrumentationDetail::Registry& instance = SP_InstrumentationDetail::registry();
+            instance.traceCapacity.store(capacity, std::memory_order_relaxed);
+            instance.isTracing.store(isEnabled, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Add processed bytes to a stage
+         */
+        static void addBytes(SP_Stage stage, uint64_t bytes)
+        {
+            SP_InstrumentationDetail::registry().stages[stage].bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Count an allocation in the innermost stage of the calling thread, called by the operator new
+         * of @ref SP_DEFINE_ALLOCATION_COUNTERS
+         */
+        static void countAllocation(size_t bytes)
+        {
+            const int stage = SP_InstrumentationDetail::currentStage();
+            if (stage >= 0) {
+                SP_InstrumentationDetail::StageCounters& counters = SP_InstrumentationDetail::registry().stages[stage];
+                counters.allocations.fetch_add(1, std::memory_order_relaxed);
+                counters.allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Get the counters of all the stages, in the order of @ref SP_Stage
+         */
+        static std::vector<MBT_StageSnapshot> snapshot()
+        {
+            SP_InstrumentationDetail::Registry& instance = SP_InstrumentationDetail::registry();
+            std::vector<MBT_StageSnapshot> result(SP_STAGE_COUNT);
+            for (int stage = 0; stage < SP_STAGE_COUNT; ++stage) {
+                const SP_InstrumentationDetail::StageCounters& counters = instance.stages[stage];
+                MBT_StageSnapshot& snapshot = result[stage];
+                snapshot.name = stageName(stage);
+                snapshot.calls = counters.calls.load(std::memory_order_relaxed);
+                snapshot.totalNs = counters.totalNs.load(std::memory_order_relaxed);
+                snapshot.maxNs = counters.maxNs.load(std::memory_order_relaxed);
+                snapshot.bytes = counters.bytes.load(std::memory_order_relaxed);
+                snapshot.allocations = counters.allocations.load(std::memory_order_relaxed);
+                snapshot.allocatedBytes = counters.allocatedBytes.load(std::memory_order_relaxed);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Get the histogram of the durations of a stage, without lock
+         *
+         * @param stage The stage
+         * @param snapshot Receives the histogram
+         */
+        static void latency(SP_Stage stage, MBT_LatencySnapshot& snapshot)
+        {
+            SP_InstrumentationDetail::registry().stages[stage].latency.snapshot(snapshot);
+        }
+
+        /**
+         * @brief Clear the counters and the recorded events
+         */
+        static void reset()
+        {
+            SP_InstrumentationDetail::Registry& instance = SP_InstrumentationDetail::registry();
+            for (int stage = 0; stage < SP_STAGE_COUNT; ++stage) {
+                instance.clearStage(stage);
+            }
+            std::lock_guard<std::mutex> lock(instance.mutex);
+            for (size_t i = 0; i < instance.threads.size(); ++i) {
+                std::lock_guard<std::mutex> threadLock(instance.threads[i]->mutex);
+                instance.threads[i]->events.clear();
+                instance.threads[i]->dropped = 0;
+            }
+        }
+
+        /**
+         * @brief Write the recorded events in the JSON Trace Event format, one complete event per probe
+         *
+         * @param out The stream receiving the JSON text
+         */
+        static void writeChromeTrace(std::ostream& out)
+        {
+            SP_InstrumentationDetail::Registry& instance = SP_InstrumentationDetail::registry();
+            char buffer[160];
+            out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            bool isFirst = true;
+            std::lock_guard<std::mutex> lock(instance.mutex);
+            for (size_t i = 0; i < instance.threads.size(); ++i) {
+                SP_InstrumentationDetail::ThreadTrace& trace = *instance.threads[i];
+                std::lock_guard<std::mutex> threadLock(trace.mutex);
+                std::snprintf(buffer, sizeof(buffer),
+                              "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                              isFirst ? "" : ",", trace.threadIndex, trace.threadIndex);
+                out << buffer;
+                isFirst = false;
+                for (size_t e = 0; e < trace.events.size(); ++e) {
+                    const SP_InstrumentationDetail::TraceEvent& event = trace.events[e];
+                    // the timestamps of the format are in microseconds
+                    std::snprintf(buffer, sizeof(buffer),
+                                  ",{\"name\":\"%s\",\"cat\":\"sdk\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                                  stageName(event.stage), trace.threadIndex, event.startNs / 1000.0, event.durationNs / 1000.0);
+                    out << buffer;
+                }
+                if (trace.dropped > 0) {
+                    std::snprintf(buffer, sizeof(buffer),
+                                  ",{\"name\":\"dropped events\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":0,\"args\":{\"count\":%llu}}",
+                                  trace.threadIndex, static_cast<unsigned long long>(trace.dropped));
+                    out << buffer;
+                }
+            }
+            out << "]}\n";
+        }
+};
+
+/**
+ * @brief Probe timing a scope as a stage, see @ref SP_SCOPED_STAGE
+ *
+ */
+class MBT_ScopedStage
+{
+    public:
+        explicit MBT_ScopedStage(SP_Stage stage, uint64_t bytes = 0)
+        : m_stage(stage), m_parent(SP_InstrumentationDetail::currentStage()), m_startNs(SP_InstrumentationDetail::nanoseconds())
+        {
+            SP_InstrumentationDetail::currentStage() = stage;
+            if (bytes > 0) {
+                MBT_Instrumentation::addBytes(stage, bytes);
+            }
+        }
+
+        ~MBT_ScopedStage()
+        {
+            const uint64_t durationNs = SP_InstrumentationDetail::nanoseconds() - m_startNs;
+            // restored first, so that the growth of the trace buffer is not counted in the stage
+            SP_InstrumentationDetail::currentStage() = m_parent;
+            SP_InstrumentationDetail::record(m_stage, m_startNs, durationNs);
+        }
+
+    private:
+        MBT_ScopedStage(MBT_ScopedStage const&);
+        MBT_ScopedStage& operator=(MBT_ScopedStage const&);
+
+        int m_stage; // stage of the scope
+        int m_parent; // stage of the enclosing probe, -1 if none
+        uint64_t m_startNs; // start of the scope
+};
+
+#define SP_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define SP_INSTRUMENTATION_CONCAT(a, b) SP_INSTRUMENTATION_CONCAT_(a, b)
+
+#if defined(SP_ENABLE_INSTRUMENTATION)
+/* 1 when the probes of the translation unit are compiled */
+#define SP_INSTRUMENTATION_COMPILED 1
+/* Time the rest of the enclosing scope as a stage */
+#define SP_SCOPED_STAGE(stage) MBT_ScopedStage SP_INSTRUMENTATION_CONCAT(spScopedStage, __LINE__)(stage)
+/* Time the rest of the enclosing scope as a stage which processes a number of bytes */
+#define SP_SCOPED_STAGE_BYTES(stage, bytes) MBT_ScopedStage SP_INSTRUMENTATION_CONCAT(spScopedStage, __LINE__)(stage, bytes)
+/* Add processed bytes to a stage */
+#define SP_COUNT_BYTES(stage, bytes) MBT_Instrumentation::addBytes(stage, bytes)
+/* Replace the global operator new to count the allocations of each stage, in one source file of a program */
+#define SP_DEFINE_ALLOCATION_COUNTERS() \
+    void* operator new(std::size_t size) \
+    { \
+        void* pointer = std::malloc(size > 0 ? size : 1); \
+        if (pointer == 0) { \
+            throw std::bad_alloc(); \
+        } \
+        MBT_Instrumentation::countAllocation(size); \
+        return pointer; \
+    } \
+    void* operator new[](std::size_t size) { return operator new(size); } \
+    void operator delete(void* pointer) noexcept { std::free(pointer); } \
+    void operator delete[](void* pointer) noexcept { std::free(pointer); }
+#else
+#define SP_INSTRUMENTATION_COMPILED 0
+#define SP_SCOPED_STAGE(stage) ((void)0)
+#define SP_SCOPED_STAGE_BYTES(stage, bytes) ((void)0)
+#define SP_COUNT_BYTES(stage, bytes) ((void)0)
+#define SP_DEFINE_ALLOCATION_COUNTERS()
+#endif
+
+#endif // __SIGNAL_PROCESSING_INSTRUMENTATION_H__
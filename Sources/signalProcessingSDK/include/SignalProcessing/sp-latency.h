@@ -0,0 +1,319 @@
+/**
+ * @file sp-latency.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Latency histograms with a bounded relative error, in the manner of HdrHistogram.
+ * The durations (in nanoseconds) are counted in log-linear buckets: the values below 64 have one bucket
+ * each, and each power of two above is split in 32 buckets, so that the percentiles are exact to 1/32
+ * (3 %) from 1 ns up to 2^40 ns (about 18 minutes, longer durations are counted in the last bucket).
+ * Recording a duration is a few relaxed atomic operations, without lock nor allocation; a snapshot
+ * copies the counters without stopping the recording threads, so that it can be taken at any time to
+ * read percentiles such as the p99, or subtracted from a later one to get the percentiles of an interval.
+ *
+ */
+
+#ifndef __SIGNAL_PROCESSING_LATENCY_H__
+#define __SIGNAL_PROCESSING_LATENCY_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * @brief Copy of the counters of a @ref MBT_LatencyHistogram
+ *
+ */
+struct MBT_LatencySnapshot {
+    enum {
+        SUB_BUCKET_BITS = 5,
+        SUB_BUCKETS = 1 << SUB_BUCKET_BITS,
+        MAX_BITS = 40, // the durations are counted up to 2^MAX_BITS - 1 nanoseconds
+        BUCKET_COUNT = (MAX_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS
+    };
+
+    uint64_t buckets[BUCKET_COUNT]; // number of durations of each bucket
+    uint64_t count; // number of durations
+    uint64_t sum; // sum of the durations in nanoseconds
+    uint64_t max; // longest duration in nanoseconds
+
+    MBT_LatencySnapshot()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            buckets[i] = 0;
+        }
+        count = 0;
+        sum = 0;
+        max = 0;
+    }
+
+    /**
+     * @brief Get the bucket of a duration
+     */
+    static size_t bucketIndex(uint64_t value)
+    {
+        const uint64_t largest = (static_cast<uint64_t>(1) << MAX_BITS) - 1;
+        if (value > largest) {
+            value = largest;
+        }
+        if (value < 2 * SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        const int highestBit = 63 - __builtin_clzll(value);
+        const int shift = highestBit - SUB_BUCKET_BITS;
+        return static_cast<size_t>(shift) * SUB_BUCKETS + static_cast<size_t>(value >> shift);
+    }
+
+    /**
+     * @brief Get the largest duration counted in a bucket
+     */
+    static uint64_t bucketHighest(size_t index)
+    {
+        if (index < 2 * SUB_BUCKETS) {
+            return index;
+        }
+        const int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+        const uint64_t mantissa = index % SUB_BUCKETS + SUB_BUCKETS;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+    /**
+     * @brief Get the mean duration in nanoseconds, 0 if there is none
+     */
+    double mean() const
+    {
+        return count > 0 ? static_cast<double>(sum) / count : 0;
+    }
+
+    /**
+     * @brief Get a percentile of the durations, as the largest duration of its bucket (never above the maximum)
+     *
+     * @param percentile The percentile, between 0 and 100
+     * @return uint64_t The duration in nanoseconds, 0 if there is none
+     */
+    uint64_t percentile(double percentile) const
+    {
+        if (count == 0) {
+            return 0;
+        }
+        const double fraction = percentile <= 0 ? 0 : (percentile >= 100 ? 1 : percentile / 100);
+        uint64_t rank = static_cast<uint64_t>(fraction * count + 0.999999);
+        rank = rank < 1 ? 1 : rank;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                const uint64_t highest = bucketHighest(i);
+                return highest < max ? highest : max;
+            }
+        }
+        return max;
+    }
+
+    /**
+     * @brief Get the number of durations longer than a bound, to within the precision of the buckets
+     */
+    uint64_t countAbove(uint64_t bound) const
+    {
+        uint64_t result = 0;
+        for (size_t i = bucketIndex(bound) + 1; i < BUCKET_COUNT; ++i) {
+            result += buckets[i];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Add the durations of another snapshot, for example of another session or thread
+     */
+    void merge(MBT_LatencySnapshot const& other)
+    {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            buckets[i] += other.buckets[i];
+        }
+        count += other.count;
+        sum += other.sum;
+        max = other.max > max ? other.max : max;
+    }
+
+    /**
+     * @brief Remove the durations of an earlier snapshot of the same histogram, to keep those of the interval
+     * between the two. The maximum is the one of the later snapshot
+     */
+    void subtract(MBT_LatencySnapshot const& earlier)
+    {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            buckets[i] -= earlier.buckets[i] < buckets[i] ? earlier.buckets[i] : buckets[i];
+        }
+        count -= earlier.count < count ? earlier.count : count;
+        sum -= earlier.sum < sum ? earlier.sum : sum;
+    }
+};
+
+/**
+ * @brief Histogram of durations, safe to record from several threads and to read at the same time
+ *
+ */
+class MBT_LatencyHistogram
+{
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        MBT_LatencyHistogram()
+        {
+            reset();
+        }
+
+        /**
+         * @brief Count a duration
+         *
+         * @param nanoseconds The duration in nanoseconds
+         */
+        void record(uint64_t nanoseconds)
+        {
+            m_buckets[MBT_LatencySnapshot::bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+            m_sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+            uint64_t longest = m_max.load(std::memory_order_relaxed);
+            while (nanoseconds > longest && !m_max.compare_exchange_weak(longest, nanoseconds, std::memory_order_relaxed)) {
+            }
+            // counted last, so that a snapshot never sees more durations than bucket counts
+            m_count.fetch_add(1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Count the duration since a time point
+         *
+         * @return uint64_t The duration in nanoseconds
+         */
+        uint64_t recordSince(Clock::time_point start)
+        {
+            const int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+            const uint64_t nanoseconds = elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0;
+            record(nanoseconds);
+            return nanoseconds;
+        }
+
+        /**
+         * @brief Clear the counters, the durations recorded at the same time may be partly kept
+         */
+        void reset()
+        {
+            for (size_t i = 0; i < MBT_LatencySnapshot::BUCKET_COUNT; ++i) {
+                m_buckets[i].store(0, std::memory_order_relaxed);
+            }
+            m_count.store(0, std::memory_order_relaxed);
+            m_sum.store(0, std::memory_order_relaxed);
+            m_max.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Copy the counters, without allocation nor lock
+         *
+         * @param snapshot Receives the counters
+         */
+        void snapshot(MBT_LatencySnapshot& snapshot) const
+        {
+            snapshot.count = m_count.load(std::memory_order_acquire);
+            snapshot.sum = m_sum.load(std::memory_order_relaxed);
+            snapshot.max = m_max.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < MBT_LatencySnapshot::BUCKET_COUNT; ++i) {
+                snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        MBT_LatencyHistogram(MBT_LatencyHistogram const&);
+        MBT_LatencyHistogram& operator=(MBT_LatencyHistogram const&);
+
+        std::atomic<uint64_t> m_buckets[MBT_LatencySnapshot::BUCKET_COUNT]; // number of durations of each bucket
+        std::atomic<uint64_t> m_count; // number of durations
+        std::atomic<uint64_t> m_sum; // sum of the durations
+        std::atomic<uint64_t> m_max; // longest duration
+};
+
+/**
+ * @brief Record the duration of a scope in a histogram
+ *
+ */
+class MBT_ScopedLatency
+{
+    public:
+        explicit MBT_ScopedLatency(MBT_LatencyHistogram& histogram)
+        : m_histogram(histogram), m_start(MBT_LatencyHistogram::Clock::now())
+        {}
+
+        ~MBT_ScopedLatency()
+        {
+            m_histogram.recordSince(m_start);
+        }
+
+    private:
+        MBT_ScopedLatency(MBT_ScopedLatency const&);
+        MBT_ScopedLatency& operator=(MBT_ScopedLatency const&);
+
+        MBT_LatencyHistogram& m_histogram; // histogram receiving the duration
+        MBT_LatencyHistogram::Clock::time_point m_start; // start of the scope
+};
+
+/**
+ * @brief Latencies of a neurofeedback session: quality checker and relax index of each packet, and the
+ * delay from a packet given to the relax index to its volume, checked against a budget
+ *
+ */
+class MBT_SessionLatency
+{
+    public:
+        MBT_SessionLatency()
+        : m_budgetNs(0), m_overBudget(0)
+        {}
+
+        MBT_LatencyHistogram quality; // MBT_ComputeQuality of each packet
+        MBT_LatencyHistogram relaxIndex; // main_relaxIndex of each packet
+        MBT_LatencyHistogram packetToVolume; // from the packet received to the volume returned
+
+        /**
+         * @brief Set the longest acceptable delay from a packet to its volume, 0 for none
+         */
+        void setBudget(uint64_t nanoseconds) { m_budgetNs.store(nanoseconds, std::memory_order_relaxed); }
+
+        uint64_t budget() const { return m_budgetNs.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the number of packets whose volume came later than the budget
+         */
+        uint64_t overBudget() const { return m_overBudget.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Count the delay of a packet to its volume, from the time the packet was received
+         */
+        void recordPacketToVolume(MBT_LatencyHistogram::Clock::time_point received)
+        {
+            const uint64_t delay = packetToVolume.recordSince(received);
+            const uint64_t limit = m_budgetNs.load(std::memory_order_relaxed);
+            if (limit > 0 && delay > limit) {
+                m_overBudget.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Clear the histograms for a new session, the budget is kept
+         */
+        void reset()
+        {
+            quality.reset();
+            relaxIndex.reset();
+            packetToVolume.reset();
+            m_overBudget.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint64_t> m_budgetNs; // longest acceptable delay, 0 for none
+        std::atomic<uint64_t> m_overBudget; // packets over the budget
+};
+
+#endif // __SIGNAL_PROCESSING_LATENCY_H__
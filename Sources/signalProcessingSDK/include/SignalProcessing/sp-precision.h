@@ -0,0 +1,57 @@
+/**
+ * @file sp-precision.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Precision policy of the preprocessing pipeline.
+ * The libraries compute in SP_RealType and exchange SP_FloatType at their interfaces, which is float in
+ * the legacy build: each stage widens its input to double and narrows its output back to float.
+ * The header-only pipeline of MBT_PrecisionPipeline.h reads, computes, accumulates and writes the signals
+ * in the single type it is instantiated with:
+ *     - SP_RealType, with the same results as the libraries except for the derivative, see MBT_Workspace.h,
+ *     - float, without any conversion to double.
+ * SP_PrecisionTraits gives the error accepted for a type against the SP_RealType reference, checked on
+ * synthetic EEG by tools/MBT_AccuracyReport.cpp.
+ *
+ */
+
+#ifndef __SIGNAL_PROCESSING_PRECISION_H__
+#define __SIGNAL_PROCESSING_PRECISION_H__
+
+#include <sp-global.h>
+
+#include <limits>
+
+/**
+ * @brief Accuracy of a computation type against the SP_RealType reference
+ *
+ */
+template<typename T>
+struct SP_PrecisionTraits {
+    enum {
+        /**
+         * @brief Largest RMS error accepted on a stage, in units of epsilon of the RMS of the reference
+         * (the sums of a window of a few thousand samples lose a few bits)
+         */
+        TOLERANCE_EPSILONS = 256
+    };
+
+    /**
+     * @brief true when T is the reference type, whose results must be identical to the libraries
+     */
+    static bool isReference() { return sizeof(T) == sizeof(SP_RealType) && std::numeric_limits<T>::digits == std::numeric_limits<SP_RealType>::digits; }
+
+    /**
+     * @brief Largest RMS error accepted on a stage, relative to the RMS of the reference output, 0 for the reference
+     */
+    static double tolerance() { return isReference() ? 0 : TOLERANCE_EPSILONS * static_cast<double>(std::numeric_limits<T>::epsilon()); }
+};
+
+/**
+ * @brief Name of a computation type, for the reports
+ */
+inline const char* SP_precisionName(float) { return "float"; }
+inline const char* SP_precisionName(double) { return "double"; }
+inline const char* SP_precisionName(long double) { return "long double"; }
+
+#endif // __SIGNAL_PROCESSING_PRECISION_H__
@@ -0,0 +1,398 @@
+/**
+ * @file MBT_AccuracyReport.cpp
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Accuracy of the single precision preprocessing (MBT_PrecisionPipeline<float>) against the
+ * SP_RealType reference, on synthetic EEG with eye blinks and muscle artifacts, for every channel count
+ * and window length requested. The results are written in JSON, one entry per stage and configuration.
+ *
+ * The reference is the SP_RealType instantiation of the same kernels. It is not compared with the libraries
+ * here: MBTWorkspaceTests compares these kernels with the compiled functions, bit for bit, except for the
+ * derivatives that the prebuilt timeFirstDerivative gets wrong (see MBT_Workspace.h).
+ *
+ * Stages compared, each one on the reference input of the stage rounded to float, so that the errors of
+ * a stage are not those of the previous ones:
+ *     removeDC             MBT_PrecisionKernels::removeDC
+ *     outlierBounds        MBT_PrecisionKernels::outlierBounds, the lower and upper bounds
+ *     interpolateOutliers  MBT_PrecisionKernels::interpolateOutliers, with the reference bounds
+ *     detrend              MBT_PrecisionKernels::detrend
+ *     timeFirstDerivative  MBT_PrecisionKernels::timeFirstDerivative
+ *     powerOfTwoWithoutDC  MBT_PrecisionKernels::powerOfTwoWithoutDC
+ * and the whole chain from the float EEG, which also counts the windows whose outliers differ:
+ *     chainSignal, chainDerivative, chainPower
+ * For each one: the RMS error relative to the RMS of the reference, the largest error relative to the
+ * largest reference value, the signal to error ratio in dB, and whether the relative RMS error is within
+ * SP_PrecisionTraits<float>::tolerance(). The samples which are NaN in one output only are counted apart.
+ *
+ * Usage:
+ *     mbt-accuracy [--output FILE] [--channels 1,2,4] [--window-seconds 1,2,4,8] [--sampling-rate 250]
+ *                  [--windows 50] [--seed 1]
+ * The exit status is 1 when a stage is out of tolerance.
+ *
+ * Build: header only, g++ -std=c++11 -O2 -I../include -I../include/SignalProcessing MBT_AccuracyReport.cpp
+ *
+ */
+
+#include <sp-global.h>
+#include <sp-precision.h>
+
+#include <DataManipulation/MBT_Matrix.h>
+#include <DataManipulation/MBT_SignalGenerator.h>
+#include <PreProcessing/MBT_PrecisionPipeline.h>
+
+#include "MBT_JsonWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef MBT_PrecisionPipeline<SP_RealType> ReferencePipeline;
+typedef MBT_PrecisionPipeline<float> SinglePipeline;
+typedef MBT_PrecisionKernels<float> SingleKernels;
+
+/**
+ * @brief Options of the report
+ */
+struct AccuracyOptions {
+    std::string output; // result file, standard output if empty
+    std::vector<int> channels; // channel counts
+    std::vector<double> windowSeconds; // window lengths in seconds
+    SP_FloatType sampRate; // sampling rate of the synthetic signals
+    int windows; // number of windows per configuration
+    unsigned int seed; // seed of the synthetic signals
+
+    AccuracyOptions()
+    : sampRate(250), windows(50), seed(1)
+    {
+        const int defaultChannels[] = { 1, 2, 4 };
+        const double defaultWindows[] = { 1, 2, 4, 8 };
+        channels.assign(defaultChannels, defaultChannels + 3);
+        windowSeconds.assign(defaultWindows, defaultWindows + 4);
+    }
+};
+
+/**
+ * @brief Errors of a stage against the reference
+ */
+class ErrorStatistics
+{
+    public:
+        ErrorStatistics()
+        : m_count(0), m_nanMismatches(0), m_squaredError(0), m_squaredReference(0), m_maxError(0), m_maxReference(0)
+        {}
+
+        void add(SP_RealType reference, float value)
+        {
+            const bool isReferenceNaN = std::isnan(reference);
+            if (isReferenceNaN || std::isnan(value)) {
+                m_nanMismatches += isReferenceNaN != std::isnan(value) ? 1 : 0;
+                return;
+            }
+            const double error = std::fabs(static_cast<double>(value) - static_cast<double>(reference));
+            const double magnitude = std::fabs(static_cast<double>(reference));
+            ++m_count;
+            m_squaredError += error * error;
+            m_squaredReference += magnitude * magnitude;
+            m_maxError = std::max(m_maxError, error);
+            m_maxReference = std::max(m_maxReference, magnitude);
+        }
+
+        void add(std::vector<SP_RealType> const& reference, std::vector<float> const& values)
+        {
+            const size_t size = std::min(reference.size(), values.size());
+            for (size_t i = 0; i < size; ++i) {
+                add(reference[i], values[i]);
+            }
+            m_nanMismatches += std::max(reference.size(), values.size()) - size;
+        }
+
+        double relativeRmsError() const
+        {
+            return m_squaredReference > 0 ? std::sqrt(m_squaredError / m_squaredReference) : std::sqrt(m_squaredError);
+        }
+
+        bool isWithin(double tolerance) const
+        {
+            return m_nanMismatches == 0 && relativeRmsError() <= tolerance;
+        }
+
+        void write(MBT_JsonWriter& json) const
+        {
+            const double count = m_count > 0 ? static_cast<double>(m_count) : 1;
+            json.field("samples", m_count)
+                .field("nanMismatches", m_nanMismatches)
+                .field("rmsError", std::sqrt(m_squaredError / count))
+                .field("relativeRmsError", relativeRmsError())
+                .field("maxError", m_maxError)
+                .field("relativeMaxError", m_maxReference > 0 ? m_maxError / m_maxReference : m_maxError)
+                .field("snrDb", m_squaredError > 0 ? 10 * std::log10(m_squaredReference / m_squaredError) : 999.0);
+        }
+
+    private:
+        unsigned long m_count; // number of compared samples
+        unsigned long m_nanMismatches; // samples NaN in one output only, or missing in one output
+        double m_squaredError; // sum of the squared errors
+        double m_squaredReference; // sum of the squared reference values
+        double m_maxError; // largest absolute error
+        double m_maxReference; // largest absolute reference value
+};
+
+/**
+ * @brief Errors of every stage for one configuration
+ */
+struct ConfigurationResult {
+    int channels; // number of channels of a window
+    int samples; // number of samples per channel of a window
+    unsigned long outlierMismatches; // channel windows whose float chain replaced other samples than the reference
+    std::vector<std::string> stages; // names of the stages
+    std::vector<ErrorStatistics> errors; // errors of each stage
+
+    ErrorStatistics& stage(const std::string& name)
+    {
+        const std::vector<std::string>::iterator it = std::find(stages.begin(), stages.end(), name);
+        if (it != stages.end()) {
+            return errors[it - stages.begin()];
+        }
+        stages.push_back(name);
+        errors.push_back(ErrorStatistics());
+        return errors.back();
+    }
+};
+
+std::vector<float> toSingle(std::vector<SP_RealType> const& values)
+{
+    return std::vector<float>(values.begin(), values.end());
+}
+
+/**
+ * @brief Compare each stage of a channel, on the reference input of the stage rounded to float
+ */
+void compareStages(ConfigurationResult& result, const SP_FloatType* eeg, size_t size, SP_FloatType sampRate)
+{
+    typedef MBT_PrecisionKernels<SP_RealType> ReferenceKernels;
+    const SP_RealType referenceRate = sampRate;
+    const float singleRate = static_cast<float>(sampRate);
+
+    std::vector<SP_RealType> input(eeg, eeg + size);
+    std::vector<SP_RealType> reference(size);
+    std::vector<float> single = toSingle(input);
+    ReferenceKernels::removeDC(input.data(), size, reference.data());
+    SingleKernels::removeDC(single.data(), size, single.data());
+    result.stage("removeDC").add(reference, single);
+
+    input = reference;
+    std::vector<SP_RealType> referenceSelection(input);
+    SP_RealType referenceBounds[2];
+    ReferenceKernels::outlierBounds(referenceSelection.data(), size, referenceBounds);
+    std::vector<float> singleSelection = toSingle(input);
+    float singleBounds[2];
+    SingleKernels::outlierBounds(singleSelection.data(), size, singleBounds);
+    result.stage("outlierBounds").add(referenceBounds[0], singleBounds[0]);
+    result.stage("outlierBounds").add(referenceBounds[1], singleBounds[1]);
+
+    // the float kernel is given the reference bounds, so that both replace the same samples
+    const float roundedBounds[2] = { static_cast<float>(referenceBounds[0]), static_cast<float>(referenceBounds[1]) };
+    reference = input;
+    ReferenceKernels::interpolateOutliers(reference.data(), size, referenceBounds);
+    single = toSingle(input);
+    SingleKernels::interpolateOutliers(single.data(), size, roundedBounds);
+    result.stage("interpolateOutliers").add(reference, single);
+
+    input = reference;
+    single = toSingle(input);
+    ReferenceKernels::detrend(input.data(), size, referenceRate, reference.data());
+    SingleKernels::detrend(single.data(), size, singleRate, single.data());
+    result.stage("detrend").add(reference, single);
+
+    input = reference;
+    single = toSingle(input);
+    reference.resize(ReferenceKernels::timeFirstDerivative(input.data(), size, referenceRate, reference.data()));
+    single.resize(SingleKernels::timeFirstDerivative(single.data(), size, singleRate, single.data()));
+    result.stage("timeFirstDerivative").add(reference, single);
+
+    reference.resize(size);
+    single = toSingle(input);
+    ReferenceKernels::powerOfTwoWithoutDC(input.data(), size, reference.data());
+    SingleKernels::powerOfTwoWithoutDC(single.data(), size, single.data());
+    result.stage("powerOfTwoWithoutDC").add(reference, single);
+}
+
+/**
+ * @brief Compare the stages and the whole chain on the windows of a configuration
+ */
+ConfigurationResult runConfiguration(const AccuracyOptions& options, int channels, int samples)
+{
+    ConfigurationResult result;
+    result.channels = channels;
+    result.samples = samples;
+    result.outlierMismatches = 0;
+
+    MBT_SignalGeneratorConfig config;
+    config.sampRate = options.sampRate;
+    config.channels = channels;
+    config.packetLength = samples;
+    config.muscleRate = 0.1f;
+    config.blinkRate = 0.3f;
+    MBT_SignalGenerator generator(config, options.seed + channels * 1000 + samples);
+
+    ReferencePipeline reference(options.sampRate, samples);
+    SinglePipeline single(options.sampRate, samples);
+    SP_FloatMatrix eeg(channels, samples);
+    std::vector<SP_RealType> referenceRow(samples);
+    std::vector<float> singleRow(samples);
+
+    for (int window = 0; window < options.windows; ++window) {
+        generator.generate(eeg);
+        for (int channel = 0; channel < channels; ++channel) {
+            const SP_FloatType* row = eeg.rowData(channel);
+            referenceRow.assign(row, row + samples);
+            reference.process(referenceRow.data(), referenceRow.size());
+
+            compareStages(result, row, samples, options.sampRate);
+
+            // the float chain starts from the EEG in float, as delivered by the acquisition
+            singleRow.assign(row, row + samples);
+            single.process(singleRow.data(), singleRow.size());
+            result.outlierMismatches += single.replaced() != reference.replaced() ? 1 : 0;
+            result.stage("chainSignal").add(reference.signal(), single.signal());
+            result.stage("chainDerivative").add(reference.derivative(), single.derivative());
+            result.stage("chainPower").add(reference.power(), single.power());
+        }
+    }
+    return result;
+}
+
+void writeResults(std::ostream& out, const AccuracyOptions& options, std::vector<ConfigurationResult> const& results, bool& isValid)
+{
+    const double tolerance = SP_PrecisionTraits<float>::tolerance();
+    MBT_JsonWriter json(out);
+    json.beginObject()
+        .field("precision", SP_precisionName(float()))
+        .field("reference", SP_precisionName(SP_RealType()))
+        .field("tolerance", tolerance)
+        .field("samplingRate", options.sampRate)
+        .field("windows", options.windows)
+        .field("seed", options.seed)
+        .field("timestamp", static_cast<long long>(std::time(0)));
+    json.key("results").beginArray();
+    isValid = true;
+    for (size_t r = 0; r < results.size(); ++r) {
+        const ConfigurationResult& result = results[r];
+        for (size_t s = 0; s < result.stages.size(); ++s) {
+            // the chain is within tolerance only when it replaced the same outliers as the reference
+            const bool isChain = result.stages[s].compare(0, 5, "chain") == 0;
+            const bool isWithin = result.errors[s].isWithin(tolerance) && !(isChain && result.outlierMismatches > 0);
+            isValid = isValid && isWithin;
+            json.beginObject()
+                .field("stage", result.stages[s])
+                .field("channels", result.channels)
+                .field("samples", result.samples)
+                .field("outlierMismatches", result.outlierMismatches);
+            result.errors[s].write(json);
+            json.field("withinTolerance", isWithin).endObject();
+            std::cerr << result.stages[s] << "\t" << result.channels << "x" << result.samples << "\t"
+                      << result.errors[s].relativeRmsError() << "\t" << (isWithin ? "ok" : "out of tolerance") << "\n";
+        }
+    }
+    json.endArray().endObject();
+}
+
+std::vector<std::string> splitList(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+template<typename T>
+std::vector<T> parseList(const std::string& text)
+{
+    const std::vector<std::string> items = splitList(text);
+    std::vector<T> values;
+    for (size_t i = 0; i < items.size(); ++i) {
+        const double value = std::atof(items[i].c_str());
+        if (value > 0) {
+            values.push_back(static_cast<T>(value));
+        }
+    }
+    return values;
+}
+
+void printUsage()
+{
+    std::cerr << "usage: mbt-accuracy [--output FILE] [--channels 1,2,4] [--window-seconds 1,2,4,8]\n"
+                 "                    [--sampling-rate 250] [--windows 50] [--seed 1]\n";
+}
+
+bool parseOptions(int argc, char** argv, AccuracyOptions& options)
+{
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string argument = argv[i];
+        const std::string value = argv[i + 1];
+        if (argument == "--output") {
+            options.output = value;
+        } else if (argument == "--channels") {
+            options.channels = parseList<int>(value);
+        } else if (argument == "--window-seconds") {
+            options.windowSeconds = parseList<double>(value);
+        } else if (argument == "--sampling-rate") {
+            options.sampRate = static_cast<SP_FloatType>(std::atof(value.c_str()));
+        } else if (argument == "--windows") {
+            options.windows = std::max(1, std::atoi(value.c_str()));
+        } else if (argument == "--seed") {
+            options.seed = static_cast<unsigned int>(std::strtoul(value.c_str(), 0, 10));
+        } else {
+            return false;
+        }
+    }
+    return argc % 2 == 1 && !options.channels.empty() && !options.windowSeconds.empty() && options.sampRate > 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    AccuracyOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    std::vector<ConfigurationResult> results;
+    for (size_t c = 0; c < options.channels.size(); ++c) {
+        for (size_t w = 0; w < options.windowSeconds.size(); ++w) {
+            const int samples = static_cast<int>(options.windowSeconds[w] * options.sampRate);
+            if (samples > 1) {
+                results.push_back(runConfiguration(options, options.channels[c], samples));
+            }
+        }
+    }
+
+    bool isValid = false;
+    if (options.output.empty()) {
+        writeResults(std::cout, options, results, isValid);
+    } else {
+        std::ofstream file(options.output.c_str());
+        writeResults(file, options, results, isValid);
+        if (!file) {
+            std::cerr << "mbt-accuracy: cannot write " << options.output << "\n";
+            return 1;
+        }
+    }
+    return isValid ? 0 : 1;
+}
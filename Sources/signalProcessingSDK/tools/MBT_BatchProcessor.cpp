@@ -0,0 +1,540 @@
+/**
+ * @file MBT_BatchProcessor.cpp
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Offline processing of recorded sessions with the same pipeline as the iOS bridge:
+ * quality checker packet by packet, IAF and calibration on the calibration recording, relax index
+ * and SNR statistics on the session recording. The results of each session are written in a JSON file.
+ *
+ * Each session is a directory holding the calibration and the session recordings, in the text format of
+ * @ref MBT_readMatrix with one channel per row. The sessions are processed by worker processes, one
+ * session per process and as many processes at a time as requested: the prebuilt libraries keep global
+ * state between calls (@ref MelomindAnalysisSingleton, the contour buffer of @ref Contourc...), so two
+ * sessions must not share a process, and a session aborting in the libraries does not stop the batch.
+ *
+ * Usage:
+ *     mbt-batch [options] --output DIR SESSION_DIR...
+ *     mbt-batch [options] --output DIR --list FILE
+ * Options:
+ *     --jobs N                 Number of sessions processed at the same time (default: number of cores)
+ *     --list FILE              Read the session directories from FILE, one per line
+ *     --calibration-file NAME  Calibration recording in each session directory (default: calibration.txt)
+ *     --session-file NAME      Session recording in each session directory (default: session.txt)
+ *     --sampling-rate FS       Sampling rate of the recordings in Hz (default: 250)
+ *     --packet-length N        Number of samples per packet (default: 250)
+ *     --snr-threshold T        Threshold given to SNR_Statistics::CalculateSNRStatistics (default: 1)
+ *     --skip-existing          Do not process the sessions whose result file already exists
+ *     --trace                  Write the trace of the stages of each session in DIR/<session>.trace.json
+ * The result of a session is written in DIR/<session>.json, where <session> is the path of the session
+ * directory relative to the directory common to all the sessions, with '/' replaced by '-' (the name of
+ * the directory when there is only one session). The batch is rejected when two sessions have the same name.
+ * The result files hold the latency percentiles of the quality checker packet by packet. When built with
+ * SP_ENABLE_INSTRUMENTATION, they also hold the counters and percentiles of the stages, and
+ * SP_DEFINE_ALLOCATION_COUNTERS below counts their allocations.
+ * The exit status is 0 if all the sessions have been processed, 1 otherwise.
+ *
+ * Build: link with the libraries of lib/ (imported targets of lib/cmake) and compile
+ * "Sources/Resources/CPPSignalProcessing/Code bridge/MBTBridgeConstants.mm" as C++ (-x c++),
+ * which holds the training data of the quality checker. POSIX only (fork).
+ *
+ */
+
+#include <sp-global.h>
+#include <sp-instrumentation.h>
+#include <sp-latency.h>
+
+#include <DataManipulation/MBT_Matrix.h>
+#include <DataManipulation/MBT_ReadInputOrWriteOutput.h>
+#include <NF_Melomind/MBT_ComputeCalibration.h>
+#include <NF_Melomind/MBT_ComputeIAFCalibration.h>
+#include <NF_Melomind/MBT_NFConfig.h>
+#include <NF_Melomind/MBT_NFResults.h>
+#include <NF_Melomind/Utils.h>
+#include <SNR/MBT_SNR_Stats.h>
+
+#include "../../Resources/CPPSignalProcessing/Code bridge/MBTBridgeParameters.h"
+#include "MBT_JsonWriter.h"
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+SP_DEFINE_ALLOCATION_COUNTERS()
+
+namespace {
+
+/**
+ * @brief Options of the batch
+ */
+struct BatchOptions {
+    std::vector<std::string> sessions; // session directories
+    std::vector<std::string> names; // name of the result files of each session
+    std::string outputDirectory; // directory of the result files
+    std::string calibrationFile; // calibration recording in each session directory
+    std::string sessionFile; // session recording in each session directory
+    unsigned int jobs; // number of worker processes
+    SP_FloatType sampRate; // sampling rate of the recordings
+    unsigned int packetLength; // number of samples per packet
+    SP_FloatType snrThreshold; // threshold of the SNR statistics
+    bool skipExisting; // keep the existing result files
+    bool trace; // write the trace of the stages of each session
+
+    BatchOptions()
+    : calibrationFile("calibration.txt"), sessionFile("session.txt"), jobs(std::thread::hardware_concurrency()),
+      sampRate(250), packetLength(250), snrThreshold(1), skipExisting(false), trace(false)
+    {
+        if (jobs == 0) {
+            jobs = 1;
+        }
+    }
+};
+
+/**
+ * @brief Recording after the quality checker: the modified signal and one quality per channel and packet
+ */
+struct CheckedRecording {
+    SP_FloatMatrix signal; // signal modified by the quality checker, one channel per row
+    SP_FloatMatrix qualities; // one row per channel, one column per packet
+
+    CheckedRecording(int channels, int packets, unsigned int packetLength)
+    : signal(channels, packets * packetLength), qualities(channels, packets)
+    {}
+};
+
+/**
+ * @brief Run the quality checker packet by packet on a recording, the incomplete last packet is dropped
+ *
+ * @param latency Receives the duration of the quality checker for each packet
+ */
+CheckedRecording checkQuality(MBT_MainQC& qualityChecker, const SP_FloatMatrix& recording, unsigned int packetLength,
+                              MBT_LatencyHistogram& latency)
+{
+    const int channels = recording.size().first;
+    const int packets = recording.size().second / static_cast<int>(packetLength);
+    CheckedRecording result(channels, packets, packetLength);
+
+    SP_FloatMatrix packet(channels, packetLength);
+    for (int p = 0; p < packets; ++p) {
+        for (int channel = 0; channel < channels; ++channel) {
+            const SP_FloatType* samples = recording.rowData(channel) + p * packetLength;
+            std::copy(samples, samples + packetLength, packet.rowData(channel));
+        }
+        {
+            SP_SCOPED_STAGE(SP_STAGE_QUALITY);
+            MBT_ScopedLatency scopedLatency(latency);
+            qualityChecker.MBT_ComputeQuality(packet);
+        }
+        const SP_FloatVector qualities = qualityChecker.MBT_get_m_quality();
+        const SP_FloatMatrix modified = qualityChecker.MBT_get_m_inputData();
+        for (int channel = 0; channel < channels; ++channel) {
+            result.qualities(channel, p) = qualities[channel];
+            std::copy(modified.rowData(channel), modified.rowData(channel) + packetLength,
+                      result.signal.rowData(channel) + p * packetLength);
+        }
+    }
+    return result;
+}
+
+void writeMatrixRows(MBT_JsonWriter& json, const SP_FloatMatrix& matrix)
+{
+    json.beginArray();
+    for (int row = 0; row < matrix.size().first; ++row) {
+        json.value(SP_FloatVector(matrix.rowData(row), matrix.rowData(row) + matrix.size().second));
+    }
+    json.endArray();
+}
+
+/**
+ * @brief Write the number, mean and percentiles of the durations of a histogram, in nanoseconds
+ */
+void writeLatency(MBT_JsonWriter& json, const MBT_LatencySnapshot& latency)
+{
+    json.beginObject()
+        .field("count", static_cast<unsigned long long>(latency.count))
+        .field("meanNs", latency.mean())
+        .field("p50Ns", static_cast<unsigned long long>(latency.percentile(50)))
+        .field("p90Ns", static_cast<unsigned long long>(latency.percentile(90)))
+        .field("p99Ns", static_cast<unsigned long long>(latency.percentile(99)))
+        .field("p999Ns", static_cast<unsigned long long>(latency.percentile(99.9)))
+        .field("maxNs", static_cast<unsigned long long>(latency.max))
+        .endObject();
+}
+
+/**
+ * @brief Write the counters and the latency percentiles of the instrumented stages which ran
+ */
+void writeStages(MBT_JsonWriter& json)
+{
+    MBT_LatencySnapshot latency;
+    const std::vector<MBT_StageSnapshot> stages = MBT_Instrumentation::snapshot();
+    json.key("stages").beginObject();
+    for (size_t i = 0; i < stages.size(); ++i) {
+        if (stages[i].calls == 0) {
+            continue;
+        }
+        json.key(stages[i].name).beginObject()
+            .field("calls", static_cast<unsigned long long>(stages[i].calls))
+            .field("totalNs", static_cast<unsigned long long>(stages[i].totalNs))
+            .field("maxNs", static_cast<unsigned long long>(stages[i].maxNs))
+            .field("bytes", static_cast<unsigned long long>(stages[i].bytes))
+            .field("allocations", static_cast<unsigned long long>(stages[i].allocations))
+            .field("allocatedBytes", static_cast<unsigned long long>(stages[i].allocatedBytes));
+        MBT_Instrumentation::latency(static_cast<SP_Stage>(i), latency);
+        json.key("latency");
+        writeLatency(json, latency);
+        json.endObject();
+    }
+    json.endObject();
+}
+
+/**
+ * @brief Components of the absolute path of a directory, or of the path as given if it cannot be resolved
+ */
+std::vector<std::string> pathComponents(const std::string& directory)
+{
+    char resolved[PATH_MAX];
+    const std::string path = realpath(directory.c_str(), resolved) != NULL ? std::string(resolved) : directory;
+    std::vector<std::string> components;
+    size_t start = 0;
+    while (start <= path.size()) {
+        const size_t slash = std::min(path.find('/', start), path.size());
+        if (slash > start) {
+            components.push_back(path.substr(start, slash - start));
+        }
+        start = slash + 1;
+    }
+    return components;
+}
+
+/**
+ * @brief Name the result files of the sessions after their path relative to the directory common to all
+ * of them, so that sessions with the same directory name in different places do not share a result file
+ *
+ * @return false if two sessions have the same name
+ */
+bool nameSessions(BatchOptions& options)
+{
+    std::vector< std::vector<std::string> > paths;
+    for (size_t i = 0; i < options.sessions.size(); ++i) {
+        paths.push_back(pathComponents(options.sessions[i]));
+    }
+    // each name keeps at least the last component of its path
+    size_t common = 0;
+    bool isCommon = !paths.empty();
+    while (isCommon) {
+        for (size_t i = 0; i < paths.size() && isCommon; ++i) {
+            isCommon = common + 1 < paths[i].size() && paths[i][common] == paths[0][common];
+        }
+        if (isCommon) {
+            ++common;
+        }
+    }
+
+    std::map<std::string, size_t> sessionOfName;
+    options.names.clear();
+    for (size_t i = 0; i < paths.size(); ++i) {
+        std::string name;
+        for (size_t component = common; component < paths[i].size(); ++component) {
+            name += (component > common ? "-" : "") + paths[i][component];
+        }
+        if (name.empty()) {
+            name = "root";
+        }
+        const std::map<std::string, size_t>::const_iterator other = sessionOfName.find(name);
+        if (other != sessionOfName.end()) {
+            std::cerr << "mbt-batch: " << options.sessions[other->second] << " and " << options.sessions[i]
+                      << " have the same result file " << name << ".json\n";
+            return false;
+        }
+        sessionOfName[name] = i;
+        options.names.push_back(name);
+    }
+    return true;
+}
+
+std::string resultPath(const BatchOptions& options, size_t session)
+{
+    return options.outputDirectory + "/" + options.names[session] + ".json";
+}
+
+bool fileExists(const std::string& path)
+{
+    struct stat status;
+    return stat(path.c_str(), &status) == 0;
+}
+
+/**
+ * @brief Process one session and write its result file, run in a worker process
+ */
+void processSession(const BatchOptions& options, size_t index)
+{
+    const std::string& directory = options.sessions[index];
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    MBT_Instrumentation::setTracing(options.trace);
+    const SP_FloatMatrix calibrationRecording = MBT_readMatrix(directory + "/" + options.calibrationFile);
+    const SP_FloatMatrix sessionRecording = MBT_readMatrix(directory + "/" + options.sessionFile);
+    if (calibrationRecording.size().first == 0 || sessionRecording.size().first == 0) {
+        throw std::runtime_error("empty or missing recording");
+    }
+    if (calibrationRecording.size().first != sessionRecording.size().first) {
+        throw std::runtime_error("the calibration and the session do not have the same channels");
+    }
+
+    // one quality checker for the calibration and the session, as during an acquisition
+    MBT_MainQC* qualityChecker = MBT_createBridgeQualityChecker(options.sampRate);
+    MBT_LatencyHistogram qualityLatency;
+    const CheckedRecording calibration = checkQuality(*qualityChecker, calibrationRecording, options.packetLength,
+                                                      qualityLatency);
+    CheckedRecording session = checkQuality(*qualityChecker, sessionRecording, options.packetLength, qualityLatency);
+    delete qualityChecker;
+    if (calibration.qualities.size().second == 0 || session.qualities.size().second == 0) {
+        throw std::runtime_error("a recording is shorter than one packet");
+    }
+
+    const int packetLength = static_cast<int>(options.packetLength);
+    SP_FloatVector iafMedian;
+    {
+        SP_SCOPED_STAGE(SP_STAGE_IAF);
+        iafMedian = MBT_ComputeIAFCalibration(calibration.signal, calibration.qualities, options.sampRate,
+                                              packetLength, IAFinf, IAFsup);
+    }
+    std::map<std::string, SP_FloatVector> paramCalib;
+    {
+        SP_SCOPED_STAGE(SP_STAGE_CALIBRATION);
+        paramCalib = MBT_ComputeCalibration(calibration.signal, calibration.qualities, options.sampRate, packetLength,
+                                            iafMedian[0], iafMedian[1], SMOOTHINGDURATION);
+    }
+    paramCalib[MBT_IAF_CALIBRATION_KEY] = iafMedian;
+    const MBT_SessionCalibration sessionCalibration(MBT_CalibrationResult::fromMap(paramCalib), RMS_MIN_FACTOR, RMS_MAX_FACTOR);
+
+    const MBT_NFConfig configuration = { static_cast<float>(options.sampRate), options.packetLength, SMOOTHINGDURATION, 1 };
+    SP_FloatVector pastRelaxIndex;
+    SP_FloatVector smoothedRelaxIndex;
+    SP_FloatVector volum;
+    {
+        SP_SCOPED_STAGE(SP_STAGE_RELAX_INDEX);
+        computeSessionRelaxIndex(configuration, sessionCalibration.paramCalib(), session.signal, pastRelaxIndex,
+                                 smoothedRelaxIndex, volum, sessionCalibration.minMax(), session.qualities);
+    }
+
+    // the SDK only computes the statistics of sessions with more than 3 relax indexes
+    std::map<std::string, SP_FloatType> snrStatistics;
+    if (pastRelaxIndex.size() > 3) {
+        SNR_Statistics statistics(pastRelaxIndex);
+        snrStatistics = statistics.CalculateSNRStatistics(pastRelaxIndex, options.snrThreshold);
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // written next to the result and renamed, so that an interrupted batch never leaves a partial result
+    const std::string path = resultPath(options, index);
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath.c_str());
+        MBT_JsonWriter json(file);
+        json.beginObject()
+            .field("session", options.names[index])
+            .field("directory", directory)
+            .field("samplingRate", options.sampRate)
+            .field("packetLength", options.packetLength)
+            .field("channels", sessionRecording.size().first)
+            .field("calibrationPackets", calibration.qualities.size().second)
+            .field("sessionPackets", session.qualities.size().second)
+            .field("calibration", paramCalib);
+        json.key("qualities").beginObject();
+        json.key("calibration");
+        writeMatrixRows(json, calibration.qualities);
+        json.key("session");
+        writeMatrixRows(json, session.qualities);
+        json.endObject();
+        json.key("relaxIndex").beginObject()
+            .field("raw", pastRelaxIndex)
+            .field("smoothed", smoothedRelaxIndex)
+            .field("volum", volum)
+            .endObject()
+            .field("snrStatistics", snrStatistics)
+            .field("processingSeconds", seconds);
+        MBT_LatencySnapshot latency;
+        qualityLatency.snapshot(latency);
+        json.key("qualityLatency");
+        writeLatency(json, latency);
+        if (SP_INSTRUMENTATION_COMPILED) {
+            writeStages(json);
+        }
+        json.endObject();
+        if (!file) {
+            throw std::runtime_error("cannot write " + temporaryPath);
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("cannot write " + path);
+    }
+    if (options.trace) {
+        const std::string tracePath = options.outputDirectory + "/" + options.names[index] + ".trace.json";
+        std::ofstream traceFile(tracePath.c_str());
+        MBT_Instrumentation::writeChromeTrace(traceFile);
+    }
+}
+
+void printUsage()
+{
+    std::cerr << "usage: mbt-batch [--jobs N] [--calibration-file NAME] [--session-file NAME] [--sampling-rate FS]\n"
+                 "                 [--packet-length N] [--snr-threshold T] [--skip-existing] [--trace]\n"
+                 "                 --output DIR (--list FILE | SESSION_DIR...)\n";
+}
+
+/**
+ * @brief Parse the command line, return false on error
+ */
+bool parseOptions(int argc, char** argv, BatchOptions& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (argument == "--skip-existing") {
+            options.skipExisting = true;
+        } else if (argument == "--trace") {
+            options.trace = true;
+        } else if (argument.compare(0, 2, "--") != 0) {
+            options.sessions.push_back(argument);
+        } else if (!hasValue) {
+            return false;
+        } else if (argument == "--output") {
+            options.outputDirectory = argv[++i];
+        } else if (argument == "--jobs") {
+            options.jobs = static_cast<unsigned int>(std::max(1, std::atoi(argv[++i])));
+        } else if (argument == "--calibration-file") {
+            options.calibrationFile = argv[++i];
+        } else if (argument == "--session-file") {
+            options.sessionFile = argv[++i];
+        } else if (argument == "--sampling-rate") {
+            options.sampRate = static_cast<SP_FloatType>(std::atof(argv[++i]));
+        } else if (argument == "--packet-length") {
+            options.packetLength = static_cast<unsigned int>(std::max(1, std::atoi(argv[++i])));
+        } else if (argument == "--snr-threshold") {
+            options.snrThreshold = static_cast<SP_FloatType>(std::atof(argv[++i]));
+        } else if (argument == "--list") {
+            std::ifstream list(argv[++i]);
+            if (!list) {
+                std::cerr << "mbt-batch: cannot read " << argv[i] << "\n";
+                return false;
+            }
+            std::string line;
+            while (std::getline(list, line)) {
+                if (!line.empty() && line[0] != '#') {
+                    options.sessions.push_back(line);
+                }
+            }
+        } else {
+            return false;
+        }
+    }
+    return !options.outputDirectory.empty() && options.sampRate > 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    BatchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+    if (!nameSessions(options)) {
+        return 2;
+    }
+    if (mkdir(options.outputDirectory.c_str(), 0755) != 0 && errno != EEXIST) {
+        std::cerr << "mbt-batch: cannot create " << options.outputDirectory << "\n";
+        return 2;
+    }
+
+    std::map<pid_t, size_t> running; // worker process of each session being processed
+    size_t next = 0;
+    unsigned int failed = 0;
+    unsigned int skipped = 0;
+    while (next < options.sessions.size() || !running.empty()) {
+        while (next < options.sessions.size() && running.size() < options.jobs) {
+            const size_t index = next++;
+            if (options.skipExisting && fileExists(resultPath(options, index))) {
+                ++skipped;
+                continue;
+            }
+            std::cout.flush();
+            const pid_t pid = fork();
+            if (pid == 0) {
+                int status = 0;
+                try {
+                    processSession(options, index);
+                } catch (const std::exception& error) {
+                    std::cerr << "mbt-batch: " << options.sessions[index] << ": " << error.what() << "\n";
+                    status = 1;
+                }
+                std::cerr.flush();
+                _exit(status);
+            }
+            if (pid < 0) {
+                std::cerr << "mbt-batch: cannot start a worker: " << std::strerror(errno) << "\n";
+                ++failed;
+                continue;
+            }
+            running[pid] = index;
+        }
+        if (running.empty()) {
+            continue;
+        }
+
+        int status = 0;
+        const pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // the workers cannot be waited for anymore, their sessions are not known to be processed
+            const std::string error = std::strerror(errno);
+            for (std::map<pid_t, size_t>::const_iterator worker = running.begin(); worker != running.end(); ++worker) {
+                std::cout << "failed\t" << options.sessions[worker->second] << "\twaitpid: " << error << "\n";
+                ++failed;
+            }
+            running.clear();
+            continue;
+        }
+        const std::map<pid_t, size_t>::iterator worker = running.find(pid);
+        if (worker == running.end()) {
+            continue;
+        }
+        const std::string& directory = options.sessions[worker->second];
+        const bool isDone = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        if (isDone) {
+            std::cout << "done\t" << directory << "\n";
+        } else {
+            ++failed;
+            if (WIFSIGNALED(status)) {
+                std::cout << "failed\t" << directory << "\tsignal " << WTERMSIG(status) << "\n";
+            } else {
+                std::cout << "failed\t" << directory << "\n";
+            }
+        }
+        running.erase(worker);
+    }
+
+    std::cerr << "mbt-batch: " << options.sessions.size() << " sessions, " << failed << " failed, "
+              << skipped << " skipped\n";
+    return failed == 0 ? 0 : 1;
+}
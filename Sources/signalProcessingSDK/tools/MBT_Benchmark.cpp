@@ -0,0 +1,692 @@
+/**
+ * @file MBT_Benchmark.cpp
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Timing of each public processing stage of the SDK on synthetic EEG, for every channel count
+ * and window length requested. The results are written in JSON, one entry per stage and configuration,
+ * to compare two drops of the libraries or to size a processing fleet.
+ *
+ * Stages timed on a window of each length and channel count:
+ *     rawFrameDecoder MBT_RawFrameDecoder::decode of the bytes of the window into the preallocated rows
+ *     pwelch          MBT_PWelchComputer (HAMMING window)
+ *     bandPass        BandPassFilter on each channel, 2-30 Hz
+ *     preprocessing   RemoveDC, CalculateBounds, InterpolateOutliers, detrend, timeFirstDerivative and
+ *                     powerOfTwoWithoutDC on each channel
+ *     preprocessingWorkspace  the same with the overloads of MBT_Workspace.h, without allocation
+ *     preprocessingFixed      the same with the kernels of MBT_FixedShape.h for the shapes of the headsets
+ *     preprocessingSingle     the same with MBT_PrecisionPipeline<SP_FloatType>, on the float EEG without conversion
+ *     quality         MBT_MainQC::MBT_ComputeQuality with the training data of the iOS bridge
+ *     iaf             MBT_ComputeIAF
+ *     rms             MBT_ComputeRMS
+ *     relaxIndex      main_relaxIndex, the window being the packet
+ *     tf              TF on each channel
+ *     contourc        Contourc on the map of the first channel
+ *     marchingSquares MBT_MarchingSquares::extract on the same map
+ * Session stages, timed for each channel count or each session length:
+ *     calibration     MBT_ComputeIAFCalibration then MBT_ComputeCalibration with the IAF median, as the
+ *                     iOS bridge, on --calibration-seconds of signal
+ *     snr             SNR_Statistics::CalculateSNRStatistics on each of --snr-lengths relax indexes
+ *
+ * Contourc appends its contours to a global buffer which is returned by the next calls, so that its
+ * duration grows with the number of calls in a process: each of its iterations runs in a new process.
+ *
+ * Usage:
+ *     mbt-benchmark [--output FILE] [--channels 1,2,4,8] [--window-seconds 1,2,4,8]
+ *                   [--calibration-seconds 30] [--snr-lengths 60,300,1200,3600] [--sampling-rate 250]
+ *                   [--iterations 20] [--min-time 0.2] [--seed 1] [--stages NAME,...]
+ * A stage which fails for a configuration is reported with its error instead of its timings.
+ *
+ * Build: same as mbt-batch, link with the libraries of lib/ and MBTBridgeConstants.mm compiled as C++.
+ *
+ */
+
+#include <sp-global.h>
+
+#include <DataManipulation/MBT_FixedShape.h>
+#include <DataManipulation/MBT_Matrix.h>
+#include <DataManipulation/MBT_RawFrameDecoder.h>
+#include <DataManipulation/MBT_SignalGenerator.h>
+#include <DataManipulation/MBT_Workspace.h>
+#include <NF_Melomind/MBT_ComputeCalibration.h>
+#include <NF_Melomind/MBT_ComputeIAFCalibration.h>
+#include <NF_Melomind/MBT_ComputeIAF.h>
+#include <NF_Melomind/MBT_ComputeRMS.h>
+#include <NF_Melomind/MBT_NFConfig.h>
+#include <NF_Melomind/MBT_NFResults.h>
+#include <NF_Melomind/Utils.h>
+#include <PreProcessing/MBT_BandPass_fftw3.h>
+#include <PreProcessing/MBT_PrecisionPipeline.h>
+#include <PreProcessing/MBT_PreProcessing.h>
+#include <QualityChecker/MBT_MainQCOperations.h>
+#include <SNR/MBT_SNR_Stats.h>
+#include <TimeFrequency/MBT_Contour.h>
+#include <TimeFrequency/MBT_MarchingSquares.h>
+#include <TimeFrequency/MBT_TF_map.h>
+#include <Transformations/MBT_PWelchComputer.h>
+
+#include "../../Resources/CPPSignalProcessing/Code bridge/MBTBridgeParameters.h"
+#include "MBT_JsonWriter.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief Options of the benchmark
+ */
+struct BenchmarkOptions {
+    std::string output; // result file, standard output if empty
+    std::vector<int> channels; // channel counts
+    std::vector<double> windowSeconds; // window lengths in seconds
+    double calibrationSeconds; // length of the calibration recording
+    std::vector<int> snrLengths; // numbers of relax indexes given to the SNR statistics
+    SP_FloatType sampRate; // sampling rate of the synthetic signals
+    int iterations; // minimum number of timed iterations
+    double minTime; // minimum timed duration in seconds
+    unsigned int seed; // seed of the synthetic signals
+    std::vector<std::string> stages; // stages to time, all if empty
+
+    BenchmarkOptions()
+    : calibrationSeconds(30), sampRate(250), iterations(20), minTime(0.2), seed(1)
+    {
+        const int defaultChannels[] = { 1, 2, 4, 8 };
+        const double defaultWindows[] = { 1, 2, 4, 8 };
+        const int defaultSnrLengths[] = { 60, 300, 1200, 3600 };
+        channels.assign(defaultChannels, defaultChannels + 4);
+        windowSeconds.assign(defaultWindows, defaultWindows + 4);
+        snrLengths.assign(defaultSnrLengths, defaultSnrLengths + 4);
+    }
+
+    bool isSelected(const std::string& stage) const
+    {
+        return stages.empty() || std::find(stages.begin(), stages.end(), stage) != stages.end();
+    }
+};
+
+/**
+ * @brief Timings of a stage for one configuration
+ */
+struct Measurement {
+    std::string stage; // name of the stage
+    int channels; // number of channels of the input
+    int samples; // number of samples per channel of the input
+    std::vector<double> durations; // duration of each iteration in nanoseconds
+    std::string error; // error of the stage, empty if it succeeded
+};
+
+/**
+ * @brief Synthetic EEG without artifacts: 1/f background and alpha peak
+ */
+SP_FloatMatrix syntheticEEG(int channels, int samples, SP_FloatType sampRate, unsigned int seed)
+{
+    MBT_SignalGeneratorConfig config;
+    config.sampRate = sampRate;
+    config.channels = channels;
+    MBT_SignalGenerator generator(config, seed);
+    return generator.generate(samples);
+}
+
+SP_Matrix toRealMatrix(const SP_FloatMatrix& matrix)
+{
+    SP_Matrix result(matrix.size().first, matrix.size().second);
+    for (int row = 0; row < matrix.size().first; ++row) {
+        std::copy(matrix.rowData(row), matrix.rowData(row) + matrix.size().second, result.rowData(row));
+    }
+    return result;
+}
+
+SP_FloatVector rowOf(const SP_FloatMatrix& matrix, int row)
+{
+    return SP_FloatVector(matrix.rowData(row), matrix.rowData(row) + matrix.size().second);
+}
+
+SP_Vector realRowOf(const SP_Matrix& matrix, int row)
+{
+    return SP_Vector(matrix.rowData(row), matrix.rowData(row) + matrix.size().second);
+}
+
+// Keeps the results of the stages alive so that the compiler cannot drop the calls
+volatile double g_sink = 0;
+
+/**
+ * @brief Time a stage: one untimed call, then calls until both the minimum number of iterations and
+ * the minimum duration are reached
+ */
+template<typename Stage>
+void measure(const BenchmarkOptions& options, Measurement& measurement, Stage stage)
+{
+    try {
+        g_sink = g_sink + stage();
+        const Clock::time_point start = Clock::now();
+        while (static_cast<int>(measurement.durations.size()) < options.iterations
+               || std::chrono::duration<double>(Clock::now() - start).count() < options.minTime) {
+            const Clock::time_point before = Clock::now();
+            g_sink = g_sink + stage();
+            measurement.durations.push_back(std::chrono::duration<double, std::nano>(Clock::now() - before).count());
+        }
+    } catch (const std::exception& error) {
+        measurement.durations.clear();
+        measurement.error = error.what();
+    }
+}
+
+/**
+ * @brief Time a stage with each call in a new process, for the stages keeping global state between calls
+ */
+template<typename Stage>
+void measureInNewProcesses(const BenchmarkOptions& options, Measurement& measurement, Stage stage)
+{
+    for (int iteration = 0; iteration < options.iterations; ++iteration) {
+        int channel[2];
+        if (pipe(channel) != 0) {
+            measurement.error = "cannot create a pipe";
+            break;
+        }
+        const pid_t pid = fork();
+        if (pid == 0) {
+            close(channel[0]);
+            double duration = -1;
+            try {
+                const Clock::time_point before = Clock::now();
+                g_sink = g_sink + stage();
+                duration = std::chrono::duration<double, std::nano>(Clock::now() - before).count();
+            } catch (const std::exception&) {
+            }
+            const ssize_t written = write(channel[1], &duration, sizeof(duration));
+            _exit(written == static_cast<ssize_t>(sizeof(duration)) ? 0 : 1);
+        }
+        close(channel[1]);
+        double duration = -1;
+        const bool isRead = pid > 0 && read(channel[0], &duration, sizeof(duration)) == static_cast<ssize_t>(sizeof(duration));
+        close(channel[0]);
+        if (pid > 0) {
+            int status = 0;
+            waitpid(pid, &status, 0);
+        }
+        if (!isRead || duration < 0) {
+            measurement.error = pid < 0 ? "cannot start a process" : "the stage failed";
+            break;
+        }
+        measurement.durations.push_back(duration);
+    }
+    if (!measurement.error.empty()) {
+        measurement.durations.clear();
+    }
+}
+
+/**
+ * @brief Benchmark runner: holds the options and the measurements
+ */
+class Benchmark
+{
+    public:
+        explicit Benchmark(const BenchmarkOptions& options)
+        : m_options(options)
+        {}
+
+        template<typename Stage>
+        void run(const std::string& name, int channels, int samples, Stage stage, bool isNewProcess = false)
+        {
+            if (!m_options.isSelected(name)) {
+                return;
+            }
+            Measurement measurement;
+            measurement.stage = name;
+            measurement.channels = channels;
+            measurement.samples = samples;
+            if (isNewProcess) {
+                measureInNewProcesses(m_options, measurement, stage);
+            } else {
+                measure(m_options, measurement, stage);
+            }
+            std::cerr << name << "\t" << channels << "x" << samples << "\t"
+                      << (measurement.error.empty() ? "ok" : measurement.error) << "\n";
+            m_measurements.push_back(measurement);
+        }
+
+        void write(std::ostream& out) const
+        {
+            MBT_JsonWriter json(out);
+            json.beginObject()
+                .field("samplingRate", m_options.sampRate)
+                .field("seed", m_options.seed)
+                .field("minIterations", m_options.iterations)
+                .field("minTime", m_options.minTime)
+                .field("hardwareConcurrency", std::thread::hardware_concurrency())
+                .field("timestamp", static_cast<long long>(std::time(0)));
+            json.key("results").beginArray();
+            for (size_t i = 0; i < m_measurements.size(); ++i) {
+                writeMeasurement(json, m_measurements[i]);
+            }
+            json.endArray().endObject();
+        }
+
+    private:
+        void writeMeasurement(MBT_JsonWriter& json, const Measurement& measurement) const
+        {
+            json.beginObject()
+                .field("stage", measurement.stage)
+                .field("channels", measurement.channels)
+                .field("samples", measurement.samples);
+            if (!measurement.error.empty() || measurement.durations.empty()) {
+                json.field("error", measurement.error).endObject();
+                return;
+            }
+            std::vector<double> sorted = measurement.durations;
+            std::sort(sorted.begin(), sorted.end());
+            double total = 0;
+            for (size_t i = 0; i < sorted.size(); ++i) {
+                total += sorted[i];
+            }
+            const double mean = total / sorted.size();
+            double variance = 0;
+            for (size_t i = 0; i < sorted.size(); ++i) {
+                variance += (sorted[i] - mean) * (sorted[i] - mean);
+            }
+            const double median = percentile(sorted, 0.5);
+            json.field("iterations", sorted.size())
+                .field("minNs", sorted.front())
+                .field("medianNs", median)
+                .field("meanNs", mean)
+                .field("stddevNs", std::sqrt(variance / sorted.size()))
+                .field("p95Ns", percentile(sorted, 0.95))
+                .field("maxNs", sorted.back())
+                .field("samplesPerSecond", 1e9 * measurement.channels * measurement.samples / median)
+                .endObject();
+        }
+
+        static double percentile(const std::vector<double>& sorted, double rank)
+        {
+            const double position = rank * (sorted.size() - 1);
+            const size_t below = static_cast<size_t>(position);
+            const size_t above = std::min(below + 1, sorted.size() - 1);
+            return sorted[below] + (position - below) * (sorted[above] - sorted[below]);
+        }
+
+        const BenchmarkOptions& m_options;
+        std::vector<Measurement> m_measurements;
+};
+
+/**
+ * @brief Time the contour extraction on a time-frequency map, at the mean of the map
+ */
+void runContourStages(Benchmark& benchmark, int samples, const SP_Matrix& map)
+{
+    double level = 0;
+    for (int row = 0; row < map.size().first; ++row) {
+        for (int column = 0; column < map.size().second; ++column) {
+            level += map.rowData(row)[column];
+        }
+    }
+    level /= std::max(1, map.size().first * map.size().second);
+    benchmark.run("contourc", 1, samples, [&]() {
+        return Contourc(map, level).size().second;
+    }, true);
+    MBT_MarchingSquares extractor;
+    MBT_Polylines contours;
+    benchmark.run("marchingSquares", 1, samples, [&]() {
+        extractor.extract(map, level, contours);
+        return contours.count();
+    });
+}
+
+/**
+ * @brief Preprocessing of the preprocessingWorkspace stage, with the specialised kernels when the window
+ * has the shape of a headset
+ */
+class PreprocessingKernel
+{
+    public:
+        typedef double Result;
+
+        PreprocessingKernel(const SP_Matrix& eeg, SP_FloatType sampRate, MBT_Workspace& workspace)
+        : m_eeg(eeg), m_sampRate(sampRate), m_workspace(workspace)
+        {}
+
+        template<typename Shape>
+        Result run()
+        {
+            typedef MBT_FixedKernels<Shape> Kernels;
+            double result = 0;
+            SP_Vector& derivative = m_workspace.scratch(1);
+            SP_Vector& power = m_workspace.scratch(2);
+            derivative.resize(Shape::SAMPLES - 1);
+            power.resize(Shape::SAMPLES);
+            for (int channel = 0; channel < Shape::CHANNELS; ++channel) {
+                SP_Vector& signal = m_workspace.signal(channel);
+                signal.resize(Shape::SAMPLES);
+                Kernels::removeDC(m_eeg.rowData(channel), signal.data());
+                CalculateBounds(signal, m_bounds, m_workspace);
+                InterpolateOutliers(signal, m_bounds, signal);
+                Kernels::detrend(signal.data(), signal.data());
+                Kernels::timeFirstDerivative(signal.data(), derivative.data());
+                Kernels::powerOfTwoWithoutDC(signal.data(), power.data());
+                result += derivative.size() + power.size();
+            }
+            return result;
+        }
+
+        Result runGeneric()
+        {
+            double result = 0;
+            for (int channel = 0; channel < m_eeg.size().first; ++channel) {
+                SP_Vector& signal = m_workspace.loadSignal(channel, m_eeg, channel);
+                RemoveDC(signal, signal);
+                CalculateBounds(signal, m_bounds, m_workspace);
+                InterpolateOutliers(signal, m_bounds, signal);
+                detrend(signal, m_sampRate, signal);
+                timeFirstDerivative(signal, m_sampRate, m_workspace.scratch(1));
+                powerOfTwoWithoutDC(signal, m_workspace.scratch(2));
+                result += m_workspace.scratch(1).size() + m_workspace.scratch(2).size();
+            }
+            return result;
+        }
+
+    private:
+        const SP_Matrix& m_eeg; // window of signal
+        const SP_FloatType m_sampRate; // sampling rate of the window
+        MBT_Workspace& m_workspace; // buffers of the thread
+        SP_Vector m_bounds; // bounds of the outliers
+};
+
+/**
+ * @brief Time the stages working on a window of signal
+ */
+void runWindowStages(Benchmark& benchmark, const BenchmarkOptions& options, int channels, int samples,
+                     MBT_MainQC& qualityChecker, const MBT_SessionCalibration& calibration)
+{
+    const SP_FloatType sampRate = options.sampRate;
+    const SP_FloatMatrix eeg = syntheticEEG(channels, samples, sampRate, options.seed + channels * 7919 + samples);
+    const SP_Matrix realEEG = toRealMatrix(eeg);
+
+    // the duration of the decoding does not depend on the values
+    std::vector<uint8_t> raw(static_cast<size_t>(channels) * samples * 2);
+    for (size_t index = 0; index < raw.size(); ++index) {
+        raw[index] = static_cast<uint8_t>(index * 37 + 11);
+    }
+    const MBT_RawFrameDecoder decoder(static_cast<unsigned int>(channels));
+    SP_FloatMatrix decoded(channels, samples);
+    benchmark.run("rawFrameDecoder", channels, samples, [&]() {
+        return decoder.decode(raw.data(), raw.size(), decoded.data(), samples);
+    });
+
+    benchmark.run("pwelch", channels, samples, [&]() {
+        MBT_PWelchComputer psd(realEEG, sampRate, "HAMMING");
+        return psd.get_PSD().size().second;
+    });
+
+    SP_FloatVector bounds;
+    bounds.push_back(2);
+    bounds.push_back(30);
+    benchmark.run("bandPass", channels, samples, [&]() {
+        double result = 0;
+        for (int channel = 0; channel < channels; ++channel) {
+            result += BandPassFilter(rowOf(eeg, channel), bounds).size();
+        }
+        return result;
+    });
+
+    std::vector<SP_Vector> rows(channels);
+    for (int channel = 0; channel < channels; ++channel) {
+        rows[channel] = realRowOf(realEEG, channel);
+    }
+    benchmark.run("preprocessing", channels, samples, [&]() {
+        double result = 0;
+        for (int channel = 0; channel < channels; ++channel) {
+            const SP_Vector signal = RemoveDC(rows[channel]);
+            const SP_Vector repaired = InterpolateOutliers(signal, CalculateBounds(signal));
+            const SP_Vector detrended = detrend(repaired, sampRate);
+            result += timeFirstDerivative(detrended, sampRate).size() + powerOfTwoWithoutDC(detrended).size();
+        }
+        return result;
+    });
+
+    const MBT_WorkspaceConfig workspaceConfig = { static_cast<unsigned int>(channels), static_cast<unsigned int>(samples), 0 };
+    MBT_Workspace& workspace = MBT_Workspace::forThread(workspaceConfig);
+    PreprocessingKernel preprocessing(realEEG, sampRate, workspace);
+    benchmark.run("preprocessingWorkspace", channels, samples, [&]() {
+        return preprocessing.runGeneric();
+    });
+
+    const MBT_ShapeId shape = MBT_selectShape(sampRate, static_cast<unsigned int>(channels), static_cast<unsigned int>(samples));
+    if (shape != MBT_SHAPE_GENERIC) {
+        benchmark.run("preprocessingFixed", channels, samples, [&]() {
+            return MBT_runWithShape(shape, preprocessing);
+        });
+    }
+
+    MBT_PrecisionPipeline<SP_FloatType> singlePipeline(sampRate, samples);
+    benchmark.run("preprocessingSingle", channels, samples, [&]() {
+        double result = 0;
+        for (int channel = 0; channel < channels; ++channel) {
+            singlePipeline.process(eeg, channel);
+            result += singlePipeline.derivative().size() + singlePipeline.power().size();
+        }
+        return result;
+    });
+
+    benchmark.run("quality", channels, samples, [&]() {
+        qualityChecker.MBT_ComputeQuality(eeg);
+        return qualityChecker.MBT_get_m_quality().size();
+    });
+
+    benchmark.run("iaf", channels, samples, [&]() {
+        SP_FloatVector histFreq;
+        return MBT_ComputeIAF(realEEG, sampRate, IAFinf, IAFsup, histFreq).size();
+    });
+
+    benchmark.run("rms", channels, samples, [&]() {
+        return MBT_ComputeRMS(realEEG, sampRate, IAFinf, IAFsup).size();
+    });
+
+    // the relax indexes of the previous packets are restored before each call, so that each call smoothes as many
+    // values as the first one instead of a history growing with the iterations
+    const MBT_NFConfig configuration = { static_cast<float>(sampRate), static_cast<unsigned int>(samples), SMOOTHINGDURATION, 1 };
+    const SP_FloatVector previousRelaxIndex(SMOOTHINGDURATION, 0.5f);
+    SP_FloatVector pastRelaxIndex;
+    SP_FloatVector smoothedRelaxIndex;
+    SP_FloatVector volum;
+    const SP_FloatVector qualities(channels, 1);
+    benchmark.run("relaxIndex", channels, samples, [&]() {
+        pastRelaxIndex = previousRelaxIndex;
+        smoothedRelaxIndex = previousRelaxIndex;
+        volum = previousRelaxIndex;
+        return main_relaxIndex(configuration, calibration, eeg, pastRelaxIndex, smoothedRelaxIndex, volum, qualities);
+    });
+
+    // TF works from the spectrum of each channel
+    const MBT_PWelchComputer psdComputer(realEEG, sampRate, "HAMMING");
+    const SP_Matrix psd = psdComputer.get_PSD();
+    const SP_Vector frequencies = realRowOf(psd, 0);
+    std::vector<SP_Vector> signals(channels);
+    std::vector<SP_Vector> powers(channels);
+    for (int channel = 0; channel < channels; ++channel) {
+        signals[channel] = realRowOf(realEEG, channel);
+        powers[channel] = realRowOf(psd, channel + 1);
+    }
+    benchmark.run("tf", channels, samples, [&]() {
+        double result = 0;
+        for (int channel = 0; channel < channels; ++channel) {
+            result += TF(signals[channel], sampRate, powers[channel], frequencies).size().second;
+        }
+        return result;
+    });
+
+    // the maps do not depend on the channel count, they are timed once per window
+    if (channels != options.channels.front()) {
+        return;
+    }
+    try {
+        runContourStages(benchmark, samples, TF(signals[0], sampRate, powers[0], frequencies));
+    } catch (const std::exception& error) {
+        std::cerr << "tf\t1x" << samples << "\t" << error.what() << ", contours skipped\n";
+    }
+}
+
+std::vector<std::string> splitList(const std::string& text)
+{
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        if (end > start) {
+            items.push_back(text.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return items;
+}
+
+template<typename T>
+std::vector<T> parseList(const std::string& text)
+{
+    const std::vector<std::string> items = splitList(text);
+    std::vector<T> values;
+    for (size_t i = 0; i < items.size(); ++i) {
+        const double value = std::atof(items[i].c_str());
+        if (value > 0) {
+            values.push_back(static_cast<T>(value));
+        }
+    }
+    return values;
+}
+
+void printUsage()
+{
+    std::cerr << "usage: mbt-benchmark [--output FILE] [--channels 1,2,4,8] [--window-seconds 1,2,4,8]\n"
+                 "                     [--calibration-seconds 30] [--snr-lengths 60,300,1200,3600]\n"
+                 "                     [--sampling-rate 250] [--iterations 20] [--min-time 0.2] [--seed 1]\n"
+                 "                     [--stages NAME,...]\n";
+}
+
+bool parseOptions(int argc, char** argv, BenchmarkOptions& options)
+{
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string argument = argv[i];
+        const std::string value = argv[i + 1];
+        if (argument == "--output") {
+            options.output = value;
+        } else if (argument == "--channels") {
+            options.channels = parseList<int>(value);
+        } else if (argument == "--window-seconds") {
+            options.windowSeconds = parseList<double>(value);
+        } else if (argument == "--calibration-seconds") {
+            options.calibrationSeconds = std::atof(value.c_str());
+        } else if (argument == "--snr-lengths") {
+            options.snrLengths = parseList<int>(value);
+        } else if (argument == "--sampling-rate") {
+            options.sampRate = static_cast<SP_FloatType>(std::atof(value.c_str()));
+        } else if (argument == "--iterations") {
+            options.iterations = std::max(1, std::atoi(value.c_str()));
+        } else if (argument == "--min-time") {
+            options.minTime = std::max(0.0, std::atof(value.c_str()));
+        } else if (argument == "--seed") {
+            options.seed = static_cast<unsigned int>(std::strtoul(value.c_str(), 0, 10));
+        } else if (argument == "--stages") {
+            options.stages = splitList(value);
+        } else {
+            return false;
+        }
+    }
+    return argc % 2 == 1 && !options.channels.empty() && !options.windowSeconds.empty()
+           && options.sampRate > 0 && options.calibrationSeconds > 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+    std::sort(options.channels.begin(), options.channels.end());
+    Benchmark benchmark(options);
+    const int packetLength = static_cast<int>(options.sampRate);
+    const int calibrationSamples = static_cast<int>(options.calibrationSeconds * options.sampRate);
+
+    for (size_t c = 0; c < options.channels.size(); ++c) {
+        const int channels = options.channels[c];
+
+        // the calibration also gives the parameters of the relax index
+        const SP_FloatMatrix calibrationEEG = syntheticEEG(channels, calibrationSamples, options.sampRate, options.seed + channels);
+        SP_FloatMatrix qualities(channels, calibrationSamples / packetLength);
+        for (int channel = 0; channel < channels; ++channel) {
+            std::fill(qualities.rowData(channel), qualities.rowData(channel) + qualities.size().second, 1);
+        }
+        // same calibration as the bridge and mbt-batch: the IAF median bounds the calibration and is kept with it
+        const auto calibrate = [&]() {
+            const SP_FloatVector iafMedian = MBT_ComputeIAFCalibration(calibrationEEG, qualities, options.sampRate,
+                                                                       packetLength, IAFinf, IAFsup);
+            std::map<std::string, SP_FloatVector> paramCalib = MBT_ComputeCalibration(calibrationEEG, qualities, options.sampRate,
+                                                                                      packetLength, iafMedian[0], iafMedian[1],
+                                                                                      SMOOTHINGDURATION);
+            paramCalib[MBT_IAF_CALIBRATION_KEY] = iafMedian;
+            return paramCalib;
+        };
+        benchmark.run("calibration", channels, calibrationSamples, [&]() {
+            return calibrate().size();
+        });
+        MBT_SessionCalibration calibration;
+        try {
+            calibration = MBT_SessionCalibration(MBT_CalibrationResult::fromMap(calibrate()), RMS_MIN_FACTOR, RMS_MAX_FACTOR);
+        } catch (const std::exception& error) {
+            std::cerr << "calibration\t" << channels << "x" << calibrationSamples << "\t" << error.what() << "\n";
+        }
+
+        MBT_MainQC* qualityChecker = MBT_createBridgeQualityChecker(options.sampRate);
+        for (size_t w = 0; w < options.windowSeconds.size(); ++w) {
+            const int samples = static_cast<int>(options.windowSeconds[w] * options.sampRate);
+            runWindowStages(benchmark, options, channels, samples, *qualityChecker, calibration);
+        }
+        delete qualityChecker;
+    }
+
+    // relax indexes between 0.2 and 1.2 from a linear congruential sequence, the same with every standard library
+    uint32_t state = options.seed;
+    for (size_t s = 0; s < options.snrLengths.size(); ++s) {
+        SP_FloatVector relaxIndexes(options.snrLengths[s]);
+        for (size_t i = 0; i < relaxIndexes.size(); ++i) {
+            state = state * 1664525u + 1013904223u;
+            relaxIndexes[i] = 0.2f + static_cast<SP_FloatType>(state >> 8) * (1.0f / 16777216.0f);
+        }
+        benchmark.run("snr", 1, options.snrLengths[s], [&]() {
+            SNR_Statistics statistics(relaxIndexes);
+            return statistics.CalculateSNRStatistics(relaxIndexes, 1).size();
+        });
+    }
+
+    if (options.output.empty()) {
+        benchmark.write(std::cout);
+    } else {
+        std::ofstream file(options.output.c_str());
+        benchmark.write(file);
+        if (!file) {
+            std::cerr << "mbt-benchmark: cannot write " << options.output << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file MBT_JsonWriter.h
+ *
+ * @copyright Copyright (c) 2026 myBrain Technologies. All rights reserved.
+ *
+ * @brief Minimal streaming JSON writer used by the command line tools to write their results.
+ * Values are written as soon as they are given, the writer only keeps whether a comma is needed
+ * at each nesting level. Non finite numbers are written as null.
+ *
+ */
+
+#ifndef MBT_JSONWRITER_H
+#define MBT_JSONWRITER_H
+
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief JSON writer on a stream, the calls can be chained: writer.beginObject().field("name", value).endObject()
+ *
+ */
+class MBT_JsonWriter
+{
+    public:
+        /**
+         * @brief Construct a writer on a stream
+         *
+         * @param out The stream receiving the JSON text
+         */
+        explicit MBT_JsonWriter(std::ostream& out)
+        : m_out(out), m_hasKey(false)
+        {}
+
+        MBT_JsonWriter& beginObject() { open('{'); return *this; }
+        MBT_JsonWriter& endObject() { close('}'); return *this; }
+        MBT_JsonWriter& beginArray() { open('['); return *this; }
+        MBT_JsonWriter& endArray() { close(']'); return *this; }
+
+        /**
+         * @brief Write the key of the next value of the current object
+         */
+        MBT_JsonWriter& key(const std::string& name)
+        {
+            separate();
+            writeString(name);
+            m_out << ':';
+            m_hasKey = true;
+            return *this;
+        }
+
+        MBT_JsonWriter& value(const std::string& text) { separate(); writeString(text); return *this; }
+        MBT_JsonWriter& value(const char* text) { return value(std::string(text)); }
+        MBT_JsonWriter& value(bool flag) { separate(); m_out << (flag ? "true" : "false"); return *this; }
+        MBT_JsonWriter& value(int number) { separate(); m_out << number; return *this; }
+        MBT_JsonWriter& value(unsigned int number) { separate(); m_out << number; return *this; }
+        MBT_JsonWriter& value(long number) { separate(); m_out << number; return *this; }
+        MBT_JsonWriter& value(unsigned long number) { separate(); m_out << number; return *this; }
+        MBT_JsonWriter& value(long long number) { separate(); m_out << number; return *this; }
+        MBT_JsonWriter& value(unsigned long long number) { separate(); m_out << number; return *this; }
+        // single precision values are written with the digits needed to read them back exactly
+        MBT_JsonWriter& value(float number) { return writeNumber(number, "%.9g"); }
+        MBT_JsonWriter& value(double number) { return writeNumber(number, "%.17g"); }
+
+        /**
+         * @brief Write a vector as an array
+         */
+        template<typename T>
+        MBT_JsonWriter& value(const std::vector<T>& values)
+        {
+            beginArray();
+            for (size_t i = 0; i < values.size(); ++i) {
+                value(values[i]);
+            }
+            return endArray();
+        }
+
+        /**
+         * @brief Write a dictionnary as an object
+         */
+        template<typename T>
+        MBT_JsonWriter& value(const std::map<std::string, T>& values)
+        {
+            beginObject();
+            for (typename std::map<std::string, T>::const_iterator it = values.begin(); it != values.end(); ++it) {
+                key(it->first).value(it->second);
+            }
+            return endObject();
+        }
+
+        /**
+         * @brief Write a key and its value
+         */
+        template<typename T>
+        MBT_JsonWriter& field(const std::string& name, const T& fieldValue)
+        {
+            return key(name).value(fieldValue);
+        }
+
+    private:
+        void separate()
+        {
+            if (m_hasKey) {
+                m_hasKey = false;
+                return;
+            }
+            if (!m_isFirst.empty()) {
+                if (!m_isFirst.back()) {
+                    m_out << ',';
+                }
+                m_isFirst.back() = false;
+            }
+        }
+
+        void open(char bracket)
+        {
+            separate();
+            m_out << bracket;
+            m_isFirst.push_back(true);
+        }
+
+        void close(char bracket)
+        {
+            m_isFirst.pop_back();
+            m_out << bracket;
+            if (m_isFirst.empty()) {
+                m_out << '\n';
+            }
+        }
+
+        MBT_JsonWriter& writeNumber(double number, const char* format)
+        {
+            separate();
+            if (!std::isfinite(number)) {
+                m_out << "null";
+                return *this;
+            }
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), format, number);
+            m_out << buffer;
+            return *this;
+        }
+
+        void writeString(const std::string& text)
+        {
+            m_out << '"';
+            for (size_t i = 0; i < text.size(); ++i) {
+                const unsigned char c = static_cast<unsigned char>(text[i]);
+                if (c == '"' || c == '\\') {
+                    m_out << '\\' << text[i];
+                } else if (c < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    m_out << buffer;
+                } else {
+                    m_out << text[i];
+                }
+            }
+            m_out << '"';
+        }
+
+        std::ostream& m_out; // stream receiving the text
+        std::vector<bool> m_isFirst; // true at each nesting level until its first value is written
+        bool m_hasKey; // true between a key and its value
+};
+
+#endif // MBT_JSONWRITER_H